@@ -82,7 +82,7 @@ typedef struct {
 // function prototypes
 
 Actor actor_create(uint32_t id, const char *model_path);
-void actor_set(Actor *actor);
+void actor_set(Actor *actor, float interpolation_factor);
 void actor_draw(Actor *actor);
 void actor_delete(Actor *actor);
 
@@ -137,12 +137,15 @@ Actor actor_create(uint32_t id, const char *model_path)
     return actor;
 }
 
-void actor_set(Actor *actor)
+/* "interpolation_factor" places the model between the last two physics steps */
+void actor_set(Actor *actor, float interpolation_factor)
 {	
+	Vector3 position = rigidBody_getInterpolatedPosition(&actor->body, interpolation_factor);
+
 	t3d_mat4fp_from_srt_euler(actor->modelMat,
 		(float[3]){actor->scale.x, actor->scale.y, actor->scale.z},
 		(float[3]){rad(actor->body.rotation.x), rad(actor->body.rotation.y), rad(actor->body.rotation.z)},
-		(float[3]){actor->body.position.x, actor->body.position.y, actor->body.position.z}
+		(float[3]){position.x, position.y, position.z}
 	);
 }
 
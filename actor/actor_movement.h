@@ -14,12 +14,17 @@ void actor_setJumpAcceleration (Actor *actor, float target_speed, float accelera
 
 void actor_integrate (Actor *actor, float frame_time);
 
+Vector3 actor_integrateVelocity (Actor *actor, float frame_time);
+
 
 
 void actor_setAcceleration(Actor *actor, float target_speed, float acceleration_rate)
 {
-    actor->target_velocity.x = target_speed * sinf(rad(actor->target_yaw));
-    actor->target_velocity.y = target_speed * -cosf(rad(actor->target_yaw));
+    float sin_yaw, cos_yaw;
+    trig_sinCos(rad(actor->target_yaw), &sin_yaw, &cos_yaw);
+
+    actor->target_velocity.x = target_speed * sin_yaw;
+    actor->target_velocity.y = target_speed * -cos_yaw;
 
     actor->body.acceleration.x = acceleration_rate * (actor->target_velocity.x - actor->body.velocity.x);
     actor->body.acceleration.y = acceleration_rate * (actor->target_velocity.y - actor->body.velocity.y);
@@ -28,8 +33,11 @@ void actor_setAcceleration(Actor *actor, float target_speed, float acceleration_
 
 void actor_setInertiaAcceleration(Actor *actor, float target_speed, float acceleration_rate)
 {
-    actor->target_velocity.x = target_speed * sinf(rad(actor->body.rotation.z));
-    actor->target_velocity.y = target_speed * -cosf(rad(actor->body.rotation.z));
+    float sin_yaw, cos_yaw;
+    trig_sinCos(rad(actor->body.rotation.z), &sin_yaw, &cos_yaw);
+
+    actor->target_velocity.x = target_speed * sin_yaw;
+    actor->target_velocity.y = target_speed * -cos_yaw;
 
     actor->body.acceleration.x = acceleration_rate * (actor->target_velocity.x - actor->body.velocity.x);
     actor->body.acceleration.y = acceleration_rate * (actor->target_velocity.y - actor->body.velocity.y);
@@ -51,6 +59,15 @@ void actor_setJumpAcceleration(Actor *actor, float target_speed, float accelerat
 
 void actor_integrate (Actor *actor, float frame_time)
 {
+    Vector3 displacement = actor_integrateVelocity(actor, frame_time);
+    vector3_add(&actor->body.position, &displacement);
+}
+
+/* integrates the velocity and returns the displacement of the step without moving the actor,
+so it can be swept against the scene before it is applied */
+Vector3 actor_integrateVelocity (Actor *actor, float frame_time)
+{
+    actor->body.previous_position = actor->body.position;
 
     if (actor->body.acceleration.x != 0 || actor->body.acceleration.y != 0 || actor->body.acceleration.z != 0){
         vector3_addScaledVector(&actor->body.velocity, &actor->body.acceleration, frame_time);
@@ -61,16 +78,15 @@ void actor_integrate (Actor *actor, float frame_time)
 		actor->body.velocity.y = 0;
 	}
 
-    if (actor->body.velocity.x != 0 || actor->body.velocity.y != 0 || actor->body.velocity.z != 0) 
-        vector3_addScaledVector(&actor->body.position, &actor->body.velocity, frame_time);
-
     if (actor->body.velocity.x != 0 || actor->body.velocity.y != 0) {
 
-		actor->body.rotation.z = deg(atan2(-actor->body.velocity.x, -actor->body.velocity.y));
+		actor->body.rotation.z = deg(trig_atan2(-actor->body.velocity.x, -actor->body.velocity.y));
 
         Vector2 horizontal_velocity = {actor->body.velocity.x, actor->body.velocity.y};
         actor->horizontal_speed = vector2_magnitude(&horizontal_velocity);       
 	}
+
+    return vector3_returnScaled(&actor->body.velocity, frame_time);
 }
 
 #endif
\ No newline at end of file
@@ -1,49 +1,108 @@
 #ifndef ACTOR_COLLISION_H
 #define ACTOR_COLLISION_H
 
-// collision types
+#define ACTOR_COLLIDER_MAX_PARTS 2           // sword and shield
 
-#define SPHERE_A 1
-#define AABB_A 2
-#define BOX_A 3
-#define PLANE_A 4
-#define RAY_A 5
-#define CAPSULE_A 6
-#define TERRAIN_A 7
-#define MESH_A 8
+#define ACTOR_CONTACT_CACHE_SIZE 16          // targets remembered per actor
+#define ACTOR_CONTACT_CACHE_EPSILON 0.01f    // relative motion under which the last result is reused as it is
+
+// Contacts are classified by the cosine of their slope, the z of their unit normal, against these precomputed limits
+#define ACTOR_GROUND_MIN_COS_SLOPE 0.64278761f      // cos(50 degrees), flatter contacts are ground
+#define ACTOR_CEILING_MAX_COS_SLOPE -0.08715574f    // cos(95 degrees), contacts facing further down are ceilings
 
 // structures
 
 typedef struct {
     float body_radius;
     float body_height;
-    //float sword_radius;
-    //float sword_lenght;
-    //float shield_radius;
+    float sword_radius;                // 0 for no sword
+    float sword_length;
+    Vector3 sword_offset;              // start of the blade from the actor position, the blade runs along the actor y axis
+    float shield_radius;               // 0 for no shield
+    Vector3 shield_offset;             // center of the shield from the actor position
 } ActorColliderSettings;
 
-typedef struct {
-    Capsule body;
-    //Capsule sword;
-    //Sphere shield;
-    ActorColliderSettings settings;
-} ActorCollider;
-
 typedef struct {
     Vector3 axis_closest_to_point;     // closest point in the capsule axis to the point of contact
     Vector3 velocity_penetration;      // penetration vector in the direction of the velocity
-    float slope;                       // angle of inclination of the the plane of contact
-    float angle_of_incidence;          // angle between the velocity vector and the plane of contact
+    float cos_slope;                   // cosine of the inclination of the plane of contact, 1 flat ground, 0 walls, -1 flat ceilings
     float displacement;                // distance from the origin to the plane of contact
     float ground_distance;          // vertical distance from the actor's position to the nearest plane of contact
     ContactData data;
 } ActorContactData;
 
+/* last narrowphase result of the actor against one target */
+typedef struct {
+    const Collider* target;            // NULL for unused entries
+    Vector3 offset;                    // actor position minus target position at the narrowphase, reuses don't move it
+    float radius;                      // of the actor body then, the contact solver grows it by the skin width
+    bool hit;
+    ActorContactData contact;
+} ActorContactCacheEntry;
+
+/* remembers the results of the actor against its targets, so a pair that didn't move relative to each other
+skips the narrowphase. the counters cover the calls since the last reset */
+typedef struct {
+    ActorContactCacheEntry entries[ACTOR_CONTACT_CACHE_SIZE];
+    int next_entry;                    // replaced when a new target doesn't fit
+    int lookups;
+    int hits;                          // results reused as they were
+    int slides;                        // plane contacts moved along with the actor
+} ActorContactCache;
+
+typedef struct {
+    Capsule body;
+    Collider parts;                                     // compound of the sword and the shield, no type without them
+    Collider part_shapes[ACTOR_COLLIDER_MAX_PARTS];     // in the frame of the actor
+    Collider world_parts[ACTOR_COLLIDER_MAX_PARTS];     // rebuilt from the shapes when a test needs them
+    ActorColliderSettings settings;
+    CollisionFilter filter;
+    CollisionFilterTable* filters;      // layer table counting the skipped pairs, NULL checks the masks only
+    ActorContactCache* cache;           // NULL runs the narrowphase every time
+} ActorCollider;
+
+/* state of actorCollision_contactBroadphase while it walks the tree */
+typedef struct {
+    ActorContactData* contacts;
+    int max_contacts;
+    int contact_count;                  // found so far, can pass "max_contacts"
+    const ActorCollider* collider;
+    const DynamicTree* tree;
+} ActorBroadphaseQuery;
+
 
+/* the parts point into the collider, keep it in place after this */
 void actorCollider_init(ActorCollider* collider)
 {
     collider->body.radius = collider->settings.body_radius;
     collider->body.length = collider->settings.body_height;
+    collisionFilter_set(&collider->filter, COLLISION_LAYER_DEFAULT, COLLISION_MASK_ALL);
+    collider->filters = NULL;
+    collider->cache = NULL;
+
+    ActorColliderSettings* settings = &collider->settings;
+    int part_count = 0;
+
+    if (settings->sword_radius > 0.0f) {
+        Collider* sword = &collider->part_shapes[part_count++];
+        collider_init(sword, CAPSULE_A);
+        sword->capsule.start = settings->sword_offset;
+        sword->capsule.end = settings->sword_offset;
+        sword->capsule.end.y += settings->sword_length;
+        sword->capsule.radius = settings->sword_radius;
+        sword->capsule.length = settings->sword_length;
+    }
+
+    if (settings->shield_radius > 0.0f) {
+        Collider* shield = &collider->part_shapes[part_count++];
+        collider_init(shield, SPHERE_A);
+        shield->sphere.center = settings->shield_offset;
+        shield->sphere.radius = settings->shield_radius;
+    }
+
+    // Without parts the type stays out of the narrowphase table, so every test against them misses
+    if (part_count > 0) collider_initCompound(&collider->parts, collider->part_shapes, collider->world_parts, part_count);
+    else collider_init(&collider->parts, 0);
 }
 
 void actorCollider_setVertical(ActorCollider* collider, Vector3* position)
@@ -51,15 +110,24 @@ void actorCollider_setVertical(ActorCollider* collider, Vector3* position)
     capsule_setVertical(&collider->body, position);
 }
 
+/* places the body at "position" and the parts around it with the actor "rotation",
+the parts only get rebuilt when something tests against them */
 void actorCollider_set(ActorCollider* collider, Vector3* position, Vector3* rotation)
 {
+    capsule_setVertical(&collider->body, position);
+    if (collider->parts.type == COMPOUND_A) compound_setTransform(&collider->parts.compound, position, rotation);
+}
+
+AABB actorCollider_getAABB(const ActorCollider* collider)
+{
+    return capsule_getAABB(&collider->body);
 }
 
 void actorContactData_clear(ActorContactData* contact)
 {
     contact->axis_closest_to_point = (Vector3){0.0f, 0.0f, 0.0f};
     contact->velocity_penetration = (Vector3){0.0f, 0.0f, 0.0f};
-    contact->slope = 1000.0f;                                      // Set the slope to an out of range value to indicate no contact
+    contact->cos_slope = -2.0f;                                    // Set the slope to an out of range value to indicate no contact
     contact->displacement = 0.0f;
     contact->ground_distance = 1000.0f;
     contactData_init(&contact->data);
@@ -70,17 +138,32 @@ void actorContactData_setAxisClosestToPoint(ActorContactData* contact, const Act
     contact->axis_closest_to_point = segment_closestToPoint(&collider->body.start, &collider->body.end, &contact->data.point);
 }
 
+/* the contact normals are unit vectors, so the cosine of the angle between the normal and the z-axis is its z */
 void actorContactData_setSlope(ActorContactData* contact) 
 {
-    float magnitude = vector3_magnitude(&contact->data.normal);
-    float cos_slope = contact->data.normal.z / magnitude;         // Calculate the cosine of the angle between the normal and the z-axis
-    float slope = acosf(cos_slope);
-    contact->slope = deg(slope);
+    contact->cos_slope = contact->data.normal.z;
 }
 
-void actorContactData_setAngleOfIncidence(ActorContactData* contact, const Vector3 *velocity) 
+bool actorContactData_isGround(const ActorContactData* contact)
 {
-    contact->angle_of_incidence = -deg((M_PI * 0.5f) - acosf(vector3_returnDotProduct(velocity, &contact->data.normal) / vector3_magnitude(velocity)));
+    return contact->cos_slope > ACTOR_GROUND_MIN_COS_SLOPE;
+}
+
+bool actorContactData_isCeiling(const ActorContactData* contact)
+{
+    return contact->cos_slope < ACTOR_CEILING_MAX_COS_SLOPE;
+}
+
+/* inclination of the plane of contact in degrees, for the gameplay that needs the angle itself */
+float actorContactData_getSlope(const ActorContactData* contact)
+{
+    return deg(trig_acos(contact->cos_slope));
+}
+
+/* angle in degrees between "velocity" and the plane of contact, computed only when asked for */
+float actorContactData_getAngleOfIncidence(const ActorContactData* contact, const Vector3 *velocity) 
+{
+    return -deg((M_PI * 0.5f) - trig_acos(vector3_returnDotProduct(velocity, &contact->data.normal) / vector3_magnitude(velocity)));
 }
 
 void actorContactData_setDisplacement(ActorContactData* contact)
@@ -94,56 +177,71 @@ void actorCollision_setGroundDistance(ActorContactData* contact, Vector3* positi
     else contact->ground_distance = (contact->displacement - vector3_returnDotProduct(position, &contact->data.normal)) / -contact->data.normal.z;
 }
 
-bool actorCollision_contactSphere(const ActorCollider* collider, const Sphere* sphere)
-{
-    return capsule_contactSphere(&collider->body, sphere);
-}
-
-void actorCollision_contactSphereSetData(ActorContactData* contact, const ActorCollider* collider, const Sphere* sphere)
+/* fills the fields derived from the contact data once a narrowphase test has hit */
+void actorContactData_setDerived(ActorContactData* contact, const ActorCollider* collider)
 {
-    capsule_contactSphereSetData(&contact->data, &collider->body, sphere);
     actorContactData_setSlope(contact);
     actorContactData_setDisplacement(contact);
     actorContactData_setAxisClosestToPoint(contact, collider);
 }
 
-bool actorCollision_contactAABB(const ActorCollider* collider, const AABB* aabb)
+/* each contact function runs a single pass narrowphase test, returns true and fills "contact" on contact */
+
+bool actorCollision_contactSphere(ActorContactData* contact, const ActorCollider* collider, const Sphere* sphere)
 {
-    return capsule_contactAABB(&collider->body, aabb);
+    if (!capsule_collisionTestSphere(&contact->data, &collider->body, sphere)) return false;
+    actorContactData_setDerived(contact, collider);
+    return true;
 }
 
-void actorCollision_contactAABBsetData(ActorContactData* contact, const ActorCollider* collider, const AABB* aabb)
+bool actorCollision_contactAABB(ActorContactData* contact, const ActorCollider* collider, const AABB* aabb)
 {
-    capsule_contactAABBSetData(&contact->data, &collider->body, aabb);
-    actorContactData_setSlope(contact);
-    actorContactData_setDisplacement(contact);
-    actorContactData_setAxisClosestToPoint(contact, collider);
+    if (!capsule_collisionTestAABB(&contact->data, &collider->body, aabb)) return false;
+    actorContactData_setDerived(contact, collider);
+    return true;
 }
 
-bool actorCollision_contactBox(const ActorCollider* collider, const Box* box)
+bool actorCollision_contactBox(ActorContactData* contact, const ActorCollider* collider, const Box* box)
 {
-    return capsule_contactBox(&collider->body, box);
+    if (!capsule_collisionTestBox(&contact->data, &collider->body, box)) return false;
+    actorContactData_setDerived(contact, collider);
+    return true;
 }
 
-void actorCollision_contactBoxSetData(ActorContactData* contact, const ActorCollider* collider, const Box* box)
-{   
-    capsule_contactBoxSetData(&contact->data, &collider->body, box);
+bool actorCollision_contactPlane(ActorContactData* contact, const ActorCollider* collider, const Plane* plane)
+{
+    if (!capsule_collisionTestPlane(&contact->data, &collider->body, plane)) return false;
     actorContactData_setSlope(contact);
-    actorContactData_setDisplacement(contact);
+    contact->displacement = plane->displacement;
     actorContactData_setAxisClosestToPoint(contact, collider);
+    return true;
 }
 
-bool actorCollision_contactPlane(const ActorCollider* collider, const Plane* plane)
+bool actorCollision_contactCapsule(ActorContactData* contact, const ActorCollider* collider, const Capsule* capsule)
 {
-    return capsule_contactPlane(&collider->body, plane);
+    if (!capsule_collisionTestCapsule(&contact->data, &collider->body, capsule)) return false;
+    actorContactData_setDerived(contact, collider);
+    return true;
 }
 
-void actorCollision_contactPlaneSetData(ActorContactData* contact, const ActorCollider* collider, const Plane* plane)
+/* contact with the body of another actor, the normal points from "other" towards "collider" */
+bool actorCollision_contactActor(ActorContactData* contact, const ActorCollider* collider, const ActorCollider* other)
 {
-    capsule_contactPlaneSetData(&contact->data, &collider->body, plane);
-    actorContactData_setSlope(contact);
-    contact->displacement = plane->displacement;
-    actorContactData_setAxisClosestToPoint(contact, collider);
+    return actorCollision_contactCapsule(contact, collider, &other->body);
+}
+
+bool actorCollision_contactMesh(ActorContactData* contact, const ActorCollider* collider, const TriangleMesh* mesh)
+{
+    if (!capsule_collisionTestMesh(&contact->data, &collider->body, mesh)) return false;
+    actorContactData_setDerived(contact, collider);
+    return true;
+}
+
+bool actorCollision_contactTerrain(ActorContactData* contact, const ActorCollider* collider, const Heightfield* terrain)
+{
+    if (!capsule_collisionTestHeightfield(&contact->data, &collider->body, terrain)) return false;
+    actorContactData_setDerived(contact, collider);
+    return true;
 }
 
 bool actorCollision_intersectionRay(const ActorCollider* collider, const Ray* ray)
@@ -151,5 +249,168 @@ bool actorCollision_intersectionRay(const ActorCollider* collider, const Ray* ra
     return capsule_intersectionRay(&collider->body, ray);
 }
 
+/* runs the narrowphase matching the type of "target" on a cleared "contact", returns true on contact */
+bool actorCollision_testCollider(ActorContactData* contact, const ActorCollider* collider, const Collider* target)
+{
+    switch(target->type) {
+
+        case SPHERE_A: return actorCollision_contactSphere(contact, collider, &target->sphere);
+        case AABB_A: return actorCollision_contactAABB(contact, collider, &target->aabb);
+        case BOX_A: return actorCollision_contactBox(contact, collider, &target->box);
+        case PLANE_A: return actorCollision_contactPlane(contact, collider, &target->plane);
+        case CAPSULE_A: return actorCollision_contactCapsule(contact, collider, &target->capsule);
+        case MESH_A: return actorCollision_contactMesh(contact, collider, target->mesh);
+        case TERRAIN_A: return actorCollision_contactTerrain(contact, collider, target->terrain);
+        default: return false;
+    }
+}
+
+void actorContactCache_resetCounters(ActorContactCache* cache)
+{
+    cache->lookups = 0;
+    cache->hits = 0;
+    cache->slides = 0;
+}
+
+void actorContactCache_init(ActorContactCache* cache)
+{
+    for (int i = 0; i < ACTOR_CONTACT_CACHE_SIZE; i++) cache->entries[i].target = NULL;
+    cache->next_entry = 0;
+    actorContactCache_resetCounters(cache);
+}
+
+/* forgets every result, needed after a target rotates or changes shape in place since only its position is tracked */
+void actorContactCache_clear(ActorContactCache* cache)
+{
+    actorContactCache_init(cache);
+}
+
+/* share of the lookups since the last reset that skipped the narrowphase */
+float actorContactCache_getHitRate(const ActorContactCache* cache)
+{
+    if (cache->lookups == 0) return 0.0f;
+    return (float)(cache->hits + cache->slides) / cache->lookups;
+}
+
+/* the narrowphase through the cache. a result is reused when the actor and the target moved less than
+ACTOR_CONTACT_CACHE_EPSILON relative to each other, and a plane contact is slid along with the actor when
+the motion stays parallel to the plane, which leaves the depth, normal and slope as they were.
+the motion is measured from the last narrowphase and not from the last reuse, so small steps into the plane
+add up until they pass the epsilon and run the narrowphase again instead of drifting away unnoticed */
+bool actorContactCache_testCollider(ActorContactCache* cache, ActorContactData* contact, const ActorCollider* collider, const Collider* target)
+{
+    cache->lookups++;
+
+    Vector3 target_position = collider_getPosition(target);
+    Vector3 offset = vector3_difference(&collider->body.start, &target_position);
+
+    ActorContactCacheEntry* entry = NULL;
+    for (int i = 0; i < ACTOR_CONTACT_CACHE_SIZE; i++) {
+        if (cache->entries[i].target == target && cache->entries[i].radius == collider->body.radius) {
+            entry = &cache->entries[i];
+            break;
+        }
+    }
+
+    if (entry != NULL) {
+
+        // Since the last narrowphase
+        Vector3 motion = vector3_difference(&offset, &entry->offset);
+        float motion_squared = vector3_squaredMagnitude(&motion);
+
+        if (motion_squared < ACTOR_CONTACT_CACHE_EPSILON * ACTOR_CONTACT_CACHE_EPSILON) {
+            cache->hits++;
+            *contact = entry->contact;
+            return entry->hit;
+        }
+
+        // Planes are unbounded, any motion along them leaves the contact as it was
+        if (entry->hit && target->type == PLANE_A && fabsf(vector3_returnDotProduct(&motion, &entry->contact.data.normal)) < ACTOR_CONTACT_CACHE_EPSILON) {
+
+            cache->slides++;
+            *contact = entry->contact;
+            vector3_add(&contact->data.point, &motion);
+            vector3_add(&contact->axis_closest_to_point, &motion);
+            return true;
+        }
+    }
+    else {
+        entry = &cache->entries[cache->next_entry];
+        cache->next_entry = (cache->next_entry + 1) % ACTOR_CONTACT_CACHE_SIZE;
+        entry->target = target;
+        entry->radius = collider->body.radius;
+    }
+
+    entry->hit = actorCollision_testCollider(contact, collider, target);
+    entry->offset = offset;
+    entry->contact = *contact;
+    return entry->hit;
+}
+
+/* runs the narrowphase matching the type of "target", returns true and fills "contact" on contact.
+targets the filters reject return false before "contact" is cleared, and the actor cache answers when it can */
+bool actorCollision_contactCollider(ActorContactData* contact, const ActorCollider* collider, const Collider* target)
+{
+    if (!collisionFilterTable_shouldCollide(collider->filters, &collider->filter, &target->filter)) return false;
+    actorContactData_clear(contact);
+
+    if (collider->cache != NULL) return actorContactCache_testCollider(collider->cache, contact, collider, target);
+    return actorCollision_testCollider(contact, collider, target);
+}
+
+/* contact between the sword and shield of the actor and "target", the normal points from "target" towards the parts.
+the bounding sphere of the parts rejects the target before any part is tested */
+bool actorCollision_contactParts(ContactData* contact, const ActorCollider* collider, const Collider* target)
+{
+    if (!collisionFilterTable_shouldCollide(collider->filters, &collider->parts.filter, &target->filter)) return false;
+    return collider_collisionTest(contact, &collider->parts, target);
+}
+
+/* sweeps the actor body along "displacement" against "target", "time" gets the fraction travelled until the first contact.
+meshes and terrains have no sweep and return false, the discrete contact functions handle them */
+bool actorCollision_sweepCollider(ActorContactData* contact, float* time, const ActorCollider* collider, const Vector3* displacement, const Collider* target)
+{
+    if (!collisionFilterTable_shouldCollide(collider->filters, &collider->filter, &target->filter)) return false;
+    actorContactData_clear(contact);
+
+    bool hit;
+
+    switch(target->type) {
+
+        case SPHERE_A: hit = capsule_sweepSphere(&contact->data, time, &collider->body, displacement, &target->sphere); break;
+        case AABB_A: hit = capsule_sweepAABB(&contact->data, time, &collider->body, displacement, &target->aabb); break;
+        case BOX_A: hit = capsule_sweepBox(&contact->data, time, &collider->body, displacement, &target->box); break;
+        case PLANE_A: hit = capsule_sweepPlane(&contact->data, time, &collider->body, displacement, &target->plane); break;
+        default: return false;
+    }
+
+    if (hit) actorContactData_setDerived(contact, collider);
+    return hit;
+}
+
+/* runs the narrowphase on one broadphase candidate of actorCollision_contactBroadphase */
+bool actorCollision_contactCandidate(int proxy_id, void* context)
+{
+    ActorBroadphaseQuery* query = context;
+    const Collider* target = dynamicTree_getData(query->tree, proxy_id);
+
+    // Past "max_contacts" the contacts are still counted, into a scratch one
+    ActorContactData scratch;
+    ActorContactData* contact = (query->contact_count < query->max_contacts) ? &query->contacts[query->contact_count] : &scratch;
+    if (actorCollision_contactCollider(contact, query->collider, target)) query->contact_count++;
+    return true;
+}
+
+/* queries the broadphase with the actor bounds and runs the narrowphase against every candidate.
+returns the number of contacts found, only the first "max_contacts" are written in "contacts",
+so a result above "max_contacts" tells the caller its buffer was too small */
+int actorCollision_contactBroadphase(ActorContactData* contacts, int max_contacts, const ActorCollider* collider, const DynamicTree* tree)
+{
+    ActorBroadphaseQuery query = {contacts, max_contacts, 0, collider, tree};
+    AABB aabb = actorCollider_getAABB(collider);
+    dynamicTree_queryCallback(tree, &aabb, actorCollision_contactCandidate, &query);
+    return query.contact_count;
+}
+
 
 #endif
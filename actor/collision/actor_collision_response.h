@@ -1,6 +1,12 @@
 #ifndef ACTOR_COLLISION_RESPONSE_H
 #define ACTOR_COLLISION_RESPONSE_H     
 
+#define ACTOR_SWEEP_MAX_PASSES 3            // contacts the actor can slide along in one step
+#define ACTOR_COLLISION_SKIN_WIDTH 0.1f     // distance the actor stops short of a contact
+#define ACTOR_COLLISION_MAX_ITERATIONS 4    // push out passes of the multi contact solver
+#define ACTOR_COLLISION_MAX_PLANES (ACTOR_COLLISION_MAX_ITERATIONS * MAX_CONTACTS)
+#define ACTOR_COLLISION_SAME_PLANE 0.99f    // cosine above which two contact normals count as one plane
+
 
 void actorCollision_pushTowardsNormal(Actor* actor, ActorContactData* contact)
 {
@@ -67,10 +73,22 @@ void actorCollision_setGroundResponse(Actor* actor)
     actor_setState(actor, actor->previous_state);
 }
 
+/* grounds the actor on the terrain under it with a single height sample,
+"set_falling" lands the actor once it reaches this height. off the terrain there is nothing to land on */
+void actorCollision_setTerrainGrounding(Actor* actor, const Heightfield* terrain)
+{
+    if (!heightfield_containsPoint(terrain, &actor->body.position)) {
+        actor->grounding_height = -FLT_MAX;
+        return;
+    }
+    actor->grounding_height = heightfield_getHeight(terrain, actor->body.position.x, actor->body.position.y);
+}
+
 void actorCollision_setCeilingResponse(Actor* actor, ActorContactData* contact)
 {   
     if (actor->body.velocity.z > 0){
-    vector3_scale(&actor->body.velocity, 1 - (contact->angle_of_incidence * 0.01));           // angle of incidence can be up to 90 degrees
+    float angle_of_incidence = actorContactData_getAngleOfIncidence(contact, &actor->body.velocity);
+    vector3_scale(&actor->body.velocity, 1 - (angle_of_incidence * 0.01));           // angle of incidence can be up to 90 degrees
     actor->body.velocity = vector3_reflect(&actor->body.velocity, &contact->data.normal);
     actor->body.velocity.z = 0.0f;
     }
@@ -83,14 +101,13 @@ void actorCollision_setCeilingResponse(Actor* actor, ActorContactData* contact)
 
 void actorCollision_setResponse(Actor* actor, ActorContactData* contact, ActorCollider* collider)
 {
-    actorContactData_setAngleOfIncidence(contact, &actor->body.velocity);
     actorCollision_solvePenetration(actor, contact, collider);
 
-    if (contact->slope > 0 && contact->slope < 50) {
+    if (actorContactData_isGround(contact)) {
         actorCollision_setGroundResponse(actor);
         actorCollision_collideAndSlide(actor, contact);
     }
-    else if (contact->slope > 95 && actor->grounded == false) {
+    else if (actorContactData_isCeiling(contact) && actor->grounded == false) {
         actorCollision_collideAndSlide(actor, contact);
         actorCollision_setCeilingResponse(actor, contact);    
     }
@@ -99,6 +116,156 @@ void actorCollision_setResponse(Actor* actor, ActorContactData* contact, ActorCo
     actorCollider_setVertical(collider, &actor->body.position);
 }
 
+/* moves the actor along "displacement" up to the first contact with "colliders", then slides the rest of the
+displacement and the velocity along that contact. repeats for up to ACTOR_SWEEP_MAX_PASSES contacts,
+so fast actors stop at thin geometry instead of tunneling through it. returns true if anything was hit */
+bool actorCollision_advanceAndSlide(Actor* actor, ActorCollider* collider, const Vector3* displacement, const Collider* colliders, int collider_count)
+{
+    Vector3 remaining = *displacement;
+    bool hit = false;
+
+    for (int pass = 0; pass < ACTOR_SWEEP_MAX_PASSES; pass++) {
+
+        actorCollider_setVertical(collider, &actor->body.position);
+
+        ActorContactData contact = {0};
+        ActorContactData candidate;
+        float time = 2.0f;
+
+        for (int i = 0; i < collider_count; i++) {
+            float candidate_time;
+            if (!actorCollision_sweepCollider(&candidate, &candidate_time, collider, &remaining, &colliders[i])) continue;
+            if (candidate_time < time) {
+                time = candidate_time;
+                contact = candidate;
+            }
+        }
+
+        if (time > 1.0f) {
+            vector3_add(&actor->body.position, &remaining);
+            break;
+        }
+
+        hit = true;
+
+        // Already touching, get out before moving
+        if (time == 0.0f && contact.data.penetration > 0.0f) actorCollision_pushTowardsNormal(actor, &contact);
+
+        // Advance to the contact, keeping the skin width between the actor and the surface along the normal
+        float approach_speed = -vector3_returnDotProduct(&remaining, &contact.data.normal);
+        float safe_time = (approach_speed > TOLERANCE) ? max2(0.0f, time - ACTOR_COLLISION_SKIN_WIDTH / approach_speed) : time;
+        vector3_addScaledVector(&actor->body.position, &remaining, safe_time);
+        vector3_scale(&remaining, 1.0f - safe_time);
+
+        // Slide what is left of the step along the contact
+        float into_contact = vector3_returnDotProduct(&remaining, &contact.data.normal);
+        if (into_contact < 0.0f) vector3_addScaledVector(&remaining, &contact.data.normal, -into_contact);
+        if (vector3_returnDotProduct(&actor->body.velocity, &contact.data.normal) < 0.0f) actorCollision_projectVelocity(actor, &contact);
+    }
+
+    actorCollider_setVertical(collider, &actor->body.position);
+    return hit;
+}
+
+/* removes from the velocity every component that goes into the accumulated contact planes.
+one plane slides the velocity along it, two planes leave it along their crease and three or more stop it at the corner */
+void actorCollision_constrainVelocity(Actor* actor, ActorContactData* planes, int plane_count)
+{
+    for (int i = 0; i < plane_count; i++) {
+
+        if (vector3_returnDotProduct(&actor->body.velocity, &planes[i].data.normal) >= 0.0f) continue;
+
+        actorCollision_projectVelocity(actor, &planes[i]);
+
+        for (int j = 0; j < plane_count; j++) {
+
+            if (j == i || vector3_returnDotProduct(&actor->body.velocity, &planes[j].data.normal) >= -TOLERANCE) continue;
+
+            // Sliding along plane i pushes into plane j, keep only the motion along their crease
+            Vector3 crease = vector3_returnCrossProduct(&planes[i].data.normal, &planes[j].data.normal);
+            vector3_normalize(&crease);
+            actor->body.velocity = vector3_returnScaled(&crease, vector3_returnDotProduct(&actor->body.velocity, &crease));
+
+            for (int k = 0; k < plane_count; k++) {
+                if (k == i || k == j) continue;
+                if (vector3_returnDotProduct(&actor->body.velocity, &planes[k].data.normal) < -TOLERANCE) {
+                    actor->body.velocity = (Vector3){0.0f, 0.0f, 0.0f};
+                    return;
+                }
+            }
+            return;
+        }
+    }
+}
+
+/* resolves every contact touching the actor in a bounded number of passes.
+each pass gathers up to MAX_CONTACTS contacts with the body grown by the skin width, pushes the actor out of them
+leaving the skin between the body and the surfaces, and adds their normals to the constraint planes.
+the velocity is then constrained against all the planes at once, which settles corners and wedges in a single step.
+returns the number of passes used, ACTOR_COLLISION_MAX_ITERATIONS means it didn't converge */
+int actorCollision_solveContacts(Actor* actor, ActorCollider* collider, const Collider* colliders, int collider_count)
+{
+    ActorContactData planes[ACTOR_COLLISION_MAX_PLANES];
+    int plane_count = 0;
+    bool grounded = false;
+    int iteration = 0;
+
+    while (iteration < ACTOR_COLLISION_MAX_ITERATIONS) {
+
+        iteration++;
+        actorCollider_setVertical(collider, &actor->body.position);
+
+        ActorCollider skin_collider = *collider;
+        skin_collider.body.radius += ACTOR_COLLISION_SKIN_WIDTH;
+
+        // Gather the contacts, keeping the deepest ones when there are more than MAX_CONTACTS
+        ActorContactData contacts[MAX_CONTACTS];
+        int contact_count = 0;
+
+        for (int i = 0; i < collider_count; i++) {
+
+            ActorContactData contact;
+            if (!actorCollision_contactCollider(&contact, &skin_collider, &colliders[i])) continue;
+
+            if (contact_count < MAX_CONTACTS) contacts[contact_count++] = contact;
+            else {
+                int shallowest = 0;
+                for (int j = 1; j < MAX_CONTACTS; j++) if (contacts[j].data.penetration < contacts[shallowest].data.penetration) shallowest = j;
+                if (contact.data.penetration > contacts[shallowest].data.penetration) contacts[shallowest] = contact;
+            }
+        }
+
+        bool resolved = true;
+
+        for (int i = 0; i < contact_count; i++) {
+
+            ActorContactData* contact = &contacts[i];
+            if (actorContactData_isGround(contact)) grounded = true;
+
+            // Push out only what goes past the skin
+            contact->data.penetration -= ACTOR_COLLISION_SKIN_WIDTH;
+            if (contact->data.penetration > TOLERANCE) {
+                actorCollision_pushTowardsNormal(actor, contact);
+                resolved = false;
+            }
+
+            bool known_plane = false;
+            for (int j = 0; j < plane_count; j++) {
+                if (vector3_returnDotProduct(&planes[j].data.normal, &contact->data.normal) > ACTOR_COLLISION_SAME_PLANE) known_plane = true;
+            }
+            if (!known_plane && plane_count < ACTOR_COLLISION_MAX_PLANES) planes[plane_count++] = *contact;
+        }
+
+        if (resolved) break;
+    }
+
+    actorCollision_constrainVelocity(actor, planes, plane_count);
+    if (grounded) actorCollision_setGroundResponse(actor);
+
+    actorCollider_setVertical(collider, &actor->body.position);
+    return iteration;
+}
+
 void actorCollision_collideWithPlayground(Actor* actor) {
     if (actor->body.position.x > 1870) actor->body.position.x = 1875;
     if (actor->body.position.x < -1870) actor->body.position.x = -1875;
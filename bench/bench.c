@@ -0,0 +1,82 @@
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include <t3d/t3dmodel.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "control/controls.h"
+#include "time/time.h"
+
+#include "physics/physics.h"
+
+#include "actor/actor.h"
+#include "actor/actor_states.h"
+#include "actor/actor_control.h"
+#include "actor/collision/actor_collision_detection.h"
+#include "actor/collision/actor_collision_response.h"
+
+#include "bench.h"
+#include "bench_math.h"
+#include "bench_shapes.h"
+#include "bench_mesh.h"
+#include "bench_frame_rate.h"
+#include "bench_sweep.h"
+#include "bench_solver.h"
+#include "bench_world.h"
+#include "bench_gjk.h"
+#include "bench_raycast.h"
+#include "bench_dynamic_tree.h"
+#include "bench_spatial_hash.h"
+#include "bench_sweep_and_prune.h"
+#include "bench_actor_cache.h"
+#include "bench_actor_solver.h"
+
+
+typedef struct {
+    const char* name;
+    void (*run)(Bench* bench);
+} BenchSuite;
+
+static const BenchSuite suites[] = {
+    {"math", bench_math},
+    {"shapes", bench_shapes},
+    {"mesh", bench_mesh},
+    {"frame_rate", bench_frameRate},
+    {"sweep", bench_sweep},
+    {"solver", bench_solver},
+    {"world", bench_world},
+    {"gjk", bench_gjk},
+    {"raycast", bench_raycast},
+    {"dynamic_tree", bench_dynamicTree},
+    {"spatial_hash", bench_spatialHash},
+    {"sweep_and_prune", bench_sweepAndPrune},
+    {"actor_cache", bench_actorCache},
+    {"actor_solver", bench_actorSolver},
+};
+
+
+/* runs every suite, or only the ones named in the arguments. returns 1 if a check failed */
+int main(int argc, char** argv)
+{
+    int failures = 0;
+
+    printf("suite\tname\tvalue\tunit\n");
+
+    for (int i = 0; i < (int)(sizeof(suites) / sizeof(suites[0])); i++) {
+
+        bool selected = (argc < 2);
+        for (int j = 1; j < argc; j++) {
+            if (strcmp(argv[j], suites[i].name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        Bench bench;
+        bench_init(&bench, suites[i].name);
+        suites[i].run(&bench);
+        failures += bench.failures;
+    }
+
+    if (failures > 0) fprintf(stderr, "%d checks failed\n", failures);
+    return failures > 0;
+}
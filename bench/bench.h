@@ -0,0 +1,149 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/* BENCH.H
+host side timing and checks for the header only code of the game, built by the bench target of the makefile.
+every result is printed as one tab separated line "suite name value unit" after a header line,
+so two runs can be diffed or loaded in a spreadsheet to track regressions.
+the inputs come from a fixed seed, every run times and checks the same values */
+
+#define BENCH_INPUT_COUNT 1024          // randomized inputs the timed loops cycle through, power of two
+#define BENCH_MIN_TIME_S 0.02           // a timing is repeated with twice the iterations until it lasts this long
+#define BENCH_MAX_ITERATIONS (1L << 30)
+#define BENCH_SEED 0x2545F491u
+
+
+// structures
+
+typedef struct {
+
+    const char* suite;      // name printed in the first column of the results
+    int checks;
+    int failures;
+    double last_ns;         // ns per run of the last timing, to derive rates from
+
+} Bench;
+
+
+// function prototypes
+
+void bench_init(Bench* bench, const char* suite);
+double bench_now();
+
+void bench_report(const Bench* bench, const char* name, double value, const char* unit);
+bool bench_check(Bench* bench, const char* name, bool passed);
+void bench_consume(float value);
+
+void bench_seed(uint32_t seed);
+uint32_t bench_random();
+float bench_randomFloat(float min, float max);
+Vector3 bench_randomVector3(float min, float max);
+Vector3 bench_randomUnitVector3();
+
+
+// function implementations
+
+/* times "statement" over "BENCH_INPUT_COUNT" cycled inputs and reports the ns per run.
+the statement reads its inputs at index "k" and adds something of its result to "sink",
+which is consumed at the end so the compiler can't drop the work. the barrier after every run
+keeps it from hoisting work out of the loop or merging runs */
+#define BENCH_TIME(bench, name, ...) BENCH_TIME_FROM(bench, name, BENCH_INPUT_COUNT, __VA_ARGS__)
+
+/* same, starting from "iterations" runs instead of one per input for the statements that take milliseconds */
+#define BENCH_TIME_FROM(bench, name, iterations, ...) do { \
+    long bench_iterations = iterations; \
+    double bench_elapsed; \
+    float sink = 0.0f; \
+    for (;;) { \
+        double bench_start = bench_now(); \
+        for (long bench_i = 0; bench_i < bench_iterations; bench_i++) { \
+            int k = (int)(bench_i & (BENCH_INPUT_COUNT - 1)); \
+            (void)k; \
+            __VA_ARGS__; \
+            __asm__ volatile("" : "+m"(sink) : : "memory"); \
+        } \
+        bench_elapsed = bench_now() - bench_start; \
+        if (bench_elapsed >= BENCH_MIN_TIME_S || bench_iterations >= BENCH_MAX_ITERATIONS) break; \
+        bench_iterations *= 2; \
+    } \
+    bench_consume(sink); \
+    (bench)->last_ns = 1e9 * bench_elapsed / bench_iterations; \
+    bench_report(bench, name, (bench)->last_ns, "ns/op"); \
+} while (0)
+
+void bench_init(Bench* bench, const char* suite)
+{
+    bench->suite = suite;
+    bench->checks = 0;
+    bench->failures = 0;
+    bench->last_ns = 0.0;
+    bench_seed(BENCH_SEED);
+}
+
+/* monotonic time in seconds */
+double bench_now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+void bench_report(const Bench* bench, const char* name, double value, const char* unit)
+{
+    printf("%s\t%s\t%.3f\t%s\n", bench->suite, name, value, unit);
+}
+
+/* reports a check as 1 or 0 with the unit "pass", returns "passed" */
+bool bench_check(Bench* bench, const char* name, bool passed)
+{
+    bench->checks++;
+    if (!passed) bench->failures++;
+    printf("%s\t%s\t%d\tpass\n", bench->suite, name, passed ? 1 : 0);
+    return passed;
+}
+
+static volatile float bench_sink;
+static uint32_t bench_random_state = BENCH_SEED;
+
+void bench_consume(float value)
+{
+    bench_sink = value;
+}
+
+void bench_seed(uint32_t seed)
+{
+    bench_random_state = seed;
+}
+
+/* xorshift32 */
+uint32_t bench_random()
+{
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 17;
+    bench_random_state ^= bench_random_state << 5;
+    return bench_random_state;
+}
+
+float bench_randomFloat(float min, float max)
+{
+    return min + (max - min) * ((bench_random() >> 8) * (1.0f / 16777216.0f));
+}
+
+Vector3 bench_randomVector3(float min, float max)
+{
+    float x = bench_randomFloat(min, max);
+    float y = bench_randomFloat(min, max);
+    float z = bench_randomFloat(min, max);
+    return (Vector3){x, y, z};
+}
+
+Vector3 bench_randomUnitVector3()
+{
+    for (;;) {
+        Vector3 v = bench_randomVector3(-1.0f, 1.0f);
+        float squared_magnitude = vector3_squaredMagnitude(&v);
+        if (squared_magnitude > 0.01f && squared_magnitude <= 1.0f) return vector3_returnScaled(&v, 1.0f / sqrtf(squared_magnitude));
+    }
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef BENCH_ACTOR_CACHE_H
+#define BENCH_ACTOR_CACHE_H
+
+/* BENCH_ACTOR_CACHE.H
+the actor contact cache against running the narrowphase every time. an actor walking on the ground while sinking
+into it by less than the cache epsilon per tick has to keep the depth of the narrowphase within that epsilon,
+and an actor standing next to a wall on the ground reports the share of lookups the cache answered.
+then the contact solver moves the actor standing in the corner, walking along the floor and pushing into the wall,
+with the cache and without, both have to end at the same place and every tick of the walk has to slide the floor contact */
+
+#define BENCH_ACTOR_CACHE_STEPS 400
+#define BENCH_ACTOR_CACHE_WALK 5.0f                                 // along the ground per tick
+#define BENCH_ACTOR_CACHE_SINK (0.3f * ACTOR_CONTACT_CACHE_EPSILON)  // into the ground per tick
+#define BENCH_ACTOR_CACHE_TARGETS 3
+#define BENCH_ACTOR_CACHE_SOLVE_STEPS 60                           // ticks of every run of the contact solver
+
+
+// function prototypes
+
+void bench_actorCache(Bench* bench);
+void bench_actorCacheInitTargets(Collider* targets);
+int bench_actorCacheStand(ActorCollider* collider, const Collider* targets);
+Vector3 bench_actorCacheSolve(ActorCollider* collider, const Collider* targets, const Vector3* start, const Vector3* velocity);
+void bench_actorCacheRun(Bench* bench, const char* run, const Collider* targets, const Vector3* start, const Vector3* velocity);
+
+
+// function implementations
+
+/* the ground plane at z 0, a wall box in front of the actor and a sphere next to it */
+void bench_actorCacheInitTargets(Collider* targets)
+{
+    collider_init(&targets[0], PLANE_A);
+    targets[0].plane = (Plane){.normal = {0.0f, 0.0f, 1.0f}, .displacement = 0.0f};
+
+    collider_init(&targets[1], BOX_A);
+    box_init(&targets[1].box, &(Vector3){20.0f, 400.0f, 400.0f}, &(Vector3){25.0f, 0.0f, 100.0f}, &(Vector3){0.0f, 0.0f, 0.0f});
+
+    collider_init(&targets[2], SPHERE_A);
+    targets[2].sphere = (Sphere){.center = {0.0f, 35.0f, 60.0f}, .radius = 20.0f};
+}
+
+/* one tick of the actor against every target, returns how many touch */
+int bench_actorCacheStand(ActorCollider* collider, const Collider* targets)
+{
+    int touching = 0;
+    for (int i = 0; i < BENCH_ACTOR_CACHE_TARGETS; i++) {
+        ActorContactData contact;
+        touching += actorCollision_contactCollider(&contact, collider, &targets[i]);
+    }
+    return touching;
+}
+
+/* BENCH_ACTOR_CACHE_SOLVE_STEPS ticks of an actor moving at "velocity" from "start" and resolved by the contact solver,
+returns where it ends */
+Vector3 bench_actorCacheSolve(ActorCollider* collider, const Collider* targets, const Vector3* start, const Vector3* velocity)
+{
+    Actor actor = actor_create(0, "rom:/capsule.t3dm");
+    actor.body.position = *start;
+
+    for (int step = 0; step < BENCH_ACTOR_CACHE_SOLVE_STEPS; step++) {
+        actor.body.velocity = *velocity;
+        vector3_addScaledVector(&actor.body.position, velocity, TIME_FIXED_STEP_S);
+        actorCollision_solveContacts(&actor, collider, targets, BENCH_ACTOR_CACHE_TARGETS);
+    }
+
+    Vector3 end = actor.body.position;
+    actor_delete(&actor);
+    return end;
+}
+
+/* one run of the contact solver with the cache and without, the cost is per tick */
+void bench_actorCacheRun(Bench* bench, const char* run, const Collider* targets, const Vector3* start, const Vector3* velocity)
+{
+    ActorContactCache cache;
+    actorContactCache_init(&cache);
+    ActorCollider collider = {.settings = {.body_radius = 20.0f, .body_height = 120.0f}};
+    actorCollider_init(&collider);
+    char name[64];
+
+    Vector3 uncached = bench_actorCacheSolve(&collider, targets, start, velocity);
+    collider.cache = &cache;
+    Vector3 cached = bench_actorCacheSolve(&collider, targets, start, velocity);
+    Vector3 difference = vector3_difference(&cached, &uncached);
+
+    snprintf(name, sizeof(name), "%s_hit_rate", run);
+    bench_report(bench, name, actorContactCache_getHitRate(&cache), "ratio");
+    snprintf(name, sizeof(name), "%s_slides_per_tick", run);
+    bench_report(bench, name, (double)cache.slides / BENCH_ACTOR_CACHE_SOLVE_STEPS, "count");
+    snprintf(name, sizeof(name), "%s_cached_end_offset", run);
+    bench_report(bench, name, vector3_magnitude(&difference), "units");
+    snprintf(name, sizeof(name), "%s_cached_end_matches", run);
+    bench_check(bench, name, vector3_magnitude(&difference) <= ACTOR_CONTACT_CACHE_EPSILON);
+
+    // The walk slides the floor contact on every tick after the first
+    if (strcmp(run, "solver_walking") == 0) bench_check(bench, "solver_walking_slides_every_tick", cache.slides >= BENCH_ACTOR_CACHE_SOLVE_STEPS - 1);
+
+    snprintf(name, sizeof(name), "%s_cached", run);
+    BENCH_TIME_FROM(bench, name, 1, actorContactCache_clear(&cache); sink += bench_actorCacheSolve(&collider, targets, start, velocity).x);
+    snprintf(name, sizeof(name), "%s_cached_per_tick", run);
+    bench_report(bench, name, bench->last_ns / BENCH_ACTOR_CACHE_SOLVE_STEPS, "ns/op");
+
+    collider.cache = NULL;
+    snprintf(name, sizeof(name), "%s_uncached", run);
+    BENCH_TIME_FROM(bench, name, 1, sink += bench_actorCacheSolve(&collider, targets, start, velocity).x);
+    snprintf(name, sizeof(name), "%s_uncached_per_tick", run);
+    bench_report(bench, name, bench->last_ns / BENCH_ACTOR_CACHE_SOLVE_STEPS, "ns/op");
+}
+
+void bench_actorCache(Bench* bench)
+{
+    Collider targets[BENCH_ACTOR_CACHE_TARGETS];
+    bench_actorCacheInitTargets(targets);
+
+    ActorContactCache cache;
+    actorContactCache_init(&cache);
+    ActorCollider collider = {.settings = {.body_radius = 20.0f, .body_height = 120.0f}};
+    actorCollider_init(&collider);
+    collider.cache = &cache;
+
+    // Walking away from the wall while sinking, every tick is a slide of the ground contact
+    Vector3 position = {0.0f, -200.0f, -1.0f};
+    float depth_error = 0.0f;
+    int misses = 0;
+
+    for (int step = 0; step < BENCH_ACTOR_CACHE_STEPS; step++) {
+        position.y -= BENCH_ACTOR_CACHE_WALK;
+        position.z -= BENCH_ACTOR_CACHE_SINK;
+        actorCollider_setVertical(&collider, &position);
+
+        ActorContactData cached, expected;
+        actorContactData_clear(&expected);
+        bool hit = actorCollision_contactCollider(&cached, &collider, &targets[0]);
+        bool expected_hit = actorCollision_testCollider(&expected, &collider, &targets[0]);
+
+        if (hit != expected_hit) misses++;
+        else if (hit) depth_error = fmaxf(depth_error, fabsf(cached.data.penetration - expected.data.penetration));
+    }
+
+    bench_report(bench, "sinking_slides", cache.slides, "count");
+    bench_report(bench, "sinking_narrowphases", cache.lookups - cache.hits - cache.slides, "count");
+    bench_report(bench, "sinking_max_depth_error", depth_error, "units");
+    bench_check(bench, "sinking_depth_within_epsilon", misses == 0 && depth_error <= ACTOR_CONTACT_CACHE_EPSILON);
+
+    // Standing still in the corner of the wall, the ground and the sphere
+    position = (Vector3){0.0f, 0.0f, -1.0f};
+    actorCollider_setVertical(&collider, &position);
+    actorContactCache_clear(&cache);
+
+    int touching = 0;
+    for (int step = 0; step < BENCH_ACTOR_CACHE_STEPS; step++) touching += bench_actorCacheStand(&collider, targets);
+    bench_report(bench, "standing_touching", (double)touching / BENCH_ACTOR_CACHE_STEPS, "count");
+    bench_report(bench, "standing_hit_rate", actorContactCache_getHitRate(&cache), "ratio");
+
+    BENCH_TIME(bench, "standing_cached", sink += bench_actorCacheStand(&collider, targets));
+    collider.cache = NULL;
+    BENCH_TIME(bench, "standing_uncached", sink += bench_actorCacheStand(&collider, targets));
+
+    float walk_speed = BENCH_ACTOR_CACHE_WALK / TIME_FIXED_STEP_S;
+    bench_actorCacheRun(bench, "solver_standing", targets, &(Vector3){0.0f, 0.0f, -1.0f}, &(Vector3){0.0f, 0.0f, 0.0f});
+    bench_actorCacheRun(bench, "solver_walking", targets, &(Vector3){0.0f, -200.0f, 0.0f}, &(Vector3){0.0f, -walk_speed, 0.0f});
+    bench_actorCacheRun(bench, "solver_pushing", targets, &(Vector3){-20.0f, -100.0f, 0.0f}, &(Vector3){walk_speed, 0.0f, 0.0f});
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef BENCH_ACTOR_SOLVER_H
+#define BENCH_ACTOR_SOLVER_H
+
+/* BENCH_ACTOR_SOLVER.H
+the multi contact solver of the actor. driven into the corner of the floor and two walls it has to settle in two passes,
+one pushing out of all three and one finding only the skin, out of every surface and with no velocity left.
+driven into the crease of the floor and a wall it has to keep only the motion along the crease and land.
+the ground and ceiling classification by the cosine of the slope has to match the one by the angle over random normals */
+
+#define BENCH_ACTOR_SOLVER_DEPTH 3.0f       // into every surface at the start
+#define BENCH_ACTOR_SOLVER_TOUCH 1e-3f      // depth left once settled
+#define BENCH_ACTOR_SOLVER_TARGETS 3
+#define BENCH_ACTOR_SOLVER_GROUND_MAX_SLOPE 50.0f     // degrees, the limits the contacts were classified by
+#define BENCH_ACTOR_SOLVER_CEILING_MIN_SLOPE 95.0f
+
+
+// function prototypes
+
+void bench_actorSolver(Bench* bench);
+void bench_actorSolverInitTargets(Collider* targets, float radius);
+float bench_actorSolverDepth(ActorCollider* collider, const Collider* targets, int target_count);
+int bench_actorSolverClassifyAngle(const Vector3* normal);
+int bench_actorSolverClassifyCosine(const Vector3* normal);
+void bench_actorSolverClassify(Bench* bench);
+
+
+// function implementations
+
+/* the floor at z 0 and two walls, one facing -x and one facing -y, each "radius" minus the depth from the origin */
+void bench_actorSolverInitTargets(Collider* targets, float radius)
+{
+    float face = radius - BENCH_ACTOR_SOLVER_DEPTH;
+
+    collider_init(&targets[0], PLANE_A);
+    targets[0].plane = (Plane){.normal = {0.0f, 0.0f, 1.0f}, .displacement = 0.0f};
+
+    collider_init(&targets[1], BOX_A);
+    box_init(&targets[1].box, &(Vector3){100.0f, 1000.0f, 1000.0f}, &(Vector3){face + 50.0f, 0.0f, 0.0f}, &(Vector3){0.0f, 0.0f, 0.0f});
+
+    collider_init(&targets[2], BOX_A);
+    box_init(&targets[2].box, &(Vector3){1000.0f, 100.0f, 1000.0f}, &(Vector3){0.0f, face + 50.0f, 0.0f}, &(Vector3){0.0f, 0.0f, 0.0f});
+}
+
+/* deepest contact of the body with the targets, 0 when it touches none */
+float bench_actorSolverDepth(ActorCollider* collider, const Collider* targets, int target_count)
+{
+    float depth = 0.0f;
+    for (int i = 0; i < target_count; i++) {
+        ActorContactData contact;
+        if (actorCollision_contactCollider(&contact, collider, &targets[i])) depth = fmaxf(depth, contact.data.penetration);
+    }
+    return depth;
+}
+
+/* 1 for ground, 2 for ceiling and 0 for neither, from the slope in degrees as the contacts were classified before */
+int bench_actorSolverClassifyAngle(const Vector3* normal)
+{
+    float slope = deg(trig_acos(normal->z / vector3_magnitude(normal)));
+    if (slope < BENCH_ACTOR_SOLVER_GROUND_MAX_SLOPE) return 1;
+    if (slope > BENCH_ACTOR_SOLVER_CEILING_MIN_SLOPE) return 2;
+    return 0;
+}
+
+/* the same from the cosine of the slope, as the contacts are classified now */
+int bench_actorSolverClassifyCosine(const Vector3* normal)
+{
+    ActorContactData contact = {.data.normal = *normal};
+    actorContactData_setSlope(&contact);
+    if (actorContactData_isGround(&contact)) return 1;
+    if (actorContactData_isCeiling(&contact)) return 2;
+    return 0;
+}
+
+void bench_actorSolverClassify(Bench* bench)
+{
+    // Flat ground and flat ceiling first, then random normals
+    static Vector3 normals[BENCH_INPUT_COUNT];
+    normals[0] = (Vector3){0.0f, 0.0f, 1.0f};
+    normals[1] = (Vector3){0.0f, 0.0f, -1.0f};
+    for (int i = 2; i < BENCH_INPUT_COUNT; i++) normals[i] = bench_randomUnitVector3();
+
+    int mismatches = 0;
+    int counts[3] = {0, 0, 0};
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        int expected = bench_actorSolverClassifyAngle(&normals[i]);
+        if (bench_actorSolverClassifyCosine(&normals[i]) != expected) mismatches++;
+        counts[expected]++;
+    }
+
+    bench_report(bench, "classified_ground", counts[1], "count");
+    bench_report(bench, "classified_ceiling", counts[2], "count");
+    bench_report(bench, "classification_mismatches", mismatches, "count");
+    bench_check(bench, "cos_classification_matches_angles", mismatches == 0);
+
+    BENCH_TIME(bench, "classify_by_angle", sink += bench_actorSolverClassifyAngle(&normals[k]));
+    BENCH_TIME(bench, "classify_by_cosine", sink += bench_actorSolverClassifyCosine(&normals[k]));
+}
+
+void bench_actorSolver(Bench* bench)
+{
+    ActorCollider collider = {.settings = {.body_radius = 20.0f, .body_height = 120.0f}};
+    actorCollider_init(&collider);
+
+    Collider targets[BENCH_ACTOR_SOLVER_TARGETS];
+    bench_actorSolverInitTargets(targets, collider.body.radius);
+    Vector3 start = {0.0f, 0.0f, -BENCH_ACTOR_SOLVER_DEPTH};
+
+    // Floor and both walls
+    Actor actor = actor_create(0, "rom:/capsule.t3dm");
+    actor.body.position = start;
+    actor.body.velocity = (Vector3){100.0f, 100.0f, -100.0f};
+    int passes = actorCollision_solveContacts(&actor, &collider, targets, BENCH_ACTOR_SOLVER_TARGETS);
+    float depth = bench_actorSolverDepth(&collider, targets, BENCH_ACTOR_SOLVER_TARGETS);
+    float speed = vector3_magnitude(&actor.body.velocity);
+
+    bench_report(bench, "corner_passes", passes, "count");
+    bench_report(bench, "corner_depth_left", depth, "units");
+    bench_check(bench, "corner_settles_in_two_passes", passes == 2);
+    bench_check(bench, "corner_pushed_out", depth < BENCH_ACTOR_SOLVER_TOUCH);
+    bench_check(bench, "corner_stops", speed < TOLERANCE && actor.grounded);
+
+    // Floor and the wall facing -x, the motion along y is kept
+    actor.body.position = start;
+    actor.body.velocity = (Vector3){100.0f, 50.0f, -100.0f};
+    actor.grounded = false;
+    passes = actorCollision_solveContacts(&actor, &collider, targets, 2);
+    depth = bench_actorSolverDepth(&collider, targets, 2);
+
+    bench_report(bench, "crease_passes", passes, "count");
+    bench_check(bench, "crease_pushed_out", depth < BENCH_ACTOR_SOLVER_TOUCH);
+    bench_check(bench, "crease_slides_along", fabsf(actor.body.velocity.x) < TOLERANCE && fabsf(actor.body.velocity.z) < TOLERANCE
+        && fabsf(actor.body.velocity.y - 50.0f) < 1e-3f && actor.grounded);
+
+    BENCH_TIME(bench, "actorCollision_solveContacts_corner",
+        actor.body.position = start;
+        actor.body.velocity = (Vector3){100.0f, 100.0f, -100.0f};
+        sink += actorCollision_solveContacts(&actor, &collider, targets, BENCH_ACTOR_SOLVER_TARGETS));
+    actor_delete(&actor);
+
+    bench_actorSolverClassify(bench);
+}
+
+#endif
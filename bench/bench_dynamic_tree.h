@@ -0,0 +1,210 @@
+#ifndef BENCH_DYNAMIC_TREE_H
+#define BENCH_DYNAMIC_TREE_H
+
+/* BENCH_DYNAMIC_TREE.H
+the dynamic AABB tree on scenes of 100, 1000 and 10000 moving boxes at the same density, against testing every pair.
+the pairs of the tree have to be exactly the pairs of fat AABBs that overlap, once after every box is inserted
+and again after the boxes walked, where only the pairs of the reinserted boxes come out.
+then the per frame cost of updating every box, of updating them and getting the pairs, and of the brute force */
+
+#define BENCH_DYNAMIC_TREE_SPACING 30.0f    // side of the area per box
+#define BENCH_DYNAMIC_TREE_SPEED 15.0f      // fastest walk
+#define BENCH_DYNAMIC_TREE_FRAMES 30        // walked before the pairs are checked again
+#define BENCH_DYNAMIC_TREE_PAIRS_PER_BOX 16
+
+
+// structures
+
+typedef struct {
+    int count;
+    float side;
+    AABB* boxes;
+    Vector3* velocities;
+    int* ids;
+    bool* moved;            // reinserted since the last pairs
+    BroadphasePair* pairs;
+    int max_pairs;
+    DynamicTree tree;
+} BenchTreeScene;
+
+
+// function prototypes
+
+void bench_dynamicTree(Bench* bench);
+void bench_dynamicTreeInit(BenchTreeScene* scene, int count);
+void bench_dynamicTreeDelete(BenchTreeScene* scene);
+int bench_dynamicTreeMove(BenchTreeScene* scene);
+int bench_dynamicTreePairs(BenchTreeScene* scene);
+int bench_dynamicTreeBruteForce(const BenchTreeScene* scene);
+int bench_dynamicTreeComparePairs(const void* a, const void* b);
+bool bench_dynamicTreeCheckPairs(BenchTreeScene* scene, int pair_count);
+void bench_dynamicTreeRun(Bench* bench, int count);
+
+
+// function implementations
+
+void bench_dynamicTreeInit(BenchTreeScene* scene, int count)
+{
+    scene->count = count;
+    scene->side = sqrtf((float)count) * BENCH_DYNAMIC_TREE_SPACING;
+    scene->max_pairs = count * BENCH_DYNAMIC_TREE_PAIRS_PER_BOX;
+    scene->boxes = malloc(count * sizeof(AABB));
+    scene->velocities = malloc(count * sizeof(Vector3));
+    scene->ids = malloc(count * sizeof(int));
+    scene->moved = malloc(count * sizeof(bool));
+    scene->pairs = malloc(scene->max_pairs * sizeof(BroadphasePair));
+    assert(scene->boxes != NULL && scene->velocities != NULL && scene->ids != NULL && scene->moved != NULL && scene->pairs != NULL);
+
+    dynamicTree_init(&scene->tree);
+
+    for (int i = 0; i < count; i++) {
+        Vector3 center = {bench_randomFloat(0.0f, scene->side), bench_randomFloat(0.0f, scene->side), bench_randomFloat(0.0f, 60.0f)};
+        Vector3 size = bench_randomVector3(5.0f, 25.0f);
+        aabb_setFromCenterAndSize(&scene->boxes[i], &center, &size);
+        float heading = bench_randomFloat(0.0f, 2.0f * PI);
+        float speed = bench_randomFloat(0.0f, BENCH_DYNAMIC_TREE_SPEED);
+        scene->velocities[i] = (Vector3){speed * cosf(heading), speed * sinf(heading), 0.0f};
+        scene->ids[i] = dynamicTree_addObject(&scene->tree, &scene->boxes[i], &scene->boxes[i]);
+        scene->moved[i] = true;
+    }
+}
+
+void bench_dynamicTreeDelete(BenchTreeScene* scene)
+{
+    dynamicTree_delete(&scene->tree);
+    free(scene->boxes);
+    free(scene->velocities);
+    free(scene->ids);
+    free(scene->moved);
+    free(scene->pairs);
+}
+
+/* one tick for every box, they turn back at the sides. returns how many left their fat AABB and got reinserted */
+int bench_dynamicTreeMove(BenchTreeScene* scene)
+{
+    int reinserted = 0;
+
+    for (int i = 0; i < scene->count; i++) {
+
+        AABB* box = &scene->boxes[i];
+        Vector3* velocity = &scene->velocities[i];
+        if ((box->minCoordinates.x < 0.0f && velocity->x < 0.0f) || (box->maxCoordinates.x > scene->side && velocity->x > 0.0f)) velocity->x = -velocity->x;
+        if ((box->minCoordinates.y < 0.0f && velocity->y < 0.0f) || (box->maxCoordinates.y > scene->side && velocity->y > 0.0f)) velocity->y = -velocity->y;
+
+        vector3_addScaledVector(&box->minCoordinates, velocity, TIME_FIXED_STEP_S);
+        vector3_addScaledVector(&box->maxCoordinates, velocity, TIME_FIXED_STEP_S);
+        if (dynamicTree_updateObject(&scene->tree, scene->ids[i], box, false)) {
+            scene->moved[i] = true;
+            reinserted++;
+        }
+    }
+
+    return reinserted;
+}
+
+/* every pair of the moves since the last call, the tree keeps the moves that don't fit for the next call */
+int bench_dynamicTreePairs(BenchTreeScene* scene)
+{
+    int pair_count = 0;
+    while (dynamicTree_hasMoves(&scene->tree)) {
+        int added = dynamicTree_getOverlappingPairs(&scene->tree, scene->pairs + pair_count, scene->max_pairs - pair_count, NULL);
+        assert(added > 0 || !dynamicTree_hasMoves(&scene->tree));
+        pair_count += added;
+    }
+    return pair_count;
+}
+
+/* pairs of overlapping fat AABBs, what the tree reports once every box moved */
+int bench_dynamicTreeBruteForce(const BenchTreeScene* scene)
+{
+    int overlapping = 0;
+    for (int i = 0; i < scene->count; i++) {
+        const AABB* fat = dynamicTree_getFatAABB(&scene->tree, scene->ids[i]);
+        for (int j = i + 1; j < scene->count; j++) overlapping += aabb_contactAABB(fat, dynamicTree_getFatAABB(&scene->tree, scene->ids[j]));
+    }
+    return overlapping;
+}
+
+int bench_dynamicTreeComparePairs(const void* a, const void* b)
+{
+    const BroadphasePair* pair_a = a;
+    const BroadphasePair* pair_b = b;
+    if (pair_a->proxy_a != pair_b->proxy_a) return (pair_a->proxy_a < pair_b->proxy_a) ? -1 : 1;
+    if (pair_a->proxy_b != pair_b->proxy_b) return (pair_a->proxy_b < pair_b->proxy_b) ? -1 : 1;
+    return 0;
+}
+
+/* the pairs of the tree are each pair of overlapping fat AABBs with a reinserted box, once. clears the moved flags */
+bool bench_dynamicTreeCheckPairs(BenchTreeScene* scene, int pair_count)
+{
+    qsort(scene->pairs, pair_count, sizeof(BroadphasePair), bench_dynamicTreeComparePairs);
+    for (int i = 1; i < pair_count; i++) {
+        if (bench_dynamicTreeComparePairs(&scene->pairs[i - 1], &scene->pairs[i]) == 0) return false;
+    }
+
+    int expected = 0;
+    bool found = true;
+    for (int i = 0; i < scene->count; i++) {
+        const AABB* fat = dynamicTree_getFatAABB(&scene->tree, scene->ids[i]);
+        for (int j = i + 1; j < scene->count; j++) {
+            if (!scene->moved[i] && !scene->moved[j]) continue;
+            if (!aabb_contactAABB(fat, dynamicTree_getFatAABB(&scene->tree, scene->ids[j]))) continue;
+            expected++;
+            BroadphasePair pair = broadphasePair_create(scene->ids[i], scene->ids[j]);
+            if (bsearch(&pair, scene->pairs, pair_count, sizeof(BroadphasePair), bench_dynamicTreeComparePairs) == NULL) found = false;
+        }
+    }
+
+    for (int i = 0; i < scene->count; i++) scene->moved[i] = false;
+    return found && expected == pair_count;
+}
+
+void bench_dynamicTreeRun(Bench* bench, int count)
+{
+    BenchTreeScene scene;
+    bench_dynamicTreeInit(&scene, count);
+    char name[64];
+
+    int inserted_pairs = bench_dynamicTreePairs(&scene);
+    bool matches = bench_dynamicTreeCheckPairs(&scene, inserted_pairs);
+
+    // Walked in frames, only the pairs of the last one are checked
+    int reinserted = 0;
+    int pair_count = 0;
+    for (int frame = 0; frame < BENCH_DYNAMIC_TREE_FRAMES; frame++) {
+        for (int i = 0; i < count; i++) scene.moved[i] = false;
+        reinserted += bench_dynamicTreeMove(&scene);
+        pair_count = bench_dynamicTreePairs(&scene);
+    }
+    bool matches_walked = bench_dynamicTreeCheckPairs(&scene, pair_count);
+
+    snprintf(name, sizeof(name), "height_%d", count);
+    bench_report(bench, name, dynamicTree_getHeight(&scene.tree), "count");
+    snprintf(name, sizeof(name), "pairs_%d", count);
+    bench_report(bench, name, inserted_pairs, "count");
+    snprintf(name, sizeof(name), "reinserted_per_update_%d", count);
+    bench_report(bench, name, (double)reinserted / (BENCH_DYNAMIC_TREE_FRAMES * count), "ratio");
+    snprintf(name, sizeof(name), "pairs_match_brute_force_%d", count);
+    bench_check(bench, name, matches);
+    snprintf(name, sizeof(name), "walked_pairs_match_brute_force_%d", count);
+    bench_check(bench, name, matches_walked);
+
+    snprintf(name, sizeof(name), "update_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, sink += bench_dynamicTreeMove(&scene); dynamicTree_clearMoves(&scene.tree));
+    snprintf(name, sizeof(name), "ns_per_update_%d", count);
+    bench_report(bench, name, bench->last_ns / count, "ns/op");
+    snprintf(name, sizeof(name), "update_and_pairs_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, sink += bench_dynamicTreeMove(&scene); sink += bench_dynamicTreePairs(&scene));
+    snprintf(name, sizeof(name), "brute_force_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, sink += bench_dynamicTreeBruteForce(&scene));
+
+    bench_dynamicTreeDelete(&scene);
+}
+
+void bench_dynamicTree(Bench* bench)
+{
+    const int counts[] = {100, 1000, 10000};
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) bench_dynamicTreeRun(bench, counts[i]);
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef BENCH_FRAME_RATE_H
+#define BENCH_FRAME_RATE_H
+
+/* BENCH_FRAME_RATE.H
+the update loop of main.c run at several frame rates on the stub clock and joypad. the physics ticks
+per second and a full jump of the player have to come out the same at every rate, with the jump button
+going down at different phases of the tick so some presses land on frames that run no tick */
+
+#define BENCH_FRAME_RATE_DURATION_S 2.0f    // simulated time of one run
+#define BENCH_FRAME_RATE_PRESS_S 0.5f       // the jump button goes down around here
+#define BENCH_FRAME_RATE_HOLD_S 0.3f        // longer than the jump timer, for a full jump
+#define BENCH_FRAME_RATE_PHASES 8           // press times spread over one tick
+
+
+// structures
+
+typedef struct {
+    int ticks;
+    int frames_without_tick;
+    bool jumped;
+    float apex;
+} BenchFrameRateRun;
+
+
+// function prototypes
+
+void bench_frameRate(Bench* bench);
+BenchFrameRateRun bench_frameRateRun(float frame_rate, float press_s);
+
+
+// function implementations
+
+/* the update of main.c without the camera and drawing, at "frame_rate" frames per second */
+BenchFrameRateRun bench_frameRateRun(float frame_rate, float press_s)
+{
+    BenchFrameRateRun run = {0};
+
+    Actor actor = actor_create(0, "rom:/capsule.t3dm");
+    actor_setState(&actor, STAND_IDLE);
+    run.apex = actor.body.position.z;
+
+    TimeData timing;
+    time_init(&timing);
+    ControllerData control;
+    controllerData_init(&control);
+
+    for (int frame = 0; frame <= (int)(BENCH_FRAME_RATE_DURATION_S * frame_rate); frame++) {
+
+        float now = frame / frame_rate;
+        stub_setTicksUs((unsigned long)(1e6f * now));
+        joypad_buttons_t buttons = {.a = (now >= press_s && now < press_s + BENCH_FRAME_RATE_HOLD_S)};
+        stub_setJoypad(buttons, 0, 0);
+
+        controllerData_getInputs(&control);
+        time_setData(&timing);
+
+        int frame_ticks = 0;
+        while (time_consumeFixedStep(&timing)) {
+            actorControl_setMotion(&actor, &control, timing.fixed_time_s, 0.0f, 0.0f);
+            actor_integrate(&actor, timing.fixed_time_s);
+            actor_setState(&actor, actor.state);
+            controllerData_clearPressed(&control);
+
+            if (actor.state == JUMP) run.jumped = true;
+            if (actor.body.position.z > run.apex) run.apex = actor.body.position.z;
+            frame_ticks++;
+        }
+
+        run.ticks += frame_ticks;
+        if (frame_ticks == 0) run.frames_without_tick++;
+    }
+
+    actor_delete(&actor);
+    return run;
+}
+
+void bench_frameRate(Bench* bench)
+{
+    const int frame_rates[] = {20, 30, 50, 60, 144, 240};
+    const int frame_rate_count = sizeof(frame_rates) / sizeof(frame_rates[0]);
+    char name[64];
+
+    BenchFrameRateRun reference = bench_frameRateRun(60.0f, BENCH_FRAME_RATE_PRESS_S);
+    bench_report(bench, "apex_reference", reference.apex, "units");
+    bench_check(bench, "reference_jumped", reference.jumped && reference.apex > 0.0f);
+
+    for (int i = 0; i < frame_rate_count; i++) {
+
+        int frames_without_tick = 0;
+        int missed_jumps = 0;
+        float apex_error = 0.0f;
+        int ticks = 0;
+
+        for (int phase = 0; phase < BENCH_FRAME_RATE_PHASES; phase++) {
+            float press_s = BENCH_FRAME_RATE_PRESS_S + phase * TIME_FIXED_STEP_S / BENCH_FRAME_RATE_PHASES;
+            BenchFrameRateRun run = bench_frameRateRun(frame_rates[i], press_s);
+
+            frames_without_tick += run.frames_without_tick;
+            if (!run.jumped) missed_jumps++;
+            else apex_error = fmaxf(apex_error, fabsf(run.apex - reference.apex));
+            ticks = run.ticks;
+        }
+
+        // The clock only has whole milliseconds, a run may end a tick short
+        float expected_ticks = BENCH_FRAME_RATE_DURATION_S / TIME_FIXED_STEP_S;
+
+        snprintf(name, sizeof(name), "ticks_%dfps", frame_rates[i]);
+        bench_report(bench, name, ticks, "count");
+        snprintf(name, sizeof(name), "frames_without_tick_%dfps", frame_rates[i]);
+        bench_report(bench, name, frames_without_tick, "count");
+        snprintf(name, sizeof(name), "apex_error_%dfps", frame_rates[i]);
+        bench_report(bench, name, apex_error, "units");
+
+        snprintf(name, sizeof(name), "tick_rate_%dfps", frame_rates[i]);
+        bench_check(bench, name, fabsf(ticks - expected_ticks) <= 1.0f);
+        snprintf(name, sizeof(name), "no_missed_jump_%dfps", frame_rates[i]);
+        bench_check(bench, name, missed_jumps == 0);
+        snprintf(name, sizeof(name), "same_jump_%dfps", frame_rates[i]);
+        bench_check(bench, name, missed_jumps == 0 && apex_error <= 1e-3f * reference.apex);
+    }
+}
+
+#endif
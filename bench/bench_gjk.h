@@ -0,0 +1,299 @@
+#ifndef BENCH_GJK_H
+#define BENCH_GJK_H
+
+/* BENCH_GJK.H
+the gjk/epa convex test against the dedicated test of every shape pair that has one: both have to agree on
+the hit, the depth and the normal, and the ns per call of the dedicated test, of gjk/epa without a cache and
+of gjk/epa with the cache of the same pair from the last frame are reported side by side.
+the pairs left to gjk/epa alone are checked by pushing them apart along the contact they get.
+planes against AABBs, boxes and hulls have to get the extent of the vertices along the normal, in both orders */
+
+#define BENCH_GJK_HULL_POINTS 12
+#define BENCH_GJK_GRAZING 1e-3f             // contacts shallower than this may be missed by either test
+#define BENCH_GJK_DEPTH_TOLERANCE 1e-2f
+#define BENCH_GJK_NORMAL_TOLERANCE 0.99f    // smallest dot product of the two normals
+#define BENCH_GJK_PUSH_MARGIN 1e-2f         // added to the depth when pushing a pair apart
+
+
+// function prototypes
+
+void bench_gjk(Bench* bench);
+Collider bench_gjkRandomCollider(int type, Vector3* hull_points);
+void bench_gjkTranslate(Collider* collider, const Vector3* offset);
+bool bench_gjkTest(ContactData* contact, const Collider* a, const Collider* b, GjkCache* cache);
+void bench_gjkCompare(Bench* bench, const char* pair, bool (*dedicated)(ContactData*, const Collider*, const Collider*),
+    const Collider* a, const Collider* b);
+void bench_gjkSeparate(Bench* bench, const char* pair, const Collider* a, const Collider* b);
+void bench_gjkTime(Bench* bench, const char* pair, const Collider* a, const Collider* b);
+int bench_gjkVertices(const Collider* collider, Vector3* vertices);
+void bench_gjkPlane(Bench* bench, const char* pair, const Collider* colliders);
+
+
+// function implementations
+
+/* shapes of bench_shapes.h, hulls are random points on an ellipsoid written in "hull_points" */
+Collider bench_gjkRandomCollider(int type, Vector3* hull_points)
+{
+    Collider collider;
+    collider_init(&collider, type);
+
+    switch (type) {
+        case SPHERE_A: collider.sphere = bench_randomSphere(); break;
+        case AABB_A: collider.aabb = bench_randomAABB(); break;
+        case BOX_A: collider.box = bench_randomBox(); break;
+        case CAPSULE_A: collider.capsule = bench_randomCapsule(); break;
+        default: {
+            Vector3 scale = bench_randomVector3(0.5f, 1.5f);
+            for (int i = 0; i < BENCH_GJK_HULL_POINTS; i++) {
+                Vector3 point = bench_randomUnitVector3();
+                hull_points[i] = (Vector3){point.x * scale.x, point.y * scale.y, point.z * scale.z};
+            }
+            Vector3 center = bench_randomVector3(-3.0f, 3.0f);
+            convexHull_init(&collider.hull, hull_points, BENCH_GJK_HULL_POINTS, &center);
+            break;
+        }
+    }
+    return collider;
+}
+
+void bench_gjkTranslate(Collider* collider, const Vector3* offset)
+{
+    switch (collider->type) {
+        case SPHERE_A: vector3_add(&collider->sphere.center, offset); break;
+        case BOX_A: vector3_add(&collider->box.center, offset); break;
+        case CONVEX_HULL_A: vector3_add(&collider->hull.center, offset); break;
+        case AABB_A:
+            vector3_add(&collider->aabb.minCoordinates, offset);
+            vector3_add(&collider->aabb.maxCoordinates, offset);
+            break;
+        case CAPSULE_A:
+            vector3_add(&collider->capsule.start, offset);
+            vector3_add(&collider->capsule.end, offset);
+            break;
+    }
+}
+
+bool bench_gjkTest(ContactData* contact, const Collider* a, const Collider* b, GjkCache* cache)
+{
+    ConvexShape shape_a = convexShape_fromCollider(a);
+    ConvexShape shape_b = convexShape_fromCollider(b);
+    return convexShape_collisionTest(contact, &shape_a, &shape_b, cache);
+}
+
+void bench_gjkCompare(Bench* bench, const char* pair, bool (*dedicated)(ContactData*, const Collider*, const Collider*),
+    const Collider* a, const Collider* b)
+{
+    int hits = 0;
+    int mismatches = 0;
+    float depth_error = 0.0f;
+    float normal_dot = 1.0f;
+    char name[64];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+
+        ContactData expected, result;
+        bool expected_hit = dedicated(&expected, &a[i], &b[i]);
+        bool hit = bench_gjkTest(&result, &a[i], &b[i], NULL);
+
+        if (expected_hit != hit) {
+            float depth = expected_hit ? expected.penetration : result.penetration;
+            if (depth > BENCH_GJK_GRAZING) mismatches++;
+            continue;
+        }
+        if (!hit) continue;
+
+        hits++;
+        float error = fabsf(result.penetration - expected.penetration);
+        depth_error = fmaxf(depth_error, error);
+        if (error > BENCH_GJK_DEPTH_TOLERANCE) mismatches++;
+
+        // The normal of a barely touching pair is decided by rounding
+        if (expected.penetration < BENCH_GJK_DEPTH_TOLERANCE) continue;
+        float dot = vector3_returnDotProduct(&result.normal, &expected.normal);
+        normal_dot = fminf(normal_dot, dot);
+        if (dot < BENCH_GJK_NORMAL_TOLERANCE) mismatches++;
+    }
+
+    snprintf(name, sizeof(name), "%s_hits", pair);
+    bench_report(bench, name, hits, "count");
+    snprintf(name, sizeof(name), "%s_max_depth_error", pair);
+    bench_report(bench, name, depth_error, "units");
+    snprintf(name, sizeof(name), "%s_min_normal_dot", pair);
+    bench_report(bench, name, normal_dot, "dot");
+    snprintf(name, sizeof(name), "%s_matches_dedicated", pair);
+    bench_check(bench, name, mismatches == 0);
+
+    snprintf(name, sizeof(name), "%s_dedicated", pair);
+    BENCH_TIME(bench, name, ContactData contact; sink += dedicated(&contact, &a[k], &b[k]); sink += contact.penetration);
+    bench_gjkTime(bench, pair, a, b);
+}
+
+/* "a" moved along the normal by its depth and a little more has to come out of "b" */
+void bench_gjkSeparate(Bench* bench, const char* pair, const Collider* a, const Collider* b)
+{
+    int hits = 0;
+    int still_overlapping = 0;
+    char name[64];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+
+        ContactData contact;
+        if (!bench_gjkTest(&contact, &a[i], &b[i], NULL)) continue;
+        hits++;
+
+        Collider moved = a[i];
+        Vector3 push = vector3_returnScaled(&contact.normal, contact.penetration + BENCH_GJK_PUSH_MARGIN);
+        bench_gjkTranslate(&moved, &push);
+        if (bench_gjkTest(&contact, &moved, &b[i], NULL) && contact.penetration > BENCH_GJK_GRAZING) still_overlapping++;
+    }
+
+    snprintf(name, sizeof(name), "%s_hits", pair);
+    bench_report(bench, name, hits, "count");
+    snprintf(name, sizeof(name), "%s_separated_by_contact", pair);
+    bench_check(bench, name, still_overlapping == 0);
+
+    bench_gjkTime(bench, pair, a, b);
+}
+
+/* without a cache, then with the cache each pair left on the previous run, as a pair that didn't move since the last frame */
+void bench_gjkTime(Bench* bench, const char* pair, const Collider* a, const Collider* b)
+{
+    static GjkCache caches[BENCH_INPUT_COUNT];
+    char name[64];
+
+    int cold_iterations = 0;
+    int cached_iterations = 0;
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        ConvexShape shape_a = convexShape_fromCollider(&a[i]);
+        ConvexShape shape_b = convexShape_fromCollider(&b[i]);
+        GjkResult result;
+        caches[i] = (GjkCache){0};
+        gjk_getDistance(&result, &shape_a, &shape_b, &caches[i]);
+        cold_iterations += result.iterations;
+        gjk_getDistance(&result, &shape_a, &shape_b, &caches[i]);
+        cached_iterations += result.iterations;
+    }
+
+    snprintf(name, sizeof(name), "%s_gjk_iterations", pair);
+    bench_report(bench, name, (double)cold_iterations / BENCH_INPUT_COUNT, "count");
+    snprintf(name, sizeof(name), "%s_gjk_iterations_cached", pair);
+    bench_report(bench, name, (double)cached_iterations / BENCH_INPUT_COUNT, "count");
+
+    snprintf(name, sizeof(name), "%s_gjk_epa", pair);
+    BENCH_TIME(bench, name, ContactData contact; sink += bench_gjkTest(&contact, &a[k], &b[k], NULL); sink += contact.penetration);
+    snprintf(name, sizeof(name), "%s_gjk_epa_cached", pair);
+    BENCH_TIME(bench, name, ContactData contact; sink += bench_gjkTest(&contact, &a[k], &b[k], &caches[k]); sink += contact.penetration);
+}
+
+void bench_gjk(Bench* bench)
+{
+    const int types[] = {SPHERE_A, AABB_A, BOX_A, CAPSULE_A, CONVEX_HULL_A};
+    const int type_count = sizeof(types) / sizeof(types[0]);
+
+    // One set of each type for the "a" side and one for the "b" side
+    static Collider colliders[2][sizeof(types) / sizeof(types[0])][BENCH_INPUT_COUNT];
+    static Vector3 hull_points[2][BENCH_INPUT_COUNT][BENCH_GJK_HULL_POINTS];
+
+    for (int side = 0; side < 2; side++) {
+        for (int t = 0; t < type_count; t++) {
+            for (int i = 0; i < BENCH_INPUT_COUNT; i++) colliders[side][t][i] = bench_gjkRandomCollider(types[t], hull_points[side][i]);
+        }
+    }
+
+    const Collider* spheres = colliders[0][0];
+    const Collider* aabbs = colliders[0][1];
+    const Collider* boxes = colliders[0][2];
+    const Collider* capsules = colliders[0][3];
+    const Collider* hulls = colliders[0][4];
+
+    bench_gjkCompare(bench, "sphere_sphere", narrowphase_sphereSphere, spheres, colliders[1][0]);
+    bench_gjkCompare(bench, "sphere_aabb", narrowphase_sphereAABB, spheres, colliders[1][1]);
+    bench_gjkCompare(bench, "sphere_box", narrowphase_sphereBox, spheres, colliders[1][2]);
+    bench_gjkCompare(bench, "sphere_capsule", narrowphase_sphereCapsule, spheres, colliders[1][3]);
+    bench_gjkCompare(bench, "aabb_aabb", narrowphase_aabbAABB, aabbs, colliders[1][1]);
+    bench_gjkCompare(bench, "aabb_capsule", narrowphase_aabbCapsule, aabbs, colliders[1][3]);
+    bench_gjkCompare(bench, "box_capsule", narrowphase_boxCapsule, boxes, colliders[1][3]);
+    bench_gjkCompare(bench, "capsule_capsule", narrowphase_capsuleCapsule, capsules, colliders[1][3]);
+
+    bench_gjkSeparate(bench, "box_box", boxes, colliders[1][2]);
+    bench_gjkSeparate(bench, "aabb_box", aabbs, colliders[1][2]);
+    bench_gjkSeparate(bench, "hull_hull", hulls, colliders[1][4]);
+    bench_gjkSeparate(bench, "capsule_hull", capsules, colliders[1][4]);
+
+    bench_gjkPlane(bench, "aabb_plane", aabbs);
+    bench_gjkPlane(bench, "box_plane", boxes);
+    bench_gjkPlane(bench, "plane_hull", hulls);
+}
+
+/* corners of AABBs and boxes and the points of hulls, returns how many */
+int bench_gjkVertices(const Collider* collider, Vector3* vertices)
+{
+    switch (collider->type) {
+        case AABB_A: aabb_getCorners(&collider->aabb, vertices); return 8;
+        case BOX_A: {
+            AABB local = box_getLocalAABB(&collider->box);
+            aabb_getCorners(&local, vertices);
+            for (int i = 0; i < 8; i++) box_transformToGlobalSpace(&collider->box, &vertices[i]);
+            return 8;
+        }
+        default:
+            for (int i = 0; i < collider->hull.vertex_count; i++) vertices[i] = vector3_sum(&collider->hull.vertices[i], &collider->hull.center);
+            return collider->hull.vertex_count;
+    }
+}
+
+/* random planes through the cube of the shapes. the shape touches while its vertices lie on both sides,
+the deepest one gives the depth, and the mirrored order has to invert the normal */
+void bench_gjkPlane(Bench* bench, const char* pair, const Collider* colliders)
+{
+    static Collider planes[BENCH_INPUT_COUNT];
+    int hits = 0;
+    int mismatches = 0;
+    char name[64];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+
+        collider_init(&planes[i], PLANE_A);
+        Vector3 normal = bench_randomUnitVector3();
+        Vector3 point = bench_randomVector3(-3.0f, 3.0f);
+        plane_setFromNormalAndPoint(&planes[i].plane, &normal, &point);
+
+        Vector3 vertices[BENCH_GJK_HULL_POINTS > 8 ? BENCH_GJK_HULL_POINTS : 8];
+        int vertex_count = bench_gjkVertices(&colliders[i], vertices);
+        float lowest = FLT_MAX;
+        float highest = -FLT_MAX;
+        for (int j = 0; j < vertex_count; j++) {
+            float distance = plane_distanceToPoint(&planes[i].plane, &vertices[j]);
+            lowest = fminf(lowest, distance);
+            highest = fmaxf(highest, distance);
+        }
+
+        // Grazing planes may go either way
+        bool expected_hit = lowest <= 0.0f && highest >= 0.0f;
+        if (fminf(fabsf(lowest), fabsf(highest)) < BENCH_GJK_GRAZING) continue;
+
+        ContactData contact, mirrored;
+        bool hit = collider_collisionTest(&contact, &colliders[i], &planes[i]);
+        bool mirrored_hit = collider_collisionTest(&mirrored, &planes[i], &colliders[i]);
+
+        if (hit != expected_hit || mirrored_hit != expected_hit) mismatches++;
+        else if (hit) {
+            hits++;
+            Vector3 inverted = vector3_getInverse(&mirrored.normal);
+            if (fabsf(contact.penetration + lowest) > BENCH_GJK_DEPTH_TOLERANCE) mismatches++;
+            else if (vector3_returnDotProduct(&contact.normal, &normal) < BENCH_GJK_NORMAL_TOLERANCE) mismatches++;
+            else if (vector3_returnDotProduct(&inverted, &normal) < BENCH_GJK_NORMAL_TOLERANCE) mismatches++;
+            else if (fabsf(plane_distanceToPoint(&planes[i].plane, &contact.point)) > BENCH_GJK_DEPTH_TOLERANCE) mismatches++;
+        }
+    }
+
+    snprintf(name, sizeof(name), "%s_hits", pair);
+    bench_report(bench, name, hits, "count");
+    snprintf(name, sizeof(name), "%s_matches_vertices", pair);
+    bench_check(bench, name, mismatches == 0 && hits > 0);
+
+    snprintf(name, sizeof(name), "%s_collisionTest", pair);
+    BENCH_TIME(bench, name, ContactData contact; sink += collider_collisionTest(&contact, &colliders[k], &planes[k]); sink += contact.penetration);
+}
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef BENCH_MATH_H
+#define BENCH_MATH_H
+
+/* BENCH_MATH.H
+ns per call of every vector3, matrix3x3 and quaternion operation and of the geometry helpers of math_functions.h,
+and the precise and fast tiers of fast_trig.h against libm: the max absolute error of each against the double
+precision functions has to stay within the bound of the header, next to the ns per call of each tier and of libm */
+
+#define BENCH_MATH_TRIG_SAMPLES (1 << 20)     // evenly spread over the range of each function
+
+
+// function prototypes
+
+void bench_math(Bench* bench);
+Matrix3x3 bench_randomMatrix3x3();
+Quaternion bench_randomUnitQuaternion();
+void bench_mathTrigTier(Bench* bench, const char* tier, int accuracy, float sin_bound, float atan2_bound, float acos_bound);
+void bench_mathTrig(Bench* bench);
+
+
+// function implementations
+
+Matrix3x3 bench_randomMatrix3x3()
+{
+    Matrix3x3 matrix;
+    // Diagonally dominant, so it always has an inverse
+    for (int i = 0; i < 3; i++) {
+        matrix.row[i] = bench_randomVector3(-1.0f, 1.0f);
+        vector3_setElement(&matrix.row[i], i, bench_randomFloat(4.0f, 8.0f));
+    }
+    return matrix;
+}
+
+Quaternion bench_randomUnitQuaternion()
+{
+    Quaternion q = {bench_randomFloat(-1.0f, 1.0f), bench_randomFloat(-1.0f, 1.0f), bench_randomFloat(-1.0f, 1.0f), bench_randomFloat(0.1f, 1.0f)};
+    return quaternion_returnUnit(&q);
+}
+
+void bench_math(Bench* bench)
+{
+    static Vector3 v[BENCH_INPUT_COUNT], w[BENCH_INPUT_COUNT], u[BENCH_INPUT_COUNT], positive[BENCH_INPUT_COUNT], angles[BENCH_INPUT_COUNT];
+    static float s[BENCH_INPUT_COUNT], t[BENCH_INPUT_COUNT];
+    static Matrix3x3 m[BENCH_INPUT_COUNT], n[BENCH_INPUT_COUNT], r[BENCH_INPUT_COUNT];
+    static Quaternion q[BENCH_INPUT_COUNT], p[BENCH_INPUT_COUNT];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        v[i] = bench_randomVector3(-100.0f, 100.0f);
+        w[i] = bench_randomVector3(-100.0f, 100.0f);
+        u[i] = bench_randomUnitVector3();
+        positive[i] = bench_randomVector3(0.5f, 100.0f);
+        angles[i] = bench_randomVector3(-180.0f, 180.0f);
+        s[i] = bench_randomFloat(0.5f, 10.0f);
+        t[i] = bench_randomFloat(0.0f, 1.0f);
+        m[i] = bench_randomMatrix3x3();
+        n[i] = bench_randomMatrix3x3();
+        r[i] = rotation_getMatrix(&angles[i]);
+        q[i] = bench_randomUnitQuaternion();
+        p[i] = bench_randomUnitQuaternion();
+    }
+
+    // Cost of the timing loop itself, included in every row below
+
+    BENCH_TIME(bench, "loop_overhead", sink += s[k]);
+
+    // vector3.h
+
+    BENCH_TIME(bench, "vector3_init", Vector3 a = v[k]; vector3_init(&a); sink += a.x);
+    BENCH_TIME(bench, "vector3_set", Vector3 a; vector3_set(&a, s[k], t[k], s[k]); sink += a.z);
+    BENCH_TIME(bench, "vector3_setElement", Vector3 a = v[k]; vector3_setElement(&a, k % 3, s[k]); sink += a.y);
+    BENCH_TIME(bench, "vector3_returnElement", sink += vector3_returnElement(&v[k], k % 3));
+    BENCH_TIME(bench, "vector3_invert", Vector3 a = v[k]; vector3_invert(&a); sink += a.x);
+    BENCH_TIME(bench, "vector3_getInverse", sink += vector3_getInverse(&v[k]).x);
+    BENCH_TIME(bench, "vector3_add", Vector3 a = v[k]; vector3_add(&a, &w[k]); sink += a.x);
+    BENCH_TIME(bench, "vector3_sum", sink += vector3_sum(&v[k], &w[k]).x);
+    BENCH_TIME(bench, "vector3_subtract", Vector3 a = v[k]; vector3_subtract(&a, &w[k]); sink += a.x);
+    BENCH_TIME(bench, "vector3_difference", sink += vector3_difference(&v[k], &w[k]).x);
+    BENCH_TIME(bench, "vector3_scale", Vector3 a = v[k]; vector3_scale(&a, s[k]); sink += a.x);
+    BENCH_TIME(bench, "vector3_returnScaled", sink += vector3_returnScaled(&v[k], s[k]).x);
+    BENCH_TIME(bench, "vector3_divideByNumber", Vector3 a = v[k]; vector3_divideByNumber(&a, s[k]); sink += a.x);
+    BENCH_TIME(bench, "vector3_returnQuotientByNumber", sink += vector3_returnQuotientByNumber(&v[k], s[k]).x);
+    BENCH_TIME(bench, "vector3_returnQuotientByVector", sink += vector3_returnQuotientByVector(&v[k], &positive[k]).x);
+    BENCH_TIME(bench, "vector3_componentProduct", Vector3 a = v[k]; vector3_componentProduct(&a, &w[k]); sink += a.x);
+    BENCH_TIME(bench, "vector3_returnComponentProduct", sink += vector3_returnComponentProduct(&v[k], &w[k]).x);
+    BENCH_TIME(bench, "vector3_crossProduct", Vector3 a = v[k]; vector3_crossProduct(&a, &w[k]); sink += a.z);
+    BENCH_TIME(bench, "vector3_returnCrossProduct", sink += vector3_returnCrossProduct(&v[k], &w[k]).z);
+    BENCH_TIME(bench, "vector3_returnDotProduct", sink += vector3_returnDotProduct(&v[k], &w[k]));
+    BENCH_TIME(bench, "vector3_addScaledVector", Vector3 a = v[k]; vector3_addScaledVector(&a, &w[k], s[k]); sink += a.x);
+    BENCH_TIME(bench, "vector3_magnitude", sink += vector3_magnitude(&v[k]));
+    BENCH_TIME(bench, "vector3_squaredMagnitude", sink += vector3_squaredMagnitude(&v[k]));
+    BENCH_TIME(bench, "vector3_normalize", Vector3 a = v[k]; vector3_normalize(&a); sink += a.x);
+    BENCH_TIME(bench, "vector3_returnNormalized", sink += vector3_returnNormalized(&v[k]).x);
+    BENCH_TIME(bench, "vector3_returnAbsoluteVector", sink += vector3_returnAbsoluteVector(&v[k]).x);
+    BENCH_TIME(bench, "vector3_min", sink += vector3_min(&v[k], &w[k]).x);
+    BENCH_TIME(bench, "vector3_max", sink += vector3_max(&v[k], &w[k]).x);
+    BENCH_TIME(bench, "vector3_returnMinValue", sink += vector3_returnMinValue(&v[k]));
+    BENCH_TIME(bench, "vector3_returnMaxValue", sink += vector3_returnMaxValue(&v[k]));
+    BENCH_TIME(bench, "vector3_returnMinAxis", sink += vector3_returnMinAxis(&v[k]));
+    BENCH_TIME(bench, "vector3_returnMaxAxis", sink += vector3_returnMaxAxis(&v[k]));
+    BENCH_TIME(bench, "vector3_isUnit", sink += vector3_isUnit(&u[k]));
+    BENCH_TIME(bench, "vector3_isFinite", sink += vector3_isFinite(&v[k]));
+    BENCH_TIME(bench, "vector3_isZero", sink += vector3_isZero(&v[k]));
+    BENCH_TIME(bench, "vector3_equals", sink += vector3_equals(&v[k], &w[k]));
+    BENCH_TIME(bench, "vector3_notEquals", sink += vector3_notEquals(&v[k], &w[k]));
+    BENCH_TIME(bench, "vector3_lessThan", sink += vector3_lessThan(&v[k], &w[k]));
+    BENCH_TIME(bench, "vector3_approxEquals", sink += vector3_approxEquals(&v[k], &w[k]));
+
+    // matrix3x3.h
+
+    BENCH_TIME(bench, "matrix3x3_init", Matrix3x3 a; matrix3x3_init(&a); sink += a.row[0].x);
+    BENCH_TIME(bench, "matrix3x3_set", Matrix3x3 a; matrix3x3_set(&a, s[k], t[k], s[k], t[k], s[k], t[k], s[k], t[k], s[k]); sink += a.row[1].y);
+    BENCH_TIME(bench, "matrix3x3_setWithValue", Matrix3x3 a; matrix3x3_setWithValue(&a, s[k]); sink += a.row[2].z);
+    BENCH_TIME(bench, "matrix3x3_returnColumn", sink += matrix3x3_returnColumn(&m[k], k % 3).x);
+    BENCH_TIME(bench, "matrix3x3_returnRow", sink += matrix3x3_returnRow(&m[k], k % 3).x);
+    BENCH_TIME(bench, "matrix3x3_add", Matrix3x3 a = m[k]; matrix3x3_add(&a, &n[k]); sink += a.row[0].x);
+    BENCH_TIME(bench, "matrix3x3_sum", sink += matrix3x3_sum(&m[k], &n[k]).row[0].x);
+    BENCH_TIME(bench, "matrix3x3_subtract", Matrix3x3 a = m[k]; matrix3x3_subtract(&a, &n[k]); sink += a.row[0].x);
+    BENCH_TIME(bench, "matrix3x3_difference", sink += matrix3x3_difference(&m[k], &n[k]).row[0].x);
+    BENCH_TIME(bench, "matrix3x3_returnScaled", sink += matrix3x3_returnScaled(&m[k], s[k]).row[0].x);
+    BENCH_TIME(bench, "matrix3x3_scale", Matrix3x3 a = m[k]; matrix3x3_scale(&a, s[k]); sink += a.row[0].x);
+    BENCH_TIME(bench, "matrix3x3_multiply", sink += matrix3x3_multiply(&m[k], &n[k]).row[1].y);
+    BENCH_TIME(bench, "matrix3x3_multiplyByVector", sink += matrix3x3_multiplyByVector(&m[k], &v[k]).x);
+    BENCH_TIME(bench, "matrix3x3_multiplyTransposeByVector", sink += matrix3x3_multiplyTransposeByVector(&m[k], &v[k]).x);
+    BENCH_TIME(bench, "matrix3x3_returnNegative", sink += matrix3x3_returnNegative(&m[k]).row[0].x);
+    BENCH_TIME(bench, "matrix3x3_returnTranspose", sink += matrix3x3_returnTranspose(&m[k]).row[0].y);
+    BENCH_TIME(bench, "matrix3x3_returnDeterminant", sink += matrix3x3_returnDeterminant(&m[k]));
+    BENCH_TIME(bench, "matrix3x3_returnTrace", sink += matrix3x3_returnTrace(&m[k]));
+    BENCH_TIME(bench, "matrix3x3_returnInverse", sink += matrix3x3_returnInverse(&m[k]).row[0].x);
+    BENCH_TIME(bench, "matrix3x3_returnAbsoluteMatrix", sink += matrix3x3_returnAbsoluteMatrix(&m[k]).row[0].x);
+    BENCH_TIME(bench, "matrix3x3_setIdentity", Matrix3x3 a = m[k]; matrix3x3_setIdentity(&a); sink += a.row[0].x);
+    BENCH_TIME(bench, "matrix3x3_computeSkewSymmetricMatrixForCrossProduct", sink += matrix3x3_computeSkewSymmetricMatrixForCrossProduct(&v[k]).row[0].y);
+    BENCH_TIME(bench, "matrix3x3_equals", sink += matrix3x3_equals(&m[k], &n[k]));
+
+    // quaternion.h
+
+    BENCH_TIME(bench, "quaternion_set", Quaternion a; quaternion_set(&a, s[k], t[k], s[k], t[k]); sink += a.w);
+    BENCH_TIME(bench, "quaternion_setWithVector", Quaternion a; quaternion_setWithVector(&a, s[k], &v[k]); sink += a.x);
+    BENCH_TIME(bench, "quaternion_sum", sink += quaternion_sum(&q[k], &p[k]).x);
+    BENCH_TIME(bench, "quaternion_difference", sink += quaternion_difference(&q[k], &p[k]).x);
+    BENCH_TIME(bench, "quaternion_returnScaled", sink += quaternion_returnScaled(&q[k], s[k]).x);
+    BENCH_TIME(bench, "quaternion_returnProduct", sink += quaternion_returnProduct(&q[k], &p[k]).x);
+    BENCH_TIME(bench, "quaternion_getVectorProduct", sink += quaternion_getVectorProduct(&q[k], &v[k]).x);
+    BENCH_TIME(bench, "quaternion_returnVectorV", sink += quaternion_returnVectorV(&q[k]).x);
+    BENCH_TIME(bench, "quaternion_magnitude", sink += quaternion_magnitude(&q[k]));
+    BENCH_TIME(bench, "quaternion_squaredMagnitude", sink += quaternion_squaredMagnitude(&q[k]));
+    BENCH_TIME(bench, "quaternion_normalize", Quaternion a = q[k]; quaternion_normalize(&a); sink += a.x);
+    BENCH_TIME(bench, "quaternion_invert", Quaternion a = q[k]; quaternion_invert(&a); sink += a.x);
+    BENCH_TIME(bench, "quaternion_returnUnit", sink += quaternion_returnUnit(&q[k]).x);
+    BENCH_TIME(bench, "quaternion_getConjugate", sink += quaternion_getConjugate(&q[k]).x);
+    BENCH_TIME(bench, "quaternion_getInverse", sink += quaternion_getInverse(&q[k]).x);
+    BENCH_TIME(bench, "quaternion_dotProduct", sink += quaternion_dotProduct(&q[k], &p[k]));
+    BENCH_TIME(bench, "quaternion_isFinite", sink += quaternion_isFinite(&q[k]));
+    BENCH_TIME(bench, "quaternion_isUnit", sink += quaternion_isUnit(&q[k]));
+    BENCH_TIME(bench, "quaternion_isValid", sink += quaternion_isValid(&q[k]));
+    BENCH_TIME(bench, "quaternion_equals", sink += quaternion_equals(&q[k], &p[k]));
+    BENCH_TIME(bench, "quaternion_getFromEulerAngles", sink += quaternion_getFromEulerAngles(angles[k].x, angles[k].y, angles[k].z).x);
+    BENCH_TIME(bench, "quaternion_getFromVector", sink += quaternion_getFromVector(&angles[k]).x);
+    BENCH_TIME(bench, "quaternion_getFromMatrix", sink += quaternion_getFromMatrix(&r[k]).x);
+    BENCH_TIME(bench, "quaternion_setRotationAngleAxis", float angle; Vector3 axis; Quaternion a = q[k]; quaternion_setRotationAngleAxis(&a, &angle, &axis); sink += angle + axis.x);
+    BENCH_TIME(bench, "quaternion_getMatrix", sink += quaternion_getMatrix(&q[k]).row[0].x);
+    BENCH_TIME(bench, "quaternion_slerp", sink += quaternion_slerp(&q[k], &p[k], t[k]).x);
+
+    // math_functions.h
+
+    BENCH_TIME(bench, "vector3_multiplyByMatrix3x3", sink += vector3_multiplyByMatrix3x3(&m[k], &v[k]).x);
+    BENCH_TIME(bench, "vector3_rotateByQuaternion", sink += vector3_rotateByQuaternion(&v[k], &q[k]).x);
+    BENCH_TIME(bench, "vector3_transformToLocalSpace", sink += vector3_transformToLocalSpace(&v[k], w[k], angles[k]).x);
+    BENCH_TIME(bench, "vector3_transformToGlobalSpace", sink += vector3_transformToGlobalSpace(&v[k], w[k], angles[k]).x);
+    BENCH_TIME(bench, "vector3_reflect", sink += vector3_reflect(&v[k], &u[k]).x);
+    BENCH_TIME(bench, "vector3_clamp", sink += vector3_clamp(&v[k], 50.0f).x);
+    BENCH_TIME(bench, "point_rotateZYX", Vector3 a = v[k]; point_rotateZYX(&a, &angles[k]); sink += a.x);
+    BENCH_TIME(bench, "point_transformToLocalSpace", Vector3 a = v[k]; point_transformToLocalSpace(&a, &w[k], &angles[k]); sink += a.x);
+    BENCH_TIME(bench, "rotation_getMatrix", sink += rotation_getMatrix(&angles[k]).row[0].x);
+    BENCH_TIME(bench, "segment_closestToPoint", sink += segment_closestToPoint(&v[k], &w[k], &positive[k]).x);
+    BENCH_TIME(bench, "segment_closestPointsWithSegment", Vector3 a, b; segment_closestPointsWithSegment(&v[k], &w[k], &positive[k], &u[k], &a, &b); sink += a.x + b.x);
+    BENCH_TIME(bench, "segment_distanceToPoint", sink += segment_distanceToPoint(&v[k], &w[k], &positive[k]));
+    BENCH_TIME(bench, "triangle_getBarycentricCoordinates", float a, b, c; triangle_getBarycentricCoordinates(&v[k], &w[k], &positive[k], &u[k], &a, &b, &c); sink += a + b + c);
+    BENCH_TIME(bench, "trig_sinCos", float sine, cosine; trig_sinCos(angles[k].x, &sine, &cosine); sink += sine + cosine);
+    BENCH_TIME(bench, "trig_atan2", sink += trig_atan2(v[k].x, w[k].x));
+    BENCH_TIME(bench, "trig_acos", sink += trig_acos(u[k].x));
+
+    bench_mathTrig(bench);
+}
+
+/* max absolute error of one tier against double precision libm, checked against the bounds of the header */
+void bench_mathTrigTier(Bench* bench, const char* tier, int accuracy, float sin_bound, float atan2_bound, float acos_bound)
+{
+    double sin_error = 0.0;
+    double atan2_error = 0.0;
+    double acos_error = 0.0;
+    char name[64];
+
+    for (int i = 0; i <= BENCH_MATH_TRIG_SAMPLES; i++) {
+
+        float fraction = (float)i / BENCH_MATH_TRIG_SAMPLES;
+
+        float angle = FAST_TRIG_SIN_RANGE * (2.0f * fraction - 1.0f);
+        float sine, cosine;
+        trig_sinCosTier(angle, &sine, &cosine, accuracy);
+        sin_error = fmax(sin_error, fmax(fabs(sine - sin((double)angle)), fabs(cosine - cos((double)angle))));
+
+        // Around the circle at a few distances from the origin
+        float direction = 2.0f * PI * fraction;
+        float distance = (i % 3 == 0) ? 1e-3f : (i % 3 == 1) ? 1.0f : 1e3f;
+        float x = distance * cosf(direction);
+        float y = distance * sinf(direction);
+        atan2_error = fmax(atan2_error, fabs(trig_atan2Tier(y, x, accuracy) - atan2((double)y, (double)x)));
+
+        float cosine_value = 2.0f * fraction - 1.0f;
+        acos_error = fmax(acos_error, fabs(trig_acosTier(cosine_value, accuracy) - acos((double)cosine_value)));
+    }
+
+    snprintf(name, sizeof(name), "%s_sin_cos_max_error", tier);
+    bench_report(bench, name, 1e6 * sin_error, "urad");
+    snprintf(name, sizeof(name), "%s_atan2_max_error", tier);
+    bench_report(bench, name, 1e6 * atan2_error, "urad");
+    snprintf(name, sizeof(name), "%s_acos_max_error", tier);
+    bench_report(bench, name, 1e6 * acos_error, "urad");
+    snprintf(name, sizeof(name), "%s_within_header_bounds", tier);
+    bench_check(bench, name, sin_error <= sin_bound && atan2_error <= atan2_bound && acos_error <= acos_bound);
+}
+
+void bench_mathTrig(Bench* bench)
+{
+    static float angles[BENCH_INPUT_COUNT], x[BENCH_INPUT_COUNT], y[BENCH_INPUT_COUNT], cosines[BENCH_INPUT_COUNT];
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        angles[i] = bench_randomFloat(-10.0f, 10.0f);
+        x[i] = bench_randomFloat(-100.0f, 100.0f);
+        y[i] = bench_randomFloat(-100.0f, 100.0f);
+        cosines[i] = bench_randomFloat(-1.0f, 1.0f);
+    }
+
+    bench_mathTrigTier(bench, "precise", FAST_TRIG_PRECISE, FAST_TRIG_PRECISE_SIN_ERROR, FAST_TRIG_PRECISE_ATAN2_ERROR, FAST_TRIG_PRECISE_ACOS_ERROR);
+    bench_mathTrigTier(bench, "fast", FAST_TRIG_FAST, FAST_TRIG_FAST_SIN_ERROR, FAST_TRIG_FAST_ATAN2_ERROR, FAST_TRIG_FAST_ACOS_ERROR);
+
+    BENCH_TIME(bench, "libm_sinf_cosf", sink += sinf(angles[k]) + cosf(angles[k]));
+    BENCH_TIME(bench, "precise_sinCos", float sine, cosine; trig_sinCosTier(angles[k], &sine, &cosine, FAST_TRIG_PRECISE); sink += sine + cosine);
+    BENCH_TIME(bench, "fast_sinCos", float sine, cosine; trig_sinCosTier(angles[k], &sine, &cosine, FAST_TRIG_FAST); sink += sine + cosine);
+    BENCH_TIME(bench, "libm_atan2f", sink += atan2f(y[k], x[k]));
+    BENCH_TIME(bench, "precise_atan2", sink += trig_atan2Tier(y[k], x[k], FAST_TRIG_PRECISE));
+    BENCH_TIME(bench, "fast_atan2", sink += trig_atan2Tier(y[k], x[k], FAST_TRIG_FAST));
+    BENCH_TIME(bench, "libm_acosf", sink += acosf(cosines[k]));
+    BENCH_TIME(bench, "precise_acos", sink += trig_acosTier(cosines[k], FAST_TRIG_PRECISE));
+    BENCH_TIME(bench, "fast_acos", sink += trig_acosTier(cosines[k], FAST_TRIG_FAST));
+}
+
+#endif
@@ -0,0 +1,467 @@
+#ifndef BENCH_MESH_H
+#define BENCH_MESH_H
+
+/* BENCH_MESH.H
+query latency of the triangle mesh collider on a generated terrain of more than 50k triangles, against the
+brute force test of every triangle, the capsule triangle test against the exact distance of the capsule axis,
+the shield of an actor against the terrain mesh and a heightfield, the sphere cast of the camera against the terrain
+as a mesh and as a heightfield, and the level geometry of assets/ground.glb read with the mesh loader */
+
+#define BENCH_MESH_GRID 160                 // quads per side of the generated terrain, two triangles each
+#define BENCH_MESH_SPACING 10.0f
+#define BENCH_MESH_CHECKED_QUERIES 64       // queries compared with the brute force result
+#define BENCH_MESH_SHIELD_RADIUS 15.0f
+#define BENCH_MESH_EXACT_TOLERANCE 1e-3f
+#define BENCH_MESH_PUSH_MARGIN 1e-2f        // added to the depth when pushing a capsule out of a triangle
+#define BENCH_MESH_FLAT_SIZE 16             // samples per side of the flat heightfield
+#define BENCH_MESH_CAST_RADIUS 30.0f        // the collision radius of the camera
+#define BENCH_MESH_CAST_SAMPLES 256         // discrete tests along every cast
+#define BENCH_MESH_CAST_TOLERANCE 0.05f     // a cast contact is at most this far from the terrain
+#define BENCH_MESH_HEIGHT_SCALE 0.01f       // world units per height unit of the terrain heightfield
+
+#ifndef BENCH_ASSET_DIR
+#define BENCH_ASSET_DIR "../assets"
+#endif
+
+
+// function prototypes
+
+void bench_mesh(Bench* bench);
+float bench_meshTerrainHeight(float x, float y);
+bool bench_meshBruteForce(ContactData* contact, const Capsule* capsule, const TriangleMesh* mesh);
+float bench_meshPointDistance(const Capsule* capsule, const Triangle* triangle, float t);
+float bench_meshExactDistance(const Capsule* capsule, const Triangle* triangle);
+void bench_meshExact(Bench* bench, const TriangleMesh* mesh, const Capsule* capsules);
+void bench_meshShield(Bench* bench, const TriangleMesh* mesh);
+void bench_meshCast(Bench* bench, const TriangleMesh* mesh);
+void bench_meshCastHeightfield(Bench* bench, const Capsule* spheres, const Vector3* arms);
+void bench_meshGround(Bench* bench);
+
+
+// function implementations
+
+float bench_meshTerrainHeight(float x, float y)
+{
+    return 40.0f * sinf(x * 0.013f) * cosf(y * 0.021f) + 15.0f * sinf((x + y) * 0.05f);
+}
+
+/* deepest contact among all the triangles, what the hierarchy has to reproduce */
+bool bench_meshBruteForce(ContactData* contact, const Capsule* capsule, const TriangleMesh* mesh)
+{
+    bool hit = false;
+    for (int i = 0; i < mesh->triangle_count; i++) {
+        Triangle triangle = triangleMesh_getTriangle(mesh, i);
+        ContactData triangle_contact;
+        if (!capsule_collisionTestTriangle(&triangle_contact, capsule, &triangle)) continue;
+        if (!hit || triangle_contact.penetration > contact->penetration) *contact = triangle_contact;
+        hit = true;
+    }
+    return hit;
+}
+
+/* distance from the point at "t" along the capsule axis to the triangle */
+float bench_meshPointDistance(const Capsule* capsule, const Triangle* triangle, float t)
+{
+    Vector3 point = capsule->start;
+    Vector3 axis = vector3_difference(&capsule->end, &capsule->start);
+    vector3_addScaledVector(&point, &axis, t);
+    Vector3 closest = triangle_closestToPoint(triangle, &point);
+    Vector3 offset = vector3_difference(&point, &closest);
+    return vector3_magnitude(&offset);
+}
+
+/* distance from the capsule axis to the triangle, by a ternary search along the axis
+since the distance to a convex shape is convex along a segment */
+float bench_meshExactDistance(const Capsule* capsule, const Triangle* triangle)
+{
+    float low = 0.0f;
+    float high = 1.0f;
+    for (int i = 0; i < 100; i++) {
+        float a = low + (high - low) / 3.0f;
+        float b = high - (high - low) / 3.0f;
+        if (bench_meshPointDistance(capsule, triangle, a) < bench_meshPointDistance(capsule, triangle, b)) high = b;
+        else low = a;
+    }
+    return bench_meshPointDistance(capsule, triangle, 0.5f * (low + high));
+}
+
+/* every triangle near the capsules against the exact distance of its axis: the same hit, the radius minus
+the distance as depth, and pushing the capsule along the normal by the depth has to take it out of the triangle.
+every other capsule is sunk by half its length, so its axis goes through the ground */
+void bench_meshExact(Bench* bench, const TriangleMesh* mesh, const Capsule* capsules)
+{
+    static int candidates[BENCH_INPUT_COUNT];
+    int tested = 0;
+    int crossing = 0;
+    int mismatches = 0;
+    int still_overlapping = 0;
+
+    for (int i = 0; i < 2 * BENCH_MESH_CHECKED_QUERIES; i++) {
+
+        Capsule capsule = capsules[i / 2];
+        if (i % 2 == 1) {
+            capsule.start.z -= 0.5f * capsule.length;
+            capsule.end.z -= 0.5f * capsule.length;
+        }
+
+        AABB bounds = capsule_getAABB(&capsule);
+        int candidate_count = triangleMesh_queryAABB(mesh, &bounds, candidates, BENCH_INPUT_COUNT);
+
+        for (int j = 0; j < candidate_count; j++) {
+
+            Triangle triangle = triangleMesh_getTriangle(mesh, candidates[j]);
+            float distance = bench_meshExactDistance(&capsule, &triangle);
+            float radius = capsule.radius;
+            tested++;
+
+            ContactData contact;
+            bool hit = capsule_collisionTestTriangle(&contact, &capsule, &triangle);
+
+            // Grazing contacts can go either way
+            if (hit != (distance <= radius)) {
+                if (fabsf(distance - radius) > BENCH_MESH_EXACT_TOLERANCE) mismatches++;
+                continue;
+            }
+            if (!hit) continue;
+
+            if (distance > BENCH_MESH_EXACT_TOLERANCE && fabsf(contact.penetration - (radius - distance)) > BENCH_MESH_EXACT_TOLERANCE) mismatches++;
+            if (distance <= BENCH_MESH_EXACT_TOLERANCE) crossing++;
+
+            Capsule pushed = capsule;
+            Vector3 push = vector3_returnScaled(&contact.normal, contact.penetration + BENCH_MESH_PUSH_MARGIN);
+            vector3_add(&pushed.start, &push);
+            vector3_add(&pushed.end, &push);
+            if (bench_meshExactDistance(&pushed, &triangle) < radius) still_overlapping++;
+        }
+    }
+
+    bench_report(bench, "exact_tested_triangles", tested, "count");
+    bench_report(bench, "exact_crossing_triangles", crossing, "count");
+    bench_check(bench, "capsule_triangle_matches_exact_distance", mismatches == 0);
+    bench_check(bench, "capsule_triangle_separated_by_contact", still_overlapping == 0);
+}
+
+void bench_mesh(Bench* bench)
+{
+    const int side = BENCH_MESH_GRID + 1;
+    Vector3* vertices = malloc(side * side * sizeof(Vector3));
+    int* indices = malloc(6 * BENCH_MESH_GRID * BENCH_MESH_GRID * sizeof(int));
+    assert(vertices != NULL && indices != NULL);
+
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            float world_x = x * BENCH_MESH_SPACING;
+            float world_y = y * BENCH_MESH_SPACING;
+            vertices[y * side + x] = (Vector3){world_x, world_y, bench_meshTerrainHeight(world_x, world_y)};
+        }
+    }
+
+    int triangle_count = 0;
+    for (int y = 0; y < BENCH_MESH_GRID; y++) {
+        for (int x = 0; x < BENCH_MESH_GRID; x++) {
+            int corner = y * side + x;
+            int quad[6] = {corner, corner + 1, corner + side + 1, corner, corner + side + 1, corner + side};
+            memcpy(&indices[3 * triangle_count], quad, sizeof(quad));
+            triangle_count += 2;
+        }
+    }
+
+    TriangleMesh mesh;
+    double build_start = bench_now();
+    triangleMesh_init(&mesh, vertices, indices, triangle_count);
+    double build_time = bench_now() - build_start;
+
+    bench_report(bench, "terrain_triangles", triangle_count, "count");
+    bench_report(bench, "terrain_nodes", mesh.node_count, "count");
+    bench_report(bench, "terrain_build", 1e3 * build_time, "ms");
+
+    // Actor sized capsules from a bit under the surface to above it
+    static Capsule capsules[BENCH_INPUT_COUNT];
+    static AABB bounds[BENCH_INPUT_COUNT];
+    float extent = BENCH_MESH_GRID * BENCH_MESH_SPACING;
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        float x = bench_randomFloat(0.0f, extent);
+        float y = bench_randomFloat(0.0f, extent);
+        Vector3 position = {x, y, bench_meshTerrainHeight(x, y) + bench_randomFloat(-15.0f, 30.0f)};
+        capsules[i] = (Capsule){.radius = 10.0f, .length = 60.0f};
+        capsule_setVertical(&capsules[i], &position);
+        bounds[i] = capsule_getAABB(&capsules[i]);
+    }
+
+    ContactData contact;
+    static int candidates[BENCH_INPUT_COUNT];
+    int candidate_total = 0;
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) candidate_total += triangleMesh_queryAABB(&mesh, &bounds[i], candidates, BENCH_INPUT_COUNT);
+    bench_report(bench, "terrain_candidates_per_query", (double)candidate_total / BENCH_INPUT_COUNT, "count");
+
+    BENCH_TIME(bench, "terrain_queryAABB", sink += triangleMesh_queryAABB(&mesh, &bounds[k], candidates, BENCH_INPUT_COUNT));
+    BENCH_TIME(bench, "terrain_capsule_contactMesh", sink += capsule_contactMesh(&capsules[k], &mesh));
+    BENCH_TIME(bench, "terrain_capsule_collisionTestMesh", sink += capsule_collisionTestMesh(&contact, &capsules[k], &mesh); sink += contact.penetration);
+    BENCH_TIME_FROM(bench, "terrain_capsule_bruteForce", 1, sink += bench_meshBruteForce(&contact, &capsules[k], &mesh); sink += contact.penetration);
+
+    int mismatches = 0;
+    int hits = 0;
+    for (int i = 0; i < BENCH_MESH_CHECKED_QUERIES; i++) {
+        ContactData expected, result;
+        bool expected_hit = bench_meshBruteForce(&expected, &capsules[i], &mesh);
+        bool hit = capsule_collisionTestMesh(&result, &capsules[i], &mesh);
+        if (hit != expected_hit || (hit && result.penetration != expected.penetration)) mismatches++;
+        hits += hit;
+    }
+    bench_report(bench, "terrain_checked_hits", hits, "count");
+    bench_check(bench, "terrain_matches_brute_force", mismatches == 0);
+
+    bench_meshExact(bench, &mesh, capsules);
+
+    bench_meshShield(bench, &mesh);
+
+    bench_meshCast(bench, &mesh);
+
+    triangleMesh_delete(&mesh);
+    free(vertices);
+    free(indices);
+
+    bench_meshGround(bench);
+}
+
+/* the shield of an actor, a sphere part, dipped into the terrain mesh and a flat heightfield. on the mesh it has to
+get the depth of the nearest triangle, on the heightfield its height over the ground, and nothing off the grid */
+void bench_meshShield(Bench* bench, const TriangleMesh* mesh)
+{
+    ActorCollider collider = {.settings = {.body_radius = 20.0f, .body_height = 120.0f,
+        .shield_radius = BENCH_MESH_SHIELD_RADIUS, .shield_offset = {0.0f, 30.0f, 40.0f}}};
+    actorCollider_init(&collider);
+    Vector3 rotation = {0.0f, 0.0f, 0.0f};
+
+    Collider terrain_mesh;
+    collider_init(&terrain_mesh, MESH_A);
+    terrain_mesh.mesh = (TriangleMesh*)mesh;
+
+    int mismatches = 0;
+    int hits = 0;
+    float extent = BENCH_MESH_GRID * BENCH_MESH_SPACING;
+
+    for (int i = 0; i < BENCH_MESH_CHECKED_QUERIES; i++) {
+
+        float x = bench_randomFloat(100.0f, extent - 100.0f);
+        float y = bench_randomFloat(100.0f, extent - 100.0f);
+        Vector3 center = {x, y, bench_meshTerrainHeight(x, y) + bench_randomFloat(-0.5f, 1.5f) * BENCH_MESH_SHIELD_RADIUS};
+        Vector3 position = vector3_difference(&center, &collider.settings.shield_offset);
+        actorCollider_set(&collider, &position, &rotation);
+
+        // Distance from the center to the nearest triangle
+        float distance = FLT_MAX;
+        for (int j = 0; j < mesh->triangle_count; j++) {
+            Triangle triangle = triangleMesh_getTriangle(mesh, j);
+            Vector3 closest = triangle_closestToPoint(&triangle, &center);
+            Vector3 offset = vector3_difference(&center, &closest);
+            distance = fminf(distance, vector3_magnitude(&offset));
+        }
+
+        ContactData contact;
+        bool expected_hit = distance <= BENCH_MESH_SHIELD_RADIUS;
+        bool hit = actorCollision_contactParts(&contact, &collider, &terrain_mesh);
+        if (hit != expected_hit || (hit && fabsf(contact.penetration - (BENCH_MESH_SHIELD_RADIUS - distance)) > 1e-3f)) mismatches++;
+        hits += hit;
+    }
+
+    bench_report(bench, "shield_mesh_hits", hits, "count");
+    bench_check(bench, "shield_touches_mesh", mismatches == 0 && hits > 0);
+
+    static int16_t heights[BENCH_MESH_FLAT_SIZE * BENCH_MESH_FLAT_SIZE];
+    Heightfield heightfield;
+    heightfield_init(&heightfield, heights, BENCH_MESH_FLAT_SIZE, BENCH_MESH_FLAT_SIZE, BENCH_MESH_SPACING, 1.0f, &(Vector3){0.0f, 0.0f, 0.0f});
+
+    Collider terrain;
+    collider_init(&terrain, TERRAIN_A);
+    terrain.terrain = &heightfield;
+
+    // Half sunk inside the grid, then the same height beyond its edge
+    mismatches = 0;
+    float flat_extent = (BENCH_MESH_FLAT_SIZE - 1) * BENCH_MESH_SPACING;
+    for (int i = 0; i < BENCH_MESH_CHECKED_QUERIES; i++) {
+
+        bool inside = (i % 2 == 0);
+        float x = inside ? bench_randomFloat(0.0f, flat_extent) : bench_randomFloat(flat_extent + 1.0f, 2.0f * flat_extent);
+        Vector3 center = {x, bench_randomFloat(0.0f, flat_extent), 0.5f * BENCH_MESH_SHIELD_RADIUS};
+        Vector3 position = vector3_difference(&center, &collider.settings.shield_offset);
+        actorCollider_set(&collider, &position, &rotation);
+
+        ContactData contact;
+        bool hit = actorCollision_contactParts(&contact, &collider, &terrain);
+        if (hit != inside) mismatches++;
+        else if (hit && (fabsf(contact.penetration - 0.5f * BENCH_MESH_SHIELD_RADIUS) > 1e-3f || contact.normal.z < 0.999f)) mismatches++;
+    }
+
+    bench_check(bench, "shield_touches_terrain", mismatches == 0);
+}
+
+/* camera sized spheres cast from above the terrain along arms going down and sideways. the cast can't miss a contact
+the discrete test finds along the arm, report it after the first touching sample, or stop short of touching */
+void bench_meshCast(Bench* bench, const TriangleMesh* mesh)
+{
+    static Capsule spheres[BENCH_INPUT_COUNT];
+    static Vector3 arms[BENCH_INPUT_COUNT];
+    float extent = BENCH_MESH_GRID * BENCH_MESH_SPACING;
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        float x = bench_randomFloat(400.0f, extent - 400.0f);
+        float y = bench_randomFloat(400.0f, extent - 400.0f);
+        Vector3 pivot = {x, y, bench_meshTerrainHeight(x, y) + bench_randomFloat(40.0f, 150.0f)};
+        spheres[i] = (Capsule){pivot, pivot, BENCH_MESH_CAST_RADIUS, 0.0f};
+
+        Vector3 direction = bench_randomUnitVector3();
+        direction.z = -fabsf(direction.z);
+        arms[i] = vector3_returnScaled(&direction, bench_randomFloat(100.0f, 400.0f));
+    }
+
+    int sampled_hits = 0;
+    int missed = 0;
+    int late = 0;
+    int early = 0;
+
+    for (int i = 0; i < BENCH_MESH_CHECKED_QUERIES; i++) {
+
+        ContactData contact;
+        int first_sample = -1;
+        for (int s = 0; s <= BENCH_MESH_CAST_SAMPLES && first_sample < 0; s++) {
+            Capsule moved = spheres[i];
+            vector3_addScaledVector(&moved.start, &arms[i], (float)s / BENCH_MESH_CAST_SAMPLES);
+            moved.end = moved.start;
+            if (capsule_collisionTestMesh(&contact, &moved, mesh)) first_sample = s;
+        }
+
+        float time;
+        bool hit = capsule_sweepMesh(&contact, &time, &spheres[i], &arms[i], mesh);
+
+        if (first_sample >= 0) {
+            sampled_hits++;
+            if (!hit) missed++;
+            else if (time > (float)first_sample / BENCH_MESH_CAST_SAMPLES + 1e-4f) late++;
+        }
+
+        if (hit) {
+            Capsule touching = spheres[i];
+            vector3_addScaledVector(&touching.start, &arms[i], time);
+            touching.end = touching.start;
+            touching.radius += BENCH_MESH_CAST_TOLERANCE;
+            if (!capsule_collisionTestMesh(&contact, &touching, mesh)) early++;
+        }
+    }
+
+    bench_report(bench, "cast_mesh_sampled_hits", sampled_hits, "count");
+    bench_check(bench, "cast_mesh_no_missed_contact", missed == 0 && sampled_hits > 0);
+    bench_check(bench, "cast_mesh_not_after_first_contact", late == 0);
+    bench_check(bench, "cast_mesh_touching_at_time", early == 0);
+
+    ContactData contact;
+    float time;
+    BENCH_TIME(bench, "cast_capsule_sweepMesh", sink += capsule_sweepMesh(&contact, &time, &spheres[k], &arms[k], mesh); sink += time);
+
+    bench_meshCastHeightfield(bench, spheres, arms);
+}
+
+/* the same terrain sampled into a heightfield, and a mesh made of the triangles of its cells.
+the cast against the heightfield has to stop exactly where the cast against that mesh does */
+void bench_meshCastHeightfield(Bench* bench, const Capsule* spheres, const Vector3* arms)
+{
+    const int side = BENCH_MESH_GRID + 1;
+    int16_t* heights = malloc(side * side * sizeof(int16_t));
+    Vector3* vertices = malloc(side * side * sizeof(Vector3));
+    int* indices = malloc(6 * BENCH_MESH_GRID * BENCH_MESH_GRID * sizeof(int));
+    assert(heights != NULL && vertices != NULL && indices != NULL);
+
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            float height = bench_meshTerrainHeight(x * BENCH_MESH_SPACING, y * BENCH_MESH_SPACING);
+            heights[y * side + x] = (int16_t)lroundf(height / BENCH_MESH_HEIGHT_SCALE);
+        }
+    }
+
+    Heightfield heightfield;
+    heightfield_init(&heightfield, heights, side, side, BENCH_MESH_SPACING, BENCH_MESH_HEIGHT_SCALE, &(Vector3){0.0f, 0.0f, 0.0f});
+
+    // The cells split along the same diagonal as heightfield_getCellTriangles
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) vertices[y * side + x] = heightfield_getSamplePoint(&heightfield, x, y);
+    }
+
+    int triangle_count = 0;
+    for (int y = 0; y < BENCH_MESH_GRID; y++) {
+        for (int x = 0; x < BENCH_MESH_GRID; x++) {
+            int corner = y * side + x;
+            int quad[6] = {corner, corner + 1, corner + side + 1, corner, corner + side + 1, corner + side};
+            memcpy(&indices[3 * triangle_count], quad, sizeof(quad));
+            triangle_count += 2;
+        }
+    }
+
+    TriangleMesh mesh;
+    triangleMesh_init(&mesh, vertices, indices, triangle_count);
+
+    int hits = 0;
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        ContactData expected, contact;
+        float expected_time, time;
+        bool expected_hit = capsule_sweepMesh(&expected, &expected_time, &spheres[i], &arms[i], &mesh);
+        bool hit = capsule_sweepHeightfield(&contact, &time, &spheres[i], &arms[i], &heightfield);
+        if (hit != expected_hit || (hit && fabsf(time - expected_time) > 1e-5f)) mismatches++;
+        hits += hit;
+    }
+
+    bench_report(bench, "cast_heightfield_hits", hits, "count");
+    bench_check(bench, "cast_heightfield_matches_mesh", mismatches == 0 && hits > 0);
+
+    ContactData contact;
+    float time;
+    BENCH_TIME(bench, "cast_capsule_sweepHeightfield", sink += capsule_sweepHeightfield(&contact, &time, &spheres[k], &arms[k], &heightfield); sink += time);
+
+    triangleMesh_delete(&mesh);
+    free(heights);
+    free(vertices);
+    free(indices);
+}
+
+/* the room of the scene, its floor is at z 0 */
+void bench_meshGround(Bench* bench)
+{
+    TriangleMeshData data;
+    if (!bench_check(bench, "ground_glb_loaded", triangleMeshData_loadGlb(&data, BENCH_ASSET_DIR "/ground.glb"))) return;
+
+    TriangleMesh mesh;
+    triangleMesh_init(&mesh, data.vertices, data.indices, data.triangle_count);
+    bench_report(bench, "ground_triangles", data.triangle_count, "count");
+
+    ContactData contact;
+    Capsule capsule = {.radius = 20.0f, .length = 120.0f};
+
+    capsule_setVertical(&capsule, &(Vector3){100.0f, -200.0f, -5.0f});
+    bool standing = capsule_collisionTestMesh(&contact, &capsule, &mesh);
+    bench_check(bench, "ground_floor_contact", standing && contact.normal.z > 0.99f && fabsf(contact.penetration - 5.0f) < 0.01f);
+
+    capsule_setVertical(&capsule, &(Vector3){100.0f, -200.0f, 50.0f});
+    bench_check(bench, "ground_no_contact_above_floor", !capsule_collisionTestMesh(&contact, &capsule, &mesh));
+
+    // The camera of the scene cast straight down at the floor stops a radius above it
+    Vector3 pivot = {100.0f, -200.0f, 100.0f};
+    Capsule sphere = {pivot, pivot, BENCH_MESH_CAST_RADIUS, 0.0f};
+    Vector3 arm = {0.0f, 0.0f, -200.0f};
+    float time;
+    bool cast_hit = capsule_sweepMesh(&contact, &time, &sphere, &arm, &mesh);
+    bench_check(bench, "ground_cast_stops_above_floor", cast_hit && fabsf(pivot.z + time * arm.z - BENCH_MESH_CAST_RADIUS) < 2.0f * CAPSULE_SWEEP_TOLERANCE);
+
+    static Capsule capsules[BENCH_INPUT_COUNT];
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        Vector3 position = bench_randomVector3(-3100.0f, 3100.0f);
+        position.z = bench_randomFloat(-50.0f, 6000.0f);
+        capsules[i] = (Capsule){.radius = 20.0f, .length = 120.0f};
+        capsule_setVertical(&capsules[i], &position);
+    }
+    BENCH_TIME(bench, "ground_capsule_collisionTestMesh", sink += capsule_collisionTestMesh(&contact, &capsules[k], &mesh); sink += contact.penetration);
+
+    triangleMesh_delete(&mesh);
+    triangleMeshData_delete(&data);
+}
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef BENCH_RAYCAST_H
+#define BENCH_RAYCAST_H
+
+/* BENCH_RAYCAST.H
+the batched raycasts of a frame worth of rays against groups of boxes, spheres and capsules scattered in a room.
+every ray is checked against a march along it in small steps: a ray can't miss a shape the march goes into or stop
+after it, and its hit has to be on the surface of the shape it names with the normal of that surface.
+the box and sphere batches have to find the nearest hit of the scalar raycasts, at the same distance with the same normal.
+then the rays per second of each batch, of the three in turn and of the scalar box and sphere raycasts */
+
+#define BENCH_RAYCAST_RAYS 64
+#define BENCH_RAYCAST_SHAPES 32             // of each kind
+#define BENCH_RAYCAST_ROOM 120.0f           // half size of the room the rays and shapes are in
+#define BENCH_RAYCAST_REACH 400.0f
+#define BENCH_RAYCAST_MARCH_STEP 0.05f
+#define BENCH_RAYCAST_SURFACE_TOLERANCE 1e-4f  // of the hit distance, the precision of floats a few hundred units out
+#define BENCH_RAYCAST_NORMAL_TOLERANCE 0.99f
+#define BENCH_RAYCAST_SCALAR_TOLERANCE 1e-3f   // of the hit distance, the scalar sphere raycast loses digits far out
+
+
+// structures
+
+typedef struct {
+    AABB aabbs[BENCH_RAYCAST_SHAPES];
+    Sphere spheres[BENCH_RAYCAST_SHAPES];
+    Capsule capsules[BENCH_RAYCAST_SHAPES];
+    AABBBatch aabb_batch;
+    SphereBatch sphere_batch;
+    CapsuleBatch capsule_batch;
+} BenchRaycastScene;
+
+
+// function prototypes
+
+void bench_raycast(Bench* bench);
+float bench_raycastSignedDistance(const BenchRaycastScene* scene, int shape, const Vector3* point, Vector3* normal);
+float bench_raycastMarch(const BenchRaycastScene* scene, const Ray* ray);
+void bench_raycastAll(const RayBatch* rays, const BenchRaycastScene* scene, float* distances, Vector3* normals, int* shapes);
+float bench_raycastScalarAABB(const Ray* ray, const AABB* aabbs, Vector3* normal);
+float bench_raycastScalarSphere(const Ray* ray, const Sphere* spheres, Vector3* normal);
+float bench_raycastScalarAABBs(const Ray* rays, const AABB* aabbs);
+float bench_raycastScalarSpheres(const Ray* rays, const Sphere* spheres);
+int bench_raycastCompareScalar(const BenchRaycastScene* scene, int kind, const Ray* rays, const float* distances, const Vector3* normals, const int* shapes);
+
+
+// function implementations
+
+/* signed distance from "point" to shape "shape" of the scene, numbered like the hits, and the surface normal there */
+float bench_raycastSignedDistance(const BenchRaycastScene* scene, int shape, const Vector3* point, Vector3* normal)
+{
+    int kind = shape / BENCH_RAYCAST_SHAPES;
+    int index = shape % BENCH_RAYCAST_SHAPES;
+
+    if (kind == 0) {
+        const AABB* aabb = &scene->aabbs[index];
+        Vector3 closest = aabb_closestToPoint(aabb, point);
+        Vector3 outside = vector3_difference(point, &closest);
+        float distance = vector3_magnitude(&outside);
+
+        // Inside or on the box, the nearest face
+        Vector3 to_min = vector3_difference(point, &aabb->minCoordinates);
+        Vector3 to_max = vector3_difference(&aabb->maxCoordinates, point);
+        float faces[6] = {to_min.x, to_max.x, to_min.y, to_max.y, to_min.z, to_max.z};
+        int face = 0;
+        for (int i = 1; i < 6; i++) if (faces[i] < faces[face]) face = i;
+        *normal = (Vector3){0.0f, 0.0f, 0.0f};
+        vector3_setElement(normal, face / 2, (face % 2) ? 1.0f : -1.0f);
+
+        return (distance > 0.0f) ? distance : -faces[face];
+    }
+
+    Vector3 center = (kind == 1) ? scene->spheres[index].center
+        : segment_closestToPoint(&scene->capsules[index].start, &scene->capsules[index].end, point);
+    float radius = (kind == 1) ? scene->spheres[index].radius : scene->capsules[index].radius;
+
+    *normal = vector3_difference(point, &center);
+    float distance = vector3_magnitude(normal);
+    if (distance > 0.0f) vector3_divideByNumber(normal, distance);
+    return distance - radius;
+}
+
+/* distance to the first sample of the ray inside a shape it doesn't start in, -1 if there is none */
+float bench_raycastMarch(const BenchRaycastScene* scene, const Ray* ray)
+{
+    bool starts_inside[3 * BENCH_RAYCAST_SHAPES];
+    Vector3 normal;
+    for (int shape = 0; shape < 3 * BENCH_RAYCAST_SHAPES; shape++) {
+        starts_inside[shape] = bench_raycastSignedDistance(scene, shape, &ray->origin, &normal) < 0.0f;
+    }
+
+    for (int step = 0; step * BENCH_RAYCAST_MARCH_STEP <= BENCH_RAYCAST_REACH; step++) {
+        float t = step * BENCH_RAYCAST_MARCH_STEP;
+        Vector3 point = ray->origin;
+        vector3_addScaledVector(&point, &ray->direction, t);
+        for (int shape = 0; shape < 3 * BENCH_RAYCAST_SHAPES; shape++) {
+            if (!starts_inside[shape] && bench_raycastSignedDistance(scene, shape, &point, &normal) < 0.0f) return t;
+        }
+    }
+    return -1.0f;
+}
+
+/* the three batches in turn, the nearest hit over all of them */
+void bench_raycastAll(const RayBatch* rays, const BenchRaycastScene* scene, float* distances, Vector3* normals, int* shapes)
+{
+    rayBatch_resetHits(rays, distances, shapes, BENCH_RAYCAST_REACH);
+    rayBatch_raycastAABBs(rays, &scene->aabb_batch, 0, distances, normals, shapes);
+    rayBatch_raycastSpheres(rays, &scene->sphere_batch, BENCH_RAYCAST_SHAPES, distances, normals, shapes);
+    rayBatch_raycastCapsules(rays, &scene->capsule_batch, 2 * BENCH_RAYCAST_SHAPES, distances, normals, shapes);
+}
+
+/* nearest hit of one ray with the scalar functions, BENCH_RAYCAST_REACH when there is none.
+they test the whole line and give 0 from inside a box, the batches only take hits ahead of a ray from outside the shape */
+float bench_raycastScalarAABB(const Ray* ray, const AABB* aabbs, Vector3* normal)
+{
+    float nearest = BENCH_RAYCAST_REACH;
+    for (int j = 0; j < BENCH_RAYCAST_SHAPES; j++) {
+        if (!ray_intersectionAABB(ray, &aabbs[j])) continue;
+        ContactData contact;
+        raycast_aabb(&contact, ray, &aabbs[j]);
+        Vector3 offset = vector3_difference(&contact.point, &ray->origin);
+        float distance = vector3_returnDotProduct(&offset, &ray->direction);
+        if (distance <= 0.0f || distance >= nearest) continue;
+        nearest = distance;
+        *normal = contact.normal;
+    }
+    return nearest;
+}
+
+float bench_raycastScalarSphere(const Ray* ray, const Sphere* spheres, Vector3* normal)
+{
+    float nearest = BENCH_RAYCAST_REACH;
+    for (int j = 0; j < BENCH_RAYCAST_SHAPES; j++) {
+        if (!ray_intersectionSphere(ray, &spheres[j])) continue;
+        ContactData contact;
+        raycast_sphere(&contact, ray, &spheres[j]);
+        Vector3 offset = vector3_difference(&contact.point, &ray->origin);
+        float distance = vector3_returnDotProduct(&offset, &ray->direction);
+        if (distance <= 0.0f || distance >= nearest) continue;
+        nearest = distance;
+        *normal = contact.normal;
+    }
+    return nearest;
+}
+
+/* one ray at a time with the scalar functions, returns the sum of the nearest distances */
+float bench_raycastScalarAABBs(const Ray* rays, const AABB* aabbs)
+{
+    float sum = 0.0f;
+    Vector3 normal;
+    for (int i = 0; i < BENCH_RAYCAST_RAYS; i++) sum += bench_raycastScalarAABB(&rays[i], aabbs, &normal);
+    return sum;
+}
+
+float bench_raycastScalarSpheres(const Ray* rays, const Sphere* spheres)
+{
+    float sum = 0.0f;
+    Vector3 normal;
+    for (int i = 0; i < BENCH_RAYCAST_RAYS; i++) sum += bench_raycastScalarSphere(&rays[i], spheres, &normal);
+    return sum;
+}
+
+/* rays whose hit in the batch of "kind", 0 boxes and 1 spheres, isn't the nearest scalar hit in distance and normal */
+int bench_raycastCompareScalar(const BenchRaycastScene* scene, int kind, const Ray* rays, const float* distances, const Vector3* normals, const int* shapes)
+{
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_RAYCAST_RAYS; i++) {
+
+        Vector3 normal;
+        float nearest = (kind == 0) ? bench_raycastScalarAABB(&rays[i], scene->aabbs, &normal) : bench_raycastScalarSphere(&rays[i], scene->spheres, &normal);
+        if (shapes[i] < 0) {
+            if (nearest < BENCH_RAYCAST_REACH) mismatches++;
+            continue;
+        }
+
+        float tolerance = BENCH_RAYCAST_SCALAR_TOLERANCE * fmaxf(1.0f, nearest);
+        if (fabsf(nearest - distances[i]) > tolerance || vector3_returnDotProduct(&normal, &normals[i]) < BENCH_RAYCAST_NORMAL_TOLERANCE) mismatches++;
+    }
+    return mismatches;
+}
+
+void bench_raycast(Bench* bench)
+{
+    static BenchRaycastScene scene;
+    aabbBatch_init(&scene.aabb_batch, BENCH_RAYCAST_SHAPES);
+    sphereBatch_init(&scene.sphere_batch, BENCH_RAYCAST_SHAPES);
+    capsuleBatch_init(&scene.capsule_batch, BENCH_RAYCAST_SHAPES);
+
+    for (int i = 0; i < BENCH_RAYCAST_SHAPES; i++) {
+
+        Vector3 center = bench_randomVector3(-BENCH_RAYCAST_ROOM, BENCH_RAYCAST_ROOM);
+        Vector3 size = bench_randomVector3(10.0f, 60.0f);
+        aabb_setFromCenterAndSize(&scene.aabbs[i], &center, &size);
+        aabbBatch_add(&scene.aabb_batch, &scene.aabbs[i]);
+
+        scene.spheres[i] = (Sphere){bench_randomVector3(-BENCH_RAYCAST_ROOM, BENCH_RAYCAST_ROOM), bench_randomFloat(5.0f, 30.0f)};
+        sphereBatch_add(&scene.sphere_batch, &scene.spheres[i]);
+
+        Vector3 axis = bench_randomUnitVector3();
+        Capsule* capsule = &scene.capsules[i];
+        capsule->radius = bench_randomFloat(5.0f, 20.0f);
+        capsule->start = bench_randomVector3(-BENCH_RAYCAST_ROOM, BENCH_RAYCAST_ROOM);
+        capsule->end = capsule->start;
+        vector3_addScaledVector(&capsule->end, &axis, bench_randomFloat(10.0f, 80.0f));
+        Vector3 segment = vector3_difference(&capsule->end, &capsule->start);
+        capsule->length = vector3_magnitude(&segment) + 2.0f * capsule->radius;
+        capsuleBatch_add(&scene.capsule_batch, capsule);
+    }
+
+    // Ground probes straight down, the rest any way
+    static Ray rays[BENCH_RAYCAST_RAYS];
+    RayBatch batch;
+    rayBatch_init(&batch, BENCH_RAYCAST_RAYS);
+    for (int i = 0; i < BENCH_RAYCAST_RAYS; i++) {
+        rays[i].origin = bench_randomVector3(-BENCH_RAYCAST_ROOM, BENCH_RAYCAST_ROOM);
+        rays[i].direction = (i % 4 == 0) ? (Vector3){0.0f, 0.0f, -1.0f} : bench_randomUnitVector3();
+        rayBatch_add(&batch, &rays[i]);
+    }
+
+    float distances[BENCH_RAYCAST_RAYS];
+    Vector3 normals[BENCH_RAYCAST_RAYS];
+    int shapes[BENCH_RAYCAST_RAYS];
+    bench_raycastAll(&batch, &scene, distances, normals, shapes);
+
+    int hits = 0;
+    int missed = 0;
+    int off_surface = 0;
+    int wrong_normals = 0;
+
+    for (int i = 0; i < BENCH_RAYCAST_RAYS; i++) {
+
+        // A grazing hit can fall between the samples, so only a late or missing hit against the march fails
+        float marched = bench_raycastMarch(&scene, &rays[i]);
+        float tolerance = BENCH_RAYCAST_SURFACE_TOLERANCE * fmaxf(1.0f, fmaxf(marched, distances[i]));
+        if (marched >= 0.0f && (shapes[i] < 0 || distances[i] > marched + tolerance)) missed++;
+        if (shapes[i] < 0) continue;
+        hits++;
+
+        Vector3 point = rays[i].origin;
+        vector3_addScaledVector(&point, &rays[i].direction, distances[i]);
+        Vector3 normal;
+        float distance = bench_raycastSignedDistance(&scene, shapes[i], &point, &normal);
+        if (fabsf(distance) > tolerance) off_surface++;
+        if (vector3_returnDotProduct(&normal, &normals[i]) < BENCH_RAYCAST_NORMAL_TOLERANCE) wrong_normals++;
+    }
+
+    bench_report(bench, "hits", hits, "count");
+    bench_check(bench, "no_missed_or_late_hit", missed == 0);
+    bench_check(bench, "hit_on_named_shape", off_surface == 0);
+    bench_check(bench, "hit_normal", wrong_normals == 0);
+
+    rayBatch_resetHits(&batch, distances, shapes, BENCH_RAYCAST_REACH);
+    rayBatch_raycastAABBs(&batch, &scene.aabb_batch, 0, distances, normals, shapes);
+    bench_check(bench, "batch_aabbs_match_scalar", bench_raycastCompareScalar(&scene, 0, rays, distances, normals, shapes) == 0);
+
+    rayBatch_resetHits(&batch, distances, shapes, BENCH_RAYCAST_REACH);
+    rayBatch_raycastSpheres(&batch, &scene.sphere_batch, 0, distances, normals, shapes);
+    bench_check(bench, "batch_spheres_match_scalar", bench_raycastCompareScalar(&scene, 1, rays, distances, normals, shapes) == 0);
+
+    BENCH_TIME_FROM(bench, "batch_aabbs", 1,
+        rayBatch_resetHits(&batch, distances, shapes, BENCH_RAYCAST_REACH);
+        rayBatch_raycastAABBs(&batch, &scene.aabb_batch, 0, distances, normals, shapes);
+        sink += distances[k % BENCH_RAYCAST_RAYS]);
+    bench_report(bench, "rays_per_s_batch_aabbs", 1e9 * BENCH_RAYCAST_RAYS / bench->last_ns, "1/s");
+
+    BENCH_TIME_FROM(bench, "batch_spheres", 1,
+        rayBatch_resetHits(&batch, distances, shapes, BENCH_RAYCAST_REACH);
+        rayBatch_raycastSpheres(&batch, &scene.sphere_batch, 0, distances, normals, shapes);
+        sink += distances[k % BENCH_RAYCAST_RAYS]);
+    bench_report(bench, "rays_per_s_batch_spheres", 1e9 * BENCH_RAYCAST_RAYS / bench->last_ns, "1/s");
+
+    BENCH_TIME_FROM(bench, "batch_capsules", 1,
+        rayBatch_resetHits(&batch, distances, shapes, BENCH_RAYCAST_REACH);
+        rayBatch_raycastCapsules(&batch, &scene.capsule_batch, 0, distances, normals, shapes);
+        sink += distances[k % BENCH_RAYCAST_RAYS]);
+    bench_report(bench, "rays_per_s_batch_capsules", 1e9 * BENCH_RAYCAST_RAYS / bench->last_ns, "1/s");
+
+    BENCH_TIME_FROM(bench, "batch_all", 1, bench_raycastAll(&batch, &scene, distances, normals, shapes); sink += distances[k % BENCH_RAYCAST_RAYS]);
+    bench_report(bench, "rays_per_s_batch_all", 1e9 * BENCH_RAYCAST_RAYS / bench->last_ns, "1/s");
+
+    BENCH_TIME_FROM(bench, "scalar_aabbs", 1, sink += bench_raycastScalarAABBs(rays, scene.aabbs));
+    bench_report(bench, "rays_per_s_scalar_aabbs", 1e9 * BENCH_RAYCAST_RAYS / bench->last_ns, "1/s");
+
+    BENCH_TIME_FROM(bench, "scalar_spheres", 1, sink += bench_raycastScalarSpheres(rays, scene.spheres));
+    bench_report(bench, "rays_per_s_scalar_spheres", 1e9 * BENCH_RAYCAST_RAYS / bench->last_ns, "1/s");
+
+    rayBatch_delete(&batch);
+    aabbBatch_delete(&scene.aabb_batch);
+    sphereBatch_delete(&scene.sphere_batch);
+    capsuleBatch_delete(&scene.capsule_batch);
+}
+
+#endif
@@ -0,0 +1,471 @@
+#ifndef BENCH_SHAPES_H
+#define BENCH_SHAPES_H
+
+/* BENCH_SHAPES.H
+ns per call of every shape pair function of the collision shapes, over random shapes
+placed in a small volume so roughly half of the pairs touch. the fused collisionTest of every pair that
+also has a contact test and a SetData pass has to agree with the two passes on every input, and the batched
+capsule test has to give the contacts of the scalar one over every pair of a group. the sword and shield compound
+of an actor in random poses has to give the deepest contact of its two parts placed by hand */
+
+#define BENCH_SHAPES_HEIGHTFIELD_SIZE 64
+#define BENCH_SHAPES_FUSED_TOLERANCE 1e-4f
+#define BENCH_SHAPES_CAPSULE_GROUP 64
+#define BENCH_SHAPES_PARTS_REACH 90.0f      // half size of the cube the targets of the sword and shield are in
+#define BENCH_SHAPES_DEEP_MARGIN 2e-3f      // sqrt(TOLERANCE) and some, the closest points meet from there on
+
+/* the two passes and the fused test of one pair over every input, counts the inputs where the hit or the contact differ.
+the older SetData passes of aabbs and spheres leave the depth alone. on "deep" inputs the closest points meet, or for
+two aabbs one nests the other on an axis, and the two passes have no direction, the fused test only has to push out there */
+#define BENCH_SHAPES_FUSED(bench, name, contact_test, set_data, collision_test, deep) do { \
+    int mismatches = 0; \
+    for (int k = 0; k < BENCH_INPUT_COUNT; k++) { \
+        ContactData expected, fused; \
+        bool expected_hit = (contact_test); \
+        expected.penetration = NAN; \
+        if (expected_hit) set_data; \
+        bool hit = (collision_test); \
+        if (hit != expected_hit) mismatches++; \
+        else if (hit && (deep)) mismatches += !bench_shapesPushesOut(&fused); \
+        else if (hit) mismatches += !bench_shapesSameContact(&expected, &fused); \
+    } \
+    bench_check(bench, name, mismatches == 0); \
+} while (0)
+
+
+// function prototypes
+
+void bench_shapes(Bench* bench);
+void bench_shapesCapsulePlane(Bench* bench);
+void bench_shapesCapsuleBatch(Bench* bench, const Capsule* capsules);
+int bench_shapesCapsuleGroup(const Capsule* capsules, int index, ContactData* contacts, int* indices);
+void bench_shapesCompound(Bench* bench);
+bool bench_shapesTestParts(ContactData* contact, const Collider* parts, int part_count, const Collider* target);
+bool bench_shapesSameContact(const ContactData* expected, const ContactData* fused);
+bool bench_shapesPushesOut(const ContactData* contact);
+bool bench_shapesNested(const AABB* a, const AABB* b);
+void bench_shapesBoxOrientation(Bench* bench, const Box* boxes, const Vector3* points);
+Sphere bench_randomSphere();
+AABB bench_randomAABB();
+Box bench_randomBox();
+Capsule bench_randomCapsule();
+Plane bench_randomPlane();
+Ray bench_randomRay();
+Triangle bench_randomTriangle();
+
+
+// function implementations
+
+bool bench_shapesSameContact(const ContactData* expected, const ContactData* fused)
+{
+    Vector3 point_difference = vector3_difference(&expected->point, &fused->point);
+    Vector3 normal_difference = vector3_difference(&expected->normal, &fused->normal);
+    bool same_depth = isnan(expected->penetration) || fabsf(expected->penetration - fused->penetration) < BENCH_SHAPES_FUSED_TOLERANCE;
+    return same_depth
+        && vector3_magnitude(&point_difference) < BENCH_SHAPES_FUSED_TOLERANCE
+        && vector3_magnitude(&normal_difference) < BENCH_SHAPES_FUSED_TOLERANCE;
+}
+
+bool bench_shapesPushesOut(const ContactData* contact)
+{
+    return contact->penetration > 0.0f && fabsf(vector3_magnitude(&contact->normal) - 1.0f) < BENCH_SHAPES_FUSED_TOLERANCE;
+}
+
+/* one box spans the other on some axis, the overlap there is less than the push out */
+bool bench_shapesNested(const AABB* a, const AABB* b)
+{
+    for (int i = 0; i < 3; i++) {
+        float a_min = vector3_returnElement(&a->minCoordinates, i), a_max = vector3_returnElement(&a->maxCoordinates, i);
+        float b_min = vector3_returnElement(&b->minCoordinates, i), b_max = vector3_returnElement(&b->maxCoordinates, i);
+        if ((a_min <= b_min && a_max >= b_max) || (b_min <= a_min && b_max >= a_max)) return true;
+    }
+    return false;
+}
+
+Sphere bench_randomSphere()
+{
+    Vector3 center = bench_randomVector3(-3.0f, 3.0f);
+    float radius = bench_randomFloat(0.5f, 1.5f);
+    return (Sphere){center, radius};
+}
+
+AABB bench_randomAABB()
+{
+    AABB aabb;
+    Vector3 center = bench_randomVector3(-3.0f, 3.0f);
+    Vector3 size = bench_randomVector3(0.5f, 3.0f);
+    aabb_setFromCenterAndSize(&aabb, &center, &size);
+    return aabb;
+}
+
+Box bench_randomBox()
+{
+    Box box;
+    Vector3 size = bench_randomVector3(0.5f, 3.0f);
+    Vector3 center = bench_randomVector3(-3.0f, 3.0f);
+    Vector3 rotation = bench_randomVector3(-180.0f, 180.0f);
+    box_init(&box, &size, &center, &rotation);
+    return box;
+}
+
+Capsule bench_randomCapsule()
+{
+    Capsule capsule;
+    Vector3 axis = bench_randomUnitVector3();
+    float segment_length = bench_randomFloat(0.5f, 2.0f);
+    capsule.radius = bench_randomFloat(0.3f, 1.0f);
+    capsule.length = segment_length + 2.0f * capsule.radius;
+    capsule.start = bench_randomVector3(-3.0f, 3.0f);
+    capsule.end = capsule.start;
+    vector3_addScaledVector(&capsule.end, &axis, segment_length);
+    return capsule;
+}
+
+Plane bench_randomPlane()
+{
+    Plane plane;
+    Vector3 normal = bench_randomUnitVector3();
+    Vector3 point = bench_randomVector3(-2.0f, 2.0f);
+    plane_setFromNormalAndPoint(&plane, &normal, &point);
+    return plane;
+}
+
+/* from far away towards the volume of the shapes */
+Ray bench_randomRay()
+{
+    Vector3 origin = bench_randomVector3(-10.0f, 10.0f);
+    Vector3 target = bench_randomVector3(-2.0f, 2.0f);
+    Vector3 direction = vector3_difference(&target, &origin);
+    vector3_normalize(&direction);
+    return (Ray){origin, direction};
+}
+
+Triangle bench_randomTriangle()
+{
+    Vector3 center = bench_randomVector3(-3.0f, 3.0f);
+    Triangle triangle = {bench_randomVector3(-1.5f, 1.5f), bench_randomVector3(-1.5f, 1.5f), bench_randomVector3(-1.5f, 1.5f)};
+    vector3_add(&triangle.a, &center);
+    vector3_add(&triangle.b, &center);
+    vector3_add(&triangle.c, &center);
+    return triangle;
+}
+
+void bench_shapes(Bench* bench)
+{
+    static Sphere spheres[BENCH_INPUT_COUNT], other_spheres[BENCH_INPUT_COUNT];
+    static AABB aabbs[BENCH_INPUT_COUNT], other_aabbs[BENCH_INPUT_COUNT];
+    static Box boxes[BENCH_INPUT_COUNT];
+    static Capsule capsules[BENCH_INPUT_COUNT], other_capsules[BENCH_INPUT_COUNT], terrain_capsules[BENCH_INPUT_COUNT];
+    static Plane planes[BENCH_INPUT_COUNT];
+    static Ray rays[BENCH_INPUT_COUNT];
+    static Triangle triangles[BENCH_INPUT_COUNT];
+    static Vector3 points[BENCH_INPUT_COUNT], other_points[BENCH_INPUT_COUNT], displacements[BENCH_INPUT_COUNT];
+    static int16_t heights[BENCH_SHAPES_HEIGHTFIELD_SIZE * BENCH_SHAPES_HEIGHTFIELD_SIZE];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        spheres[i] = bench_randomSphere();
+        other_spheres[i] = bench_randomSphere();
+        aabbs[i] = bench_randomAABB();
+        other_aabbs[i] = bench_randomAABB();
+        boxes[i] = bench_randomBox();
+        capsules[i] = bench_randomCapsule();
+        other_capsules[i] = bench_randomCapsule();
+        planes[i] = bench_randomPlane();
+        rays[i] = bench_randomRay();
+        triangles[i] = bench_randomTriangle();
+        points[i] = bench_randomVector3(-4.0f, 4.0f);
+        other_points[i] = bench_randomVector3(-4.0f, 4.0f);
+        displacements[i] = bench_randomVector3(-5.0f, 5.0f);
+
+        // Vertical capsules standing around the surface of the terrain
+        Vector3 position = {bench_randomFloat(0.0f, 63.0f), bench_randomFloat(0.0f, 63.0f), bench_randomFloat(-1.0f, 3.0f)};
+        terrain_capsules[i] = (Capsule){.radius = 0.5f, .length = 2.0f};
+        capsule_setVertical(&terrain_capsules[i], &position);
+    }
+
+    for (int i = 0; i < BENCH_SHAPES_HEIGHTFIELD_SIZE * BENCH_SHAPES_HEIGHTFIELD_SIZE; i++) heights[i] = (int16_t)(bench_random() % 200);
+    Heightfield heightfield;
+    heightfield_init(&heightfield, heights, BENCH_SHAPES_HEIGHTFIELD_SIZE, BENCH_SHAPES_HEIGHTFIELD_SIZE, 1.0f, 0.01f, &(Vector3){0.0f, 0.0f, 0.0f});
+
+    ContactData contact;
+    float time;
+
+    // sphere.h
+
+    BENCH_TIME(bench, "sphere_contactSphere", sink += sphere_contactSphere(&spheres[k], &other_spheres[k]));
+    BENCH_TIME(bench, "sphere_collisionTestSphere", sink += sphere_collisionTestSphere(&contact, &spheres[k], &other_spheres[k]); sink += contact.penetration);
+
+    // AABB.h
+
+    BENCH_TIME(bench, "aabb_closestToPoint", sink += aabb_closestToPoint(&aabbs[k], &points[k]).x);
+    BENCH_TIME(bench, "aabb_closestToSegment", sink += aabb_closestToSegment(&aabbs[k], &points[k], &other_points[k]).x);
+    BENCH_TIME(bench, "aabb_contactAABB", sink += aabb_contactAABB(&aabbs[k], &other_aabbs[k]));
+    BENCH_TIME(bench, "aabb_contactAABBsetData", aabb_contactAABBsetData(&contact, &aabbs[k], &other_aabbs[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "aabb_contactSphere", sink += aabb_contactSphere(&aabbs[k], &spheres[k]));
+    BENCH_TIME(bench, "aabb_contactSphereSetData", aabb_contactSphereSetData(&contact, &aabbs[k], &spheres[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "aabb_collisionTestAABB", sink += aabb_collisionTestAABB(&contact, &aabbs[k], &other_aabbs[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "aabb_collisionTestSphere", sink += aabb_collisionTestSphere(&contact, &aabbs[k], &spheres[k]); sink += contact.penetration);
+
+    // box.h
+
+    BENCH_TIME(bench, "box_contactSphere", sink += box_contactSphere(&boxes[k], &spheres[k]));
+    BENCH_TIME(bench, "box_contactSphereSetData", box_contactSphereSetData(&contact, &boxes[k], &spheres[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "box_collisionTestSphere", sink += box_collisionTestSphere(&contact, &boxes[k], &spheres[k]); sink += contact.penetration);
+    bench_shapesBoxOrientation(bench, boxes, points);
+
+    // plane.h
+
+    BENCH_TIME(bench, "plane_distanceToPoint", sink += plane_distanceToPoint(&planes[k], &points[k]));
+    BENCH_TIME(bench, "plane_collisionTestSphere", sink += plane_collisionTestSphere(&contact, &planes[k], &spheres[k]); sink += contact.penetration);
+
+    // ray.h
+
+    BENCH_TIME(bench, "ray_intersectionSphere", sink += ray_intersectionSphere(&rays[k], &spheres[k]));
+    BENCH_TIME(bench, "raycast_sphere", raycast_sphere(&contact, &rays[k], &spheres[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "ray_intersectionAABB", sink += ray_intersectionAABB(&rays[k], &aabbs[k]));
+    BENCH_TIME(bench, "raycast_aabb", raycast_aabb(&contact, &rays[k], &aabbs[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "ray_intersectionBox", sink += ray_intersectionBox(&rays[k], &boxes[k]));
+    BENCH_TIME(bench, "raycast_box", raycast_box(&contact, &rays[k], &boxes[k]); sink += contact.penetration);
+
+    // capsule.h
+
+    BENCH_TIME(bench, "capsule_contactSphere", sink += capsule_contactSphere(&capsules[k], &spheres[k]));
+    BENCH_TIME(bench, "capsule_contactSphereSetData", capsule_contactSphereSetData(&contact, &capsules[k], &spheres[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestSphere", sink += capsule_collisionTestSphere(&contact, &capsules[k], &spheres[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_contactAABB", sink += capsule_contactAABB(&capsules[k], &aabbs[k]));
+    BENCH_TIME(bench, "capsule_contactAABBSetData", capsule_contactAABBSetData(&contact, &capsules[k], &aabbs[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestAABB", sink += capsule_collisionTestAABB(&contact, &capsules[k], &aabbs[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_contactBox", sink += capsule_contactBox(&capsules[k], &boxes[k]));
+    BENCH_TIME(bench, "capsule_contactBoxSetData", capsule_contactBoxSetData(&contact, &capsules[k], &boxes[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestBox", sink += capsule_collisionTestBox(&contact, &capsules[k], &boxes[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_contactPlane", sink += capsule_contactPlane(&capsules[k], &planes[k]));
+    BENCH_TIME(bench, "capsule_contactPlaneSetData", capsule_contactPlaneSetData(&contact, &capsules[k], &planes[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestPlane", sink += capsule_collisionTestPlane(&contact, &capsules[k], &planes[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_contactCapsule", sink += capsule_contactCapsule(&capsules[k], &other_capsules[k]));
+    BENCH_TIME(bench, "capsule_contactCapsuleSetData", capsule_contactCapsuleSetData(&contact, &capsules[k], &other_capsules[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestCapsule", sink += capsule_collisionTestCapsule(&contact, &capsules[k], &other_capsules[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_sweepSphere", sink += capsule_sweepSphere(&contact, &time, &capsules[k], &displacements[k], &spheres[k]); sink += time);
+    BENCH_TIME(bench, "capsule_sweepAABB", sink += capsule_sweepAABB(&contact, &time, &capsules[k], &displacements[k], &aabbs[k]); sink += time);
+    BENCH_TIME(bench, "capsule_sweepBox", sink += capsule_sweepBox(&contact, &time, &capsules[k], &displacements[k], &boxes[k]); sink += time);
+    BENCH_TIME(bench, "capsule_sweepPlane", sink += capsule_sweepPlane(&contact, &time, &capsules[k], &displacements[k], &planes[k]); sink += time);
+    BENCH_TIME(bench, "capsule_intersectionRay", sink += capsule_intersectionRay(&capsules[k], &rays[k]));
+
+    // triangle.h
+
+    BENCH_TIME(bench, "triangle_closestToPoint", sink += triangle_closestToPoint(&triangles[k], &points[k]).x);
+    BENCH_TIME(bench, "capsule_closestToTriangle", sink += capsule_closestToTriangle(&capsules[k], &triangles[k]).x);
+    BENCH_TIME(bench, "capsule_contactTriangle", sink += capsule_contactTriangle(&capsules[k], &triangles[k]));
+    BENCH_TIME(bench, "capsule_contactTriangleSetData", capsule_contactTriangleSetData(&contact, &capsules[k], &triangles[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestTriangle", sink += capsule_collisionTestTriangle(&contact, &capsules[k], &triangles[k]); sink += contact.penetration);
+
+    // heightfield.h
+
+    BENCH_TIME(bench, "capsule_contactHeightfield", sink += capsule_contactHeightfield(&terrain_capsules[k], &heightfield));
+    BENCH_TIME(bench, "capsule_contactHeightfieldSetData", capsule_contactHeightfieldSetData(&contact, &terrain_capsules[k], &heightfield); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_collisionTestHeightfield", sink += capsule_collisionTestHeightfield(&contact, &terrain_capsules[k], &heightfield); sink += contact.penetration);
+
+    // Fused against two passes
+
+    BENCH_SHAPES_FUSED(bench, "aabb_aabb_fused_matches_two_pass", aabb_contactAABB(&aabbs[k], &other_aabbs[k]),
+        aabb_contactAABBsetData(&expected, &aabbs[k], &other_aabbs[k]), aabb_collisionTestAABB(&fused, &aabbs[k], &other_aabbs[k]), bench_shapesNested(&aabbs[k], &other_aabbs[k]));
+    BENCH_SHAPES_FUSED(bench, "aabb_sphere_fused_matches_two_pass", aabb_contactSphere(&aabbs[k], &spheres[k]),
+        aabb_contactSphereSetData(&expected, &aabbs[k], &spheres[k]), aabb_collisionTestSphere(&fused, &aabbs[k], &spheres[k]), fused.penetration >= spheres[k].radius - BENCH_SHAPES_DEEP_MARGIN);
+    BENCH_SHAPES_FUSED(bench, "box_sphere_fused_matches_two_pass", box_contactSphere(&boxes[k], &spheres[k]),
+        box_contactSphereSetData(&expected, &boxes[k], &spheres[k]), box_collisionTestSphere(&fused, &boxes[k], &spheres[k]), fused.penetration >= spheres[k].radius - BENCH_SHAPES_DEEP_MARGIN);
+    BENCH_SHAPES_FUSED(bench, "capsule_sphere_fused_matches_two_pass", capsule_contactSphere(&capsules[k], &spheres[k]),
+        capsule_contactSphereSetData(&expected, &capsules[k], &spheres[k]), capsule_collisionTestSphere(&fused, &capsules[k], &spheres[k]), false);
+    BENCH_SHAPES_FUSED(bench, "capsule_aabb_fused_matches_two_pass", capsule_contactAABB(&capsules[k], &aabbs[k]),
+        capsule_contactAABBSetData(&expected, &capsules[k], &aabbs[k]), capsule_collisionTestAABB(&fused, &capsules[k], &aabbs[k]), fused.penetration >= capsules[k].radius - BENCH_SHAPES_DEEP_MARGIN);
+    BENCH_SHAPES_FUSED(bench, "capsule_box_fused_matches_two_pass", capsule_contactBox(&capsules[k], &boxes[k]),
+        capsule_contactBoxSetData(&expected, &capsules[k], &boxes[k]), capsule_collisionTestBox(&fused, &capsules[k], &boxes[k]), fused.penetration >= capsules[k].radius - BENCH_SHAPES_DEEP_MARGIN);
+    BENCH_SHAPES_FUSED(bench, "capsule_plane_fused_matches_two_pass", capsule_contactPlane(&capsules[k], &planes[k]),
+        capsule_contactPlaneSetData(&expected, &capsules[k], &planes[k]), capsule_collisionTestPlane(&fused, &capsules[k], &planes[k]), false);
+    BENCH_SHAPES_FUSED(bench, "capsule_capsule_fused_matches_two_pass", capsule_contactCapsule(&capsules[k], &other_capsules[k]),
+        capsule_contactCapsuleSetData(&expected, &capsules[k], &other_capsules[k]), capsule_collisionTestCapsule(&fused, &capsules[k], &other_capsules[k]), false);
+    BENCH_SHAPES_FUSED(bench, "capsule_triangle_fused_matches_two_pass", capsule_contactTriangle(&capsules[k], &triangles[k]),
+        capsule_contactTriangleSetData(&expected, &capsules[k], &triangles[k]), capsule_collisionTestTriangle(&fused, &capsules[k], &triangles[k]), false);
+    BENCH_SHAPES_FUSED(bench, "capsule_heightfield_fused_matches_two_pass", capsule_contactHeightfield(&terrain_capsules[k], &heightfield),
+        capsule_contactHeightfieldSetData(&expected, &terrain_capsules[k], &heightfield), capsule_collisionTestHeightfield(&fused, &terrain_capsules[k], &heightfield), false);
+
+    BENCH_TIME(bench, "capsule_AABB_two_pass", if (capsule_contactAABB(&capsules[k], &aabbs[k])) capsule_contactAABBSetData(&contact, &capsules[k], &aabbs[k]); sink += contact.penetration);
+    BENCH_TIME(bench, "capsule_AABB_fused", sink += capsule_collisionTestAABB(&contact, &capsules[k], &aabbs[k]); sink += contact.penetration);
+
+    bench_shapesCapsulePlane(bench);
+    bench_shapesCapsuleBatch(bench, capsules);
+    bench_shapesCompound(bench);
+}
+
+/* deepest contact of "parts" against "target", as the compound keeps it. the table tests a compound pair
+target first and mirrors the normal, which leaves the point on the part */
+bool bench_shapesTestParts(ContactData* contact, const Collider* parts, int part_count, const Collider* target)
+{
+    bool hit = false;
+    for (int i = 0; i < part_count; i++) {
+        ContactData part_contact;
+        if (!collider_collisionTest(&part_contact, target, &parts[i])) continue;
+        if (!hit || part_contact.penetration > contact->penetration) *contact = part_contact;
+        hit = true;
+    }
+    if (hit) vector3_invert(&contact->normal);
+    return hit;
+}
+
+/* the parts compound of an actor with a sword and a shield against spheres around it */
+void bench_shapesCompound(Bench* bench)
+{
+    static Collider targets[BENCH_INPUT_COUNT];
+    static Vector3 positions[BENCH_INPUT_COUNT], rotations[BENCH_INPUT_COUNT];
+
+    ActorCollider collider = {.settings = {.body_radius = 20.0f, .body_height = 120.0f,
+        .sword_radius = 3.0f, .sword_length = 60.0f, .sword_offset = {15.0f, 10.0f, 60.0f},
+        .shield_radius = 15.0f, .shield_offset = {-15.0f, 30.0f, 40.0f}}};
+    actorCollider_init(&collider);
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        collider_init(&targets[i], SPHERE_A);
+        targets[i].sphere = (Sphere){bench_randomVector3(-BENCH_SHAPES_PARTS_REACH, BENCH_SHAPES_PARTS_REACH), bench_randomFloat(5.0f, 60.0f)};
+        positions[i] = bench_randomVector3(-20.0f, 20.0f);
+        rotations[i] = bench_randomVector3(-180.0f, 180.0f);
+    }
+
+    int hits = 0;
+    int mismatches = 0;
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+
+        actorCollider_set(&collider, &positions[i], &rotations[i]);
+        ContactData contact, expected;
+        bool hit = actorCollision_contactParts(&contact, &collider, &targets[i]);
+
+        // The same parts moved to the pose with the euler angles
+        Collider parts[ACTOR_COLLIDER_MAX_PARTS];
+        for (int j = 0; j < ACTOR_COLLIDER_MAX_PARTS; j++) parts[j] = collider.part_shapes[j];
+        point_transformToGlobalSpace(&parts[0].capsule.start, &positions[i], &rotations[i]);
+        point_transformToGlobalSpace(&parts[0].capsule.end, &positions[i], &rotations[i]);
+        point_transformToGlobalSpace(&parts[1].sphere.center, &positions[i], &rotations[i]);
+        bool expected_hit = bench_shapesTestParts(&expected, parts, ACTOR_COLLIDER_MAX_PARTS, &targets[i]);
+
+        hits += hit;
+        if (hit != expected_hit || (hit && !bench_shapesSameContact(&expected, &contact))) mismatches++;
+    }
+
+    bench_report(bench, "parts_hits", hits, "count");
+    bench_check(bench, "parts_compound_matches_parts", mismatches == 0 && hits > 0);
+
+    // One pose, the world parts are built once
+    actorCollider_set(&collider, &positions[0], &rotations[0]);
+    const Collider* world_parts = collider_getCompoundChildren(&collider.parts);
+    ContactData contact;
+    BENCH_TIME(bench, "parts_compound", sink += actorCollision_contactParts(&contact, &collider, &targets[k]));
+    BENCH_TIME(bench, "parts_one_by_one", sink += bench_shapesTestParts(&contact, world_parts, ACTOR_COLLIDER_MAX_PARTS, &targets[k]));
+}
+
+/* the scalar capsule test of capsule "index" against the ones after it in the group, as capsuleBatch_collisionTestCapsule */
+int bench_shapesCapsuleGroup(const Capsule* capsules, int index, ContactData* contacts, int* indices)
+{
+    int contact_count = 0;
+    for (int j = index + 1; j < BENCH_SHAPES_CAPSULE_GROUP; j++) {
+        if (!capsule_collisionTestCapsule(&contacts[contact_count], &capsules[index], &capsules[j])) continue;
+        indices[contact_count++] = j;
+    }
+    return contact_count;
+}
+
+/* every pair of a group of capsules, batched and one by one */
+void bench_shapesCapsuleBatch(Bench* bench, const Capsule* capsules)
+{
+    CapsuleBatch batch;
+    capsuleBatch_init(&batch, BENCH_SHAPES_CAPSULE_GROUP);
+    for (int i = 0; i < BENCH_SHAPES_CAPSULE_GROUP; i++) capsuleBatch_add(&batch, &capsules[i]);
+
+    ContactData contacts[BENCH_SHAPES_CAPSULE_GROUP], expected[BENCH_SHAPES_CAPSULE_GROUP];
+    int indices[BENCH_SHAPES_CAPSULE_GROUP], expected_indices[BENCH_SHAPES_CAPSULE_GROUP];
+    int mismatches = 0;
+    int touching = 0;
+
+    for (int i = 0; i < BENCH_SHAPES_CAPSULE_GROUP; i++) {
+        int count = capsuleBatch_collisionTestCapsule(contacts, indices, BENCH_SHAPES_CAPSULE_GROUP, &batch, i + 1, &capsules[i]);
+        int expected_count = bench_shapesCapsuleGroup(capsules, i, expected, expected_indices);
+        touching += expected_count;
+
+        if (count != expected_count) {
+            mismatches++;
+            continue;
+        }
+        for (int j = 0; j < count; j++) {
+            if (indices[j] != expected_indices[j] || !bench_shapesSameContact(&expected[j], &contacts[j])) mismatches++;
+        }
+    }
+
+    const int pair_count = BENCH_SHAPES_CAPSULE_GROUP * (BENCH_SHAPES_CAPSULE_GROUP - 1) / 2;
+    bench_report(bench, "capsule_group_touching", touching, "count");
+    bench_check(bench, "capsule_batch_matches_scalar", mismatches == 0);
+
+    BENCH_TIME_FROM(bench, "capsule_group_scalar", 1,
+        for (int i = 0; i < BENCH_SHAPES_CAPSULE_GROUP; i++) sink += bench_shapesCapsuleGroup(capsules, i, expected, expected_indices));
+    bench_report(bench, "capsule_group_scalar_per_pair", bench->last_ns / pair_count, "ns/op");
+    BENCH_TIME_FROM(bench, "capsule_group_batch", 1,
+        for (int i = 0; i < BENCH_SHAPES_CAPSULE_GROUP; i++) sink += capsuleBatch_collisionTestCapsule(contacts, indices, BENCH_SHAPES_CAPSULE_GROUP, &batch, i + 1, &capsules[i]));
+    bench_report(bench, "capsule_group_batch_per_pair", bench->last_ns / pair_count, "ns/op");
+
+    capsuleBatch_delete(&batch);
+}
+
+/* the cached orientation of the box against building the rotation from its euler angles on every call,
+both have to move the points to the same place. a zeroed box given its rotation has to get an orientation */
+void bench_shapesBoxOrientation(Bench* bench, const Box* boxes, const Vector3* points)
+{
+    float error = 0.0f;
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+        Vector3 cached = points[i];
+        box_transformToLocalSpace(&boxes[i], &cached);
+        Vector3 trig = points[i];
+        point_transformToLocalSpace(&trig, &boxes[i].center, &boxes[i].rotation);
+        Vector3 difference = vector3_difference(&cached, &trig);
+        error = fmaxf(error, vector3_magnitude(&difference));
+
+        box_transformToGlobalSpace(&boxes[i], &cached);
+        difference = vector3_difference(&cached, &points[i]);
+        error = fmaxf(error, vector3_magnitude(&difference));
+    }
+    bench_report(bench, "box_orientation_max_error", error, "units");
+    bench_check(bench, "box_orientation_matches_trig", error < 1e-4f);
+
+    Box zeroed = {0};
+    zeroed.size = (Vector3){1.0f, 1.0f, 1.0f};
+    zeroed.center = (Vector3){1.0f, 2.0f, 3.0f};
+    box_setRotation(&zeroed, &(Vector3){0.0f, 0.0f, 0.0f});
+    Vector3 corner = {1.5f, 2.5f, 3.5f};
+    box_transformToLocalSpace(&zeroed, &corner);
+    bench_check(bench, "zeroed_box_gets_orientation", fabsf(corner.x - 0.5f) < 1e-6f && fabsf(corner.z - 0.5f) < 1e-6f);
+
+    BENCH_TIME(bench, "box_transformToLocalSpace", Vector3 point = points[k]; box_transformToLocalSpace(&boxes[k], &point); sink += point.x);
+    BENCH_TIME(bench, "box_transformToLocalSpace_trig", Vector3 point = points[k]; point_transformToLocalSpace(&point, &boxes[k].center, &boxes[k].rotation); sink += point.x);
+    BENCH_TIME(bench, "box_transformToGlobalSpace", Vector3 point = points[k]; box_transformToGlobalSpace(&boxes[k], &point); sink += point.x);
+    BENCH_TIME(bench, "box_transformToGlobalSpace_trig", Vector3 point = points[k]; point_transformToGlobalSpace(&point, &boxes[k].center, &boxes[k].rotation); sink += point.x);
+}
+
+/* depth of a capsule against the ground plane z = 0, the deepest endpoint counts even behind the plane */
+void bench_shapesCapsulePlane(Bench* bench)
+{
+    Plane ground = {.normal = {0.0f, 0.0f, 1.0f}, .displacement = 0.0f};
+    ContactData contact;
+
+    // Start 0.2 behind the plane, end above it
+    Capsule sunk = {.start = {0.0f, 0.0f, -0.2f}, .end = {0.0f, 0.0f, 2.0f}, .radius = 0.5f};
+    bool hit = capsule_collisionTestPlane(&contact, &sunk, &ground);
+    bench_check(bench, "capsule_plane_behind_depth", hit && fabsf(contact.penetration - 0.7f) < 1e-5f && fabsf(contact.point.z) < 1e-5f);
+
+    // Start within the radius, the end deeper on a tilted capsule
+    Capsule tilted = {.start = {0.0f, 0.0f, 0.3f}, .end = {2.0f, 0.0f, -0.1f}, .radius = 0.5f};
+    hit = capsule_collisionTestPlane(&contact, &tilted, &ground);
+    bench_check(bench, "capsule_plane_deeper_end", hit && fabsf(contact.penetration - 0.6f) < 1e-5f && contact.point.x == 2.0f);
+
+    capsule_contactPlaneSetData(&contact, &tilted, &ground);
+    bench_check(bench, "capsule_plane_set_data_deeper_end", fabsf(contact.penetration - 0.6f) < 1e-5f && contact.point.x == 2.0f);
+
+    Capsule above = {.start = {0.0f, 0.0f, 0.6f}, .end = {0.0f, 0.0f, 2.0f}, .radius = 0.5f};
+    bench_check(bench, "capsule_plane_no_contact_above", !capsule_collisionTestPlane(&contact, &above, &ground));
+}
+
+#endif
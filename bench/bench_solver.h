@@ -0,0 +1,265 @@
+#ifndef BENCH_SOLVER_H
+#define BENCH_SOLVER_H
+
+/* BENCH_SOLVER.H
+the contact solver on a stack of five spheres resting on a plane in a PhysicsWorld, at a few velocity iteration counts,
+and the solves per second it sustains on 50, 200 and 1000 resting contacts. the stack is offset a little at every level
+so friction has to hold it, and it has to come to rest at the right height and fall asleep. asleep it runs no narrowphase,
+and a kick to the top sphere wakes the whole stack, one contact further down every step.
+a resting column warm started from the impulses of the frame before has to come to rest in fewer iterations than from zero */
+
+#define BENCH_SOLVER_STACK_HEIGHT 5
+#define BENCH_SOLVER_RADIUS 10.0f
+#define BENCH_SOLVER_LEVEL_OFFSET 0.5f      // horizontal shift of every sphere over the one below
+#define BENCH_SOLVER_GRAVITY -1000.0f
+#define BENCH_SOLVER_STACK_TIME_S 4.0f
+#define BENCH_SOLVER_REST_SPEED 1.0f        // the stack counts as settled once every sphere is slower than this
+#define BENCH_SOLVER_WARM_SPEED 0.1f        // the column counts as solved once every sphere is slower than this
+#define BENCH_SOLVER_MAX_ITERATIONS 100     // of the frame before, which converges
+#define BENCH_SOLVER_KICK 200.0f            // sideways impulse on the top sphere once the stack sleeps
+#define BENCH_SOLVER_WAKE_FRAMES (BENCH_SOLVER_STACK_HEIGHT - 1)   // the wake goes down one contact per step
+
+
+// structures
+
+typedef struct {
+    float settle_time;      // seconds until every sphere went under the rest speed for good, -1 if it never did
+    float height_error;     // of the top sphere at the end
+    float max_drift;        // horizontal distance of a sphere from where it started
+    bool sleeping;
+    float sleep_time;       // seconds until every sphere slept, -1 if they never did
+    int sleeping_pairs;     // narrowphase pairs of a step once the stack sleeps
+    int wake_frames;        // steps after the kick until every sphere is awake, -1 if some never woke
+} BenchSolverStack;
+
+
+// function prototypes
+
+void bench_solver(Bench* bench);
+BenchSolverStack bench_solverStack(int velocity_iterations);
+bool bench_solverStackSleeps(const PhysicsWorld* world, const PoolHandle* bodies);
+void bench_solverThroughput(Bench* bench, int contact_count);
+float bench_solverColumnSpeed(int velocity_iterations, bool warm_start);
+int bench_solverIterationsToRest(bool warm_start);
+
+
+// function implementations
+
+BenchSolverStack bench_solverStack(int velocity_iterations)
+{
+    BenchSolverStack result = {.settle_time = -1.0f, .sleep_time = -1.0f, .wake_frames = -1};
+
+    PhysicsWorld world;
+    physicsWorld_init(&world, BENCH_SOLVER_STACK_HEIGHT, BENCH_SOLVER_STACK_HEIGHT + 1, 2 * BENCH_SOLVER_STACK_HEIGHT);
+    world.gravity = (Vector3){0.0f, 0.0f, BENCH_SOLVER_GRAVITY};
+    world.solver.velocity_iterations = velocity_iterations;
+
+    Collider ground;
+    collider_init(&ground, PLANE_A);
+    plane_setFromNormalAndPoint(&ground.plane, &(Vector3){0.0f, 0.0f, 1.0f}, &(Vector3){0.0f, 0.0f, 0.0f});
+    physicsWorld_createCollider(&world, &ground, POOL_NULL_HANDLE);
+
+    // Dropped from just above their resting height
+    PoolHandle bodies[BENCH_SOLVER_STACK_HEIGHT];
+    Vector3 starts[BENCH_SOLVER_STACK_HEIGHT];
+    for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) {
+        starts[i] = (Vector3){BENCH_SOLVER_LEVEL_OFFSET * i, 0.0f, BENCH_SOLVER_RADIUS * (2 * i + 1) + 0.5f * (i + 1)};
+        bodies[i] = physicsWorld_createBody(&world, 1.0f, &starts[i]);
+        physicsWorld_getBody(&world, bodies[i])->friction = 0.5f;
+
+        Collider sphere;
+        collider_init(&sphere, SPHERE_A);
+        sphere.sphere = (Sphere){starts[i], BENCH_SOLVER_RADIUS};
+        physicsWorld_createCollider(&world, &sphere, bodies[i]);
+    }
+
+    int steps = (int)(BENCH_SOLVER_STACK_TIME_S / TIME_FIXED_STEP_S);
+    for (int step = 0; step < steps; step++) {
+
+        physicsWorld_step(&world, TIME_FIXED_STEP_S);
+
+        bool resting = true;
+        for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) {
+            const RigidBody* body = physicsWorld_getBody(&world, bodies[i]);
+            if (vector3_magnitude(&body->velocity) > BENCH_SOLVER_REST_SPEED) resting = false;
+        }
+        if (!resting) result.settle_time = -1.0f;
+        else if (result.settle_time < 0.0f) result.settle_time = (step + 1) * TIME_FIXED_STEP_S;
+
+        if (result.sleep_time < 0.0f && bench_solverStackSleeps(&world, bodies)) result.sleep_time = (step + 1) * TIME_FIXED_STEP_S;
+    }
+
+    result.sleeping = true;
+    for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) {
+        const RigidBody* body = physicsWorld_getBody(&world, bodies[i]);
+        Vector2 drift = {body->position.x - starts[i].x, body->position.y - starts[i].y};
+        result.max_drift = fmaxf(result.max_drift, vector2_magnitude(&drift));
+        result.sleeping = result.sleeping && body->sleeping;
+    }
+
+    RigidBody* top = physicsWorld_getBody(&world, bodies[BENCH_SOLVER_STACK_HEIGHT - 1]);
+    result.height_error = fabsf(top->position.z - BENCH_SOLVER_RADIUS * (2 * BENCH_SOLVER_STACK_HEIGHT - 1));
+
+    // One more step asleep, then the kick has to reach the bottom of the stack
+    physicsWorld_step(&world, TIME_FIXED_STEP_S);
+    result.sleeping_pairs = world.pairs.count;
+
+    rigidBody_applyImpulse(top, &(Vector3){BENCH_SOLVER_KICK, 0.0f, 0.0f});
+    for (int step = 1; step <= 2 * BENCH_SOLVER_WAKE_FRAMES && result.wake_frames < 0; step++) {
+        physicsWorld_step(&world, TIME_FIXED_STEP_S);
+        bool awake = true;
+        for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) awake = awake && !physicsWorld_getBody(&world, bodies[i])->sleeping;
+        if (awake) result.wake_frames = step;
+    }
+
+    physicsWorld_delete(&world);
+    return result;
+}
+
+bool bench_solverStackSleeps(const PhysicsWorld* world, const PoolHandle* bodies)
+{
+    for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) {
+        if (!physicsWorld_getBody(world, bodies[i])->sleeping) return false;
+    }
+    return true;
+}
+
+/* columns of resting spheres, each gives one contact with the ground and one with every sphere it holds.
+the velocities are reset before every solve, so each one starts from the pull of one step of gravity */
+void bench_solverThroughput(Bench* bench, int contact_count)
+{
+    int body_count = contact_count;
+    RigidBody* bodies = aligned_alloc(GLOBAL_ALIGNMENT, body_count * sizeof(RigidBody));
+    assert(bodies != NULL);
+    memset(bodies, 0, body_count * sizeof(RigidBody));
+
+    ContactSolver solver;
+    contactSolver_init(&solver, contact_count);
+
+    for (int i = 0; i < body_count; i++) {
+
+        int column = i / BENCH_SOLVER_STACK_HEIGHT;
+        int level = i % BENCH_SOLVER_STACK_HEIGHT;
+        bodies[i].position = (Vector3){50.0f * column, 0.0f, BENCH_SOLVER_RADIUS * (2 * level + 1)};
+        bodies[i].friction = 0.5f;
+        rigidBody_setMass(&bodies[i], 1.0f);
+
+        ContactData contact = {.normal = {0.0f, 0.0f, 1.0f}, .penetration = 0.1f};
+        contact.point = bodies[i].position;
+        contact.point.z -= BENCH_SOLVER_RADIUS;
+        contactSolver_addContact(&solver, &bodies[i], (level > 0) ? &bodies[i - 1] : NULL, &contact, NULL);
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "solve_%d_contacts", contact_count);
+    BENCH_TIME_FROM(bench, name, 1,
+        for (int i = 0; i < body_count; i++) {
+            bodies[i].velocity = (Vector3){0.0f, 0.0f, BENCH_SOLVER_GRAVITY * TIME_FIXED_STEP_S};
+            bodies[i].split_velocity = (Vector3){0.0f, 0.0f, 0.0f};
+        }
+        contactSolver_solve(&solver, TIME_FIXED_STEP_S);
+        sink += bodies[k % body_count].velocity.z);
+
+    snprintf(name, sizeof(name), "solves_per_s_%d_contacts", contact_count);
+    bench_report(bench, name, 1e9 / bench->last_ns, "1/s");
+    snprintf(name, sizeof(name), "velocity_iterations_per_s_%d_contacts", contact_count);
+    bench_report(bench, name, 1e9 * solver.velocity_iterations / bench->last_ns, "1/s");
+
+    contactSolver_delete(&solver);
+    free(bodies);
+}
+
+/* a column of resting spheres on the ground, pulled by one step of gravity and solved with "velocity_iterations".
+with "warm_start" the contacts start from the impulses of a converged frame before. returns the fastest sphere after it */
+float bench_solverColumnSpeed(int velocity_iterations, bool warm_start)
+{
+    RigidBody bodies[BENCH_SOLVER_STACK_HEIGHT];
+    ContactPoint points[BENCH_SOLVER_STACK_HEIGHT];
+    memset(bodies, 0, sizeof(bodies));
+    memset(points, 0, sizeof(points));
+
+    ContactSolver solver;
+    contactSolver_init(&solver, BENCH_SOLVER_STACK_HEIGHT);
+
+    for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) {
+        bodies[i].position = (Vector3){0.0f, 0.0f, BENCH_SOLVER_RADIUS * (2 * i + 1)};
+        bodies[i].friction = 0.5f;
+        rigidBody_setMass(&bodies[i], 1.0f);
+
+        points[i].data = (ContactData){.normal = {0.0f, 0.0f, 1.0f}, .penetration = 0.1f};
+        points[i].data.point = bodies[i].position;
+        points[i].data.point.z -= BENCH_SOLVER_RADIUS;
+    }
+
+    int frames = warm_start ? 2 : 1;
+    for (int frame = 0; frame < frames; frame++) {
+
+        contactSolver_clear(&solver);
+        for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) {
+            bodies[i].velocity = (Vector3){0.0f, 0.0f, BENCH_SOLVER_GRAVITY * TIME_FIXED_STEP_S};
+            bodies[i].split_velocity = (Vector3){0.0f, 0.0f, 0.0f};
+            contactSolver_addContact(&solver, &bodies[i], (i > 0) ? &bodies[i - 1] : NULL, &points[i].data, warm_start ? &points[i] : NULL);
+        }
+
+        solver.velocity_iterations = (frame == frames - 1) ? velocity_iterations : BENCH_SOLVER_MAX_ITERATIONS;
+        contactSolver_solve(&solver, TIME_FIXED_STEP_S);
+    }
+
+    float speed = 0.0f;
+    for (int i = 0; i < BENCH_SOLVER_STACK_HEIGHT; i++) speed = fmaxf(speed, vector3_magnitude(&bodies[i].velocity));
+
+    contactSolver_delete(&solver);
+    return speed;
+}
+
+/* fewest velocity iterations that bring the column under BENCH_SOLVER_WARM_SPEED, -1 if none up to the maximum does */
+int bench_solverIterationsToRest(bool warm_start)
+{
+    for (int iterations = 1; iterations <= BENCH_SOLVER_MAX_ITERATIONS; iterations++) {
+        if (bench_solverColumnSpeed(iterations, warm_start) < BENCH_SOLVER_WARM_SPEED) return iterations;
+    }
+    return -1;
+}
+
+void bench_solver(Bench* bench)
+{
+    const int iterations[] = {2, 4, DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS};
+    char name[64];
+
+    for (int i = 0; i < (int)(sizeof(iterations) / sizeof(iterations[0])); i++) {
+
+        BenchSolverStack stack = bench_solverStack(iterations[i]);
+
+        snprintf(name, sizeof(name), "stack_settle_time_%d_iterations", iterations[i]);
+        bench_report(bench, name, stack.settle_time, "s");
+        snprintf(name, sizeof(name), "stack_height_error_%d_iterations", iterations[i]);
+        bench_report(bench, name, stack.height_error, "units");
+        snprintf(name, sizeof(name), "stack_drift_%d_iterations", iterations[i]);
+        bench_report(bench, name, stack.max_drift, "units");
+        snprintf(name, sizeof(name), "stack_sleep_time_%d_iterations", iterations[i]);
+        bench_report(bench, name, stack.sleep_time, "s");
+
+        // The default settings have to hold the stack
+        if (iterations[i] != DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS) continue;
+        bench_check(bench, "stack_settles", stack.settle_time >= 0.0f);
+        bench_check(bench, "stack_height", stack.height_error < 1.0f);
+        bench_check(bench, "stack_holds", stack.max_drift < 1.0f);
+        bench_check(bench, "stack_sleeps", stack.sleeping);
+        bench_report(bench, "stack_sleeping_pairs", stack.sleeping_pairs, "count");
+        bench_report(bench, "stack_wake_frames", stack.wake_frames, "count");
+        bench_check(bench, "stack_asleep_skips_narrowphase", stack.sleeping_pairs == 0);
+        bench_check(bench, "stack_wakes_on_impulse", stack.wake_frames > 0 && stack.wake_frames <= BENCH_SOLVER_WAKE_FRAMES);
+    }
+
+    int cold_iterations = bench_solverIterationsToRest(false);
+    int warm_iterations = bench_solverIterationsToRest(true);
+    bench_report(bench, "column_iterations_cold", cold_iterations, "count");
+    bench_report(bench, "column_iterations_warm", warm_iterations, "count");
+    bench_check(bench, "warm_start_saves_iterations", warm_iterations > 0 && (cold_iterations < 0 || warm_iterations < cold_iterations));
+
+    bench_solverThroughput(bench, 50);
+    bench_solverThroughput(bench, 200);
+    bench_solverThroughput(bench, 1000);
+}
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef BENCH_SPATIAL_HASH_H
+#define BENCH_SPATIAL_HASH_H
+
+/* BENCH_SPATIAL_HASH.H
+the spatial hash on crowds of 10 to 5000 walking actor capsules at the same density, against testing every pair.
+per frame it times moving every actor, gathering the pairs with the narrowphase on them, and the brute force.
+every touching pair of the brute force has to be among the pairs of the hash, and no pair can come twice,
+also after some actors were removed and added again */
+
+#define BENCH_SPATIAL_HASH_RADIUS 10.0f
+#define BENCH_SPATIAL_HASH_LENGTH 40.0f
+#define BENCH_SPATIAL_HASH_SPACING 40.0f    // side of the ground area per actor
+#define BENCH_SPATIAL_HASH_SPEED 300.0f     // fastest walk
+#define BENCH_SPATIAL_HASH_FRAMES 60        // walked before the pairs are checked
+#define BENCH_SPATIAL_HASH_PAIRS_PER_ACTOR 64
+
+
+// structures
+
+typedef struct {
+    int count;
+    float side;             // of the square the actors walk in, they come back in on the other side
+    Vector3* positions;
+    Vector3* velocities;
+    Capsule* capsules;
+    int* ids;
+    BroadphasePair* pairs;
+    int max_pairs;
+    SpatialHash hash;
+} BenchSpatialHashCrowd;
+
+
+// function prototypes
+
+void bench_spatialHash(Bench* bench);
+void bench_spatialHashInit(BenchSpatialHashCrowd* crowd, int count);
+void bench_spatialHashDelete(BenchSpatialHashCrowd* crowd);
+int bench_spatialHashWalk(BenchSpatialHashCrowd* crowd);
+int bench_spatialHashCollide(const BenchSpatialHashCrowd* crowd, int pair_count);
+int bench_spatialHashBruteForce(const BenchSpatialHashCrowd* crowd);
+int bench_spatialHashComparePairs(const void* a, const void* b);
+bool bench_spatialHashCheckPairs(BenchSpatialHashCrowd* crowd);
+void bench_spatialHashRun(Bench* bench, int count);
+
+
+// function implementations
+
+void bench_spatialHashInit(BenchSpatialHashCrowd* crowd, int count)
+{
+    crowd->count = count;
+    crowd->side = sqrtf((float)count) * BENCH_SPATIAL_HASH_SPACING;
+    crowd->max_pairs = count * BENCH_SPATIAL_HASH_PAIRS_PER_ACTOR;
+    crowd->positions = malloc(count * sizeof(Vector3));
+    crowd->velocities = malloc(count * sizeof(Vector3));
+    crowd->capsules = malloc(count * sizeof(Capsule));
+    crowd->ids = malloc(count * sizeof(int));
+    crowd->pairs = malloc(crowd->max_pairs * sizeof(BroadphasePair));
+    assert(crowd->positions != NULL && crowd->velocities != NULL && crowd->capsules != NULL && crowd->ids != NULL && crowd->pairs != NULL);
+
+    spatialHash_init(&crowd->hash, spatialHash_getCapsuleCellSize(BENCH_SPATIAL_HASH_RADIUS, BENCH_SPATIAL_HASH_LENGTH), count);
+
+    for (int i = 0; i < count; i++) {
+
+        // On a bumpy ground, so some of them are stacked a little
+        crowd->positions[i] = (Vector3){bench_randomFloat(0.0f, crowd->side), bench_randomFloat(0.0f, crowd->side), bench_randomFloat(0.0f, 20.0f)};
+        float heading = bench_randomFloat(0.0f, 2.0f * PI);
+        float speed = bench_randomFloat(0.0f, BENCH_SPATIAL_HASH_SPEED);
+        crowd->velocities[i] = (Vector3){speed * cosf(heading), speed * sinf(heading), 0.0f};
+
+        crowd->capsules[i] = (Capsule){.radius = BENCH_SPATIAL_HASH_RADIUS, .length = BENCH_SPATIAL_HASH_LENGTH};
+        capsule_setVertical(&crowd->capsules[i], &crowd->positions[i]);
+        crowd->ids[i] = spatialHash_addObject(&crowd->hash, &crowd->positions[i], &crowd->capsules[i]);
+    }
+}
+
+void bench_spatialHashDelete(BenchSpatialHashCrowd* crowd)
+{
+    spatialHash_delete(&crowd->hash);
+    free(crowd->positions);
+    free(crowd->velocities);
+    free(crowd->capsules);
+    free(crowd->ids);
+    free(crowd->pairs);
+}
+
+/* one tick of walking, returns how many actors changed cell */
+int bench_spatialHashWalk(BenchSpatialHashCrowd* crowd)
+{
+    int cell_changes = 0;
+
+    for (int i = 0; i < crowd->count; i++) {
+
+        Vector3* position = &crowd->positions[i];
+        vector3_addScaledVector(position, &crowd->velocities[i], TIME_FIXED_STEP_S);
+        if (position->x < 0.0f) position->x += crowd->side;
+        if (position->x >= crowd->side) position->x -= crowd->side;
+        if (position->y < 0.0f) position->y += crowd->side;
+        if (position->y >= crowd->side) position->y -= crowd->side;
+
+        capsule_setVertical(&crowd->capsules[i], position);
+        cell_changes += spatialHash_moveObject(&crowd->hash, crowd->ids[i], position);
+    }
+
+    return cell_changes;
+}
+
+/* the narrowphase on the pairs of the hash, returns how many touch */
+int bench_spatialHashCollide(const BenchSpatialHashCrowd* crowd, int pair_count)
+{
+    int touching = 0;
+    for (int i = 0; i < pair_count; i++) {
+        const Capsule* a = spatialHash_getData(&crowd->hash, crowd->pairs[i].proxy_a);
+        const Capsule* b = spatialHash_getData(&crowd->hash, crowd->pairs[i].proxy_b);
+        touching += capsule_contactCapsule(a, b);
+    }
+    return touching;
+}
+
+int bench_spatialHashBruteForce(const BenchSpatialHashCrowd* crowd)
+{
+    int touching = 0;
+    for (int i = 0; i < crowd->count; i++) {
+        for (int j = i + 1; j < crowd->count; j++) touching += capsule_contactCapsule(&crowd->capsules[i], &crowd->capsules[j]);
+    }
+    return touching;
+}
+
+int bench_spatialHashComparePairs(const void* a, const void* b)
+{
+    const BroadphasePair* pair_a = a;
+    const BroadphasePair* pair_b = b;
+    if (pair_a->proxy_a != pair_b->proxy_a) return (pair_a->proxy_a < pair_b->proxy_a) ? -1 : 1;
+    if (pair_a->proxy_b != pair_b->proxy_b) return (pair_a->proxy_b < pair_b->proxy_b) ? -1 : 1;
+    return 0;
+}
+
+/* every touching pair among the pairs of the hash, and each pair once */
+bool bench_spatialHashCheckPairs(BenchSpatialHashCrowd* crowd)
+{
+    int pair_count = spatialHash_getPairs(&crowd->hash, crowd->pairs, crowd->max_pairs);
+    if (pair_count == crowd->max_pairs) return false;
+
+    qsort(crowd->pairs, pair_count, sizeof(BroadphasePair), bench_spatialHashComparePairs);
+    for (int i = 1; i < pair_count; i++) {
+        if (bench_spatialHashComparePairs(&crowd->pairs[i - 1], &crowd->pairs[i]) == 0) return false;
+    }
+
+    for (int i = 0; i < crowd->count; i++) {
+        for (int j = i + 1; j < crowd->count; j++) {
+            if (!capsule_contactCapsule(&crowd->capsules[i], &crowd->capsules[j])) continue;
+            BroadphasePair pair = broadphasePair_create(crowd->ids[i], crowd->ids[j]);
+            if (bsearch(&pair, crowd->pairs, pair_count, sizeof(BroadphasePair), bench_spatialHashComparePairs) == NULL) return false;
+        }
+    }
+
+    return true;
+}
+
+void bench_spatialHashRun(Bench* bench, int count)
+{
+    BenchSpatialHashCrowd crowd;
+    bench_spatialHashInit(&crowd, count);
+    char name[64];
+
+    int cell_changes = 0;
+    for (int frame = 0; frame < BENCH_SPATIAL_HASH_FRAMES; frame++) cell_changes += bench_spatialHashWalk(&crowd);
+    bool found = bench_spatialHashCheckPairs(&crowd);
+
+    // A third of the crowd leaves and comes back somewhere else
+    for (int i = 0; i < count; i += 3) {
+        spatialHash_removeObject(&crowd.hash, crowd.ids[i]);
+        crowd.positions[i].x = bench_randomFloat(0.0f, crowd.side);
+        capsule_setVertical(&crowd.capsules[i], &crowd.positions[i]);
+    }
+    for (int i = 0; i < count; i += 3) crowd.ids[i] = spatialHash_addObject(&crowd.hash, &crowd.positions[i], &crowd.capsules[i]);
+    found = bench_spatialHashCheckPairs(&crowd) && found;
+
+    int pair_count = spatialHash_getPairs(&crowd.hash, crowd.pairs, crowd.max_pairs);
+
+    snprintf(name, sizeof(name), "cell_changes_per_move_%d", count);
+    bench_report(bench, name, (double)cell_changes / (BENCH_SPATIAL_HASH_FRAMES * count), "ratio");
+    snprintf(name, sizeof(name), "pairs_%d", count);
+    bench_report(bench, name, pair_count, "count");
+    snprintf(name, sizeof(name), "touching_%d", count);
+    bench_report(bench, name, bench_spatialHashCollide(&crowd, pair_count), "count");
+    snprintf(name, sizeof(name), "finds_every_touching_pair_once_%d", count);
+    bench_check(bench, name, found);
+
+    snprintf(name, sizeof(name), "move_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, sink += bench_spatialHashWalk(&crowd));
+    snprintf(name, sizeof(name), "pairs_and_narrowphase_%d", count);
+    BENCH_TIME_FROM(bench, name, 1,
+        int pairs = spatialHash_getPairs(&crowd.hash, crowd.pairs, crowd.max_pairs);
+        sink += bench_spatialHashCollide(&crowd, pairs));
+    snprintf(name, sizeof(name), "brute_force_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, sink += bench_spatialHashBruteForce(&crowd));
+
+    bench_spatialHashDelete(&crowd);
+}
+
+void bench_spatialHash(Bench* bench)
+{
+    const int counts[] = {10, 100, 500, 1000, 2000, 5000};
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) bench_spatialHashRun(bench, counts[i]);
+}
+
+#endif
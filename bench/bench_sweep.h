@@ -0,0 +1,222 @@
+#ifndef BENCH_SWEEP_H
+#define BENCH_SWEEP_H
+
+/* BENCH_SWEEP.H
+fast actor sized capsules fired at walls 2 units thick, and at planes and small spheres, moving several times
+their radius per step. every sweep is compared with the discrete test sampled densely along the displacement:
+it can't miss a contact the samples find, report it after the first touching sample, or stop short of touching.
+then the actor step of advanceAndSlide is run into a thin wall at increasing speeds */
+
+#define BENCH_SWEEP_SAMPLES 1024            // discrete tests along every displacement
+#define BENCH_SWEEP_WALL_THICKNESS 2.0f
+#define BENCH_SWEEP_TOUCH_TOLERANCE 0.05f   // a sweep contact is at most this far from the shape
+#define BENCH_SWEEP_ACTOR_STEPS 8           // ticks an actor runs towards the wall
+
+
+// function prototypes
+
+void bench_sweep(Bench* bench);
+bool bench_sweepTest(ContactData* contact, const Capsule* capsule, const Collider* target);
+bool bench_sweepCollider(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Collider* target);
+Capsule bench_sweepMoved(const Capsule* capsule, const Vector3* displacement, float time);
+void bench_sweepFuzz(Bench* bench, const char* shape, const Capsule* capsules, const Vector3* displacements, const Collider* targets);
+void bench_sweepActor(Bench* bench);
+
+
+// function implementations
+
+bool bench_sweepTest(ContactData* contact, const Capsule* capsule, const Collider* target)
+{
+    switch (target->type) {
+        case SPHERE_A: return capsule_collisionTestSphere(contact, capsule, &target->sphere);
+        case AABB_A: return capsule_collisionTestAABB(contact, capsule, &target->aabb);
+        case BOX_A: return capsule_collisionTestBox(contact, capsule, &target->box);
+        case PLANE_A: return capsule_collisionTestPlane(contact, capsule, &target->plane);
+        default: return false;
+    }
+}
+
+bool bench_sweepCollider(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Collider* target)
+{
+    switch (target->type) {
+        case SPHERE_A: return capsule_sweepSphere(contact, time, capsule, displacement, &target->sphere);
+        case AABB_A: return capsule_sweepAABB(contact, time, capsule, displacement, &target->aabb);
+        case BOX_A: return capsule_sweepBox(contact, time, capsule, displacement, &target->box);
+        case PLANE_A: return capsule_sweepPlane(contact, time, capsule, displacement, &target->plane);
+        default: return false;
+    }
+}
+
+Capsule bench_sweepMoved(const Capsule* capsule, const Vector3* displacement, float time)
+{
+    Capsule moved = *capsule;
+    vector3_addScaledVector(&moved.start, displacement, time);
+    vector3_addScaledVector(&moved.end, displacement, time);
+    return moved;
+}
+
+/* checks the sweep of every capsule against its target and reports the misses of a discrete test at the end of the step */
+void bench_sweepFuzz(Bench* bench, const char* shape, const Capsule* capsules, const Vector3* displacements, const Collider* targets)
+{
+    int sampled_hits = 0;
+    int end_misses = 0;
+    int missed = 0;
+    int late = 0;
+    int early = 0;
+    char name[64];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+
+        ContactData contact;
+        int first_sample = -1;
+        for (int s = 0; s <= BENCH_SWEEP_SAMPLES && first_sample < 0; s++) {
+            Capsule moved = bench_sweepMoved(&capsules[i], &displacements[i], (float)s / BENCH_SWEEP_SAMPLES);
+            if (bench_sweepTest(&contact, &moved, &targets[i])) first_sample = s;
+        }
+
+        float time;
+        bool hit = bench_sweepCollider(&contact, &time, &capsules[i], &displacements[i], &targets[i]);
+
+        if (first_sample >= 0) {
+            sampled_hits++;
+            Capsule end = bench_sweepMoved(&capsules[i], &displacements[i], 1.0f);
+            if (!bench_sweepTest(&contact, &end, &targets[i])) end_misses++;
+            if (!hit) missed++;
+            else if (time > (float)first_sample / BENCH_SWEEP_SAMPLES + 1e-4f) late++;
+        }
+
+        // Touching at the reported time, with a bit of room for the tolerance of the iterative sweeps
+        if (hit) {
+            Capsule touching = bench_sweepMoved(&capsules[i], &displacements[i], time);
+            touching.radius += BENCH_SWEEP_TOUCH_TOLERANCE;
+            if (!bench_sweepTest(&contact, &touching, &targets[i])) early++;
+        }
+    }
+
+    snprintf(name, sizeof(name), "%s_sampled_hits", shape);
+    bench_report(bench, name, sampled_hits, "count");
+    snprintf(name, sizeof(name), "%s_discrete_end_misses", shape);
+    bench_report(bench, name, end_misses, "count");
+
+    snprintf(name, sizeof(name), "%s_no_missed_contact", shape);
+    bench_check(bench, name, missed == 0);
+    snprintf(name, sizeof(name), "%s_not_after_first_contact", shape);
+    bench_check(bench, name, late == 0);
+    snprintf(name, sizeof(name), "%s_touching_at_time", shape);
+    bench_check(bench, name, early == 0);
+}
+
+void bench_sweep(Bench* bench)
+{
+    static Capsule capsules[BENCH_INPUT_COUNT];
+    static Vector3 displacements[BENCH_INPUT_COUNT];
+    static Collider walls[BENCH_INPUT_COUNT], boxes[BENCH_INPUT_COUNT], planes[BENCH_INPUT_COUNT], spheres[BENCH_INPUT_COUNT];
+
+    for (int i = 0; i < BENCH_INPUT_COUNT; i++) {
+
+        // Actor sized, tilted at random, in front of the walls at x 0 and moving 5 to 60 radii towards them
+        Vector3 axis = bench_randomUnitVector3();
+        capsules[i].radius = 10.0f;
+        capsules[i].length = 60.0f;
+        capsules[i].start = (Vector3){bench_randomFloat(-300.0f, -30.0f), bench_randomFloat(-150.0f, 150.0f), bench_randomFloat(-150.0f, 150.0f)};
+        capsules[i].end = capsules[i].start;
+        vector3_addScaledVector(&capsules[i].end, &axis, 40.0f);
+
+        Vector3 direction = {1.0f, bench_randomFloat(-0.5f, 0.5f), bench_randomFloat(-0.5f, 0.5f)};
+        vector3_normalize(&direction);
+        displacements[i] = vector3_returnScaled(&direction, bench_randomFloat(50.0f, 600.0f));
+
+        collider_init(&walls[i], AABB_A);
+        aabb_setFromCenterAndSize(&walls[i].aabb, &(Vector3){0.0f, 0.0f, 0.0f}, &(Vector3){BENCH_SWEEP_WALL_THICKNESS, 200.0f, 200.0f});
+
+        collider_init(&boxes[i], BOX_A);
+        Vector3 rotation = {0.0f, bench_randomFloat(-30.0f, 30.0f), bench_randomFloat(-30.0f, 30.0f)};
+        box_init(&boxes[i].box, &(Vector3){BENCH_SWEEP_WALL_THICKNESS, 200.0f, 200.0f}, &(Vector3){0.0f, 0.0f, 0.0f}, &rotation);
+
+        collider_init(&planes[i], PLANE_A);
+        Vector3 normal = {-1.0f, bench_randomFloat(-0.3f, 0.3f), bench_randomFloat(-0.3f, 0.3f)};
+        vector3_normalize(&normal);
+        plane_setFromNormalAndPoint(&planes[i].plane, &normal, &(Vector3){0.0f, 0.0f, 0.0f});
+
+        // Small obstacles around the path
+        collider_init(&spheres[i], SPHERE_A);
+        Vector3 center = vector3_returnScaled(&displacements[i], bench_randomFloat(0.0f, 1.2f));
+        vector3_add(&center, &capsules[i].start);
+        Vector3 offset = bench_randomVector3(-40.0f, 40.0f);
+        vector3_add(&center, &offset);
+        spheres[i].sphere = (Sphere){center, bench_randomFloat(1.0f, 10.0f)};
+    }
+
+    bench_sweepFuzz(bench, "aabb_wall", capsules, displacements, walls);
+    bench_sweepFuzz(bench, "box_wall", capsules, displacements, boxes);
+    bench_sweepFuzz(bench, "plane", capsules, displacements, planes);
+    bench_sweepFuzz(bench, "sphere", capsules, displacements, spheres);
+
+    ContactData contact;
+    float time;
+    BENCH_TIME(bench, "capsule_sweepAABB_wall", sink += capsule_sweepAABB(&contact, &time, &capsules[k], &displacements[k], &walls[k].aabb); sink += time);
+    BENCH_TIME(bench, "capsule_sweepBox_wall", sink += capsule_sweepBox(&contact, &time, &capsules[k], &displacements[k], &boxes[k].box); sink += time);
+    BENCH_TIME(bench, "capsule_sweepPlane", sink += capsule_sweepPlane(&contact, &time, &capsules[k], &displacements[k], &planes[k].plane); sink += time);
+    BENCH_TIME(bench, "capsule_sweepSphere", sink += capsule_sweepSphere(&contact, &time, &capsules[k], &displacements[k], &spheres[k].sphere); sink += time);
+
+    bench_sweepActor(bench);
+}
+
+/* the player runs at a wall at x 0 from speeds where a tick moves less than the wall thickness to ones
+that move several body lengths, it has to stay in front of the wall */
+void bench_sweepActor(Bench* bench)
+{
+    Collider wall;
+    collider_init(&wall, BOX_A);
+    box_init(&wall.box, &(Vector3){BENCH_SWEEP_WALL_THICKNESS, 1000.0f, 1000.0f}, &(Vector3){0.0f, 0.0f, 0.0f}, &(Vector3){0.0f, 0.0f, 15.0f});
+
+    ActorCollider collider = {.settings = {.body_radius = 20.0f, .body_height = 120.0f}};
+    actorCollider_init(&collider);
+
+    const float speeds[] = {60.0f, 900.0f, 3000.0f, 10000.0f, 30000.0f};
+    int tunnels = 0;
+    int discrete_tunnels = 0;
+
+    for (int i = 0; i < (int)(sizeof(speeds) / sizeof(speeds[0])); i++) {
+        for (int heading = -2; heading <= 2; heading++) {
+
+            Actor actor = actor_create(0, "rom:/capsule.t3dm");
+            actor.body.position = (Vector3){-200.0f, 20.0f * heading, 0.0f};
+            Vector3 direction = {1.0f, 0.25f * heading, 0.0f};
+            vector3_normalize(&direction);
+            actor.body.velocity = vector3_returnScaled(&direction, speeds[i]);
+
+            for (int step = 0; step < BENCH_SWEEP_ACTOR_STEPS; step++) {
+                Vector3 displacement = vector3_returnScaled(&actor.body.velocity, TIME_FIXED_STEP_S);
+
+                // Where the discrete step would have put the body
+                Vector3 unswept = actor.body.position;
+                vector3_add(&unswept, &displacement);
+                Vector3 local = unswept;
+                box_transformToLocalSpace(&wall.box, &local);
+                if (local.x > 0.5f * BENCH_SWEEP_WALL_THICKNESS + collider.body.radius) discrete_tunnels++;
+
+                actorCollision_advanceAndSlide(&actor, &collider, &displacement, &wall, 1);
+            }
+
+            Vector3 local = actor.body.position;
+            box_transformToLocalSpace(&wall.box, &local);
+            if (local.x > -0.5f * BENCH_SWEEP_WALL_THICKNESS) tunnels++;
+            actor_delete(&actor);
+        }
+    }
+
+    bench_report(bench, "actor_discrete_tunnels", discrete_tunnels, "count");
+    bench_check(bench, "actor_stays_in_front_of_wall", tunnels == 0);
+
+    Actor actor = actor_create(0, "rom:/capsule.t3dm");
+    Vector3 displacement = {500.0f, 0.0f, 0.0f};
+    BENCH_TIME(bench, "actor_advanceAndSlide_wall",
+        actor.body.position = (Vector3){-200.0f, 0.0f, 0.0f};
+        actor.body.velocity = (Vector3){30000.0f, 0.0f, 0.0f};
+        actorCollision_advanceAndSlide(&actor, &collider, &displacement, &wall, 1);
+        sink += actor.body.position.x);
+    actor_delete(&actor);
+}
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef BENCH_SWEEP_AND_PRUNE_H
+#define BENCH_SWEEP_AND_PRUNE_H
+
+/* BENCH_SWEEP_AND_PRUNE.H
+the incremental sweep and prune on scenes of 100 to 2000 boxes where one in twenty moves, and where all of them do,
+against sorting every box by its min x from scratch each frame and sweeping. after every frame its pairs have
+to be those of the full sweep and its events the change of its pairs since the last frame, also once half of
+the boxes are removed. then the per frame cost of both, from moving the boxes to having the pairs, and of the sweep and prune up to its events */
+
+#define BENCH_SAP_SPACING 40.0f             // side of the area per box
+#define BENCH_SAP_SPEED 120.0f
+#define BENCH_SAP_MOVING_STRIDE 20          // every this many boxes one moves
+#define BENCH_SAP_CHECKED_FRAMES 60
+#define BENCH_SAP_PAIRS_PER_BOX 4         // room for the pairs and the events of a frame, about ten times what the scenes get
+
+
+// structures
+
+typedef struct {
+    int count;
+    float side;
+    AABB* boxes;
+    Vector3* velocities;
+    bool* removed;
+    int* ids;
+    int* order;             // of the full sweep
+    BroadphasePair* pairs;  // of the full sweep
+    BroadphasePair* sap_pairs;
+    BroadphasePair* previous_pairs;
+    int max_pairs;
+    SweepAndPrune sap;
+} BenchSapScene;
+
+
+// function prototypes
+
+void bench_sweepAndPrune(Bench* bench);
+void bench_sapInit(BenchSapScene* scene, int count);
+void bench_sapDelete(BenchSapScene* scene);
+void bench_sapMove(BenchSapScene* scene, int stride, bool update);
+int bench_sapFullSweep(BenchSapScene* scene);
+int bench_sapComparePairs(const void* a, const void* b);
+int bench_sapCompareMinX(const void* a, const void* b);
+bool bench_sapHasPair(const BroadphasePair* pairs, int count, const BroadphasePair* pair);
+bool bench_sapCheckFrame(BenchSapScene* scene, int* previous_count);
+void bench_sapRun(Bench* bench, int count);
+
+
+// function implementations
+
+void bench_sapInit(BenchSapScene* scene, int count)
+{
+    scene->count = count;
+    scene->side = sqrtf((float)count) * BENCH_SAP_SPACING;
+    scene->max_pairs = count * BENCH_SAP_PAIRS_PER_BOX;
+    scene->boxes = malloc(count * sizeof(AABB));
+    scene->velocities = malloc(count * sizeof(Vector3));
+    scene->removed = calloc(count, sizeof(bool));
+    scene->ids = malloc(count * sizeof(int));
+    scene->order = malloc(count * sizeof(int));
+    scene->pairs = malloc(scene->max_pairs * sizeof(BroadphasePair));
+    scene->sap_pairs = malloc(scene->max_pairs * sizeof(BroadphasePair));
+    scene->previous_pairs = malloc(scene->max_pairs * sizeof(BroadphasePair));
+    assert(scene->boxes != NULL && scene->velocities != NULL && scene->removed != NULL && scene->ids != NULL
+        && scene->order != NULL && scene->pairs != NULL && scene->sap_pairs != NULL && scene->previous_pairs != NULL);
+
+    sweepAndPrune_init(&scene->sap, count, scene->max_pairs);
+
+    for (int i = 0; i < count; i++) {
+        Vector3 center = {bench_randomFloat(0.0f, scene->side), bench_randomFloat(0.0f, scene->side), bench_randomFloat(0.0f, 100.0f)};
+        Vector3 size = bench_randomVector3(5.0f, 25.0f);
+        aabb_setFromCenterAndSize(&scene->boxes[i], &center, &size);
+        float heading = bench_randomFloat(0.0f, 2.0f * PI);
+        scene->velocities[i] = (Vector3){BENCH_SAP_SPEED * cosf(heading), BENCH_SAP_SPEED * sinf(heading), 0.0f};
+        scene->ids[i] = sweepAndPrune_addObject(&scene->sap, &scene->boxes[i], &scene->boxes[i]);
+    }
+    sweepAndPrune_clearEvents(&scene->sap);
+}
+
+void bench_sapDelete(BenchSapScene* scene)
+{
+    sweepAndPrune_delete(&scene->sap);
+    free(scene->boxes);
+    free(scene->velocities);
+    free(scene->removed);
+    free(scene->ids);
+    free(scene->order);
+    free(scene->pairs);
+    free(scene->sap_pairs);
+    free(scene->previous_pairs);
+}
+
+/* one tick for every "stride"th box, they turn back at the sides. "update" hands them to the sweep and prune */
+void bench_sapMove(BenchSapScene* scene, int stride, bool update)
+{
+    for (int i = 0; i < scene->count; i += stride) {
+
+        if (scene->removed[i]) continue;
+
+        AABB* box = &scene->boxes[i];
+        Vector3* velocity = &scene->velocities[i];
+        if ((box->minCoordinates.x < 0.0f && velocity->x < 0.0f) || (box->maxCoordinates.x > scene->side && velocity->x > 0.0f)) velocity->x = -velocity->x;
+        if ((box->minCoordinates.y < 0.0f && velocity->y < 0.0f) || (box->maxCoordinates.y > scene->side && velocity->y > 0.0f)) velocity->y = -velocity->y;
+
+        vector3_addScaledVector(&box->minCoordinates, velocity, TIME_FIXED_STEP_S);
+        vector3_addScaledVector(&box->maxCoordinates, velocity, TIME_FIXED_STEP_S);
+        if (update) sweepAndPrune_updateObject(&scene->sap, scene->ids[i], box);
+    }
+}
+
+static const AABB* bench_sap_sorted_boxes;
+
+int bench_sapCompareMinX(const void* a, const void* b)
+{
+    float min_a = bench_sap_sorted_boxes[*(const int*)a].minCoordinates.x;
+    float min_b = bench_sap_sorted_boxes[*(const int*)b].minCoordinates.x;
+    return (min_a > min_b) - (min_a < min_b);
+}
+
+/* every box sorted by min x from scratch and swept, the pairs overlapping on x and y like the sweep and prune */
+int bench_sapFullSweep(BenchSapScene* scene)
+{
+    int order_count = 0;
+    for (int i = 0; i < scene->count; i++) {
+        if (!scene->removed[i]) scene->order[order_count++] = i;
+    }
+    bench_sap_sorted_boxes = scene->boxes;
+    qsort(scene->order, order_count, sizeof(int), bench_sapCompareMinX);
+
+    int pair_count = 0;
+    for (int i = 0; i < order_count; i++) {
+
+        const AABB* box = &scene->boxes[scene->order[i]];
+
+        for (int j = i + 1; j < order_count; j++) {
+            const AABB* other = &scene->boxes[scene->order[j]];
+            if (other->minCoordinates.x > box->maxCoordinates.x) break;
+            if (other->minCoordinates.y > box->maxCoordinates.y || other->maxCoordinates.y < box->minCoordinates.y) continue;
+
+            assert(pair_count < scene->max_pairs);
+            scene->pairs[pair_count++] = broadphasePair_create(scene->ids[scene->order[i]], scene->ids[scene->order[j]]);
+        }
+    }
+
+    return pair_count;
+}
+
+int bench_sapComparePairs(const void* a, const void* b)
+{
+    const BroadphasePair* pair_a = a;
+    const BroadphasePair* pair_b = b;
+    if (pair_a->proxy_a != pair_b->proxy_a) return (pair_a->proxy_a < pair_b->proxy_a) ? -1 : 1;
+    if (pair_a->proxy_b != pair_b->proxy_b) return (pair_a->proxy_b < pair_b->proxy_b) ? -1 : 1;
+    return 0;
+}
+
+/* "pairs" sorted with bench_sapComparePairs */
+bool bench_sapHasPair(const BroadphasePair* pairs, int count, const BroadphasePair* pair)
+{
+    return bsearch(pair, pairs, count, sizeof(BroadphasePair), bench_sapComparePairs) != NULL;
+}
+
+/* the pairs of the sweep and prune against the full sweep, and its events against the pairs of the last frame.
+the sorted pairs are kept in "previous_pairs" for the next frame */
+bool bench_sapCheckFrame(BenchSapScene* scene, int* previous_count)
+{
+    SweepAndPrune* sap = &scene->sap;
+    bool passed = true;
+
+    int expected_count = bench_sapFullSweep(scene);
+    qsort(scene->pairs, expected_count, sizeof(BroadphasePair), bench_sapComparePairs);
+
+    BroadphasePair* pairs = scene->sap_pairs;
+    int count = sweepAndPrune_getPairs(sap, pairs, scene->max_pairs);
+    qsort(pairs, count, sizeof(BroadphasePair), bench_sapComparePairs);
+    if (count != expected_count || memcmp(pairs, scene->pairs, count * sizeof(BroadphasePair)) != 0) passed = false;
+
+    // A pair can come and go within a frame, the events only have to add up to the change
+    if (count != *previous_count + sap->added_count - sap->removed_count) passed = false;
+    for (int i = 0; i < count; i++) {
+        if (bench_sapHasPair(scene->previous_pairs, *previous_count, &pairs[i])) continue;
+        bool added = false;
+        for (int j = 0; j < sap->added_count && !added; j++) added = bench_sapComparePairs(&sap->added_pairs[j], &pairs[i]) == 0;
+        if (!added) passed = false;
+    }
+    for (int i = 0; i < *previous_count; i++) {
+        if (bench_sapHasPair(pairs, count, &scene->previous_pairs[i])) continue;
+        bool removed = false;
+        for (int j = 0; j < sap->removed_count && !removed; j++) removed = bench_sapComparePairs(&sap->removed_pairs[j], &scene->previous_pairs[i]) == 0;
+        if (!removed) passed = false;
+    }
+
+    memcpy(scene->previous_pairs, pairs, count * sizeof(BroadphasePair));
+    *previous_count = count;
+    sweepAndPrune_clearEvents(sap);
+    return passed;
+}
+
+void bench_sapRun(Bench* bench, int count)
+{
+    BenchSapScene scene;
+    bench_sapInit(&scene, count);
+    char name[64];
+
+    int previous_count = sweepAndPrune_getPairs(&scene.sap, scene.previous_pairs, scene.max_pairs);
+    qsort(scene.previous_pairs, previous_count, sizeof(BroadphasePair), bench_sapComparePairs);
+
+    bool matches = true;
+    for (int frame = 0; frame < BENCH_SAP_CHECKED_FRAMES; frame++) {
+        bench_sapMove(&scene, (frame % 2) ? 1 : BENCH_SAP_MOVING_STRIDE, true);
+        matches = bench_sapCheckFrame(&scene, &previous_count) && matches;
+    }
+
+    snprintf(name, sizeof(name), "pairs_%d", count);
+    bench_report(bench, name, previous_count, "count");
+    snprintf(name, sizeof(name), "matches_full_sweep_%d", count);
+    bench_check(bench, name, matches);
+
+    // The events are all a user of the incremental pairs reads, the full list costs a walk over the pair set
+    snprintf(name, sizeof(name), "sap_events_%d", count);
+    BENCH_TIME_FROM(bench, name, 1,
+        bench_sapMove(&scene, BENCH_SAP_MOVING_STRIDE, true);
+        sink += scene.sap.added_count - scene.sap.removed_count;
+        sweepAndPrune_clearEvents(&scene.sap));
+    snprintf(name, sizeof(name), "sap_%d", count);
+    BENCH_TIME_FROM(bench, name, 1,
+        bench_sapMove(&scene, BENCH_SAP_MOVING_STRIDE, true);
+        sink += sweepAndPrune_getPairs(&scene.sap, scene.pairs, scene.max_pairs);
+        sweepAndPrune_clearEvents(&scene.sap));
+    snprintf(name, sizeof(name), "full_resort_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, bench_sapMove(&scene, BENCH_SAP_MOVING_STRIDE, false); sink += bench_sapFullSweep(&scene));
+
+    snprintf(name, sizeof(name), "sap_events_all_moving_%d", count);
+    BENCH_TIME_FROM(bench, name, 1,
+        bench_sapMove(&scene, 1, true);
+        sink += scene.sap.added_count - scene.sap.removed_count;
+        sweepAndPrune_clearEvents(&scene.sap));
+    snprintf(name, sizeof(name), "sap_all_moving_%d", count);
+    BENCH_TIME_FROM(bench, name, 1,
+        bench_sapMove(&scene, 1, true);
+        sink += sweepAndPrune_getPairs(&scene.sap, scene.pairs, scene.max_pairs);
+        sweepAndPrune_clearEvents(&scene.sap));
+    snprintf(name, sizeof(name), "full_resort_all_moving_%d", count);
+    BENCH_TIME_FROM(bench, name, 1, bench_sapMove(&scene, 1, false); sink += bench_sapFullSweep(&scene));
+
+    // The full sweep moved the boxes without the sweep and prune, catch it up before checking again
+    for (int i = 0; i < count; i++) sweepAndPrune_updateObject(&scene.sap, scene.ids[i], &scene.boxes[i]);
+    sweepAndPrune_clearEvents(&scene.sap);
+    previous_count = sweepAndPrune_getPairs(&scene.sap, scene.previous_pairs, scene.max_pairs);
+    qsort(scene.previous_pairs, previous_count, sizeof(BroadphasePair), bench_sapComparePairs);
+
+    for (int i = 0; i < count; i += 2) {
+        sweepAndPrune_removeObject(&scene.sap, scene.ids[i]);
+        scene.removed[i] = true;
+    }
+    snprintf(name, sizeof(name), "matches_after_removing_half_%d", count);
+    bench_check(bench, name, bench_sapCheckFrame(&scene, &previous_count));
+
+    bench_sapDelete(&scene);
+}
+
+void bench_sweepAndPrune(Bench* bench)
+{
+    const int counts[] = {100, 500, 1000, 2000};
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) bench_sapRun(bench, counts[i]);
+}
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef BENCH_WORLD_H
+#define BENCH_WORLD_H
+
+/* BENCH_WORLD.H
+the broadphase and narrowphase pass of a PhysicsWorld on a crowd of spheres that all overlap each other,
+so every query returns far more candidates than a small fixed buffer holds. every overlapping pair has to
+end up with a manifold, whichever collider of the pair found it, and an actor standing in the crowd has to
+touch every sphere through the broadphase, also counted when its contact buffer is too small.
+with half the crowd on a layer the filter table keeps from touching itself, the pairs within that half have to be
+counted as skipped, every other pair as tested and given a manifold, and a second pass has to count them again from zero.
+a crowd of turned boxes, left to gjk, has to keep a gjk cache in the manifold of every touching pair,
+and starting from it has to take fewer iterations than a cold start */
+
+#define BENCH_WORLD_CROWD 48                // spheres in the crowd, each overlaps all the others
+#define BENCH_WORLD_RADIUS 10.0f
+#define BENCH_WORLD_SPREAD 4.0f             // half size of the cube the centers are scattered in
+#define BENCH_WORLD_BOX_SPREAD 40.0f        // the box crowd is looser, only some pairs touch
+#define BENCH_WORLD_FILTERED_LAYER 1        // layer number of the half of the crowd that doesn't touch itself
+
+
+// function prototypes
+
+void bench_world(Bench* bench);
+void bench_worldActor(Bench* bench, const Vector3* positions);
+void bench_worldBoxes(Bench* bench);
+void bench_worldFilters(Bench* bench, const Vector3* positions);
+
+
+// function implementations
+
+void bench_world(Bench* bench)
+{
+    int expected_pairs = BENCH_WORLD_CROWD * (BENCH_WORLD_CROWD - 1) / 2;
+
+    PhysicsWorld world;
+    physicsWorld_init(&world, BENCH_WORLD_CROWD, BENCH_WORLD_CROWD, expected_pairs);
+
+    Vector3 positions[BENCH_WORLD_CROWD];
+    for (int i = 0; i < BENCH_WORLD_CROWD; i++) {
+        positions[i] = bench_randomVector3(-BENCH_WORLD_SPREAD, BENCH_WORLD_SPREAD);
+        PoolHandle body = physicsWorld_createBody(&world, 1.0f, &positions[i]);
+
+        Collider sphere;
+        collider_init(&sphere, SPHERE_A);
+        sphere.sphere = (Sphere){positions[i], BENCH_WORLD_RADIUS};
+        physicsWorld_createCollider(&world, &sphere, body);
+    }
+
+    // Any two centers are closer than a diameter
+    int overlapping = 0;
+    for (int i = 0; i < BENCH_WORLD_CROWD; i++) {
+        for (int j = i + 1; j < BENCH_WORLD_CROWD; j++) {
+            Vector3 offset = vector3_difference(&positions[i], &positions[j]);
+            if (vector3_magnitude(&offset) < 2.0f * BENCH_WORLD_RADIUS) overlapping++;
+        }
+    }
+
+    physicsWorld_updateBroadphase(&world);
+    physicsWorld_collide(&world);
+
+    bench_report(bench, "crowd_overlapping_pairs", overlapping, "count");
+    bench_report(bench, "crowd_manifolds", world.manifolds.count, "count");
+    bench_check(bench, "crowd_every_pair_found", overlapping == expected_pairs && world.manifolds.count == overlapping);
+
+    BENCH_TIME_FROM(bench, "crowd_collide", 1, physicsWorld_collide(&world); sink += world.manifolds.count);
+
+    bench_worldActor(bench, positions);
+    bench_worldFilters(bench, positions);
+
+    physicsWorld_delete(&world);
+
+    bench_worldBoxes(bench);
+}
+
+void bench_worldActor(Bench* bench, const Vector3* positions)
+{
+    static Collider spheres[BENCH_WORLD_CROWD];
+    static ActorContactData contacts[BENCH_WORLD_CROWD];
+
+    DynamicTree tree;
+    dynamicTree_init(&tree);
+    for (int i = 0; i < BENCH_WORLD_CROWD; i++) {
+        collider_init(&spheres[i], SPHERE_A);
+        spheres[i].sphere = (Sphere){positions[i], BENCH_WORLD_RADIUS};
+        collider_addToBroadphase(&spheres[i], &tree);
+    }
+
+    // Its body runs through the middle of the cube of centers
+    ActorCollider collider = {.settings = {.body_radius = BENCH_WORLD_SPREAD, .body_height = 4.0f * BENCH_WORLD_SPREAD}};
+    actorCollider_init(&collider);
+    actorCollider_setVertical(&collider, &(Vector3){0.0f, 0.0f, -2.0f * BENCH_WORLD_SPREAD});
+
+    int found = actorCollision_contactBroadphase(contacts, BENCH_WORLD_CROWD, &collider, &tree);
+    int counted = actorCollision_contactBroadphase(contacts, BENCH_WORLD_CROWD / 4, &collider, &tree);
+
+    bench_report(bench, "actor_contacts", found, "count");
+    bench_check(bench, "actor_touches_every_sphere", found == BENCH_WORLD_CROWD && counted == BENCH_WORLD_CROWD);
+
+    BENCH_TIME(bench, "actor_contactBroadphase", sink += actorCollision_contactBroadphase(contacts, BENCH_WORLD_CROWD, &collider, &tree));
+
+    dynamicTree_delete(&tree);
+}
+
+void bench_worldFilters(Bench* bench, const Vector3* positions)
+{
+    int max_pairs = BENCH_WORLD_CROWD * (BENCH_WORLD_CROWD - 1) / 2;
+    int filtered = BENCH_WORLD_CROWD / 2;
+    int expected_skipped = filtered * (filtered - 1) / 2;
+
+    PhysicsWorld world;
+    physicsWorld_init(&world, BENCH_WORLD_CROWD, BENCH_WORLD_CROWD, max_pairs);
+    collisionFilterTable_setLayerPair(&world.filters, BENCH_WORLD_FILTERED_LAYER, BENCH_WORLD_FILTERED_LAYER, false);
+
+    PoolHandle colliders[BENCH_WORLD_CROWD];
+    for (int i = 0; i < BENCH_WORLD_CROWD; i++) {
+        PoolHandle body = physicsWorld_createBody(&world, 1.0f, &positions[i]);
+
+        Collider sphere;
+        collider_init(&sphere, SPHERE_A);
+        sphere.sphere = (Sphere){positions[i], BENCH_WORLD_RADIUS};
+        if (i < filtered) collisionFilter_set(&sphere.filter, 1 << BENCH_WORLD_FILTERED_LAYER, COLLISION_MASK_ALL);
+        colliders[i] = physicsWorld_createCollider(&world, &sphere, body);
+    }
+
+    physicsWorld_updateBroadphase(&world);
+    physicsWorld_collide(&world);
+    int tested = world.filters.tested_pairs;
+    int skipped = world.filters.skipped_pairs;
+
+    // No manifold joins two colliders of the filtered half
+    int filtered_manifolds = 0;
+    for (int i = 0; i < filtered; i++) {
+        for (int j = i + 1; j < filtered; j++) {
+            Collider* a = physicsWorld_getCollider(&world, colliders[i]);
+            Collider* b = physicsWorld_getCollider(&world, colliders[j]);
+            if (contactManifoldCache_get(&world.manifolds, a, b) != NULL) filtered_manifolds++;
+        }
+    }
+
+    physicsWorld_collide(&world);
+
+    bench_report(bench, "filtered_tested_pairs", tested, "count");
+    bench_report(bench, "filtered_skipped_pairs", skipped, "count");
+    bench_check(bench, "filtered_pairs_counted", skipped == expected_skipped && tested == max_pairs - expected_skipped);
+    bench_check(bench, "filtered_pairs_get_no_manifold", filtered_manifolds == 0 && world.manifolds.count == tested);
+    bench_check(bench, "filter_counters_cover_last_step", world.filters.tested_pairs == tested && world.filters.skipped_pairs == skipped);
+
+    BENCH_TIME_FROM(bench, "filtered_collide", 1, physicsWorld_collide(&world); sink += world.manifolds.count);
+
+    physicsWorld_delete(&world);
+}
+
+void bench_worldBoxes(Bench* bench)
+{
+    int max_pairs = BENCH_WORLD_CROWD * (BENCH_WORLD_CROWD - 1) / 2;
+
+    PhysicsWorld world;
+    physicsWorld_init(&world, BENCH_WORLD_CROWD, BENCH_WORLD_CROWD, max_pairs);
+
+    for (int i = 0; i < BENCH_WORLD_CROWD; i++) {
+        Vector3 position = bench_randomVector3(-BENCH_WORLD_BOX_SPREAD, BENCH_WORLD_BOX_SPREAD);
+        PoolHandle body = physicsWorld_createBody(&world, 1.0f, &position);
+
+        Collider box;
+        collider_init(&box, BOX_A);
+        Vector3 size = bench_randomVector3(10.0f, 30.0f);
+        Vector3 rotation = bench_randomVector3(0.0f, 360.0f);
+        box_init(&box.box, &size, &position, &rotation);
+        physicsWorld_createCollider(&world, &box, body);
+    }
+
+    // The second pass finds the caches the first one left
+    physicsWorld_updateBroadphase(&world);
+    physicsWorld_collide(&world);
+    physicsWorld_collide(&world);
+
+    int manifolds = 0;
+    int missing = 0;
+    int cold_iterations = 0;
+    int cached_iterations = 0;
+
+    for (int i = 0; i < world.manifolds.capacity; i++) {
+
+        const ContactManifold* manifold = &world.manifolds.manifolds[i];
+        if (manifold->collider_a == NULL) continue;
+
+        manifolds++;
+        if (vector3_isZero(&manifold->gjk.direction)) missing++;
+
+        ConvexShape shape_a = convexShape_fromCollider(manifold->collider_a);
+        ConvexShape shape_b = convexShape_fromCollider(manifold->collider_b);
+        GjkCache cache = manifold->gjk;
+        GjkResult result;
+        gjk_getDistance(&result, &shape_a, &shape_b, NULL);
+        cold_iterations += result.iterations;
+        gjk_getDistance(&result, &shape_a, &shape_b, &cache);
+        cached_iterations += result.iterations;
+    }
+
+    bench_report(bench, "boxes_manifolds", manifolds, "count");
+    bench_report(bench, "boxes_gjk_iterations", (double)cold_iterations / manifolds, "count");
+    bench_report(bench, "boxes_gjk_iterations_cached", (double)cached_iterations / manifolds, "count");
+    bench_check(bench, "boxes_manifolds_keep_gjk_cache", manifolds > 0 && missing == 0);
+    bench_check(bench, "boxes_cached_gjk_takes_fewer_iterations", cached_iterations < cold_iterations);
+
+    BENCH_TIME_FROM(bench, "boxes_collide", 1, physicsWorld_collide(&world); sink += world.manifolds.count);
+
+    physicsWorld_delete(&world);
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef BENCH_LIBDRAGON_STUB_H
+#define BENCH_LIBDRAGON_STUB_H
+
+/* LIBDRAGON.H
+the part of libdragon the game headers use outside of rendering, just enough to build them on the host.
+the clock counts from the start of the process like the console one counts from boot, until a suite
+drives it with stub_setTicksUs. the joypad reports what the last stub_setJoypad call set, with the
+pressed buttons found on poll like the console does */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+
+// structures
+
+typedef enum {
+    JOYPAD_PORT_1,
+    JOYPAD_PORT_2,
+    JOYPAD_PORT_3,
+    JOYPAD_PORT_4,
+} joypad_port_t;
+
+typedef union {
+    uint32_t raw;
+    struct __attribute__((packed)) {
+        unsigned a : 1;
+        unsigned b : 1;
+        unsigned z : 1;
+        unsigned start : 1;
+        unsigned d_up : 1;
+        unsigned d_down : 1;
+        unsigned d_left : 1;
+        unsigned d_right : 1;
+        unsigned y : 1;
+        unsigned x : 1;
+        unsigned l : 1;
+        unsigned r : 1;
+        unsigned c_up : 1;
+        unsigned c_down : 1;
+        unsigned c_left : 1;
+        unsigned c_right : 1;
+        unsigned : 16;
+    };
+} joypad_buttons_t;
+
+typedef struct {
+    joypad_buttons_t btn;
+    int8_t stick_x;
+    int8_t stick_y;
+    int8_t cstick_x;
+    int8_t cstick_y;
+    uint8_t analog_l;
+    uint8_t analog_r;
+} joypad_inputs_t;
+
+typedef struct rspq_block_s rspq_block_t;
+
+
+// function prototypes
+
+unsigned long get_ticks_ms();
+unsigned long get_ticks_us();
+void stub_setTicksUs(unsigned long ticks_us);
+
+void joypad_init();
+void joypad_poll();
+joypad_buttons_t joypad_get_buttons_pressed(joypad_port_t port);
+joypad_buttons_t joypad_get_buttons_held(joypad_port_t port);
+joypad_inputs_t joypad_get_inputs(joypad_port_t port);
+void stub_setJoypad(joypad_buttons_t held, int8_t stick_x, int8_t stick_y);
+
+void* malloc_uncached(size_t size);
+void free_uncached(void* buffer);
+void rspq_block_begin();
+rspq_block_t* rspq_block_end();
+void rspq_block_run(rspq_block_t* block);
+
+
+// function implementations
+
+static bool stub_manual_clock = false;
+static unsigned long stub_ticks_us = 0;
+
+unsigned long get_ticks_us()
+{
+    if (stub_manual_clock) return stub_ticks_us;
+
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long)(time.tv_sec * 1000000ull + time.tv_nsec / 1000);
+}
+
+unsigned long get_ticks_ms()
+{
+    return get_ticks_us() / 1000;
+}
+
+/* stops the clock at "ticks_us", it only moves with the next call */
+void stub_setTicksUs(unsigned long ticks_us)
+{
+    stub_manual_clock = true;
+    stub_ticks_us = ticks_us;
+}
+
+static joypad_inputs_t stub_joypad_next = {0};
+static joypad_inputs_t stub_joypad_inputs = {0};
+static joypad_buttons_t stub_joypad_pressed = {0};
+
+void joypad_init()
+{
+}
+
+/* pressed holds the buttons that went down since the previous poll */
+void joypad_poll()
+{
+    stub_joypad_pressed.raw = stub_joypad_next.btn.raw & ~stub_joypad_inputs.btn.raw;
+    stub_joypad_inputs = stub_joypad_next;
+}
+
+joypad_buttons_t joypad_get_buttons_pressed(joypad_port_t port)
+{
+    return (port == JOYPAD_PORT_1) ? stub_joypad_pressed : (joypad_buttons_t){0};
+}
+
+joypad_buttons_t joypad_get_buttons_held(joypad_port_t port)
+{
+    return (port == JOYPAD_PORT_1) ? stub_joypad_inputs.btn : (joypad_buttons_t){0};
+}
+
+joypad_inputs_t joypad_get_inputs(joypad_port_t port)
+{
+    return (port == JOYPAD_PORT_1) ? stub_joypad_inputs : (joypad_inputs_t){0};
+}
+
+/* state of the first controller from the next poll on */
+void stub_setJoypad(joypad_buttons_t held, int8_t stick_x, int8_t stick_y)
+{
+    stub_joypad_next = (joypad_inputs_t){.btn = held, .stick_x = stick_x, .stick_y = stick_y};
+}
+
+void* malloc_uncached(size_t size)
+{
+    return malloc(size);
+}
+
+void free_uncached(void* buffer)
+{
+    free(buffer);
+}
+
+void rspq_block_begin()
+{
+}
+
+rspq_block_t* rspq_block_end()
+{
+    return NULL;
+}
+
+void rspq_block_run(rspq_block_t* block)
+{
+}
+
+#endif
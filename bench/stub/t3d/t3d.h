@@ -0,0 +1,26 @@
+#ifndef BENCH_T3D_STUB_H
+#define BENCH_T3D_STUB_H
+
+/* T3D.H
+the types and calls of tiny3d the actor headers reference, they draw nothing on the host */
+
+
+// structures
+
+typedef struct {
+    int32_t m[4][4];
+} T3DMat4FP;
+
+
+// function prototypes
+
+void t3d_matrix_set(const T3DMat4FP* matrix, bool multiply);
+
+
+// function implementations
+
+void t3d_matrix_set(const T3DMat4FP* matrix, bool multiply)
+{
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BENCH_T3DMATH_STUB_H
+#define BENCH_T3DMATH_STUB_H
+
+/* T3DMATH.H
+fixed point matrix setters of tiny3d, only cleared on the host */
+
+
+// function prototypes
+
+void t3d_mat4fp_identity(T3DMat4FP* matrix);
+void t3d_mat4fp_from_srt_euler(T3DMat4FP* matrix, const float scale[3], const float rotation[3], const float translation[3]);
+
+
+// function implementations
+
+void t3d_mat4fp_identity(T3DMat4FP* matrix)
+{
+    memset(matrix, 0, sizeof(T3DMat4FP));
+}
+
+void t3d_mat4fp_from_srt_euler(T3DMat4FP* matrix, const float scale[3], const float rotation[3], const float translation[3])
+{
+    memset(matrix, 0, sizeof(T3DMat4FP));
+}
+
+#endif
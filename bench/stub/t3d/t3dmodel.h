@@ -0,0 +1,30 @@
+#ifndef BENCH_T3DMODEL_STUB_H
+#define BENCH_T3DMODEL_STUB_H
+
+/* T3DMODEL.H
+models of tiny3d, nothing is loaded on the host */
+
+
+// structures
+
+typedef struct T3DModel T3DModel;
+
+
+// function prototypes
+
+T3DModel* t3d_model_load(const char* path);
+void t3d_model_draw(const T3DModel* model);
+
+
+// function implementations
+
+T3DModel* t3d_model_load(const char* path)
+{
+    return NULL;
+}
+
+void t3d_model_draw(const T3DModel* model)
+{
+}
+
+#endif
@@ -35,6 +35,9 @@ typedef struct {
 	
 	float max_pitch;
 
+	float collision_radius;		// of the sphere cast against the level, keeps the near plane out of the walls
+	float collision_ease_rate;	// how fast the camera goes back out after a collision, per second
+
 } CameraSettings;
 
 
@@ -119,6 +122,8 @@ Camera camera_create()
         	.offset_angle = 23,
         	.offset_angle_aim = 30,
         	.max_pitch = 70,
+        	.collision_radius = 30,
+        	.collision_ease_rate = 4,
         },
     };
 
@@ -151,33 +156,31 @@ void camera_getOrbitalPosition(Camera *camera, Vector3 barycenter, float frame_t
     if (camera->pitch > camera->settings.max_pitch) camera->pitch = camera->settings.max_pitch;
     if (camera->pitch < -camera->settings.max_pitch + 30) camera->pitch = -camera->settings.max_pitch + 30; // this hard coded + 20 is for the near plane to not enter the actor geometry during "camera collision"
 
-    camera->horizontal_barycenter_distance = camera->distance_from_barycenter * cosf(rad(camera->pitch));
-	camera->vertical_barycenter_distance = camera->distance_from_barycenter * sinf(rad(camera->pitch));
+    // The angles don't change inside this function, so each sine and cosine pair is computed once
+    float sin_pitch, cos_pitch;
+    trig_sinCos(rad(camera->pitch), &sin_pitch, &cos_pitch);
+
+    float sin_orbit, cos_orbit;
+    trig_sinCos(rad(camera->angle_around_barycenter - camera->offset_angle), &sin_orbit, &cos_orbit);
+
+    float sin_around, cos_around;
+    trig_sinCos(rad(camera->angle_around_barycenter), &sin_around, &cos_around);
+
+    // The position wanted without collisions, camera_collide pulls it in along the arm
+    camera->horizontal_barycenter_distance = camera->settings.distance_from_baricenter * cos_pitch;
+	camera->vertical_barycenter_distance = camera->settings.distance_from_baricenter * sin_pitch;
 
-	camera-> horizontal_target_distance = camera->target_distance * cosf(rad(camera->pitch));
-	camera->vertical_target_distance = camera->target_distance * sinf(rad(camera->pitch + 180));
+	camera-> horizontal_target_distance = camera->target_distance * cos_pitch;
+	camera->vertical_target_distance = camera->target_distance * -sin_pitch;
 
-    camera->position.x = barycenter.x - (camera->horizontal_barycenter_distance * sinf(rad(camera->angle_around_barycenter - camera->offset_angle)));
-    camera->position.y = barycenter.y - (camera->horizontal_barycenter_distance * cosf(rad(camera->angle_around_barycenter - camera->offset_angle)));
+    camera->position.x = barycenter.x - (camera->horizontal_barycenter_distance * sin_orbit);
+    camera->position.y = barycenter.y - (camera->horizontal_barycenter_distance * cos_orbit);
     camera->position.z = barycenter.z + camera->offset_height + camera->vertical_barycenter_distance;
-	
-	/* this is a temporary brute force abomination to "collide" the camera with an horizontal plane at height 20 simulating the floor,
-    will be modyfied when camera collision happens */
-	/*
-	*/
-	camera->distance_from_barycenter = camera->settings.distance_from_baricenter;
-	while (camera->position.z < 30)  {
-		camera->distance_from_barycenter--; 
-		camera->horizontal_barycenter_distance = camera->distance_from_barycenter * cosf(rad(camera->pitch));
-		camera->vertical_barycenter_distance = camera->distance_from_barycenter * sinf(rad(camera->pitch));
-
-		camera->position.x = barycenter.x - camera->horizontal_barycenter_distance * sinf(rad(camera->angle_around_barycenter - camera->offset_angle));
-		camera->position.y = barycenter.y - camera->horizontal_barycenter_distance * cosf(rad(camera->angle_around_barycenter - camera->offset_angle));
-		camera->position.z = barycenter.z + camera->offset_height + camera->vertical_barycenter_distance;
-	}
 
-	camera->target.x = barycenter.x - camera-> horizontal_target_distance * sinf(rad(camera->angle_around_barycenter + 180));
-	camera->target.y = barycenter.y - camera-> horizontal_target_distance * cosf(rad(camera->angle_around_barycenter + 180));
+
+	// The target sits on the opposite side of the orbit, sin(a + 180) = -sin(a) and cos(a + 180) = -cos(a)
+	camera->target.x = barycenter.x + camera-> horizontal_target_distance * sin_around;
+	camera->target.y = barycenter.y + camera-> horizontal_target_distance * cos_around;
 	camera->target.z = barycenter.z + camera->offset_height + camera->vertical_target_distance;
 }
 
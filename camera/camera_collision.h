@@ -0,0 +1,73 @@
+#ifndef CAMERA_COLLISION_H
+#define CAMERA_COLLISION_H
+
+/* CAMERA_COLLISION.H
+keeps the camera out of the level. a sphere is cast once per frame from the pivot of the orbit (barycenter plus offset height)
+towards the position camera_getOrbitalPosition wants, and the camera stops where it hits.
+it moves in at once so it never clips, and eases back out once the way is clear */
+
+
+// function prototypes
+
+float camera_castSphere(const Vector3* pivot, const Vector3* displacement, float radius, const Collider* colliders, int collider_count);
+void camera_collide(Camera *camera, Vector3 barycenter, const Collider* colliders, int collider_count, float frame_time);
+
+
+// function implementations
+
+/* returns the fraction of "displacement" a sphere of "radius" travels from "pivot" before touching "colliders", 1 when clear.
+the other collider types are skipped */
+float camera_castSphere(const Vector3* pivot, const Vector3* displacement, float radius, const Collider* colliders, int collider_count)
+{
+    // A capsule with both ends together is the sphere, so the capsule sweeps do the cast
+    Capsule sphere = {*pivot, *pivot, radius, 0.0f};
+    float nearest = 1.0f;
+
+    for (int i = 0; i < collider_count; i++) {
+
+        const Collider* collider = &colliders[i];
+        ContactData contact;
+        float time;
+        bool hit;
+
+        switch(collider->type) {
+            case SPHERE_A: hit = capsule_sweepSphere(&contact, &time, &sphere, displacement, &collider->sphere); break;
+            case AABB_A: hit = capsule_sweepAABB(&contact, &time, &sphere, displacement, &collider->aabb); break;
+            case BOX_A: hit = capsule_sweepBox(&contact, &time, &sphere, displacement, &collider->box); break;
+            case PLANE_A: hit = capsule_sweepPlane(&contact, &time, &sphere, displacement, &collider->plane); break;
+            case TERRAIN_A: hit = capsule_sweepHeightfield(&contact, &time, &sphere, displacement, collider->terrain); break;
+            case MESH_A: hit = capsule_sweepMesh(&contact, &time, &sphere, displacement, collider->mesh); break;
+            default: hit = false; break;
+        }
+
+        if (hit && time < nearest) nearest = max2(time, 0.0f);
+    }
+
+    return nearest;
+}
+
+/* call after camera_getOrbitalPosition, moves the camera along the orbit arm to the allowed distance */
+void camera_collide(Camera *camera, Vector3 barycenter, const Collider* colliders, int collider_count, float frame_time)
+{
+    Vector3 pivot = {barycenter.x, barycenter.y, barycenter.z + camera->offset_height};
+    Vector3 arm = vector3_difference(&camera->position, &pivot);
+    float desired_distance = camera->settings.distance_from_baricenter;
+
+    float allowed_distance = desired_distance * camera_castSphere(&pivot, &arm, camera->settings.collision_radius, colliders, collider_count);
+
+    if (allowed_distance < camera->distance_from_barycenter) camera->distance_from_barycenter = allowed_distance;
+    else {
+        float step = min2(camera->settings.collision_ease_rate * frame_time, 1.0f);
+        camera->distance_from_barycenter += (allowed_distance - camera->distance_from_barycenter) * step;
+    }
+
+    // Scaling the arm keeps the angles, no trigonometry needed
+    float scale = camera->distance_from_barycenter / desired_distance;
+    camera->horizontal_barycenter_distance *= scale;
+    camera->vertical_barycenter_distance *= scale;
+
+    camera->position = pivot;
+    vector3_addScaledVector(&camera->position, &arm, scale);
+}
+
+#endif
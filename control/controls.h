@@ -12,15 +12,32 @@ typedef struct {
 } ControllerData;
 
 
+void controllerData_init(ControllerData* data);
 void controllerData_getInputs(ControllerData* data);
+void controllerData_clearPressed(ControllerData* data);
 
 
+void controllerData_init(ControllerData* data)
+{
+    data->pressed.raw = 0;
+    data->held.raw = 0;
+    data->input = (joypad_inputs_t){0};
+}
+
+/* the pressed buttons add up over the frames until controllerData_clearPressed,
+so a press on a frame that runs no physics tick still reaches the next tick */
 void controllerData_getInputs(ControllerData* data)
 {
     joypad_poll();
-    data->pressed = joypad_get_buttons_pressed(JOYPAD_PORT_1);
+    data->pressed.raw |= joypad_get_buttons_pressed(JOYPAD_PORT_1).raw;
     data->held = joypad_get_buttons_held(JOYPAD_PORT_1);
     data->input = joypad_get_inputs(JOYPAD_PORT_1); 
 }
 
+/* call once a physics tick has read the pressed buttons */
+void controllerData_clearPressed(ControllerData* data)
+{
+    data->pressed.raw = 0;
+}
+
 #endif
\ No newline at end of file
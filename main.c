@@ -12,6 +12,7 @@
 #include "camera/camera.h"
 #include "camera/camera_states.h"
 #include "camera/camera_control.h"
+#include "camera/camera_collision.h"
 
 #include "actor/actor.h"
 #include "actor/actor_states.h"
@@ -38,6 +39,7 @@ int main()
 	time_init(&timing);
 
 	ControllerData control;
+	controllerData_init(&control);
 
 	t3d_init((T3DInitParams){});
 
@@ -54,6 +56,21 @@ int main()
 	//scenery
 	Scenery ground = scenery_create(0, "rom:/ground.t3dm");
 
+	// the level geometry for the camera to collide with, the floor plane stands in if the mesh can't be read
+	TriangleMeshData ground_data;
+	TriangleMesh ground_mesh;
+	Collider level_collider;
+
+	if (triangleMeshData_loadGlb(&ground_data, "rom:/ground.glb")) {
+		triangleMesh_init(&ground_mesh, ground_data.vertices, ground_data.indices, ground_data.triangle_count);
+		collider_init(&level_collider, MESH_A);
+		level_collider.mesh = &ground_mesh;
+	}
+	else {
+		collider_init(&level_collider, PLANE_A);
+		plane_setFromNormalAndPoint(&level_collider.plane, &(Vector3){0, 0, 1}, &(Vector3){0, 0, 0});
+	}
+
 	for(;;)
 	{
 		// ======== Update ======== //
@@ -61,13 +78,19 @@ int main()
 		controllerData_getInputs(&control);
 		time_setData(&timing);
 		
-		actorControl_setMotion(&player, &control, timing.frame_time_s, camera.angle_around_barycenter, camera.offset_angle);
-		actor_integrate(&player, timing.frame_time_s);
-		actor_setState(&player, player.state);
-		actor_set(&player);
+		// physics runs in fixed ticks, any number of them per frame
+		while (time_consumeFixedStep(&timing)) {
+			actorControl_setMotion(&player, &control, timing.fixed_time_s, camera.angle_around_barycenter, camera.offset_angle);
+			actor_integrate(&player, timing.fixed_time_s);
+			actor_setState(&player, player.state);
+			controllerData_clearPressed(&control);
+		}
+		actor_set(&player, timing.interpolation_factor);
 
 		cameraControl_setOrbitalMovement(&camera, &control);
-		camera_getOrbitalPosition(&camera, player.body.position, timing.frame_time_s);
+		Vector3 barycenter = rigidBody_getInterpolatedPosition(&player.body, timing.interpolation_factor);
+		camera_getOrbitalPosition(&camera, barycenter, timing.frame_time_s);
+		camera_collide(&camera, barycenter, &level_collider, 1, timing.frame_time_s);
 		camera_set(&camera, &screen);
 
 		scenery_set(&ground);
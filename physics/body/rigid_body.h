@@ -9,14 +9,22 @@
 #define RIGID_BODY_H
 
 
-typedef struct RigidBody {
+/* aligned so a pool of bodies is also a plain array of them, with every body on GLOBAL_ALIGNMENT */
+typedef struct __attribute__((aligned(GLOBAL_ALIGNMENT))) RigidBody {
 
     Vector3 acceleration;
     Vector3 velocity;
     Vector3 position;
     Vector3 rotation;
 
-    Vector3 previous_position;
+    Vector3 previous_position;      // position before the last integration step
+
+    float inverse_mass;             // 0 for bodies the contact solver can't move
+    float friction;
+    Vector3 split_velocity;         // position correction of the split impulses, applied once by the next position step
+
+    bool sleeping;                  // skipped by the integration until woken up
+    float sleep_time;               // seconds spent under the sleep velocity
     
     //Quaternion orientation;
 
@@ -24,5 +32,83 @@ typedef struct RigidBody {
 } RigidBody;
 
 
+// function prototypes
+
+void rigidBody_setMass(RigidBody* body, float mass);
+void rigidBody_wakeUp(RigidBody* body);
+void rigidBody_applyImpulse(RigidBody* body, const Vector3* impulse);
+bool rigidBody_isActive(const RigidBody* body);
+bool rigidBody_updateSleepTime(RigidBody* body, float time_step);
+void rigidBody_integrateVelocity(RigidBody* body, float time_step);
+void rigidBody_integratePosition(RigidBody* body, float time_step);
+Vector3 rigidBody_getInterpolatedPosition(const RigidBody* body, float factor);
+
+
+// function implementations
+
+/* a mass of 0 makes the body static */
+void rigidBody_setMass(RigidBody* body, float mass)
+{
+    assert(mass >= 0.0f);
+    body->inverse_mass = (mass > 0.0f) ? 1.0f / mass : 0.0f;
+}
+
+void rigidBody_wakeUp(RigidBody* body)
+{
+    body->sleeping = false;
+    body->sleep_time = 0.0f;
+}
+
+/* external impulses wake the body up */
+void rigidBody_applyImpulse(RigidBody* body, const Vector3* impulse)
+{
+    rigidBody_wakeUp(body);
+    vector3_addScaledVector(&body->velocity, impulse, body->inverse_mass);
+}
+
+/* returns false for bodies that can't move this step: NULL (static geometry), static or sleeping.
+pairs where neither body is active need no broadphase update nor narrowphase */
+bool rigidBody_isActive(const RigidBody* body)
+{
+    return body != NULL && body->inverse_mass > 0.0f && !body->sleeping;
+}
+
+/* counts the time the body stays under DEFAULT_SLEEP_LINEAR_VELOCITY, returns true once it could sleep.
+the islands decide if it actually sleeps */
+bool rigidBody_updateSleepTime(RigidBody* body, float time_step)
+{
+    if (vector3_squaredMagnitude(&body->velocity) > DEFAULT_SLEEP_LINEAR_VELOCITY * DEFAULT_SLEEP_LINEAR_VELOCITY) body->sleep_time = 0.0f;
+    else body->sleep_time += time_step;
+
+    return body->sleep_time >= DEFAULT_TIME_BEFORE_SLEEP;
+}
+
+/* semi implicit euler, the contact solver runs between the velocity and the position step */
+void rigidBody_integrateVelocity(RigidBody* body, float time_step)
+{
+    if (body->sleeping) return;
+    vector3_addScaledVector(&body->velocity, &body->acceleration, time_step);
+}
+
+void rigidBody_integratePosition(RigidBody* body, float time_step)
+{
+    body->previous_position = body->position;
+    if (body->sleeping) return;
+
+    Vector3 velocity = vector3_sum(&body->velocity, &body->split_velocity);
+    vector3_addScaledVector(&body->position, &velocity, time_step);
+    body->split_velocity = (Vector3){0.0f, 0.0f, 0.0f};
+}
+
+/* returns the position "factor" of the way from the previous step to the current one, for rendering between physics ticks */
+Vector3 rigidBody_getInterpolatedPosition(const RigidBody* body, float factor)
+{
+    Transform previous = {body->previous_position, {0.0f, 0.0f, 0.0f, 1.0f}};
+    Transform current = {body->position, {0.0f, 0.0f, 0.0f, 1.0f}};
+    Transform interpolated = transform_getInterpolated(&previous, &current, factor);
+    return interpolated.position;
+}
+
+
 
 #endif
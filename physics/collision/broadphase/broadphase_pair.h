@@ -0,0 +1,24 @@
+#ifndef BROADPHASE_PAIR_H
+#define BROADPHASE_PAIR_H
+
+// structures
+
+/* candidate pair produced by a broadphase, "proxy_a" is always lower than "proxy_b" */
+typedef struct {
+    int proxy_a;
+    int proxy_b;
+} BroadphasePair;
+
+// function prototypes
+
+BroadphasePair broadphasePair_create(int proxy_a, int proxy_b);
+
+// function implementations
+
+BroadphasePair broadphasePair_create(int proxy_a, int proxy_b)
+{
+    if (proxy_a < proxy_b) return (BroadphasePair){proxy_a, proxy_b};
+    return (BroadphasePair){proxy_b, proxy_a};
+}
+
+#endif
@@ -0,0 +1,628 @@
+#ifndef DYNAMIC_TREE_H
+#define DYNAMIC_TREE_H
+
+/* DYNAMIC_TREE.H
+bounding volume hierarchy of fat AABBs used as broadphase.
+every object is a leaf of the tree, internal nodes enclose their two children.
+the fat AABBs let an object move a little without touching the tree, and the tree
+is kept balanced with rotations every time a leaf is inserted or removed */
+
+#define DYNAMIC_TREE_NULL_NODE -1
+#define DYNAMIC_TREE_INITIAL_CAPACITY 16
+#define DYNAMIC_TREE_STACK_SIZE 128
+
+
+// structures
+
+/* called by dynamicTree_queryCallback for each object found, returning false ends the query */
+typedef bool (*DynamicTreeQueryCallback)(int proxy_id, void* context);
+
+typedef struct {
+
+    AABB aabb;              // fat AABB for leaves, enclosing AABB for internal nodes
+    void* data;             // user data of the object, only used by leaves
+    CollisionFilter filter; // of the object, pairs it rejects are never generated
+
+    union {
+        int parent_id;
+        int next_free_id;
+    };
+
+    int children[2];
+    int height;             // 0 for leaves, -1 for free nodes
+    bool moved;             // the leaf was inserted or reinserted since the last pair update
+
+} DynamicTreeNode;
+
+typedef struct {
+
+    DynamicTreeNode* nodes;
+    int root_id;
+    int node_count;
+    int node_capacity;
+    int free_id;
+
+    int* move_buffer;       // leaves that need their pairs recomputed
+    int move_count;
+    int move_capacity;
+
+} DynamicTree;
+
+
+// function prototypes
+
+void dynamicTree_init(DynamicTree* tree);
+void dynamicTree_delete(DynamicTree* tree);
+
+int dynamicTree_addObject(DynamicTree* tree, const AABB* aabb, void* data);
+void dynamicTree_removeObject(DynamicTree* tree, int proxy_id);
+bool dynamicTree_updateObject(DynamicTree* tree, int proxy_id, const AABB* aabb, bool force_reinsert);
+
+void* dynamicTree_getData(const DynamicTree* tree, int proxy_id);
+void dynamicTree_setFilter(DynamicTree* tree, int proxy_id, const CollisionFilter* filter);
+const AABB* dynamicTree_getFatAABB(const DynamicTree* tree, int proxy_id);
+int dynamicTree_getHeight(const DynamicTree* tree);
+
+int dynamicTree_queryAABB(const DynamicTree* tree, const AABB* aabb, int* proxies, int max_proxies);
+void dynamicTree_queryCallback(const DynamicTree* tree, const AABB* aabb, DynamicTreeQueryCallback callback, void* context);
+int dynamicTree_getOverlappingPairs(DynamicTree* tree, BroadphasePair* pairs, int max_pairs, CollisionFilterTable* filters);
+bool dynamicTree_hasMoves(const DynamicTree* tree);
+void dynamicTree_clearMoves(DynamicTree* tree);
+
+int dynamicTree_allocateNode(DynamicTree* tree);
+void dynamicTree_freeNode(DynamicTree* tree, int node_id);
+void dynamicTree_insertLeaf(DynamicTree* tree, int leaf_id);
+void dynamicTree_removeLeaf(DynamicTree* tree, int leaf_id);
+int dynamicTree_balance(DynamicTree* tree, int node_id);
+void dynamicTree_bufferMove(DynamicTree* tree, int proxy_id);
+void dynamicTree_unbufferMove(DynamicTree* tree, int proxy_id);
+
+
+// function implementations
+
+void dynamicTree_init(DynamicTree* tree)
+{
+    tree->root_id = DYNAMIC_TREE_NULL_NODE;
+    tree->node_count = 0;
+    tree->node_capacity = DYNAMIC_TREE_INITIAL_CAPACITY;
+    tree->nodes = malloc(tree->node_capacity * sizeof(DynamicTreeNode));
+    assert(tree->nodes != NULL);
+
+    // Link all the nodes in the free list
+    for (int i = 0; i < tree->node_capacity - 1; i++) {
+        tree->nodes[i].next_free_id = i + 1;
+        tree->nodes[i].height = -1;
+    }
+    tree->nodes[tree->node_capacity - 1].next_free_id = DYNAMIC_TREE_NULL_NODE;
+    tree->nodes[tree->node_capacity - 1].height = -1;
+    tree->free_id = 0;
+
+    tree->move_count = 0;
+    tree->move_capacity = DYNAMIC_TREE_INITIAL_CAPACITY;
+    tree->move_buffer = malloc(tree->move_capacity * sizeof(int));
+    assert(tree->move_buffer != NULL);
+}
+
+void dynamicTree_delete(DynamicTree* tree)
+{
+    free(tree->nodes);
+    free(tree->move_buffer);
+    tree->nodes = NULL;
+    tree->move_buffer = NULL;
+    tree->root_id = DYNAMIC_TREE_NULL_NODE;
+    tree->node_count = 0;
+    tree->node_capacity = 0;
+    tree->move_count = 0;
+    tree->move_capacity = 0;
+}
+
+/* inserts a new object and returns its proxy id, the AABB stored is the inflated "aabb" */
+int dynamicTree_addObject(DynamicTree* tree, const AABB* aabb, void* data)
+{
+    int proxy_id = dynamicTree_allocateNode(tree);
+
+    tree->nodes[proxy_id].aabb = *aabb;
+    aabb_inflate(&tree->nodes[proxy_id].aabb, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE);
+    tree->nodes[proxy_id].data = data;
+    collisionFilter_set(&tree->nodes[proxy_id].filter, COLLISION_LAYER_DEFAULT, COLLISION_MASK_ALL);
+    tree->nodes[proxy_id].height = 0;
+    tree->nodes[proxy_id].moved = true;
+
+    dynamicTree_insertLeaf(tree, proxy_id);
+    dynamicTree_bufferMove(tree, proxy_id);
+
+    return proxy_id;
+}
+
+void dynamicTree_removeObject(DynamicTree* tree, int proxy_id)
+{
+    assert(proxy_id >= 0 && proxy_id < tree->node_capacity);
+    assert(tree->nodes[proxy_id].height == 0);
+
+    dynamicTree_unbufferMove(tree, proxy_id);
+    dynamicTree_removeLeaf(tree, proxy_id);
+    dynamicTree_freeNode(tree, proxy_id);
+}
+
+/* updates the object with its new tight "aabb". the leaf is only reinserted when
+the new AABB gets out of the fat one, returns true in that case */
+bool dynamicTree_updateObject(DynamicTree* tree, int proxy_id, const AABB* aabb, bool force_reinsert)
+{
+    assert(proxy_id >= 0 && proxy_id < tree->node_capacity);
+    assert(tree->nodes[proxy_id].height == 0);
+
+    if (!force_reinsert && aabb_containsAABB(&tree->nodes[proxy_id].aabb, aabb)) return false;
+
+    dynamicTree_removeLeaf(tree, proxy_id);
+
+    tree->nodes[proxy_id].aabb = *aabb;
+    aabb_inflate(&tree->nodes[proxy_id].aabb, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE);
+
+    dynamicTree_insertLeaf(tree, proxy_id);
+
+    if (!tree->nodes[proxy_id].moved) {
+        tree->nodes[proxy_id].moved = true;
+        dynamicTree_bufferMove(tree, proxy_id);
+    }
+
+    return true;
+}
+
+void* dynamicTree_getData(const DynamicTree* tree, int proxy_id)
+{
+    assert(proxy_id >= 0 && proxy_id < tree->node_capacity);
+    return tree->nodes[proxy_id].data;
+}
+
+/* objects are added with the default filter, colliding with everything */
+void dynamicTree_setFilter(DynamicTree* tree, int proxy_id, const CollisionFilter* filter)
+{
+    assert(proxy_id >= 0 && proxy_id < tree->node_capacity);
+    tree->nodes[proxy_id].filter = *filter;
+}
+
+const AABB* dynamicTree_getFatAABB(const DynamicTree* tree, int proxy_id)
+{
+    assert(proxy_id >= 0 && proxy_id < tree->node_capacity);
+    return &tree->nodes[proxy_id].aabb;
+}
+
+int dynamicTree_getHeight(const DynamicTree* tree)
+{
+    if (tree->root_id == DYNAMIC_TREE_NULL_NODE) return 0;
+    return tree->nodes[tree->root_id].height;
+}
+
+/* writes in "proxies" the ids of the objects whose fat AABB overlaps "aabb",
+returns how many were written (never more than "max_proxies") */
+int dynamicTree_queryAABB(const DynamicTree* tree, const AABB* aabb, int* proxies, int max_proxies)
+{
+    int count = 0;
+    int stack[DYNAMIC_TREE_STACK_SIZE];
+    int stack_size = 0;
+
+    if (tree->root_id == DYNAMIC_TREE_NULL_NODE) return 0;
+    stack[stack_size++] = tree->root_id;
+
+    while (stack_size > 0) {
+
+        int node_id = stack[--stack_size];
+        const DynamicTreeNode* node = &tree->nodes[node_id];
+
+        if (!aabb_contactAABB(&node->aabb, aabb)) continue;
+
+        if (node->height == 0) {
+            if (count == max_proxies) return count;
+            proxies[count++] = node_id;
+        }
+        else {
+            assert(stack_size + 2 <= DYNAMIC_TREE_STACK_SIZE);
+            stack[stack_size++] = node->children[0];
+            stack[stack_size++] = node->children[1];
+        }
+    }
+
+    return count;
+}
+
+/* calls "callback" with the id of every object whose fat AABB overlaps "aabb", with no limit on how many */
+void dynamicTree_queryCallback(const DynamicTree* tree, const AABB* aabb, DynamicTreeQueryCallback callback, void* context)
+{
+    int stack[DYNAMIC_TREE_STACK_SIZE];
+    int stack_size = 0;
+
+    if (tree->root_id == DYNAMIC_TREE_NULL_NODE) return;
+    stack[stack_size++] = tree->root_id;
+
+    while (stack_size > 0) {
+
+        int node_id = stack[--stack_size];
+        const DynamicTreeNode* node = &tree->nodes[node_id];
+
+        if (!aabb_contactAABB(&node->aabb, aabb)) continue;
+
+        if (node->height == 0) {
+            if (!callback(node_id, context)) return;
+        }
+        else {
+            assert(stack_size + 2 <= DYNAMIC_TREE_STACK_SIZE);
+            stack[stack_size++] = node->children[0];
+            stack[stack_size++] = node->children[1];
+        }
+    }
+}
+
+/* writes in "pairs" the candidate pairs involving the objects that moved since the last call,
+each pair is reported once. pairs rejected by the filters of their objects and "filters" (can be NULL) are left out.
+returns the number of pairs. when the pairs of a moved object don't fit in "max_pairs" its move and the ones
+after it are kept for the next call, so call again while dynamicTree_hasMoves returns true.
+"max_pairs" must hold the pairs of any single object */
+int dynamicTree_getOverlappingPairs(DynamicTree* tree, BroadphasePair* pairs, int max_pairs, CollisionFilterTable* filters)
+{
+    int pair_count = 0;
+    int stack[DYNAMIC_TREE_STACK_SIZE];
+    int processed = 0;
+
+    for (; processed < tree->move_count; processed++) {
+
+        int query_id = tree->move_buffer[processed];
+        if (query_id == DYNAMIC_TREE_NULL_NODE) continue;
+
+        const AABB* query_aabb = &tree->nodes[query_id].aabb;
+        int query_first_pair = pair_count;
+        bool overflow = false;
+        int stack_size = 0;
+        stack[stack_size++] = tree->root_id;
+
+        while (stack_size > 0) {
+
+            int node_id = stack[--stack_size];
+            const DynamicTreeNode* node = &tree->nodes[node_id];
+
+            if (!aabb_contactAABB(&node->aabb, query_aabb)) continue;
+
+            if (node->height == 0) {
+                if (node_id == query_id) continue;
+                // The other object still has to be queried, the pair is reported then
+                if (node->moved) continue;
+                if (!collisionFilterTable_shouldCollide(filters, &tree->nodes[query_id].filter, &node->filter)) continue;
+                if (pair_count == max_pairs) {
+                    overflow = true;
+                    break;
+                }
+                pairs[pair_count++] = broadphasePair_create(query_id, node_id);
+            }
+            else {
+                assert(stack_size + 2 <= DYNAMIC_TREE_STACK_SIZE);
+                stack[stack_size++] = node->children[0];
+                stack[stack_size++] = node->children[1];
+            }
+        }
+
+        // Drop the partial pairs of this object, it is queried again whole on the next call
+        if (overflow) {
+            assert(query_first_pair > 0);
+            pair_count = query_first_pair;
+            break;
+        }
+
+        tree->nodes[query_id].moved = false;
+    }
+
+    // Keep the moves that were not queried at the front of the buffer
+    tree->move_count -= processed;
+    memmove(tree->move_buffer, tree->move_buffer + processed, tree->move_count * sizeof(int));
+
+    return pair_count;
+}
+
+bool dynamicTree_hasMoves(const DynamicTree* tree)
+{
+    return tree->move_count > 0;
+}
+
+/* forgets the moves since the last call, for users that find their pairs with queries instead of dynamicTree_getOverlappingPairs */
+void dynamicTree_clearMoves(DynamicTree* tree)
+{
+    for (int i = 0; i < tree->move_count; i++) {
+        int proxy_id = tree->move_buffer[i];
+        if (proxy_id != DYNAMIC_TREE_NULL_NODE) tree->nodes[proxy_id].moved = false;
+    }
+    tree->move_count = 0;
+}
+
+/* takes a node from the free list, growing the node pool if it is empty */
+int dynamicTree_allocateNode(DynamicTree* tree)
+{
+    if (tree->free_id == DYNAMIC_TREE_NULL_NODE) {
+
+        assert(tree->node_count == tree->node_capacity);
+
+        tree->node_capacity *= 2;
+        tree->nodes = realloc(tree->nodes, tree->node_capacity * sizeof(DynamicTreeNode));
+        assert(tree->nodes != NULL);
+
+        for (int i = tree->node_count; i < tree->node_capacity - 1; i++) {
+            tree->nodes[i].next_free_id = i + 1;
+            tree->nodes[i].height = -1;
+        }
+        tree->nodes[tree->node_capacity - 1].next_free_id = DYNAMIC_TREE_NULL_NODE;
+        tree->nodes[tree->node_capacity - 1].height = -1;
+        tree->free_id = tree->node_count;
+    }
+
+    int node_id = tree->free_id;
+    DynamicTreeNode* node = &tree->nodes[node_id];
+    tree->free_id = node->next_free_id;
+
+    node->parent_id = DYNAMIC_TREE_NULL_NODE;
+    node->children[0] = DYNAMIC_TREE_NULL_NODE;
+    node->children[1] = DYNAMIC_TREE_NULL_NODE;
+    node->height = 0;
+    node->data = NULL;
+    node->moved = false;
+    tree->node_count++;
+
+    return node_id;
+}
+
+void dynamicTree_freeNode(DynamicTree* tree, int node_id)
+{
+    assert(node_id >= 0 && node_id < tree->node_capacity);
+    assert(tree->node_count > 0);
+
+    tree->nodes[node_id].next_free_id = tree->free_id;
+    tree->nodes[node_id].height = -1;
+    tree->free_id = node_id;
+    tree->node_count--;
+}
+
+/* inserts the leaf next to the sibling that minimizes the surface area heuristic */
+void dynamicTree_insertLeaf(DynamicTree* tree, int leaf_id)
+{
+    if (tree->root_id == DYNAMIC_TREE_NULL_NODE) {
+        tree->root_id = leaf_id;
+        tree->nodes[leaf_id].parent_id = DYNAMIC_TREE_NULL_NODE;
+        return;
+    }
+
+    // Find the best sibling for the new leaf
+    AABB leaf_aabb = tree->nodes[leaf_id].aabb;
+    int index = tree->root_id;
+
+    while (tree->nodes[index].height > 0) {
+
+        const DynamicTreeNode* node = &tree->nodes[index];
+        int child_0 = node->children[0];
+        int child_1 = node->children[1];
+
+        float area = aabb_getSurfaceArea(&node->aabb);
+        AABB combined_aabb = aabb_returnMerged(&node->aabb, &leaf_aabb);
+        float combined_area = aabb_getSurfaceArea(&combined_aabb);
+
+        // Cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combined_area;
+
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritance_cost = 2.0f * (combined_area - area);
+
+        AABB merged_0 = aabb_returnMerged(&leaf_aabb, &tree->nodes[child_0].aabb);
+        float cost_0 = aabb_getSurfaceArea(&merged_0) + inheritance_cost;
+        if (tree->nodes[child_0].height > 0) cost_0 -= aabb_getSurfaceArea(&tree->nodes[child_0].aabb);
+
+        AABB merged_1 = aabb_returnMerged(&leaf_aabb, &tree->nodes[child_1].aabb);
+        float cost_1 = aabb_getSurfaceArea(&merged_1) + inheritance_cost;
+        if (tree->nodes[child_1].height > 0) cost_1 -= aabb_getSurfaceArea(&tree->nodes[child_1].aabb);
+
+        if (cost < cost_0 && cost < cost_1) break;
+
+        index = (cost_0 < cost_1) ? child_0 : child_1;
+    }
+
+    int sibling_id = index;
+
+    // Create a new parent for the leaf and its sibling
+    int old_parent_id = tree->nodes[sibling_id].parent_id;
+    int new_parent_id = dynamicTree_allocateNode(tree);
+    DynamicTreeNode* new_parent = &tree->nodes[new_parent_id];
+    new_parent->parent_id = old_parent_id;
+    new_parent->aabb = aabb_returnMerged(&leaf_aabb, &tree->nodes[sibling_id].aabb);
+    new_parent->height = tree->nodes[sibling_id].height + 1;
+    new_parent->children[0] = sibling_id;
+    new_parent->children[1] = leaf_id;
+
+    if (old_parent_id != DYNAMIC_TREE_NULL_NODE) {
+        DynamicTreeNode* old_parent = &tree->nodes[old_parent_id];
+        if (old_parent->children[0] == sibling_id) old_parent->children[0] = new_parent_id;
+        else old_parent->children[1] = new_parent_id;
+    }
+    else tree->root_id = new_parent_id;
+
+    tree->nodes[sibling_id].parent_id = new_parent_id;
+    tree->nodes[leaf_id].parent_id = new_parent_id;
+
+    // Walk back up the tree fixing heights and AABBs
+    index = tree->nodes[leaf_id].parent_id;
+    while (index != DYNAMIC_TREE_NULL_NODE) {
+
+        index = dynamicTree_balance(tree, index);
+
+        DynamicTreeNode* node = &tree->nodes[index];
+        const DynamicTreeNode* child_0 = &tree->nodes[node->children[0]];
+        const DynamicTreeNode* child_1 = &tree->nodes[node->children[1]];
+
+        node->height = 1 + (child_0->height > child_1->height ? child_0->height : child_1->height);
+        node->aabb = aabb_returnMerged(&child_0->aabb, &child_1->aabb);
+
+        index = node->parent_id;
+    }
+}
+
+void dynamicTree_removeLeaf(DynamicTree* tree, int leaf_id)
+{
+    if (leaf_id == tree->root_id) {
+        tree->root_id = DYNAMIC_TREE_NULL_NODE;
+        return;
+    }
+
+    int parent_id = tree->nodes[leaf_id].parent_id;
+    int grand_parent_id = tree->nodes[parent_id].parent_id;
+    int sibling_id = (tree->nodes[parent_id].children[0] == leaf_id) ? tree->nodes[parent_id].children[1] : tree->nodes[parent_id].children[0];
+
+    if (grand_parent_id == DYNAMIC_TREE_NULL_NODE) {
+        tree->root_id = sibling_id;
+        tree->nodes[sibling_id].parent_id = DYNAMIC_TREE_NULL_NODE;
+        dynamicTree_freeNode(tree, parent_id);
+        return;
+    }
+
+    // Destroy the parent and connect the sibling to the grand parent
+    DynamicTreeNode* grand_parent = &tree->nodes[grand_parent_id];
+    if (grand_parent->children[0] == parent_id) grand_parent->children[0] = sibling_id;
+    else grand_parent->children[1] = sibling_id;
+    tree->nodes[sibling_id].parent_id = grand_parent_id;
+    dynamicTree_freeNode(tree, parent_id);
+
+    // Walk back up the tree fixing heights and AABBs
+    int index = grand_parent_id;
+    while (index != DYNAMIC_TREE_NULL_NODE) {
+
+        index = dynamicTree_balance(tree, index);
+
+        DynamicTreeNode* node = &tree->nodes[index];
+        const DynamicTreeNode* child_0 = &tree->nodes[node->children[0]];
+        const DynamicTreeNode* child_1 = &tree->nodes[node->children[1]];
+
+        node->aabb = aabb_returnMerged(&child_0->aabb, &child_1->aabb);
+        node->height = 1 + (child_0->height > child_1->height ? child_0->height : child_1->height);
+
+        index = node->parent_id;
+    }
+}
+
+/* performs a left or right rotation if the node "a_id" is imbalanced, returns the new root of the subtree
+          a
+        /   \
+       b     c
+      / \   / \
+     d   e f   g
+*/
+int dynamicTree_balance(DynamicTree* tree, int a_id)
+{
+    DynamicTreeNode* a = &tree->nodes[a_id];
+    if (a->height < 2) return a_id;
+
+    int b_id = a->children[0];
+    int c_id = a->children[1];
+    DynamicTreeNode* b = &tree->nodes[b_id];
+    DynamicTreeNode* c = &tree->nodes[c_id];
+
+    int balance = c->height - b->height;
+
+    // Rotate c up
+    if (balance > 1) {
+
+        int f_id = c->children[0];
+        int g_id = c->children[1];
+        DynamicTreeNode* f = &tree->nodes[f_id];
+        DynamicTreeNode* g = &tree->nodes[g_id];
+
+        // Swap a and c
+        c->children[0] = a_id;
+        c->parent_id = a->parent_id;
+        a->parent_id = c_id;
+
+        if (c->parent_id != DYNAMIC_TREE_NULL_NODE) {
+            DynamicTreeNode* c_parent = &tree->nodes[c->parent_id];
+            if (c_parent->children[0] == a_id) c_parent->children[0] = c_id;
+            else c_parent->children[1] = c_id;
+        }
+        else tree->root_id = c_id;
+
+        // Rotate
+        if (f->height > g->height) {
+            c->children[1] = f_id;
+            a->children[1] = g_id;
+            g->parent_id = a_id;
+            a->aabb = aabb_returnMerged(&b->aabb, &g->aabb);
+            c->aabb = aabb_returnMerged(&a->aabb, &f->aabb);
+            a->height = 1 + (b->height > g->height ? b->height : g->height);
+            c->height = 1 + (a->height > f->height ? a->height : f->height);
+        }
+        else {
+            c->children[1] = g_id;
+            a->children[1] = f_id;
+            f->parent_id = a_id;
+            a->aabb = aabb_returnMerged(&b->aabb, &f->aabb);
+            c->aabb = aabb_returnMerged(&a->aabb, &g->aabb);
+            a->height = 1 + (b->height > f->height ? b->height : f->height);
+            c->height = 1 + (a->height > g->height ? a->height : g->height);
+        }
+
+        return c_id;
+    }
+
+    // Rotate b up
+    if (balance < -1) {
+
+        int d_id = b->children[0];
+        int e_id = b->children[1];
+        DynamicTreeNode* d = &tree->nodes[d_id];
+        DynamicTreeNode* e = &tree->nodes[e_id];
+
+        // Swap a and b
+        b->children[0] = a_id;
+        b->parent_id = a->parent_id;
+        a->parent_id = b_id;
+
+        if (b->parent_id != DYNAMIC_TREE_NULL_NODE) {
+            DynamicTreeNode* b_parent = &tree->nodes[b->parent_id];
+            if (b_parent->children[0] == a_id) b_parent->children[0] = b_id;
+            else b_parent->children[1] = b_id;
+        }
+        else tree->root_id = b_id;
+
+        // Rotate
+        if (d->height > e->height) {
+            b->children[1] = d_id;
+            a->children[0] = e_id;
+            e->parent_id = a_id;
+            a->aabb = aabb_returnMerged(&c->aabb, &e->aabb);
+            b->aabb = aabb_returnMerged(&a->aabb, &d->aabb);
+            a->height = 1 + (c->height > e->height ? c->height : e->height);
+            b->height = 1 + (a->height > d->height ? a->height : d->height);
+        }
+        else {
+            b->children[1] = e_id;
+            a->children[0] = d_id;
+            d->parent_id = a_id;
+            a->aabb = aabb_returnMerged(&c->aabb, &d->aabb);
+            b->aabb = aabb_returnMerged(&a->aabb, &e->aabb);
+            a->height = 1 + (c->height > d->height ? c->height : d->height);
+            b->height = 1 + (a->height > e->height ? a->height : e->height);
+        }
+
+        return b_id;
+    }
+
+    return a_id;
+}
+
+void dynamicTree_bufferMove(DynamicTree* tree, int proxy_id)
+{
+    if (tree->move_count == tree->move_capacity) {
+        tree->move_capacity *= 2;
+        tree->move_buffer = realloc(tree->move_buffer, tree->move_capacity * sizeof(int));
+        assert(tree->move_buffer != NULL);
+    }
+    tree->move_buffer[tree->move_count++] = proxy_id;
+}
+
+void dynamicTree_unbufferMove(DynamicTree* tree, int proxy_id)
+{
+    for (int i = 0; i < tree->move_count; i++) {
+        if (tree->move_buffer[i] == proxy_id) tree->move_buffer[i] = DYNAMIC_TREE_NULL_NODE;
+    }
+}
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+/* SPATIAL_HASH.H
+uniform grid broadphase for many objects of about the same size, like the actors of a scene.
+every object is filed in the cell holding its position, and the cells live in a fixed size open addressing
+table keyed by their coordinates, so nothing is allocated after spatialHash_init.
+with a cell at least as large as the reach of two objects, the objects that can touch one
+always sit in its cell or in the 26 around it. moving an object only touches the table when it changes cell */
+
+#define SPATIAL_HASH_NULL -1
+
+
+// structures
+
+typedef struct {
+    int x;
+    int y;
+    int z;
+    int first_id;           // first object of the cell, SPATIAL_HASH_NULL for free slots
+} SpatialHashCell;
+
+typedef struct {
+    Vector3 position;
+    void* data;
+    int cell_x;
+    int cell_y;
+    int cell_z;
+    int next_id;            // next object in the cell, or in the free list
+    int previous_id;        // previous object in the cell
+    bool used;
+} SpatialHashObject;
+
+typedef struct {
+
+    float cell_size;
+    float inverse_cell_size;
+
+    SpatialHashCell* cells;
+    int cell_capacity;      // power of two, at least twice the objects so probing stays short
+
+    SpatialHashObject* objects;
+    int object_capacity;
+    int object_count;
+    int free_id;
+
+} SpatialHash;
+
+
+// function prototypes
+
+float spatialHash_getCapsuleCellSize(float radius, float length);
+
+void spatialHash_init(SpatialHash* hash, float cell_size, int max_objects);
+void spatialHash_delete(SpatialHash* hash);
+
+int spatialHash_addObject(SpatialHash* hash, const Vector3* position, void* data);
+void spatialHash_removeObject(SpatialHash* hash, int object_id);
+bool spatialHash_moveObject(SpatialHash* hash, int object_id, const Vector3* position);
+void* spatialHash_getData(const SpatialHash* hash, int object_id);
+
+int spatialHash_queryNeighbors(const SpatialHash* hash, const Vector3* position, int* object_ids, int max_objects);
+int spatialHash_getPairs(const SpatialHash* hash, BroadphasePair* pairs, int max_pairs);
+
+int spatialHash_getCellCoordinate(const SpatialHash* hash, float coordinate);
+int spatialHash_findSlot(const SpatialHash* hash, int x, int y, int z);
+void spatialHash_insertInCell(SpatialHash* hash, int object_id);
+void spatialHash_removeFromCell(SpatialHash* hash, int object_id);
+
+
+// function implementations
+
+/* smallest cell that keeps any two touching vertical capsules of this size in neighbouring cells,
+their positions can be up to two radii apart horizontally and the length plus two radii vertically */
+float spatialHash_getCapsuleCellSize(float radius, float length)
+{
+    return length + 2.0f * radius;
+}
+
+/* the only allocation of the grid, room for "max_objects" objects */
+void spatialHash_init(SpatialHash* hash, float cell_size, int max_objects)
+{
+    assert(cell_size > 0.0f && max_objects > 0);
+
+    hash->cell_size = cell_size;
+    hash->inverse_cell_size = 1.0f / cell_size;
+
+    // Each object fills at most one cell
+    hash->cell_capacity = 1;
+    while (hash->cell_capacity < 2 * max_objects) hash->cell_capacity <<= 1;
+
+    hash->cells = malloc(hash->cell_capacity * sizeof(SpatialHashCell));
+    hash->objects = malloc(max_objects * sizeof(SpatialHashObject));
+    assert(hash->cells != NULL && hash->objects != NULL);
+
+    for (int i = 0; i < hash->cell_capacity; i++) hash->cells[i].first_id = SPATIAL_HASH_NULL;
+
+    for (int i = 0; i < max_objects; i++) {
+        hash->objects[i].used = false;
+        hash->objects[i].next_id = (i + 1 < max_objects) ? i + 1 : SPATIAL_HASH_NULL;
+    }
+
+    hash->object_capacity = max_objects;
+    hash->object_count = 0;
+    hash->free_id = 0;
+}
+
+void spatialHash_delete(SpatialHash* hash)
+{
+    free(hash->cells);
+    free(hash->objects);
+    hash->cells = NULL;
+    hash->objects = NULL;
+    hash->cell_capacity = 0;
+    hash->object_capacity = 0;
+    hash->object_count = 0;
+}
+
+/* returns the id of the object */
+int spatialHash_addObject(SpatialHash* hash, const Vector3* position, void* data)
+{
+    assert(hash->free_id != SPATIAL_HASH_NULL);
+
+    int object_id = hash->free_id;
+    SpatialHashObject* object = &hash->objects[object_id];
+    hash->free_id = object->next_id;
+    hash->object_count++;
+
+    object->position = *position;
+    object->data = data;
+    object->used = true;
+    object->cell_x = spatialHash_getCellCoordinate(hash, position->x);
+    object->cell_y = spatialHash_getCellCoordinate(hash, position->y);
+    object->cell_z = spatialHash_getCellCoordinate(hash, position->z);
+
+    spatialHash_insertInCell(hash, object_id);
+    return object_id;
+}
+
+void spatialHash_removeObject(SpatialHash* hash, int object_id)
+{
+    assert(object_id >= 0 && object_id < hash->object_capacity && hash->objects[object_id].used);
+
+    spatialHash_removeFromCell(hash, object_id);
+
+    hash->objects[object_id].used = false;
+    hash->objects[object_id].next_id = hash->free_id;
+    hash->free_id = object_id;
+    hash->object_count--;
+}
+
+/* updates the position of the object, returns true if it changed cell and had to be filed again */
+bool spatialHash_moveObject(SpatialHash* hash, int object_id, const Vector3* position)
+{
+    assert(object_id >= 0 && object_id < hash->object_capacity && hash->objects[object_id].used);
+
+    SpatialHashObject* object = &hash->objects[object_id];
+    object->position = *position;
+
+    int x = spatialHash_getCellCoordinate(hash, position->x);
+    int y = spatialHash_getCellCoordinate(hash, position->y);
+    int z = spatialHash_getCellCoordinate(hash, position->z);
+    if (x == object->cell_x && y == object->cell_y && z == object->cell_z) return false;
+
+    spatialHash_removeFromCell(hash, object_id);
+    object->cell_x = x;
+    object->cell_y = y;
+    object->cell_z = z;
+    spatialHash_insertInCell(hash, object_id);
+    return true;
+}
+
+void* spatialHash_getData(const SpatialHash* hash, int object_id)
+{
+    assert(object_id >= 0 && object_id < hash->object_capacity && hash->objects[object_id].used);
+    return hash->objects[object_id].data;
+}
+
+/* writes the ids of the objects in the cell of "position" and the 26 around it, up to "max_objects".
+returns how many were written, the caller still has to run the narrowphase on them */
+int spatialHash_queryNeighbors(const SpatialHash* hash, const Vector3* position, int* object_ids, int max_objects)
+{
+    int x = spatialHash_getCellCoordinate(hash, position->x);
+    int y = spatialHash_getCellCoordinate(hash, position->y);
+    int z = spatialHash_getCellCoordinate(hash, position->z);
+    int count = 0;
+
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+
+                int slot = spatialHash_findSlot(hash, x + dx, y + dy, z + dz);
+
+                for (int id = hash->cells[slot].first_id; id != SPATIAL_HASH_NULL; id = hash->objects[id].next_id) {
+                    if (count == max_objects) return count;
+                    object_ids[count++] = id;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/* writes every pair of objects sharing a cell or sitting in neighbouring cells, each pair once, up to "max_pairs".
+the cells are walked in table order and each one only looks at half of its neighbours, the other half finds it */
+int spatialHash_getPairs(const SpatialHash* hash, BroadphasePair* pairs, int max_pairs)
+{
+    // The 13 neighbours with a positive first non zero offset
+    static const int offsets[13][3] = {
+        {1, -1, -1}, {1, -1, 0}, {1, -1, 1}, {1, 0, -1}, {1, 0, 0}, {1, 0, 1}, {1, 1, -1}, {1, 1, 0}, {1, 1, 1},
+        {0, 1, -1}, {0, 1, 0}, {0, 1, 1}, {0, 0, 1}
+    };
+
+    int count = 0;
+
+    for (int slot = 0; slot < hash->cell_capacity; slot++) {
+
+        const SpatialHashCell* cell = &hash->cells[slot];
+        if (cell->first_id == SPATIAL_HASH_NULL) continue;
+
+        for (int a = cell->first_id; a != SPATIAL_HASH_NULL; a = hash->objects[a].next_id) {
+
+            for (int b = hash->objects[a].next_id; b != SPATIAL_HASH_NULL; b = hash->objects[b].next_id) {
+                if (count == max_pairs) return count;
+                pairs[count++] = broadphasePair_create(a, b);
+            }
+        }
+
+        for (int i = 0; i < 13; i++) {
+
+            int neighbour = spatialHash_findSlot(hash, cell->x + offsets[i][0], cell->y + offsets[i][1], cell->z + offsets[i][2]);
+            if (hash->cells[neighbour].first_id == SPATIAL_HASH_NULL) continue;
+
+            for (int a = cell->first_id; a != SPATIAL_HASH_NULL; a = hash->objects[a].next_id) {
+
+                for (int b = hash->cells[neighbour].first_id; b != SPATIAL_HASH_NULL; b = hash->objects[b].next_id) {
+                    if (count == max_pairs) return count;
+                    pairs[count++] = broadphasePair_create(a, b);
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+int spatialHash_getCellCoordinate(const SpatialHash* hash, float coordinate)
+{
+    return (int)floorf(coordinate * hash->inverse_cell_size);
+}
+
+/* returns the slot holding the cell, or the free slot where it would be inserted */
+int spatialHash_findSlot(const SpatialHash* hash, int x, int y, int z)
+{
+    int mask = hash->cell_capacity - 1;
+    uint32_t key = ((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u) ^ ((uint32_t)z * 83492791u);
+
+    // Neighbouring cells have close keys, mixing the bits keeps them from piling up in one run of slots
+    key ^= key >> 16;
+    key *= 0x85EBCA6Bu;
+    key ^= key >> 13;
+    int slot = (int)(key & (uint32_t)mask);
+
+    while (hash->cells[slot].first_id != SPATIAL_HASH_NULL) {
+        const SpatialHashCell* cell = &hash->cells[slot];
+        if (cell->x == x && cell->y == y && cell->z == z) return slot;
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/* links the object at the head of the cell of its coordinates, taking a free slot for a new cell */
+void spatialHash_insertInCell(SpatialHash* hash, int object_id)
+{
+    SpatialHashObject* object = &hash->objects[object_id];
+    int slot = spatialHash_findSlot(hash, object->cell_x, object->cell_y, object->cell_z);
+    SpatialHashCell* cell = &hash->cells[slot];
+
+    if (cell->first_id == SPATIAL_HASH_NULL) {
+        cell->x = object->cell_x;
+        cell->y = object->cell_y;
+        cell->z = object->cell_z;
+    }
+    else hash->objects[cell->first_id].previous_id = object_id;
+
+    object->next_id = cell->first_id;
+    object->previous_id = SPATIAL_HASH_NULL;
+    cell->first_id = object_id;
+}
+
+/* unlinks the object from its cell and frees the slot of the cell once it is empty */
+void spatialHash_removeFromCell(SpatialHash* hash, int object_id)
+{
+    SpatialHashObject* object = &hash->objects[object_id];
+    int slot = spatialHash_findSlot(hash, object->cell_x, object->cell_y, object->cell_z);
+    assert(hash->cells[slot].first_id != SPATIAL_HASH_NULL);
+
+    if (object->next_id != SPATIAL_HASH_NULL) hash->objects[object->next_id].previous_id = object->previous_id;
+    if (object->previous_id != SPATIAL_HASH_NULL) hash->objects[object->previous_id].next_id = object->next_id;
+    else hash->cells[slot].first_id = object->next_id;
+
+    if (hash->cells[slot].first_id != SPATIAL_HASH_NULL) return;
+
+    // Shift back the cells after the hole that would no longer be reachable from their home slot
+    int mask = hash->cell_capacity - 1;
+    int next = (slot + 1) & mask;
+    while (hash->cells[next].first_id != SPATIAL_HASH_NULL) {
+
+        SpatialHashCell moved = hash->cells[next];
+        hash->cells[next].first_id = SPATIAL_HASH_NULL;
+        int target = spatialHash_findSlot(hash, moved.x, moved.y, moved.z);
+        hash->cells[target] = moved;
+
+        next = (next + 1) & mask;
+    }
+}
+
+#endif
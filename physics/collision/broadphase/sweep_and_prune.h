@@ -0,0 +1,372 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+
+/* SWEEP_AND_PRUNE.H
+broadphase for scenes of mostly static objects with a few movers. the x and y extents of every AABB are kept
+as endpoints in one sorted array per axis, and two objects are a pair while their extents overlap on both axes.
+the arrays stay sorted between frames, so moving an object only walks its endpoints past the ones it crossed,
+an insertion sort that is close to free for the objects that barely moved and nothing for the ones that didn't.
+every crossing adds or removes a pair, and those changes are kept as events until sweepAndPrune_clearEvents.
+all the memory is allocated by sweepAndPrune_init */
+
+#define SWEEP_AND_PRUNE_NULL -1
+#define SWEEP_AND_PRUNE_AXES 2
+#define SWEEP_AND_PRUNE_REMOVED_BOUND 1e30f     // where the endpoints of a removed object are sent before dropping them
+
+
+// structures
+
+typedef struct {
+    float value;
+    int object_id;
+    bool is_max;
+} SweepAndPruneEndpoint;
+
+typedef struct {
+    float min[SWEEP_AND_PRUNE_AXES];
+    float max[SWEEP_AND_PRUNE_AXES];
+    int min_index[SWEEP_AND_PRUNE_AXES];     // positions of the endpoints in the arrays of each axis
+    int max_index[SWEEP_AND_PRUNE_AXES];
+    void* data;
+    int next_free_id;
+    bool used;
+} SweepAndPruneObject;
+
+typedef struct {
+
+    SweepAndPruneObject* objects;
+    int object_capacity;
+    int free_id;
+
+    SweepAndPruneEndpoint* endpoints[SWEEP_AND_PRUNE_AXES];
+    int endpoint_count;     // the same on every axis, two per object
+
+    BroadphasePair* pairs;  // open addressing set of the overlapping pairs, proxy_a is SWEEP_AND_PRUNE_NULL for free slots
+    int pair_table_size;
+    int pair_count;
+    int pair_capacity;
+
+    BroadphasePair* added_pairs;    // events since the last sweepAndPrune_clearEvents
+    BroadphasePair* removed_pairs;
+    int added_count;
+    int removed_count;
+
+} SweepAndPrune;
+
+
+// function prototypes
+
+void sweepAndPrune_init(SweepAndPrune* sap, int max_objects, int max_pairs);
+void sweepAndPrune_delete(SweepAndPrune* sap);
+
+int sweepAndPrune_addObject(SweepAndPrune* sap, const AABB* aabb, void* data);
+void sweepAndPrune_removeObject(SweepAndPrune* sap, int object_id);
+void sweepAndPrune_updateObject(SweepAndPrune* sap, int object_id, const AABB* aabb);
+void* sweepAndPrune_getData(const SweepAndPrune* sap, int object_id);
+
+int sweepAndPrune_getPairs(const SweepAndPrune* sap, BroadphasePair* pairs, int max_pairs);
+void sweepAndPrune_clearEvents(SweepAndPrune* sap);
+
+void sweepAndPrune_setBounds(SweepAndPrune* sap, int object_id, float min_x, float min_y, float max_x, float max_y);
+bool sweepAndPrune_endpointLess(const SweepAndPruneEndpoint* a, const SweepAndPruneEndpoint* b);
+bool sweepAndPrune_overlaps(const SweepAndPrune* sap, int object_a, int object_b);
+void sweepAndPrune_setEndpoint(SweepAndPrune* sap, int axis, int index, const SweepAndPruneEndpoint* endpoint);
+void sweepAndPrune_sortDown(SweepAndPrune* sap, int axis, int index);
+void sweepAndPrune_sortUp(SweepAndPrune* sap, int axis, int index);
+void sweepAndPrune_crossEndpoints(SweepAndPrune* sap, const SweepAndPruneEndpoint* moving, const SweepAndPruneEndpoint* crossed, bool moving_down);
+
+int sweepAndPrune_findPairSlot(const SweepAndPrune* sap, const BroadphasePair* pair);
+void sweepAndPrune_addPair(SweepAndPrune* sap, int object_a, int object_b);
+void sweepAndPrune_removePair(SweepAndPrune* sap, int object_a, int object_b);
+
+
+// function implementations
+
+/* the only allocation of the broadphase, "max_pairs" bounds both the overlapping pairs and the events of a frame */
+void sweepAndPrune_init(SweepAndPrune* sap, int max_objects, int max_pairs)
+{
+    assert(max_objects > 0 && max_pairs > 0);
+
+    sap->objects = malloc(max_objects * sizeof(SweepAndPruneObject));
+    assert(sap->objects != NULL);
+
+    for (int i = 0; i < max_objects; i++) {
+        sap->objects[i].used = false;
+        sap->objects[i].next_free_id = (i + 1 < max_objects) ? i + 1 : SWEEP_AND_PRUNE_NULL;
+    }
+
+    sap->object_capacity = max_objects;
+    sap->free_id = 0;
+
+    for (int axis = 0; axis < SWEEP_AND_PRUNE_AXES; axis++) {
+        sap->endpoints[axis] = malloc(2 * max_objects * sizeof(SweepAndPruneEndpoint));
+        assert(sap->endpoints[axis] != NULL);
+    }
+    sap->endpoint_count = 0;
+
+    // Keep the load of the pair set under 1/2 so probing stays short
+    sap->pair_table_size = 1;
+    while (sap->pair_table_size < 2 * max_pairs) sap->pair_table_size <<= 1;
+
+    sap->pairs = malloc(sap->pair_table_size * sizeof(BroadphasePair));
+    sap->added_pairs = malloc(max_pairs * sizeof(BroadphasePair));
+    sap->removed_pairs = malloc(max_pairs * sizeof(BroadphasePair));
+    assert(sap->pairs != NULL && sap->added_pairs != NULL && sap->removed_pairs != NULL);
+
+    for (int i = 0; i < sap->pair_table_size; i++) sap->pairs[i].proxy_a = SWEEP_AND_PRUNE_NULL;
+
+    sap->pair_count = 0;
+    sap->pair_capacity = max_pairs;
+    sweepAndPrune_clearEvents(sap);
+}
+
+void sweepAndPrune_delete(SweepAndPrune* sap)
+{
+    free(sap->objects);
+    for (int axis = 0; axis < SWEEP_AND_PRUNE_AXES; axis++) free(sap->endpoints[axis]);
+    free(sap->pairs);
+    free(sap->added_pairs);
+    free(sap->removed_pairs);
+
+    sap->objects = NULL;
+    sap->pairs = NULL;
+    sap->added_pairs = NULL;
+    sap->removed_pairs = NULL;
+    sap->object_capacity = 0;
+    sap->endpoint_count = 0;
+    sap->pair_count = 0;
+}
+
+/* returns the id of the object. its endpoints enter at the end of the arrays and sort down from there,
+the pairs they find come out as added events */
+int sweepAndPrune_addObject(SweepAndPrune* sap, const AABB* aabb, void* data)
+{
+    assert(sap->free_id != SWEEP_AND_PRUNE_NULL);
+
+    int object_id = sap->free_id;
+    SweepAndPruneObject* object = &sap->objects[object_id];
+    sap->free_id = object->next_free_id;
+
+    object->used = true;
+    object->data = data;
+
+    int min_index = sap->endpoint_count;
+    int max_index = sap->endpoint_count + 1;
+    sap->endpoint_count += 2;
+
+    for (int axis = 0; axis < SWEEP_AND_PRUNE_AXES; axis++) {
+        object->min[axis] = SWEEP_AND_PRUNE_REMOVED_BOUND;
+        object->max[axis] = SWEEP_AND_PRUNE_REMOVED_BOUND;
+        sweepAndPrune_setEndpoint(sap, axis, min_index, &(SweepAndPruneEndpoint){SWEEP_AND_PRUNE_REMOVED_BOUND, object_id, false});
+        sweepAndPrune_setEndpoint(sap, axis, max_index, &(SweepAndPruneEndpoint){SWEEP_AND_PRUNE_REMOVED_BOUND, object_id, true});
+    }
+
+    sweepAndPrune_updateObject(sap, object_id, aabb);
+    return object_id;
+}
+
+/* sends the endpoints of the object past every other one, which removes its pairs as events, and drops them */
+void sweepAndPrune_removeObject(SweepAndPrune* sap, int object_id)
+{
+    assert(object_id >= 0 && object_id < sap->object_capacity && sap->objects[object_id].used);
+
+    sweepAndPrune_setBounds(sap, object_id,
+        SWEEP_AND_PRUNE_REMOVED_BOUND, SWEEP_AND_PRUNE_REMOVED_BOUND, SWEEP_AND_PRUNE_REMOVED_BOUND, SWEEP_AND_PRUNE_REMOVED_BOUND);
+
+    // Only removed objects reach the bound, and the others were dropped already, so these are the last two
+    sap->endpoint_count -= 2;
+
+    SweepAndPruneObject* object = &sap->objects[object_id];
+    object->used = false;
+    object->next_free_id = sap->free_id;
+    sap->free_id = object_id;
+}
+
+/* moves the object to its new bounds, only the x and y extents are used */
+void sweepAndPrune_updateObject(SweepAndPrune* sap, int object_id, const AABB* aabb)
+{
+    assert(object_id >= 0 && object_id < sap->object_capacity && sap->objects[object_id].used);
+
+    sweepAndPrune_setBounds(sap, object_id,
+        aabb->minCoordinates.x, aabb->minCoordinates.y, aabb->maxCoordinates.x, aabb->maxCoordinates.y);
+}
+
+void* sweepAndPrune_getData(const SweepAndPrune* sap, int object_id)
+{
+    assert(object_id >= 0 && object_id < sap->object_capacity && sap->objects[object_id].used);
+    return sap->objects[object_id].data;
+}
+
+/* writes the overlapping pairs, up to "max_pairs", and returns how many were written */
+int sweepAndPrune_getPairs(const SweepAndPrune* sap, BroadphasePair* pairs, int max_pairs)
+{
+    int count = 0;
+
+    for (int slot = 0; slot < sap->pair_table_size && count < max_pairs; slot++) {
+        if (sap->pairs[slot].proxy_a != SWEEP_AND_PRUNE_NULL) pairs[count++] = sap->pairs[slot];
+    }
+
+    return count;
+}
+
+/* forgets the added and removed pairs, call once per frame after handling them.
+a pair that came and went within the same frame shows up in both */
+void sweepAndPrune_clearEvents(SweepAndPrune* sap)
+{
+    sap->added_count = 0;
+    sap->removed_count = 0;
+}
+
+/* stores the new extents and walks each endpoint to its place. the overlap checks use the stored extents,
+so the order of the walks doesn't change the resulting pairs */
+void sweepAndPrune_setBounds(SweepAndPrune* sap, int object_id, float min_x, float min_y, float max_x, float max_y)
+{
+    SweepAndPruneObject* object = &sap->objects[object_id];
+    float mins[SWEEP_AND_PRUNE_AXES] = {min_x, min_y};
+    float maxs[SWEEP_AND_PRUNE_AXES] = {max_x, max_y};
+
+    for (int axis = 0; axis < SWEEP_AND_PRUNE_AXES; axis++) {
+        object->min[axis] = mins[axis];
+        object->max[axis] = maxs[axis];
+    }
+
+    for (int axis = 0; axis < SWEEP_AND_PRUNE_AXES; axis++) {
+
+        SweepAndPruneEndpoint* endpoints = sap->endpoints[axis];
+
+        // Grow first and shrink after, so the two endpoints never pass each other
+        float old_min = endpoints[object->min_index[axis]].value;
+        float old_max = endpoints[object->max_index[axis]].value;
+        endpoints[object->min_index[axis]].value = mins[axis];
+        endpoints[object->max_index[axis]].value = maxs[axis];
+
+        if (mins[axis] < old_min) sweepAndPrune_sortDown(sap, axis, object->min_index[axis]);
+        if (maxs[axis] > old_max) sweepAndPrune_sortUp(sap, axis, object->max_index[axis]);
+        if (mins[axis] > old_min) sweepAndPrune_sortUp(sap, axis, object->min_index[axis]);
+        if (maxs[axis] < old_max) sweepAndPrune_sortDown(sap, axis, object->max_index[axis]);
+    }
+}
+
+/* at equal values the min endpoints go first, so touching extents count as overlapping */
+bool sweepAndPrune_endpointLess(const SweepAndPruneEndpoint* a, const SweepAndPruneEndpoint* b)
+{
+    return a->value < b->value || (a->value == b->value && !a->is_max && b->is_max);
+}
+
+bool sweepAndPrune_overlaps(const SweepAndPrune* sap, int object_a, int object_b)
+{
+    const SweepAndPruneObject* a = &sap->objects[object_a];
+    const SweepAndPruneObject* b = &sap->objects[object_b];
+
+    for (int axis = 0; axis < SWEEP_AND_PRUNE_AXES; axis++) {
+        if (a->min[axis] > b->max[axis] || b->min[axis] > a->max[axis]) return false;
+    }
+    return true;
+}
+
+/* writes the endpoint at "index" and points its object at it */
+void sweepAndPrune_setEndpoint(SweepAndPrune* sap, int axis, int index, const SweepAndPruneEndpoint* endpoint)
+{
+    sap->endpoints[axis][index] = *endpoint;
+
+    SweepAndPruneObject* object = &sap->objects[endpoint->object_id];
+    if (endpoint->is_max) object->max_index[axis] = index;
+    else object->min_index[axis] = index;
+}
+
+/* insertion sort step of the endpoint at "index" towards the start of the array */
+void sweepAndPrune_sortDown(SweepAndPrune* sap, int axis, int index)
+{
+    SweepAndPruneEndpoint* endpoints = sap->endpoints[axis];
+    SweepAndPruneEndpoint moving = endpoints[index];
+
+    while (index > 0 && sweepAndPrune_endpointLess(&moving, &endpoints[index - 1])) {
+        sweepAndPrune_crossEndpoints(sap, &moving, &endpoints[index - 1], true);
+        sweepAndPrune_setEndpoint(sap, axis, index, &endpoints[index - 1]);
+        index--;
+    }
+
+    sweepAndPrune_setEndpoint(sap, axis, index, &moving);
+}
+
+/* insertion sort step of the endpoint at "index" towards the end of the array */
+void sweepAndPrune_sortUp(SweepAndPrune* sap, int axis, int index)
+{
+    SweepAndPruneEndpoint* endpoints = sap->endpoints[axis];
+    SweepAndPruneEndpoint moving = endpoints[index];
+
+    while (index + 1 < sap->endpoint_count && sweepAndPrune_endpointLess(&endpoints[index + 1], &moving)) {
+        sweepAndPrune_crossEndpoints(sap, &moving, &endpoints[index + 1], false);
+        sweepAndPrune_setEndpoint(sap, axis, index, &endpoints[index + 1]);
+        index++;
+    }
+
+    sweepAndPrune_setEndpoint(sap, axis, index, &moving);
+}
+
+/* a min passing a max towards it can start an overlap, passing it away from it ends one.
+two mins or two maxes crossing change nothing */
+void sweepAndPrune_crossEndpoints(SweepAndPrune* sap, const SweepAndPruneEndpoint* moving, const SweepAndPruneEndpoint* crossed, bool moving_down)
+{
+    if (moving->is_max == crossed->is_max || moving->object_id == crossed->object_id) return;
+
+    // Down past a max, or up past a min, the extents now meet on this axis
+    bool entering = (moving_down != moving->is_max);
+
+    if (!entering) sweepAndPrune_removePair(sap, moving->object_id, crossed->object_id);
+    else if (sweepAndPrune_overlaps(sap, moving->object_id, crossed->object_id)) sweepAndPrune_addPair(sap, moving->object_id, crossed->object_id);
+}
+
+/* returns the slot holding the pair, or the free slot where it would be inserted */
+int sweepAndPrune_findPairSlot(const SweepAndPrune* sap, const BroadphasePair* pair)
+{
+    int mask = sap->pair_table_size - 1;
+    int slot = (int)(((uint32_t)pair->proxy_a * 73856093u) ^ ((uint32_t)pair->proxy_b * 19349663u)) & mask;
+
+    while (sap->pairs[slot].proxy_a != SWEEP_AND_PRUNE_NULL) {
+        if (sap->pairs[slot].proxy_a == pair->proxy_a && sap->pairs[slot].proxy_b == pair->proxy_b) return slot;
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void sweepAndPrune_addPair(SweepAndPrune* sap, int object_a, int object_b)
+{
+    BroadphasePair pair = broadphasePair_create(object_a, object_b);
+    int slot = sweepAndPrune_findPairSlot(sap, &pair);
+    if (sap->pairs[slot].proxy_a != SWEEP_AND_PRUNE_NULL) return;
+
+    assert(sap->pair_count < sap->pair_capacity && sap->added_count < sap->pair_capacity);
+
+    sap->pairs[slot] = pair;
+    sap->pair_count++;
+    sap->added_pairs[sap->added_count++] = pair;
+}
+
+void sweepAndPrune_removePair(SweepAndPrune* sap, int object_a, int object_b)
+{
+    BroadphasePair pair = broadphasePair_create(object_a, object_b);
+    int slot = sweepAndPrune_findPairSlot(sap, &pair);
+    if (sap->pairs[slot].proxy_a == SWEEP_AND_PRUNE_NULL) return;
+
+    assert(sap->removed_count < sap->pair_capacity);
+
+    sap->pairs[slot].proxy_a = SWEEP_AND_PRUNE_NULL;
+    sap->pair_count--;
+    sap->removed_pairs[sap->removed_count++] = pair;
+
+    // Shift back the pairs after the hole that would no longer be reachable from their home slot
+    int mask = sap->pair_table_size - 1;
+    int next = (slot + 1) & mask;
+    while (sap->pairs[next].proxy_a != SWEEP_AND_PRUNE_NULL) {
+
+        BroadphasePair moved = sap->pairs[next];
+        sap->pairs[next].proxy_a = SWEEP_AND_PRUNE_NULL;
+        sap->pairs[sweepAndPrune_findPairSlot(sap, &moved)] = moved;
+
+        next = (next + 1) & mask;
+    }
+}
+
+#endif
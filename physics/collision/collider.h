@@ -0,0 +1,226 @@
+#ifndef COLLIDER_H
+#define COLLIDER_H
+
+// collision types
+
+#define SPHERE_A 1
+#define AABB_A 2
+#define BOX_A 3
+#define PLANE_A 4
+#define RAY_A 5
+#define CAPSULE_A 6
+#define TERRAIN_A 7
+#define MESH_A 8
+#define CONVEX_HULL_A 9
+#define COMPOUND_A 10
+#define COLLIDER_TYPE_COUNT 11     // the ids above run from 1, 0 is no type
+
+/* half size of the bounds given to shapes without a finite AABB (planes) */
+#define COLLIDER_UNBOUNDED_EXTENT 1e9f
+
+
+// structures
+
+typedef struct Collider {
+
+    int type;               // one of the collision types above
+
+    union {
+        Sphere sphere;
+        AABB aabb;
+        Box box;
+        Plane plane;
+        Capsule capsule;
+        ConvexHull hull;            // its vertices are shared like meshes, its center is its own
+        const TriangleMesh* mesh;   // meshes and terrains are shared, the collider only points to them
+        const Heightfield* terrain;
+        Compound compound;          // its children are colliders of their own, kept by the caller
+    };
+
+    CollisionFilter filter; // set before adding the collider to the broadphase
+    int proxy_id;           // id in the broadphase tree, DYNAMIC_TREE_NULL_NODE when not inserted
+
+} Collider;
+
+
+// function prototypes
+
+void collider_init(Collider* collider, int type);
+AABB collider_getAABB(const Collider* collider);
+void collider_setPosition(Collider* collider, const Vector3* position);
+Vector3 collider_getPosition(const Collider* collider);
+
+void collider_initCompound(Collider* collider, const Collider* children, Collider* world_children, int child_count);
+const Collider* collider_getCompoundChildren(const Collider* collider);
+
+void collider_addToBroadphase(Collider* collider, DynamicTree* tree);
+bool collider_updateBroadphase(Collider* collider, DynamicTree* tree);
+void collider_removeFromBroadphase(Collider* collider, DynamicTree* tree);
+
+
+// function implementations
+
+/* sets the type of the collider, the shape of that type must be filled by the caller */
+void collider_init(Collider* collider, int type)
+{
+    collider->type = type;
+    collisionFilter_set(&collider->filter, COLLISION_LAYER_DEFAULT, COLLISION_MASK_ALL);
+    collider->proxy_id = DYNAMIC_TREE_NULL_NODE;
+}
+
+/* returns the world space AABB of the collider shape */
+AABB collider_getAABB(const Collider* collider)
+{
+    switch(collider->type) {
+
+        case SPHERE_A: return sphere_getAABB(&collider->sphere);
+        case AABB_A: return collider->aabb;
+        case BOX_A: return box_getAABB(&collider->box);
+        case CAPSULE_A: return capsule_getAABB(&collider->capsule);
+        case CONVEX_HULL_A: return convexHull_getAABB(&collider->hull);
+        case MESH_A: return triangleMesh_getAABB(collider->mesh);
+        case TERRAIN_A: return heightfield_getAABB(collider->terrain);
+        case COMPOUND_A: return compound_getAABB(&collider->compound);
+        default: {
+            AABB unbounded = {
+                .minCoordinates = {-COLLIDER_UNBOUNDED_EXTENT, -COLLIDER_UNBOUNDED_EXTENT, -COLLIDER_UNBOUNDED_EXTENT},
+                .maxCoordinates = {COLLIDER_UNBOUNDED_EXTENT, COLLIDER_UNBOUNDED_EXTENT, COLLIDER_UNBOUNDED_EXTENT}
+            };
+            return unbounded;
+        }
+    }
+}
+
+/* moves the shape so its center sits at "position". planes, meshes and terrains are static and don't move */
+void collider_setPosition(Collider* collider, const Vector3* position)
+{
+    switch(collider->type) {
+
+        case SPHERE_A: collider->sphere.center = *position; break;
+        case BOX_A: collider->box.center = *position; break;
+        case CONVEX_HULL_A: collider->hull.center = *position; break;
+        case COMPOUND_A: compound_setPosition(&collider->compound, position); break;
+        case AABB_A: {
+            Vector3 center = aabb_getCenter(&collider->aabb);
+            Vector3 offset = vector3_difference(position, &center);
+            vector3_add(&collider->aabb.minCoordinates, &offset);
+            vector3_add(&collider->aabb.maxCoordinates, &offset);
+            break;
+        }
+        case CAPSULE_A: {
+            Vector3 center = vector3_sum(&collider->capsule.start, &collider->capsule.end);
+            vector3_scale(&center, 0.5f);
+            Vector3 offset = vector3_difference(position, &center);
+            vector3_add(&collider->capsule.start, &offset);
+            vector3_add(&collider->capsule.end, &offset);
+            break;
+        }
+        default: break;
+    }
+}
+
+/* the center collider_setPosition moves, the origin for the static planes, meshes and terrains */
+Vector3 collider_getPosition(const Collider* collider)
+{
+    switch(collider->type) {
+
+        case SPHERE_A: return collider->sphere.center;
+        case BOX_A: return collider->box.center;
+        case CONVEX_HULL_A: return collider->hull.center;
+        case COMPOUND_A: return collider->compound.bound.center;
+        case AABB_A: return aabb_getCenter(&collider->aabb);
+        case CAPSULE_A: {
+            Vector3 center = vector3_sum(&collider->capsule.start, &collider->capsule.end);
+            vector3_scale(&center, 0.5f);
+            return center;
+        }
+        default: return (Vector3){0.0f, 0.0f, 0.0f};
+    }
+}
+
+/* makes "collider" a compound of "children", given around its origin. only spheres and capsules can be children,
+the shapes whose world form follows from transforming a few points. "world_children" is room for as many colliders,
+the compound starts at the origin with no rotation */
+void collider_initCompound(Collider* collider, const Collider* children, Collider* world_children, int child_count)
+{
+    assert(children != NULL && world_children != NULL && child_count > 0);
+
+    collider_init(collider, COMPOUND_A);
+    Compound* compound = &collider->compound;
+    float radius = 0.0f;
+
+    for (int i = 0; i < child_count; i++) {
+
+        const Collider* child = &children[i];
+        assert(child->type == SPHERE_A || child->type == CAPSULE_A);
+
+        // Farthest the child reaches from the origin in any rotation
+        float reach;
+        if (child->type == SPHERE_A) reach = vector3_magnitude(&child->sphere.center) + child->sphere.radius;
+        else reach = max2(vector3_magnitude(&child->capsule.start), vector3_magnitude(&child->capsule.end)) + child->capsule.radius;
+
+        radius = max2(radius, reach);
+    }
+
+    compound->children = children;
+    compound->world_children = world_children;
+    compound->child_count = child_count;
+    compound->bound = (Sphere){{0.0f, 0.0f, 0.0f}, radius};
+    compound->rotation = (Vector3){0.0f, 0.0f, 0.0f};
+    compound->dirty = true;
+}
+
+/* returns the world space children of a compound, rebuilding them first if it moved since the last call */
+const Collider* collider_getCompoundChildren(const Collider* collider)
+{
+    assert(collider->type == COMPOUND_A);
+
+    // The world children are a cache of the transform, refreshing them doesn't change the collider
+    Compound* compound = (Compound*)&collider->compound;
+    if (!compound->dirty) return compound->world_children;
+
+    Matrix3x3 orientation = rotation_getMatrix(&compound->rotation);
+
+    for (int i = 0; i < compound->child_count; i++) {
+
+        Collider* child = &compound->world_children[i];
+        *child = compound->children[i];
+
+        if (child->type == SPHERE_A) {
+            child->sphere.center = matrix3x3_multiplyByVector(&orientation, &child->sphere.center);
+            vector3_add(&child->sphere.center, &compound->bound.center);
+        }
+        else {
+            child->capsule.start = matrix3x3_multiplyByVector(&orientation, &child->capsule.start);
+            child->capsule.end = matrix3x3_multiplyByVector(&orientation, &child->capsule.end);
+            vector3_add(&child->capsule.start, &compound->bound.center);
+            vector3_add(&child->capsule.end, &compound->bound.center);
+        }
+    }
+
+    compound->dirty = false;
+    return compound->world_children;
+}
+
+void collider_addToBroadphase(Collider* collider, DynamicTree* tree)
+{
+    assert(collider->proxy_id == DYNAMIC_TREE_NULL_NODE);
+    AABB aabb = collider_getAABB(collider);
+    collider->proxy_id = dynamicTree_addObject(tree, &aabb, collider);
+    dynamicTree_setFilter(tree, collider->proxy_id, &collider->filter);
+}
+
+/* call after moving the collider shape, returns true if the broadphase had to reinsert it */
+bool collider_updateBroadphase(Collider* collider, DynamicTree* tree)
+{
+    AABB aabb = collider_getAABB(collider);
+    return dynamicTree_updateObject(tree, collider->proxy_id, &aabb, false);
+}
+
+void collider_removeFromBroadphase(Collider* collider, DynamicTree* tree)
+{
+    dynamicTree_removeObject(tree, collider->proxy_id);
+    collider->proxy_id = DYNAMIC_TREE_NULL_NODE;
+}
+
+#endif
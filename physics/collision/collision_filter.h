@@ -0,0 +1,108 @@
+#ifndef COLLISION_FILTER_H
+#define COLLISION_FILTER_H
+
+/* COLLISION_FILTER.H
+keeps pairs that should never interact away from the narrowphase.
+every collider sits on one or more layers and has a mask of the layers it collides with, and a table
+on top says which layers may touch at all. a pair goes through only if both masks and the table accept it.
+the table counts the pairs it lets through and the ones it skips, reset the counters once per frame */
+
+#define COLLISION_MAX_LAYERS 16
+#define COLLISION_LAYER_DEFAULT 0x0001
+#define COLLISION_MASK_ALL 0xFFFF
+
+
+// structures
+
+typedef struct {
+    uint16_t layer;         // bits of the layers the collider is on
+    uint16_t mask;          // bits of the layers it collides with
+} CollisionFilter;
+
+typedef struct {
+    uint16_t layer_masks[COLLISION_MAX_LAYERS];     // layers each layer may touch, kept symmetric
+    int tested_pairs;       // let through since the last reset
+    int skipped_pairs;      // rejected since the last reset
+} CollisionFilterTable;
+
+
+// function prototypes
+
+void collisionFilter_set(CollisionFilter* filter, uint16_t layer, uint16_t mask);
+bool collisionFilter_accepts(const CollisionFilter* a, const CollisionFilter* b);
+
+void collisionFilterTable_init(CollisionFilterTable* table);
+void collisionFilterTable_setLayerPair(CollisionFilterTable* table, int layer_a, int layer_b, bool collide);
+bool collisionFilterTable_acceptsLayers(const CollisionFilterTable* table, uint16_t layers_a, uint16_t layers_b);
+bool collisionFilterTable_shouldCollide(CollisionFilterTable* table, const CollisionFilter* a, const CollisionFilter* b);
+void collisionFilterTable_resetCounters(CollisionFilterTable* table);
+
+
+// function implementations
+
+void collisionFilter_set(CollisionFilter* filter, uint16_t layer, uint16_t mask)
+{
+    filter->layer = layer;
+    filter->mask = mask;
+}
+
+/* both colliders have to want each other */
+bool collisionFilter_accepts(const CollisionFilter* a, const CollisionFilter* b)
+{
+    return (a->layer & b->mask) != 0 && (b->layer & a->mask) != 0;
+}
+
+/* every layer touches every other one */
+void collisionFilterTable_init(CollisionFilterTable* table)
+{
+    for (int i = 0; i < COLLISION_MAX_LAYERS; i++) table->layer_masks[i] = COLLISION_MASK_ALL;
+    collisionFilterTable_resetCounters(table);
+}
+
+/* "layer_a" and "layer_b" are layer numbers, not bits */
+void collisionFilterTable_setLayerPair(CollisionFilterTable* table, int layer_a, int layer_b, bool collide)
+{
+    assert(layer_a >= 0 && layer_a < COLLISION_MAX_LAYERS && layer_b >= 0 && layer_b < COLLISION_MAX_LAYERS);
+
+    if (collide) {
+        table->layer_masks[layer_a] |= (uint16_t)(1 << layer_b);
+        table->layer_masks[layer_b] |= (uint16_t)(1 << layer_a);
+    }
+    else {
+        table->layer_masks[layer_a] &= (uint16_t)~(1 << layer_b);
+        table->layer_masks[layer_b] &= (uint16_t)~(1 << layer_a);
+    }
+}
+
+/* true if any layer of "layers_a" may touch any layer of "layers_b" */
+bool collisionFilterTable_acceptsLayers(const CollisionFilterTable* table, uint16_t layers_a, uint16_t layers_b)
+{
+    while (layers_a != 0) {
+        int layer = __builtin_ctz(layers_a);
+        if (table->layer_masks[layer] & layers_b) return true;
+        layers_a &= layers_a - 1;
+    }
+    return false;
+}
+
+/* the check to run before any narrowphase work, counts the pair as tested or skipped.
+"table" can be NULL, then only the masks are checked and nothing is counted */
+bool collisionFilterTable_shouldCollide(CollisionFilterTable* table, const CollisionFilter* a, const CollisionFilter* b)
+{
+    bool collide = collisionFilter_accepts(a, b);
+    if (table == NULL) return collide;
+
+    collide = collide && collisionFilterTable_acceptsLayers(table, a->layer, b->layer);
+
+    if (collide) table->tested_pairs++;
+    else table->skipped_pairs++;
+    return collide;
+}
+
+void collisionFilterTable_resetCounters(CollisionFilterTable* table)
+{
+    table->tested_pairs = 0;
+    table->skipped_pairs = 0;
+}
+
+#endif
@@ -0,0 +1,326 @@
+#ifndef CONTACT_MANIFOLD_H
+#define CONTACT_MANIFOLD_H
+
+/* CONTACT_MANIFOLD.H
+contact points that persist across frames for each pair of colliders.
+a new contact close to a cached point (SAME_CONTACT_POINT_DISTANCE_THRESHOLD) updates it and keeps its accumulated impulses,
+so the solver can warm start from last frame's result. the manifold also keeps where gjk ended for the pair,
+so a convex pair that keeps touching starts its next search there. the manifolds live in an open addressing table keyed by the pair */
+
+#define CONTACT_MANIFOLD_MAX_POINTS 4
+#define CONTACT_MANIFOLD_BREAKING_DISTANCE 2.0f     // a cached point this far off the new contact plane is dropped
+#define CONTACT_MANIFOLD_POINT_LIFETIME 4           // frames a cached point survives without being matched again
+
+
+// structures
+
+typedef struct {
+    ContactData data;
+    float normal_impulse;       // accumulated by the solver, reused to warm start the next frame
+    float tangent_impulse[2];
+    int frames_unmatched;       // 0 when the point was matched by a contact this frame
+} ContactPoint;
+
+typedef struct {
+    const Collider* collider_a;     // NULL marks a free slot of the table
+    const Collider* collider_b;
+    ContactPoint points[CONTACT_MANIFOLD_MAX_POINTS];
+    int point_count;
+    bool updated;                   // received a contact since the last contactManifoldCache_removeStale
+    GjkCache gjk;                   // of "collider_a" against "collider_b", zero until a convex pair sets it
+} ContactManifold;
+
+typedef struct {
+    ContactManifold* manifolds;
+    int capacity;                   // power of two
+    int count;
+} ContactManifoldCache;
+
+
+// function prototypes
+
+int contactManifoldCache_getTableSize(int capacity);
+size_t contactManifoldCache_getMemorySize(int capacity);
+void contactManifoldCache_init(ContactManifoldCache* cache, int capacity);
+void contactManifoldCache_initFromArena(ContactManifoldCache* cache, MemoryArena* arena, int capacity);
+void contactManifoldCache_setMemory(ContactManifoldCache* cache, void* memory, int capacity);
+void contactManifoldCache_delete(ContactManifoldCache* cache);
+
+ContactManifold* contactManifoldCache_get(const ContactManifoldCache* cache, const Collider* a, const Collider* b);
+ContactManifold* contactManifoldCache_update(ContactManifoldCache* cache, const Collider* a, const Collider* b, const ContactData* contact);
+void contactManifoldCache_remove(ContactManifoldCache* cache, const Collider* a, const Collider* b);
+void contactManifoldCache_removeStale(ContactManifoldCache* cache);
+
+void contactManifold_addPoint(ContactManifold* manifold, const ContactData* contact);
+void contactManifold_removePoint(ContactManifold* manifold, int index);
+int contactManifold_getReplacedPoint(const ContactManifold* manifold, const ContactData* contact);
+GjkCache contactManifold_getGjkCache(const ContactManifold* manifold, const Collider* a);
+void contactManifold_setGjkCache(ContactManifold* manifold, const Collider* a, const GjkCache* cache);
+
+int contactManifoldCache_findSlot(const ContactManifoldCache* cache, const Collider* a, const Collider* b);
+
+
+// function implementations
+
+/* "capacity" is rounded up to a power of two, keep it well above the expected number of touching pairs */
+int contactManifoldCache_getTableSize(int capacity)
+{
+    assert(capacity > 0);
+
+    int table_size = 1;
+    while (table_size < capacity) table_size <<= 1;
+    return table_size;
+}
+
+size_t contactManifoldCache_getMemorySize(int capacity)
+{
+    return contactManifoldCache_getTableSize(capacity) * sizeof(ContactManifold);
+}
+
+void contactManifoldCache_init(ContactManifoldCache* cache, int capacity)
+{
+    void* memory = malloc(contactManifoldCache_getMemorySize(capacity));
+    assert(memory != NULL);
+    contactManifoldCache_setMemory(cache, memory, capacity);
+}
+
+/* the table lives as long as the arena, don't call contactManifoldCache_delete on it */
+void contactManifoldCache_initFromArena(ContactManifoldCache* cache, MemoryArena* arena, int capacity)
+{
+    contactManifoldCache_setMemory(cache, memoryArena_allocate(arena, contactManifoldCache_getMemorySize(capacity)), capacity);
+}
+
+/* builds an empty table over "memory", of contactManifoldCache_getMemorySize bytes */
+void contactManifoldCache_setMemory(ContactManifoldCache* cache, void* memory, int capacity)
+{
+    cache->capacity = contactManifoldCache_getTableSize(capacity);
+    cache->count = 0;
+    cache->manifolds = memory;
+    memset(cache->manifolds, 0, cache->capacity * sizeof(ContactManifold));
+}
+
+void contactManifoldCache_delete(ContactManifoldCache* cache)
+{
+    free(cache->manifolds);
+    cache->manifolds = NULL;
+    cache->capacity = 0;
+    cache->count = 0;
+}
+
+/* returns the slot holding the pair, or the free slot where it would be inserted */
+int contactManifoldCache_findSlot(const ContactManifoldCache* cache, const Collider* a, const Collider* b)
+{
+    uintptr_t key_a = (uintptr_t)a;
+    uintptr_t key_b = (uintptr_t)b;
+    int mask = cache->capacity - 1;
+    int slot = (int)((key_a * 73856093u) ^ (key_b * 19349663u)) & mask;
+
+    while (cache->manifolds[slot].collider_a != NULL) {
+        if (cache->manifolds[slot].collider_a == a && cache->manifolds[slot].collider_b == b) return slot;
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/* returns the manifold of the pair or NULL. the pair is unordered */
+ContactManifold* contactManifoldCache_get(const ContactManifoldCache* cache, const Collider* a, const Collider* b)
+{
+    if (a > b) {
+        const Collider* swap = a;
+        a = b;
+        b = swap;
+    }
+
+    int slot = contactManifoldCache_findSlot(cache, a, b);
+    return (cache->manifolds[slot].collider_a != NULL) ? &cache->manifolds[slot] : NULL;
+}
+
+/* merges "contact" into the manifold of the pair, creating it if needed. a frame ends with
+contactManifoldCache_removeStale, pairs can get several contacts in between.
+the normal of "contact" must point towards "a", it is flipped if the pair is stored the other way */
+ContactManifold* contactManifoldCache_update(ContactManifoldCache* cache, const Collider* a, const Collider* b, const ContactData* contact)
+{
+    ContactData ordered_contact = *contact;
+    if (a > b) {
+        const Collider* swap = a;
+        a = b;
+        b = swap;
+        vector3_invert(&ordered_contact.normal);
+    }
+
+    int slot = contactManifoldCache_findSlot(cache, a, b);
+    ContactManifold* manifold = &cache->manifolds[slot];
+
+    if (manifold->collider_a == NULL) {
+        // Keep the load under 3/4 so probing stays short
+        assert(4 * (cache->count + 1) <= 3 * cache->capacity);
+        manifold->collider_a = a;
+        manifold->collider_b = b;
+        manifold->point_count = 0;
+        manifold->gjk = (GjkCache){0};
+        cache->count++;
+    }
+
+    // First contact of the frame, age the cached points
+    if (!manifold->updated) {
+        for (int i = manifold->point_count - 1; i >= 0; i--) {
+            if (++manifold->points[i].frames_unmatched > CONTACT_MANIFOLD_POINT_LIFETIME) contactManifold_removePoint(manifold, i);
+        }
+        manifold->updated = true;
+    }
+
+    contactManifold_addPoint(manifold, &ordered_contact);
+    return manifold;
+}
+
+void contactManifoldCache_remove(ContactManifoldCache* cache, const Collider* a, const Collider* b)
+{
+    if (a > b) {
+        const Collider* swap = a;
+        a = b;
+        b = swap;
+    }
+
+    int mask = cache->capacity - 1;
+    int slot = contactManifoldCache_findSlot(cache, a, b);
+    if (cache->manifolds[slot].collider_a == NULL) return;
+
+    cache->manifolds[slot].collider_a = NULL;
+    cache->count--;
+
+    // Shift back the entries after the hole that would no longer be reachable from their home slot
+    int next = (slot + 1) & mask;
+    while (cache->manifolds[next].collider_a != NULL) {
+
+        ContactManifold moved = cache->manifolds[next];
+        cache->manifolds[next].collider_a = NULL;
+        int target = contactManifoldCache_findSlot(cache, moved.collider_a, moved.collider_b);
+        cache->manifolds[target] = moved;
+
+        next = (next + 1) & mask;
+    }
+}
+
+/* removes the manifolds of the pairs that stopped touching, call once per frame after the narrowphase */
+void contactManifoldCache_removeStale(ContactManifoldCache* cache)
+{
+    for (int i = 0; i < cache->capacity; i++) {
+
+        ContactManifold* manifold = &cache->manifolds[i];
+        if (manifold->collider_a == NULL || manifold->updated) continue;
+
+        contactManifoldCache_remove(cache, manifold->collider_a, manifold->collider_b);
+
+        // The removal may have shifted another entry into this slot
+        i--;
+    }
+
+    // Cleared apart, entries shifted back across the end of the table would otherwise be checked twice
+    for (int i = 0; i < cache->capacity; i++) cache->manifolds[i].updated = false;
+}
+
+/* matches "contact" with the cached points, updating the matched one or adding it as a new point.
+points that left the contact plane are dropped */
+void contactManifold_addPoint(ContactManifold* manifold, const ContactData* contact)
+{
+    float threshold_squared = SAME_CONTACT_POINT_DISTANCE_THRESHOLD * SAME_CONTACT_POINT_DISTANCE_THRESHOLD;
+    int matched = -1;
+
+    for (int i = manifold->point_count - 1; i >= 0; i--) {
+
+        ContactPoint* point = &manifold->points[i];
+        Vector3 difference = vector3_difference(&point->data.point, &contact->point);
+
+        if (matched < 0 && vector3_squaredMagnitude(&difference) <= threshold_squared) {
+            matched = i;
+            continue;
+        }
+
+        float off_plane = vector3_returnDotProduct(&difference, &contact->normal);
+        if (fabsf(off_plane) > CONTACT_MANIFOLD_BREAKING_DISTANCE) {
+            contactManifold_removePoint(manifold, i);
+            if (matched > i) matched--;
+        }
+    }
+
+    if (matched >= 0) {
+        manifold->points[matched].data = *contact;
+        manifold->points[matched].frames_unmatched = 0;
+        return;
+    }
+
+    int index = manifold->point_count;
+    if (index == CONTACT_MANIFOLD_MAX_POINTS) index = contactManifold_getReplacedPoint(manifold, contact);
+    else manifold->point_count++;
+
+    manifold->points[index] = (ContactPoint){
+        .data = *contact,
+        .normal_impulse = 0.0f,
+        .tangent_impulse = {0.0f, 0.0f},
+        .frames_unmatched = 0
+    };
+}
+
+void contactManifold_removePoint(ContactManifold* manifold, int index)
+{
+    manifold->point_count--;
+    for (int i = index; i < manifold->point_count; i++) manifold->points[i] = manifold->points[i + 1];
+}
+
+/* picks the point to replace by "contact" in a full manifold. the oldest point not matched this frame goes first,
+otherwise the deepest point is kept and among the others the one whose replacement leaves the largest contact area goes */
+int contactManifold_getReplacedPoint(const ContactManifold* manifold, const ContactData* contact)
+{
+    int oldest = 0;
+    for (int i = 1; i < CONTACT_MANIFOLD_MAX_POINTS; i++) {
+        if (manifold->points[i].frames_unmatched > manifold->points[oldest].frames_unmatched) oldest = i;
+    }
+    if (manifold->points[oldest].frames_unmatched > 0) return oldest;
+
+    int deepest = 0;
+    for (int i = 1; i < CONTACT_MANIFOLD_MAX_POINTS; i++) {
+        if (manifold->points[i].data.penetration > manifold->points[deepest].data.penetration) deepest = i;
+    }
+
+    int replaced = (deepest == 0) ? 1 : 0;
+    float largest_area = -1.0f;
+
+    for (int i = 0; i < CONTACT_MANIFOLD_MAX_POINTS; i++) {
+
+        if (i == deepest) continue;
+
+        // Area of the quad left when point i is replaced, from the cross product of its diagonals
+        Vector3 corners[CONTACT_MANIFOLD_MAX_POINTS];
+        for (int j = 0; j < CONTACT_MANIFOLD_MAX_POINTS; j++) corners[j] = (j == i) ? contact->point : manifold->points[j].data.point;
+
+        Vector3 diagonal_a = vector3_difference(&corners[2], &corners[0]);
+        Vector3 diagonal_b = vector3_difference(&corners[3], &corners[1]);
+        Vector3 cross = vector3_returnCrossProduct(&diagonal_a, &diagonal_b);
+        float area = vector3_squaredMagnitude(&cross);
+
+        if (area > largest_area) {
+            largest_area = area;
+            replaced = i;
+        }
+    }
+
+    return replaced;
+}
+
+/* the gjk cache of the pair seen from "a", either of its colliders */
+GjkCache contactManifold_getGjkCache(const ContactManifold* manifold, const Collider* a)
+{
+    GjkCache cache = manifold->gjk;
+    if (a != manifold->collider_a) vector3_invert(&cache.direction);
+    return cache;
+}
+
+/* keeps "cache", found for "a" against the other collider of the pair */
+void contactManifold_setGjkCache(ContactManifold* manifold, const Collider* a, const GjkCache* cache)
+{
+    manifold->gjk = *cache;
+    if (a != manifold->collider_a) vector3_invert(&manifold->gjk.direction);
+}
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef EPA_H
+#define EPA_H
+
+/* EPA.H
+penetration depth and normal of two overlapping convex shapes (expanding polytope algorithm).
+starts from the simplex where gjk found the overlap and grows a polytope inside the difference of the shapes
+until its face closest to the origin lies on the boundary. everything lives in fixed arrays on the stack */
+
+#define EPA_MAX_ITERATIONS 32
+#define EPA_MAX_VERTICES (4 + EPA_MAX_ITERATIONS)
+#define EPA_MAX_FACES 96
+#define EPA_TOLERANCE 1e-3f                 // distance under which the closest face is on the boundary
+#define EPA_DEGENERATE_TOLERANCE 1e-4f      // below this a new vertex doesn't add a dimension to the starting simplex
+
+
+// structures
+
+typedef struct {
+    int vertices[3];        // counter clockwise seen from outside
+    Vector3 normal;         // outwards, unit length
+    float distance;         // from the origin to the plane of the face
+} EpaFace;
+
+typedef struct {
+    GjkVertex vertices[EPA_MAX_VERTICES];
+    int vertex_count;
+    EpaFace faces[EPA_MAX_FACES];
+    int face_count;
+} EpaPolytope;
+
+
+// function prototypes
+
+bool epa_getPenetration(ContactData* contact, const ConvexShape* a, const ConvexShape* b, const GjkSimplex* simplex);
+
+bool epa_buildTetrahedron(EpaPolytope* polytope, const ConvexShape* a, const ConvexShape* b);
+void epa_addFace(EpaPolytope* polytope, int v0, int v1, int v2);
+int epa_getClosestFace(const EpaPolytope* polytope);
+void epa_getBarycentric(const EpaPolytope* polytope, const EpaFace* face, float weights[3]);
+
+
+// function implementations
+
+/* fills "contact" with the normal towards "a", the depth and a point on "b", from the overlapping simplex of gjk_getDistance.
+returns false when the polytope can't be built, for shapes only touching */
+bool epa_getPenetration(ContactData* contact, const ConvexShape* a, const ConvexShape* b, const GjkSimplex* simplex)
+{
+    EpaPolytope polytope;
+
+    polytope.vertex_count = simplex->count;
+    for (int i = 0; i < simplex->count; i++) polytope.vertices[i] = simplex->vertices[i];
+
+    if (!epa_buildTetrahedron(&polytope, a, b)) return false;
+
+    int closest = epa_getClosestFace(&polytope);
+
+    for (int iteration = 0; iteration < EPA_MAX_ITERATIONS; iteration++) {
+
+        EpaFace* face = &polytope.faces[closest];
+        GjkVertex vertex = gjk_getSupport(a, b, &face->normal, true);
+
+        // The face can't be pushed further out, it lies on the boundary
+        float support_distance = vector3_returnDotProduct(&vertex.w, &face->normal);
+        if (support_distance - face->distance < EPA_TOLERANCE) break;
+        if (polytope.vertex_count == EPA_MAX_VERTICES) break;
+
+        int added = polytope.vertex_count++;
+        polytope.vertices[added] = vertex;
+
+        // Remove the faces seen from the new vertex, keeping the edges of the hole they leave
+        int horizon[EPA_MAX_FACES * 3][2];
+        int horizon_count = 0;
+
+        for (int f = 0; f < polytope.face_count;) {
+
+            EpaFace* visible = &polytope.faces[f];
+            Vector3 to_vertex = vector3_difference(&vertex.w, &polytope.vertices[visible->vertices[0]].w);
+            if (vector3_returnDotProduct(&visible->normal, &to_vertex) <= 0.0f) {
+                f++;
+                continue;
+            }
+
+            for (int e = 0; e < 3; e++) {
+
+                int from = visible->vertices[e];
+                int to = visible->vertices[(e + 1) % 3];
+
+                // An edge shared with another removed face is inside the hole
+                bool shared = false;
+                for (int h = 0; h < horizon_count; h++) {
+                    if (horizon[h][0] == to && horizon[h][1] == from) {
+                        horizon[h][0] = horizon[horizon_count - 1][0];
+                        horizon[h][1] = horizon[horizon_count - 1][1];
+                        horizon_count--;
+                        shared = true;
+                        break;
+                    }
+                }
+
+                if (!shared) {
+                    horizon[horizon_count][0] = from;
+                    horizon[horizon_count][1] = to;
+                    horizon_count++;
+                }
+            }
+
+            polytope.faces[f] = polytope.faces[--polytope.face_count];
+        }
+
+        // Out of room, settle for the faces left
+        if (polytope.face_count + horizon_count > EPA_MAX_FACES) return false;
+
+        for (int h = 0; h < horizon_count; h++) epa_addFace(&polytope, horizon[h][0], horizon[h][1], added);
+
+        closest = epa_getClosestFace(&polytope);
+    }
+
+    const EpaFace* face = &polytope.faces[closest];
+    float weights[3];
+    epa_getBarycentric(&polytope, face, weights);
+
+    contact->point = (Vector3){0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 3; i++) vector3_addScaledVector(&contact->point, &polytope.vertices[face->vertices[i]].b, weights[i]);
+
+    contact->normal = vector3_getInverse(&face->normal);
+    contact->penetration = max2(face->distance, 0.0f);
+    return true;
+}
+
+/* grows the starting simplex into a tetrahedron with full supports and builds its faces */
+bool epa_buildTetrahedron(EpaPolytope* polytope, const ConvexShape* a, const ConvexShape* b)
+{
+    static const Vector3 axes[3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+    GjkVertex* vertices = polytope->vertices;
+
+    if (polytope->vertex_count == 0) {
+        vertices[0] = gjk_getSupport(a, b, &axes[0], true);
+        polytope->vertex_count = 1;
+    }
+
+    if (polytope->vertex_count == 1) {
+        for (int i = 0; i < 6 && polytope->vertex_count == 1; i++) {
+            Vector3 direction = (i < 3) ? axes[i] : vector3_getInverse(&axes[i - 3]);
+            GjkVertex vertex = gjk_getSupport(a, b, &direction, true);
+            Vector3 edge = vector3_difference(&vertex.w, &vertices[0].w);
+            if (vector3_squaredMagnitude(&edge) > EPA_DEGENERATE_TOLERANCE * EPA_DEGENERATE_TOLERANCE) vertices[polytope->vertex_count++] = vertex;
+        }
+        if (polytope->vertex_count == 1) return false;
+    }
+
+    if (polytope->vertex_count == 2) {
+        Vector3 line = vector3_difference(&vertices[1].w, &vertices[0].w);
+        float line_squared = vector3_squaredMagnitude(&line);
+
+        for (int i = 0; i < 6 && polytope->vertex_count == 2; i++) {
+            Vector3 direction = vector3_returnCrossProduct(&line, &axes[i % 3]);
+            if (i >= 3) vector3_invert(&direction);
+            if (vector3_isZero(&direction)) continue;
+
+            GjkVertex vertex = gjk_getSupport(a, b, &direction, true);
+            Vector3 edge = vector3_difference(&vertex.w, &vertices[0].w);
+            Vector3 area = vector3_returnCrossProduct(&line, &edge);
+            if (vector3_squaredMagnitude(&area) > EPA_DEGENERATE_TOLERANCE * EPA_DEGENERATE_TOLERANCE * line_squared) vertices[polytope->vertex_count++] = vertex;
+        }
+        if (polytope->vertex_count == 2) return false;
+    }
+
+    if (polytope->vertex_count == 3) {
+        Vector3 ab = vector3_difference(&vertices[1].w, &vertices[0].w);
+        Vector3 ac = vector3_difference(&vertices[2].w, &vertices[0].w);
+        Vector3 normal = vector3_returnCrossProduct(&ab, &ac);
+        vector3_normalize(&normal);
+
+        for (int i = 0; i < 2 && polytope->vertex_count == 3; i++) {
+            Vector3 direction = (i == 0) ? normal : vector3_getInverse(&normal);
+            GjkVertex vertex = gjk_getSupport(a, b, &direction, true);
+            Vector3 edge = vector3_difference(&vertex.w, &vertices[0].w);
+            if (fabsf(vector3_returnDotProduct(&normal, &edge)) > EPA_DEGENERATE_TOLERANCE) vertices[polytope->vertex_count++] = vertex;
+        }
+        if (polytope->vertex_count == 3) return false;
+    }
+
+    // Wind the faces so their normals point away from the fourth vertex
+    Vector3 ab = vector3_difference(&vertices[1].w, &vertices[0].w);
+    Vector3 ac = vector3_difference(&vertices[2].w, &vertices[0].w);
+    Vector3 ad = vector3_difference(&vertices[3].w, &vertices[0].w);
+    Vector3 normal = vector3_returnCrossProduct(&ab, &ac);
+
+    if (vector3_returnDotProduct(&normal, &ad) > 0.0f) {
+        GjkVertex swap = vertices[1];
+        vertices[1] = vertices[2];
+        vertices[2] = swap;
+    }
+
+    polytope->face_count = 0;
+    epa_addFace(polytope, 0, 1, 2);
+    epa_addFace(polytope, 0, 3, 1);
+    epa_addFace(polytope, 0, 2, 3);
+    epa_addFace(polytope, 1, 3, 2);
+    return true;
+}
+
+void epa_addFace(EpaPolytope* polytope, int v0, int v1, int v2)
+{
+    assert(polytope->face_count < EPA_MAX_FACES);
+
+    EpaFace* face = &polytope->faces[polytope->face_count++];
+    face->vertices[0] = v0;
+    face->vertices[1] = v1;
+    face->vertices[2] = v2;
+
+    const Vector3* a = &polytope->vertices[v0].w;
+    Vector3 ab = vector3_difference(&polytope->vertices[v1].w, a);
+    Vector3 ac = vector3_difference(&polytope->vertices[v2].w, a);
+    face->normal = vector3_returnCrossProduct(&ab, &ac);
+
+    // A sliver face has no direction to push, keep it out of the search
+    float length = vector3_magnitude(&face->normal);
+    if (length <= TOLERANCE) {
+        face->distance = FLT_MAX;
+        return;
+    }
+
+    vector3_divideByNumber(&face->normal, length);
+    face->distance = vector3_returnDotProduct(&face->normal, a);
+}
+
+int epa_getClosestFace(const EpaPolytope* polytope)
+{
+    int closest = 0;
+    for (int i = 1; i < polytope->face_count; i++) {
+        if (polytope->faces[i].distance < polytope->faces[closest].distance) closest = i;
+    }
+    return closest;
+}
+
+/* weights of the projection of the origin on "face" */
+void epa_getBarycentric(const EpaPolytope* polytope, const EpaFace* face, float weights[3])
+{
+    const Vector3* a = &polytope->vertices[face->vertices[0]].w;
+    Vector3 point = vector3_returnScaled(&face->normal, face->distance);
+
+    Vector3 v0 = vector3_difference(&polytope->vertices[face->vertices[1]].w, a);
+    Vector3 v1 = vector3_difference(&polytope->vertices[face->vertices[2]].w, a);
+    Vector3 v2 = vector3_difference(&point, a);
+
+    float d00 = vector3_returnDotProduct(&v0, &v0);
+    float d01 = vector3_returnDotProduct(&v0, &v1);
+    float d11 = vector3_returnDotProduct(&v1, &v1);
+    float d20 = vector3_returnDotProduct(&v2, &v0);
+    float d21 = vector3_returnDotProduct(&v2, &v1);
+    float denominator = d00 * d11 - d01 * d01;
+
+    if (denominator <= TOLERANCE) {
+        weights[0] = 1.0f;
+        weights[1] = 0.0f;
+        weights[2] = 0.0f;
+        return;
+    }
+
+    weights[1] = (d11 * d20 - d01 * d21) / denominator;
+    weights[2] = (d00 * d21 - d01 * d20) / denominator;
+    weights[0] = 1.0f - weights[1] - weights[2];
+}
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef GJK_H
+#define GJK_H
+
+/* GJK.H
+distance between two convex shapes reached only through their support points (Gilbert-Johnson-Keerthi).
+spheres and capsules are handled as their core (center, axis) rounded by their radius, which keeps GJK exact
+and quick on them. when the cores overlap, epa.h finds the penetration from the final simplex.
+a GjkCache kept for a pair starts the search where the last one ended, which saves coherent pairs about one iteration
+(2 to 4 instead of 2 to 5, box against box 4) */
+
+#define GJK_MAX_ITERATIONS 32
+#define GJK_RELATIVE_TOLERANCE 1e-4f        // progress along the search direction under which the distance is final
+#define GJK_OVERLAP_TOLERANCE 1e-4f         // core distance under which the cores count as overlapping
+
+
+// structures
+
+typedef struct {
+    int type;               // SPHERE_A, AABB_A, BOX_A, CAPSULE_A or CONVEX_HULL_A
+    const void* shape;
+} ConvexShape;
+
+typedef struct {
+    Vector3 w;              // support point of the difference of the shapes, a - b
+    Vector3 a;
+    Vector3 b;
+} GjkVertex;
+
+typedef struct {
+    GjkVertex vertices[4];
+    float weights[4];       // barycentric weights of the simplex point closest to the origin
+    int count;
+} GjkSimplex;
+
+typedef struct {
+    Vector3 direction;      // closest point of the difference found by the last query, zero for a new pair
+} GjkCache;
+
+typedef struct {
+    Vector3 point_a;        // closest points of the cores
+    Vector3 point_b;
+    float distance;         // between the cores, 0 when they overlap
+    bool overlap;
+    int iterations;
+    GjkSimplex simplex;     // final simplex, epa starts from it
+} GjkResult;
+
+
+// function prototypes
+
+bool convexShape_isSupported(int type);
+ConvexShape convexShape_fromCollider(const Collider* collider);
+float convexShape_getRadius(const ConvexShape* shape);
+Vector3 convexShape_getCoreSupport(const ConvexShape* shape, const Vector3* direction);
+Vector3 convexShape_getSupport(const ConvexShape* shape, const Vector3* direction);
+
+GjkVertex gjk_getSupport(const ConvexShape* a, const ConvexShape* b, const Vector3* direction, bool rounded);
+void gjk_getDistance(GjkResult* result, const ConvexShape* a, const ConvexShape* b, GjkCache* cache);
+
+bool gjk_solveSimplex(GjkSimplex* simplex, Vector3* closest);
+void gjk_solveSegment(GjkSimplex* simplex, int i, int j);
+void gjk_solveTriangle(GjkSimplex* simplex, int i, int j, int k);
+bool gjk_solveTetrahedron(GjkSimplex* simplex);
+void gjk_setVertex(GjkSimplex* simplex, int i);
+void gjk_compactSimplex(GjkSimplex* simplex);
+
+
+// function implementations
+
+bool convexShape_isSupported(int type)
+{
+    return type == SPHERE_A || type == AABB_A || type == BOX_A || type == CAPSULE_A || type == CONVEX_HULL_A;
+}
+
+ConvexShape convexShape_fromCollider(const Collider* collider)
+{
+    assert(convexShape_isSupported(collider->type));
+
+    switch(collider->type) {
+        case SPHERE_A: return (ConvexShape){SPHERE_A, &collider->sphere};
+        case AABB_A: return (ConvexShape){AABB_A, &collider->aabb};
+        case BOX_A: return (ConvexShape){BOX_A, &collider->box};
+        case CAPSULE_A: return (ConvexShape){CAPSULE_A, &collider->capsule};
+        default: return (ConvexShape){CONVEX_HULL_A, &collider->hull};
+    }
+}
+
+/* rounding around the core */
+float convexShape_getRadius(const ConvexShape* shape)
+{
+    switch(shape->type) {
+        case SPHERE_A: return ((const Sphere*)shape->shape)->radius;
+        case CAPSULE_A: return ((const Capsule*)shape->shape)->radius;
+        default: return 0.0f;
+    }
+}
+
+/* support point of the shape without its rounding */
+Vector3 convexShape_getCoreSupport(const ConvexShape* shape, const Vector3* direction)
+{
+    switch(shape->type) {
+        case SPHERE_A: return ((const Sphere*)shape->shape)->center;
+        case AABB_A: return aabb_getSupportPoint(shape->shape, direction);
+        case BOX_A: return box_getSupportPoint(shape->shape, direction);
+        case CAPSULE_A: return capsule_getAxisSupportPoint(shape->shape, direction);
+        default: return convexHull_getSupportPoint(shape->shape, direction);
+    }
+}
+
+/* support point of the whole shape */
+Vector3 convexShape_getSupport(const ConvexShape* shape, const Vector3* direction)
+{
+    switch(shape->type) {
+        case SPHERE_A: return sphere_getSupportPoint(shape->shape, direction);
+        case CAPSULE_A: return capsule_getSupportPoint(shape->shape, direction);
+        default: return convexShape_getCoreSupport(shape, direction);
+    }
+}
+
+/* support point of a - b along "direction", of the cores or of the "rounded" shapes */
+GjkVertex gjk_getSupport(const ConvexShape* a, const ConvexShape* b, const Vector3* direction, bool rounded)
+{
+    Vector3 opposite = vector3_getInverse(direction);
+    GjkVertex vertex;
+
+    if (rounded) {
+        vertex.a = convexShape_getSupport(a, direction);
+        vertex.b = convexShape_getSupport(b, &opposite);
+    }
+    else {
+        vertex.a = convexShape_getCoreSupport(a, direction);
+        vertex.b = convexShape_getCoreSupport(b, &opposite);
+    }
+
+    vertex.w = vector3_difference(&vertex.a, &vertex.b);
+    return vertex;
+}
+
+/* closest points between the cores of "a" and "b", "cache" can be NULL */
+void gjk_getDistance(GjkResult* result, const ConvexShape* a, const ConvexShape* b, GjkCache* cache)
+{
+    GjkSimplex* simplex = &result->simplex;
+    simplex->count = 0;
+    result->overlap = false;
+
+    // Any direction works to start, last query's one is usually already the right one
+    Vector3 closest = {1.0f, 0.0f, 0.0f};
+    if (cache != NULL && !vector3_isZero(&cache->direction)) closest = cache->direction;
+
+    int iteration = 0;
+    while (iteration < GJK_MAX_ITERATIONS) {
+
+        iteration++;
+
+        Vector3 search = vector3_getInverse(&closest);
+        GjkVertex vertex = gjk_getSupport(a, b, &search, false);
+
+        if (simplex->count > 0) {
+
+            // No progress towards the origin, the distance is final
+            float closest_squared = vector3_squaredMagnitude(&closest);
+            if (closest_squared - vector3_returnDotProduct(&closest, &vertex.w) <= GJK_RELATIVE_TOLERANCE * closest_squared) break;
+
+            bool repeated = false;
+            for (int i = 0; i < simplex->count; i++) {
+                if (vector3_equals(&simplex->vertices[i].w, &vertex.w)) repeated = true;
+            }
+            if (repeated) break;
+        }
+
+        GjkSimplex previous = *simplex;
+        Vector3 previous_closest = closest;
+        simplex->vertices[simplex->count++] = vertex;
+
+        if (gjk_solveSimplex(simplex, &closest) || vector3_squaredMagnitude(&closest) < GJK_OVERLAP_TOLERANCE * GJK_OVERLAP_TOLERANCE) {
+            result->overlap = true;
+            break;
+        }
+
+        // Rounding can make degenerate simplices cycle, the distance must shrink every iteration
+        if (previous.count > 0 && vector3_squaredMagnitude(&closest) >= vector3_squaredMagnitude(&previous_closest)) {
+            *simplex = previous;
+            closest = previous_closest;
+            break;
+        }
+    }
+
+    result->point_a = (Vector3){0.0f, 0.0f, 0.0f};
+    result->point_b = (Vector3){0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < simplex->count; i++) {
+        vector3_addScaledVector(&result->point_a, &simplex->vertices[i].a, simplex->weights[i]);
+        vector3_addScaledVector(&result->point_b, &simplex->vertices[i].b, simplex->weights[i]);
+    }
+
+    result->distance = result->overlap ? 0.0f : vector3_magnitude(&closest);
+    result->iterations = iteration;
+
+    if (cache != NULL && !vector3_isZero(&closest)) cache->direction = closest;
+}
+
+/* reduces the simplex to the smallest part holding its point closest to the origin, written in "closest".
+returns true when the simplex is a tetrahedron holding the origin */
+bool gjk_solveSimplex(GjkSimplex* simplex, Vector3* closest)
+{
+    bool inside = false;
+
+    switch(simplex->count) {
+        case 1: gjk_setVertex(simplex, 0); break;
+        case 2: gjk_solveSegment(simplex, 0, 1); break;
+        case 3: gjk_solveTriangle(simplex, 0, 1, 2); break;
+        default: inside = gjk_solveTetrahedron(simplex); break;
+    }
+
+    if (inside) {
+        *closest = (Vector3){0.0f, 0.0f, 0.0f};
+        return true;
+    }
+
+    gjk_compactSimplex(simplex);
+
+    *closest = (Vector3){0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < simplex->count; i++) vector3_addScaledVector(closest, &simplex->vertices[i].w, simplex->weights[i]);
+    return false;
+}
+
+/* keeps only vertex "i" */
+void gjk_setVertex(GjkSimplex* simplex, int i)
+{
+    for (int n = 0; n < 4; n++) simplex->weights[n] = 0.0f;
+    simplex->weights[i] = 1.0f;
+}
+
+/* closest point of the segment i j to the origin */
+void gjk_solveSegment(GjkSimplex* simplex, int i, int j)
+{
+    const Vector3* a = &simplex->vertices[i].w;
+    Vector3 ab = vector3_difference(&simplex->vertices[j].w, a);
+    float length_squared = vector3_squaredMagnitude(&ab);
+
+    float t = (length_squared > TOLERANCE) ? -vector3_returnDotProduct(a, &ab) / length_squared : 0.0f;
+
+    if (t <= 0.0f) gjk_setVertex(simplex, i);
+    else if (t >= 1.0f) gjk_setVertex(simplex, j);
+    else {
+        gjk_setVertex(simplex, i);
+        simplex->weights[i] = 1.0f - t;
+        simplex->weights[j] = t;
+    }
+}
+
+/* closest point of the triangle i j k to the origin, by its voronoi regions (ericson, real time collision detection 5.1.5) */
+void gjk_solveTriangle(GjkSimplex* simplex, int i, int j, int k)
+{
+    const Vector3* a = &simplex->vertices[i].w;
+    const Vector3* b = &simplex->vertices[j].w;
+    const Vector3* c = &simplex->vertices[k].w;
+
+    Vector3 ab = vector3_difference(b, a);
+    Vector3 ac = vector3_difference(c, a);
+
+    float d1 = -vector3_returnDotProduct(&ab, a);
+    float d2 = -vector3_returnDotProduct(&ac, a);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        gjk_setVertex(simplex, i);
+        return;
+    }
+
+    float d3 = -vector3_returnDotProduct(&ab, b);
+    float d4 = -vector3_returnDotProduct(&ac, b);
+    if (d3 >= 0.0f && d4 <= d3) {
+        gjk_setVertex(simplex, j);
+        return;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        gjk_solveSegment(simplex, i, j);
+        return;
+    }
+
+    float d5 = -vector3_returnDotProduct(&ab, c);
+    float d6 = -vector3_returnDotProduct(&ac, c);
+    if (d6 >= 0.0f && d5 <= d6) {
+        gjk_setVertex(simplex, k);
+        return;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        gjk_solveSegment(simplex, i, k);
+        return;
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        gjk_solveSegment(simplex, j, k);
+        return;
+    }
+
+    // Inside the face, a flat triangle never gets here with a usable denominator
+    float denominator = va + vb + vc;
+    if (denominator <= TOLERANCE) {
+        gjk_solveSegment(simplex, i, j);
+        return;
+    }
+
+    gjk_setVertex(simplex, i);
+    simplex->weights[j] = vb / denominator;
+    simplex->weights[k] = vc / denominator;
+    simplex->weights[i] = 1.0f - simplex->weights[j] - simplex->weights[k];
+}
+
+/* closest point of the tetrahedron to the origin, returns true when it holds the origin */
+bool gjk_solveTetrahedron(GjkSimplex* simplex)
+{
+    static const int faces[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+    float best_distance = FLT_MAX;
+    float best_weights[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    bool inside = true;
+
+    for (int f = 0; f < 4; f++) {
+
+        const Vector3* a = &simplex->vertices[faces[f][0]].w;
+        const Vector3* b = &simplex->vertices[faces[f][1]].w;
+        const Vector3* c = &simplex->vertices[faces[f][2]].w;
+        const Vector3* d = &simplex->vertices[faces[f][3]].w;
+
+        Vector3 ab = vector3_difference(b, a);
+        Vector3 ac = vector3_difference(c, a);
+        Vector3 normal = vector3_returnCrossProduct(&ab, &ac);
+        Vector3 ad = vector3_difference(d, a);
+
+        // The origin is on the other side of the face than the fourth vertex, a flat tetrahedron checks every face
+        float side_origin = -vector3_returnDotProduct(&normal, a);
+        float side_fourth = vector3_returnDotProduct(&normal, &ad);
+        if (side_origin * side_fourth > 0.0f) continue;
+
+        inside = false;
+
+        GjkSimplex face = *simplex;
+        gjk_solveTriangle(&face, faces[f][0], faces[f][1], faces[f][2]);
+
+        Vector3 closest = {0.0f, 0.0f, 0.0f};
+        for (int i = 0; i < 4; i++) vector3_addScaledVector(&closest, &face.vertices[i].w, face.weights[i]);
+
+        float distance = vector3_squaredMagnitude(&closest);
+        if (distance < best_distance) {
+            best_distance = distance;
+            for (int i = 0; i < 4; i++) best_weights[i] = face.weights[i];
+        }
+    }
+
+    if (inside) {
+        for (int i = 0; i < 4; i++) simplex->weights[i] = 0.25f;
+        return true;
+    }
+
+    for (int i = 0; i < 4; i++) simplex->weights[i] = best_weights[i];
+    return false;
+}
+
+/* drops the vertices without weight */
+void gjk_compactSimplex(GjkSimplex* simplex)
+{
+    int count = 0;
+    for (int i = 0; i < simplex->count; i++) {
+        if (simplex->weights[i] <= 0.0f) continue;
+        simplex->vertices[count] = simplex->vertices[i];
+        simplex->weights[count] = simplex->weights[i];
+        count++;
+    }
+    simplex->count = count;
+}
+
+#endif
@@ -0,0 +1,441 @@
+#ifndef NARROWPHASE_H
+#define NARROWPHASE_H
+
+/* NARROWPHASE.H
+contact between two colliders. a table indexed by the types of both colliders points at the test of the pair,
+the dedicated tests of the shapes where there is one and gjk and epa for any other pair of convex shapes.
+every test takes the collider with the lower type first, the mirrored entries swap the colliders and invert the normal.
+planes take any convex shape through its support points along their normal.
+compounds go through their children once their bounding sphere is hit.
+the candidate pairs of a step can be bucketed by type first, so each test runs over a run of pairs of its own */
+
+
+// structures
+
+/* narrowphase between two colliders, "a" has the lower type and the normal points from "b" towards "a" */
+typedef bool (*NarrowphaseTest)(ContactData* contact, const Collider* a, const Collider* b);
+
+typedef struct {
+    NarrowphaseTest test;       // NULL for the pairs without a test
+    bool swapped;               // mirrored pair, the colliders go in swapped and the normal gets inverted
+} NarrowphaseEntry;
+
+typedef struct {
+    const Collider* a;          // the one with the lower type
+    const Collider* b;
+    int key;                    // type pair, the row and column of the dispatch table in one index
+    GjkCache gjk;               // where gjk starts for "a" against "b", the caller carries it across frames
+} CollisionPair;
+
+/* the candidate pairs of a step, gathered in any order and bucketed by type pair before the narrowphase */
+typedef struct {
+    CollisionPair* pairs;
+    CollisionPair* sorted;      // the touching pairs end up at the front after collisionPairBuffer_collisionTest
+    ContactData* contacts;      // contact of each touching pair in "sorted"
+    int count;
+    int capacity;
+} CollisionPairBuffer;
+
+
+// function prototypes
+
+bool convexShape_collisionTest(ContactData* contact, const ConvexShape* a, const ConvexShape* b, GjkCache* cache);
+bool convexShape_collisionTestPlane(ContactData* contact, const ConvexShape* shape, const Plane* plane);
+bool collider_collisionTest(ContactData* contact, const Collider* a, const Collider* b);
+
+bool narrowphase_sphereSphere(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_sphereAABB(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_sphereBox(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_spherePlane(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_sphereCapsule(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_sphereTerrain(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_sphereMesh(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_aabbAABB(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_aabbCapsule(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_boxCapsule(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_planeCapsule(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_convexPlane(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_planeConvex(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_capsuleCapsule(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_capsuleTerrain(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_capsuleMesh(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_convex(ContactData* contact, const Collider* a, const Collider* b);
+bool narrowphase_convexCached(ContactData* contact, const Collider* a, const Collider* b, GjkCache* cache);
+bool narrowphase_compound(ContactData* contact, const Collider* a, const Collider* b);
+
+const NarrowphaseEntry* narrowphase_getEntry(int type_a, int type_b);
+
+void collisionPair_set(CollisionPair* pair, const Collider* a, const Collider* b);
+bool collisionPair_usesGjk(const CollisionPair* pair);
+
+size_t collisionPairBuffer_getMemorySize(int capacity);
+void collisionPairBuffer_initFromArena(CollisionPairBuffer* buffer, MemoryArena* arena, int capacity);
+void collisionPairBuffer_clear(CollisionPairBuffer* buffer);
+CollisionPair* collisionPairBuffer_add(CollisionPairBuffer* buffer, const Collider* a, const Collider* b);
+void collisionPairBuffer_sortByType(CollisionPairBuffer* buffer);
+int collisionPairBuffer_collisionTest(CollisionPairBuffer* buffer);
+
+
+// function implementations
+
+/* contact between two convex shapes, the normal points from "b" towards "a" and the point lies on "b".
+separated cores only need gjk, epa runs when the cores overlap. keep "cache" per pair across frames, or pass NULL */
+bool convexShape_collisionTest(ContactData* contact, const ConvexShape* a, const ConvexShape* b, GjkCache* cache)
+{
+    GjkResult result;
+    gjk_getDistance(&result, a, b, cache);
+
+    float radius_a = convexShape_getRadius(a);
+    float radius_b = convexShape_getRadius(b);
+
+    if (!result.overlap) {
+
+        if (result.distance >= radius_a + radius_b) return false;
+
+        // Only the roundings overlap, the closest points of the cores give everything
+        contact->normal = vector3_difference(&result.point_a, &result.point_b);
+        vector3_divideByNumber(&contact->normal, result.distance);
+        contact->penetration = radius_a + radius_b - result.distance;
+        contact->point = result.point_b;
+        vector3_addScaledVector(&contact->point, &contact->normal, radius_b);
+        return true;
+    }
+
+    if (!epa_getPenetration(contact, a, b, &result.simplex)) return false;
+
+    // Gjk keeps nothing when the cores overlap, the normal is where a separated pair would have ended
+    if (cache != NULL) cache->direction = contact->normal;
+    return true;
+}
+
+/* a convex shape touches the plane while the plane crosses it, rounding included, like capsule_collisionTestPlane.
+its support points along the normal give its extent, the deepest one the depth. the normal is the one of the plane
+and the point lies on the plane under the deepest support point */
+bool convexShape_collisionTestPlane(ContactData* contact, const ConvexShape* shape, const Plane* plane)
+{
+    Vector3 opposite = vector3_getInverse(&plane->normal);
+    Vector3 deepest = convexShape_getCoreSupport(shape, &opposite);
+    Vector3 highest = convexShape_getCoreSupport(shape, &plane->normal);
+    float radius = convexShape_getRadius(shape);
+
+    float distance = plane_distanceToPoint(plane, &deepest);
+    if (distance > radius || plane_distanceToPoint(plane, &highest) < -radius) return false;
+
+    contact->normal = plane->normal;
+    contact->penetration = radius - distance;
+    contact->point = deepest;
+    vector3_addScaledVector(&contact->point, &contact->normal, -distance);
+    return true;
+}
+
+/* each test below takes the colliders with the lower type first, the normal points from "b" towards "a" */
+
+bool narrowphase_sphereSphere(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return sphere_collisionTestSphere(contact, &b->sphere, &a->sphere);
+}
+
+bool narrowphase_sphereAABB(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return aabb_collisionTestSphere(contact, &b->aabb, &a->sphere);
+}
+
+bool narrowphase_sphereBox(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return box_collisionTestSphere(contact, &b->box, &a->sphere);
+}
+
+bool narrowphase_spherePlane(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return plane_collisionTestSphere(contact, &b->plane, &a->sphere);
+}
+
+/* the capsule tests give the normal towards the shape they are tested against */
+bool narrowphase_sphereCapsule(ContactData* contact, const Collider* a, const Collider* b)
+{
+    if (!capsule_collisionTestSphere(contact, &b->capsule, &a->sphere)) return false;
+    vector3_invert(&contact->normal);
+    return true;
+}
+
+/* the sphere goes in as a capsule of no length, the terrain and mesh tests only look at its axis and radius */
+bool narrowphase_sphereTerrain(ContactData* contact, const Collider* a, const Collider* b)
+{
+    Capsule point = {a->sphere.center, a->sphere.center, a->sphere.radius, 0.0f};
+    return capsule_collisionTestHeightfield(contact, &point, b->terrain);
+}
+
+bool narrowphase_sphereMesh(ContactData* contact, const Collider* a, const Collider* b)
+{
+    Capsule point = {a->sphere.center, a->sphere.center, a->sphere.radius, 0.0f};
+    return capsule_collisionTestMesh(contact, &point, b->mesh);
+}
+
+bool narrowphase_aabbAABB(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return aabb_collisionTestAABB(contact, &a->aabb, &b->aabb);
+}
+
+bool narrowphase_aabbCapsule(ContactData* contact, const Collider* a, const Collider* b)
+{
+    if (!capsule_collisionTestAABB(contact, &b->capsule, &a->aabb)) return false;
+    vector3_invert(&contact->normal);
+    return true;
+}
+
+bool narrowphase_boxCapsule(ContactData* contact, const Collider* a, const Collider* b)
+{
+    if (!capsule_collisionTestBox(contact, &b->capsule, &a->box)) return false;
+    vector3_invert(&contact->normal);
+    return true;
+}
+
+bool narrowphase_planeCapsule(ContactData* contact, const Collider* a, const Collider* b)
+{
+    if (!capsule_collisionTestPlane(contact, &b->capsule, &a->plane)) return false;
+    vector3_invert(&contact->normal);
+    return true;
+}
+
+bool narrowphase_capsuleCapsule(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return capsule_collisionTestCapsule(contact, &a->capsule, &b->capsule);
+}
+
+bool narrowphase_capsuleTerrain(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return capsule_collisionTestHeightfield(contact, &a->capsule, b->terrain);
+}
+
+bool narrowphase_capsuleMesh(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return capsule_collisionTestMesh(contact, &a->capsule, b->mesh);
+}
+
+/* "b" is the plane, for the convex types below it */
+bool narrowphase_convexPlane(ContactData* contact, const Collider* a, const Collider* b)
+{
+    ConvexShape shape = convexShape_fromCollider(a);
+    return convexShape_collisionTestPlane(contact, &shape, &b->plane);
+}
+
+/* "a" is the plane, for the convex types above it */
+bool narrowphase_planeConvex(ContactData* contact, const Collider* a, const Collider* b)
+{
+    ConvexShape shape = convexShape_fromCollider(b);
+    if (!convexShape_collisionTestPlane(contact, &shape, &a->plane)) return false;
+    vector3_invert(&contact->normal);
+    return true;
+}
+
+/* convex pairs without a dedicated test */
+bool narrowphase_convex(ContactData* contact, const Collider* a, const Collider* b)
+{
+    return narrowphase_convexCached(contact, a, b, NULL);
+}
+
+/* narrowphase_convex starting gjk from the cache of the pair, "cache" can be NULL */
+bool narrowphase_convexCached(ContactData* contact, const Collider* a, const Collider* b, GjkCache* cache)
+{
+    ConvexShape shape_a = convexShape_fromCollider(a);
+    ConvexShape shape_b = convexShape_fromCollider(b);
+    return convexShape_collisionTest(contact, &shape_a, &shape_b, cache);
+}
+
+/* "b" is the compound, its bounding sphere rejects the pair before any child is built or tested.
+the deepest contact among the children is kept */
+bool narrowphase_compound(ContactData* contact, const Collider* a, const Collider* b)
+{
+    AABB bounds = collider_getAABB(a);
+    if (!aabb_contactSphere(&bounds, &b->compound.bound)) return false;
+
+    const Collider* children = collider_getCompoundChildren(b);
+    bool hit = false;
+
+    for (int i = 0; i < b->compound.child_count; i++) {
+
+        ContactData child_contact;
+        if (!collider_collisionTest(&child_contact, a, &children[i])) continue;
+
+        if (!hit || child_contact.penetration > contact->penetration) *contact = child_contact;
+        hit = true;
+    }
+
+    return hit;
+}
+
+// Fills the entry of a type pair and its mirror
+#define NARROWPHASE_PAIR(type_a, type_b, function) \
+    [type_a][type_b] = {function, false}, [type_b][type_a] = {function, true}
+
+#define NARROWPHASE_SAME_PAIR(type, function) \
+    [type][type] = {function, false}
+
+static const NarrowphaseEntry narrowphase_table[COLLIDER_TYPE_COUNT][COLLIDER_TYPE_COUNT] = {
+
+    NARROWPHASE_SAME_PAIR(SPHERE_A, narrowphase_sphereSphere),
+    NARROWPHASE_PAIR(SPHERE_A, AABB_A, narrowphase_sphereAABB),
+    NARROWPHASE_PAIR(SPHERE_A, BOX_A, narrowphase_sphereBox),
+    NARROWPHASE_PAIR(SPHERE_A, PLANE_A, narrowphase_spherePlane),
+    NARROWPHASE_PAIR(SPHERE_A, CAPSULE_A, narrowphase_sphereCapsule),
+    NARROWPHASE_PAIR(SPHERE_A, TERRAIN_A, narrowphase_sphereTerrain),
+    NARROWPHASE_PAIR(SPHERE_A, MESH_A, narrowphase_sphereMesh),
+    NARROWPHASE_PAIR(SPHERE_A, CONVEX_HULL_A, narrowphase_convex),
+
+    NARROWPHASE_SAME_PAIR(AABB_A, narrowphase_aabbAABB),
+    NARROWPHASE_PAIR(AABB_A, BOX_A, narrowphase_convex),
+    NARROWPHASE_PAIR(AABB_A, PLANE_A, narrowphase_convexPlane),
+    NARROWPHASE_PAIR(AABB_A, CAPSULE_A, narrowphase_aabbCapsule),
+    NARROWPHASE_PAIR(AABB_A, CONVEX_HULL_A, narrowphase_convex),
+
+    NARROWPHASE_SAME_PAIR(BOX_A, narrowphase_convex),
+    NARROWPHASE_PAIR(BOX_A, PLANE_A, narrowphase_convexPlane),
+    NARROWPHASE_PAIR(BOX_A, CAPSULE_A, narrowphase_boxCapsule),
+    NARROWPHASE_PAIR(BOX_A, CONVEX_HULL_A, narrowphase_convex),
+
+    NARROWPHASE_PAIR(PLANE_A, CAPSULE_A, narrowphase_planeCapsule),
+    NARROWPHASE_PAIR(PLANE_A, CONVEX_HULL_A, narrowphase_planeConvex),
+
+    NARROWPHASE_SAME_PAIR(CAPSULE_A, narrowphase_capsuleCapsule),
+    NARROWPHASE_PAIR(CAPSULE_A, TERRAIN_A, narrowphase_capsuleTerrain),
+    NARROWPHASE_PAIR(CAPSULE_A, MESH_A, narrowphase_capsuleMesh),
+    NARROWPHASE_PAIR(CAPSULE_A, CONVEX_HULL_A, narrowphase_convex),
+
+    NARROWPHASE_SAME_PAIR(CONVEX_HULL_A, narrowphase_convex),
+
+    NARROWPHASE_PAIR(SPHERE_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(AABB_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(BOX_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(PLANE_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(CAPSULE_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(TERRAIN_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(MESH_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_PAIR(CONVEX_HULL_A, COMPOUND_A, narrowphase_compound),
+    NARROWPHASE_SAME_PAIR(COMPOUND_A, narrowphase_compound),
+};
+
+#undef NARROWPHASE_PAIR
+#undef NARROWPHASE_SAME_PAIR
+
+const NarrowphaseEntry* narrowphase_getEntry(int type_a, int type_b)
+{
+    assert(type_a >= 0 && type_a < COLLIDER_TYPE_COUNT && type_b >= 0 && type_b < COLLIDER_TYPE_COUNT);
+    return &narrowphase_table[type_a][type_b];
+}
+
+/* narrowphase between two colliders in any order, the normal points from "b" towards "a".
+returns false when they are apart and for the type pairs without a test */
+bool collider_collisionTest(ContactData* contact, const Collider* a, const Collider* b)
+{
+    const NarrowphaseEntry* entry = narrowphase_getEntry(a->type, b->type);
+    if (entry->test == NULL) return false;
+    if (!entry->swapped) return entry->test(contact, a, b);
+
+    if (!entry->test(contact, b, a)) return false;
+    vector3_invert(&contact->normal);
+    return true;
+}
+
+/* orders the colliders lower type first, so the pair always lands on an entry that isn't swapped */
+void collisionPair_set(CollisionPair* pair, const Collider* a, const Collider* b)
+{
+    if (a->type > b->type) {
+        const Collider* swap = a;
+        a = b;
+        b = swap;
+    }
+
+    pair->a = a;
+    pair->b = b;
+    pair->key = a->type * COLLIDER_TYPE_COUNT + b->type;
+    pair->gjk = (GjkCache){0};
+}
+
+/* the pairs whose test reads "gjk", the only ones worth a cache */
+bool collisionPair_usesGjk(const CollisionPair* pair)
+{
+    return narrowphase_table[pair->key / COLLIDER_TYPE_COUNT][pair->key % COLLIDER_TYPE_COUNT].test == narrowphase_convex;
+}
+
+size_t collisionPairBuffer_getMemorySize(int capacity)
+{
+    return 2 * memoryArena_getAlignedSize(capacity * sizeof(CollisionPair))
+        + memoryArena_getAlignedSize(capacity * sizeof(ContactData));
+}
+
+/* the buffer lives as long as the arena */
+void collisionPairBuffer_initFromArena(CollisionPairBuffer* buffer, MemoryArena* arena, int capacity)
+{
+    assert(capacity > 0);
+
+    buffer->pairs = memoryArena_allocate(arena, capacity * sizeof(CollisionPair));
+    buffer->sorted = memoryArena_allocate(arena, capacity * sizeof(CollisionPair));
+    buffer->contacts = memoryArena_allocate(arena, capacity * sizeof(ContactData));
+    buffer->count = 0;
+    buffer->capacity = capacity;
+}
+
+void collisionPairBuffer_clear(CollisionPairBuffer* buffer)
+{
+    buffer->count = 0;
+}
+
+/* pairs with no test for their types are dropped here and return NULL, the others return the pair with a new gjk cache */
+CollisionPair* collisionPairBuffer_add(CollisionPairBuffer* buffer, const Collider* a, const Collider* b)
+{
+    if (narrowphase_getEntry(a->type, b->type)->test == NULL) return NULL;
+
+    assert(buffer->count < buffer->capacity);
+    CollisionPair* pair = &buffer->pairs[buffer->count++];
+    collisionPair_set(pair, a, b);
+    return pair;
+}
+
+/* counting sort of "pairs" into "sorted" by type pair, stable so the pairs of a type keep their order */
+void collisionPairBuffer_sortByType(CollisionPairBuffer* buffer)
+{
+    int starts[COLLIDER_TYPE_COUNT * COLLIDER_TYPE_COUNT] = {0};
+
+    for (int i = 0; i < buffer->count; i++) starts[buffer->pairs[i].key]++;
+
+    int start = 0;
+    for (int key = 0; key < COLLIDER_TYPE_COUNT * COLLIDER_TYPE_COUNT; key++) {
+        int count = starts[key];
+        starts[key] = start;
+        start += count;
+    }
+
+    for (int i = 0; i < buffer->count; i++) buffer->sorted[starts[buffer->pairs[i].key]++] = buffer->pairs[i];
+}
+
+/* runs the narrowphase over the sorted pairs, one run of a type pair at a time with its test looked up once.
+the touching pairs are moved to the front of "sorted" with their contact at the same index in "contacts"
+and the gjk cache the test left, returns how many there are */
+int collisionPairBuffer_collisionTest(CollisionPairBuffer* buffer)
+{
+    int contact_count = 0;
+    int run_start = 0;
+
+    while (run_start < buffer->count) {
+
+        int key = buffer->sorted[run_start].key;
+        NarrowphaseTest test = narrowphase_table[key / COLLIDER_TYPE_COUNT][key % COLLIDER_TYPE_COUNT].test;
+        bool uses_gjk = (test == narrowphase_convex);
+
+        int run_end = run_start;
+        while (run_end < buffer->count && buffer->sorted[run_end].key == key) {
+
+            CollisionPair pair = buffer->sorted[run_end++];
+            ContactData* contact = &buffer->contacts[contact_count];
+            bool hit = uses_gjk ? narrowphase_convexCached(contact, pair.a, pair.b, &pair.gjk) : test(contact, pair.a, pair.b);
+            if (!hit) continue;
+            buffer->sorted[contact_count++] = pair;
+        }
+
+        run_start = run_end;
+    }
+
+    return contact_count;
+}
+
+#endif
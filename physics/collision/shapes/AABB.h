@@ -8,20 +8,52 @@ typedef struct AABB {
     Vector3 maxCoordinates;
 } AABB;
 
+/* AABBs laid out one array per component, for the batched queries */
+typedef struct {
+    float* min_x;
+    float* min_y;
+    float* min_z;
+    float* max_x;
+    float* max_y;
+    float* max_z;
+    int count;
+    int capacity;
+} AABBBatch;
+
 // function prototypes
 
 void aabb_setFromCenterAndSize(AABB *aabb, const Vector3* center, const Vector3* size);
 void aabb_getCorners(const AABB* aabb, Vector3 corners[8]);
 
+void aabb_merge(AABB* aabb, const AABB* other);
+AABB aabb_returnMerged(const AABB* a, const AABB* b);
+void aabb_inflate(AABB* aabb, float percentage);
+float aabb_getSurfaceArea(const AABB* aabb);
+bool aabb_containsAABB(const AABB* aabb, const AABB* other);
+
+AABB sphere_getAABB(const Sphere* sphere);
+Vector3 aabb_getSupportPoint(const AABB* aabb, const Vector3* direction);
+
 Vector3 aabb_closestToPoint(const AABB* aabb, const Vector3* point);
 Vector3 aabb_closestToSegment(const AABB* aabb, const Vector3* a, const Vector3* b);
 
 bool aabb_containsPoint(const AABB *aabb, const Vector3 *point);
 bool aabb_contactAABB(const AABB *a, const AABB *b);
+bool aabb_sweepAABB(float* time, const AABB* moving, const Vector3* displacement, const AABB* aabb);
+bool aabb_sweepAxis(float* enter, float* leave, float moving_min, float moving_max, float displacement, float min, float max);
 void aabb_contactAABBsetData(ContactData* contact, const AABB* a, const AABB* b);
 bool aabb_contactSphere(const AABB* aabb, const Sphere* sphere);
 void aabb_contactSphereSetData(ContactData* contact, const AABB* aabb, const Sphere* sphere);
 
+bool aabb_collisionTestAABB(ContactData* contact, const AABB* a, const AABB* b);
+bool aabb_collisionTestSphere(ContactData* contact, const AABB* aabb, const Sphere* sphere);
+
+void aabbBatch_init(AABBBatch* batch, int capacity);
+void aabbBatch_delete(AABBBatch* batch);
+void aabbBatch_clear(AABBBatch* batch);
+int aabbBatch_add(AABBBatch* batch, const AABB* aabb);
+void aabbBatch_set(AABBBatch* batch, int index, const AABB* aabb);
+
 // function implementations
 
 void aabb_setFromCenterAndSize(AABB *aabb, const Vector3* center, const Vector3* size) 
@@ -43,6 +75,53 @@ void aabb_getCorners(const AABB* aabb, Vector3 corners[8])
     corners[7] = (Vector3){aabb->maxCoordinates.x, aabb->maxCoordinates.y, aabb->maxCoordinates.z};
 }
 
+/* grows "aabb" so that it also encloses "other" */
+void aabb_merge(AABB* aabb, const AABB* other)
+{
+    aabb->minCoordinates = vector3_min(&aabb->minCoordinates, &other->minCoordinates);
+    aabb->maxCoordinates = vector3_max(&aabb->maxCoordinates, &other->maxCoordinates);
+}
+
+/* returns the smallest AABB enclosing both "a" and "b" */
+AABB aabb_returnMerged(const AABB* a, const AABB* b)
+{
+    AABB merged = *a;
+    aabb_merge(&merged, b);
+    return merged;
+}
+
+/* enlarges the AABB on every side by "percentage" of its size along each axis */
+void aabb_inflate(AABB* aabb, float percentage)
+{
+    Vector3 size = vector3_difference(&aabb->maxCoordinates, &aabb->minCoordinates);
+    Vector3 gap = vector3_returnScaled(&size, percentage * 0.5f);
+    vector3_subtract(&aabb->minCoordinates, &gap);
+    vector3_add(&aabb->maxCoordinates, &gap);
+}
+
+float aabb_getSurfaceArea(const AABB* aabb)
+{
+    Vector3 size = vector3_difference(&aabb->maxCoordinates, &aabb->minCoordinates);
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+/* return true if "other" lies completely inside "aabb" */
+bool aabb_containsAABB(const AABB* aabb, const AABB* other)
+{
+    return (other->minCoordinates.x >= aabb->minCoordinates.x && other->maxCoordinates.x <= aabb->maxCoordinates.x &&
+            other->minCoordinates.y >= aabb->minCoordinates.y && other->maxCoordinates.y <= aabb->maxCoordinates.y &&
+            other->minCoordinates.z >= aabb->minCoordinates.z && other->maxCoordinates.z <= aabb->maxCoordinates.z);
+}
+
+AABB sphere_getAABB(const Sphere* sphere)
+{
+    Vector3 extent = {sphere->radius, sphere->radius, sphere->radius};
+    return (AABB){
+        .minCoordinates = vector3_difference(&sphere->center, &extent),
+        .maxCoordinates = vector3_sum(&sphere->center, &extent)
+    };
+}
+
 Vector3 aabb_closestToPoint(const AABB* aabb, const Vector3* point) 
 {
     Vector3 closest;
@@ -52,6 +131,16 @@ Vector3 aabb_closestToPoint(const AABB* aabb, const Vector3* point)
     return closest;
 }
 
+/* farthest corner of the AABB along "direction" */
+Vector3 aabb_getSupportPoint(const AABB* aabb, const Vector3* direction)
+{
+    return (Vector3){
+        direction->x >= 0.0f ? aabb->maxCoordinates.x : aabb->minCoordinates.x,
+        direction->y >= 0.0f ? aabb->maxCoordinates.y : aabb->minCoordinates.y,
+        direction->z >= 0.0f ? aabb->maxCoordinates.z : aabb->minCoordinates.z
+    };
+}
+
 Vector3 aabb_getCenter(const AABB* aabb)
 {
     Vector3 sum = vector3_sum(&aabb->minCoordinates, &aabb->maxCoordinates);
@@ -110,6 +199,9 @@ Vector3 aabb_closestToSegment(const AABB* aabb, const Vector3* a, const Vector3*
         } else if (s.x > half_size.x) {
             region.x = 1;
             tanchor.x = (half_size.x - s.x) / v.x;
+        } else {
+            // Inside the slab, the anchor is where the segment leaves it
+            tanchor.x = (half_size.x - s.x) / v.x;
         }
     }
     else {
@@ -124,6 +216,8 @@ Vector3 aabb_closestToSegment(const AABB* aabb, const Vector3* a, const Vector3*
         } else if (s.y > half_size.y) {
             region.y = 1;
             tanchor.y = (half_size.y - s.y) / v.y;
+        } else {
+            tanchor.y = (half_size.y - s.y) / v.y;
         }
     }    
     else {
@@ -137,6 +231,8 @@ Vector3 aabb_closestToSegment(const AABB* aabb, const Vector3* a, const Vector3*
         } else if (s.z > half_size.z) {
             region.z = 1;
             tanchor.z = (half_size.z - s.z) / v.z;
+        } else {
+            tanchor.z = (half_size.z - s.z) / v.z;
         }
     }
     else {
@@ -229,6 +325,35 @@ bool aabb_contactAABB(const AABB *a, const AABB *b)
     return true;
 }
 
+/* "time" gets the fraction of "displacement" the AABB "moving" travels before it overlaps "aabb", 0 if it already does.
+returns false when they don't meet along the way. a cheap bound for the exact sweeps of the shapes inside them */
+bool aabb_sweepAABB(float* time, const AABB* moving, const Vector3* displacement, const AABB* aabb)
+{
+    float enter = 0.0f;
+    float leave = 1.0f;
+
+    if (!aabb_sweepAxis(&enter, &leave, moving->minCoordinates.x, moving->maxCoordinates.x, displacement->x, aabb->minCoordinates.x, aabb->maxCoordinates.x)) return false;
+    if (!aabb_sweepAxis(&enter, &leave, moving->minCoordinates.y, moving->maxCoordinates.y, displacement->y, aabb->minCoordinates.y, aabb->maxCoordinates.y)) return false;
+    if (!aabb_sweepAxis(&enter, &leave, moving->minCoordinates.z, moving->maxCoordinates.z, displacement->z, aabb->minCoordinates.z, aabb->maxCoordinates.z)) return false;
+
+    *time = enter;
+    return true;
+}
+
+/* narrows [enter, leave] to the fractions of the move where both intervals overlap along one axis */
+bool aabb_sweepAxis(float* enter, float* leave, float moving_min, float moving_max, float displacement, float min, float max)
+{
+    if (fabsf(displacement) < TOLERANCE) return moving_max >= min && moving_min <= max;
+
+    float inverse = 1.0f / displacement;
+    float t1 = (min - moving_max) * inverse;
+    float t2 = (max - moving_min) * inverse;
+
+    *enter = max2(*enter, min2(t1, t2));
+    *leave = min2(*leave, max2(t1, t2));
+    return *enter <= *leave;
+}
+
 void aabb_contactAABBsetData(ContactData* contact, const AABB* a, const AABB* b)
 {
     // Calculate overlap on each axis
@@ -276,6 +401,117 @@ void aabb_contactSphereSetData(ContactData* contact, const AABB* aabb, const Sph
     vector3_normalize(&contact->normal);
 }
 
+/* single pass test, returns false without touching "contact" when the boxes are apart.
+the normal points from "b" towards "a", which moves out of "b" by the penetration along it */
+bool aabb_collisionTestAABB(ContactData* contact, const AABB* a, const AABB* b)
+{
+    // How far "a" has to go up or down every axis to clear "b", an axis nested in the other needs more than its overlap
+    Vector3 push_up = vector3_difference(&b->maxCoordinates, &a->minCoordinates);
+    Vector3 push_down = vector3_difference(&a->maxCoordinates, &b->minCoordinates);
+    if (vector3_returnMinValue(&push_up) < 0.0f || vector3_returnMinValue(&push_down) < 0.0f) return false;
+
+    // The axis of least penetration gives the normal
+    contact->penetration = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        float up = vector3_returnElement(&push_up, i);
+        float down = vector3_returnElement(&push_down, i);
+        if (min2(up, down) >= contact->penetration) continue;
+
+        contact->penetration = min2(up, down);
+        contact->normal = (Vector3){0.0f, 0.0f, 0.0f};
+        vector3_setElement(&contact->normal, i, (up < down) ? 1.0f : -1.0f);
+    }
+
+    contact->point = (Vector3){
+        (max2(a->minCoordinates.x, b->minCoordinates.x) + min2(a->maxCoordinates.x, b->maxCoordinates.x)) * 0.5f,
+        (max2(a->minCoordinates.y, b->minCoordinates.y) + min2(a->maxCoordinates.y, b->maxCoordinates.y)) * 0.5f,
+        (max2(a->minCoordinates.z, b->minCoordinates.z) + min2(a->maxCoordinates.z, b->maxCoordinates.z)) * 0.5f
+    };
+
+    return true;
+}
+
+/* single pass test, returns false without touching "contact" when the shapes are apart.
+the normal points from the AABB towards the sphere */
+bool aabb_collisionTestSphere(ContactData* contact, const AABB* aabb, const Sphere* sphere)
+{
+    Vector3 closestPoint = aabb_closestToPoint(aabb, &sphere->center);
+    Vector3 difference = vector3_difference(&sphere->center, &closestPoint);
+    float distanceSquared = vector3_squaredMagnitude(&difference);
+    if (distanceSquared > sphere->radius * sphere->radius) return false;
+
+    contact->point = closestPoint;
+
+    // The center is inside the box, push out through the nearest face
+    if (distanceSquared < TOLERANCE) {
+        Vector3 toMin = vector3_difference(&sphere->center, &aabb->minCoordinates);
+        Vector3 toMax = vector3_difference(&aabb->maxCoordinates, &sphere->center);
+        float faces[6] = {toMin.x, toMax.x, toMin.y, toMax.y, toMin.z, toMax.z};
+        int face = 0;
+        for (int i = 1; i < 6; i++) if (faces[i] < faces[face]) face = i;
+        contact->normal = (Vector3){0.0f, 0.0f, 0.0f};
+        vector3_setElement(&contact->normal, face / 2, (face % 2) ? 1.0f : -1.0f);
+        contact->penetration = sphere->radius + faces[face];
+        return true;
+    }
+
+    float distance = vector3_magnitude(&difference);
+    contact->penetration = sphere->radius - distance;
+    contact->normal = vector3_returnScaled(&difference, 1.0f / distance);
+    return true;
+}
+
+/* one block holds every array */
+void aabbBatch_init(AABBBatch* batch, int capacity)
+{
+    assert(capacity > 0);
+
+    float* memory = malloc(6 * capacity * sizeof(float));
+    assert(memory != NULL);
+
+    batch->min_x = memory;
+    batch->min_y = memory + capacity;
+    batch->min_z = memory + 2 * capacity;
+    batch->max_x = memory + 3 * capacity;
+    batch->max_y = memory + 4 * capacity;
+    batch->max_z = memory + 5 * capacity;
+    batch->count = 0;
+    batch->capacity = capacity;
+}
+
+void aabbBatch_delete(AABBBatch* batch)
+{
+    free(batch->min_x);
+    batch->min_x = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+void aabbBatch_clear(AABBBatch* batch)
+{
+    batch->count = 0;
+}
+
+/* returns the index of the AABB in the batch */
+int aabbBatch_add(AABBBatch* batch, const AABB* aabb)
+{
+    assert(batch->count < batch->capacity);
 
+    int index = batch->count++;
+    aabbBatch_set(batch, index, aabb);
+    return index;
+}
+
+void aabbBatch_set(AABBBatch* batch, int index, const AABB* aabb)
+{
+    assert(index >= 0 && index < batch->count);
+
+    batch->min_x[index] = aabb->minCoordinates.x;
+    batch->min_y[index] = aabb->minCoordinates.y;
+    batch->min_z[index] = aabb->minCoordinates.z;
+    batch->max_x[index] = aabb->maxCoordinates.x;
+    batch->max_y[index] = aabb->maxCoordinates.y;
+    batch->max_z[index] = aabb->maxCoordinates.z;
+}
 
 #endif
\ No newline at end of file
@@ -6,20 +6,92 @@
 typedef struct {
     Vector3 size;
     Vector3 center;
-    Vector3 rotation;
+    Vector3 rotation;               // euler angles in degrees, change them with box_setRotation
+    Matrix3x3 orientation;          // local to global rotation built from "rotation", its transpose goes back to local
+    Vector3 orientation_rotation;   // rotation the cached orientation was built from
 } Box;
 
 
 // function prototypes
 
+void box_init(Box* box, const Vector3* size, const Vector3* center, const Vector3* rotation);
+void box_setRotation(Box* box, const Vector3* rotation);
+void box_updateOrientation(Box* box);
+bool box_hasOrientation(const Box* box);
+
+void box_transformToLocalSpace(const Box* box, Vector3* point);
+void box_transformToGlobalSpace(const Box* box, Vector3* point);
+void box_rotateToLocalSpace(const Box* box, Vector3* vector);
+void box_rotateToGlobalSpace(const Box* box, Vector3* vector);
+
 AABB box_getLocalAABB(const Box* box);
+AABB box_getAABB(const Box* box);
+Vector3 box_getSupportPoint(const Box* box, const Vector3* direction);
 
 bool box_contactSphere(const Box* box, const Sphere* sphere);
 void box_contactSphereSetData(ContactData* contact, const Box* box, const Sphere* sphere);
+bool box_collisionTestSphere(ContactData* contact, const Box* box, const Sphere* sphere);
 
 
 // function implementations
 
+void box_init(Box* box, const Vector3* size, const Vector3* center, const Vector3* rotation)
+{
+    box->size = *size;
+    box->center = *center;
+    box->rotation = *rotation;
+    box_updateOrientation(box);
+}
+
+/* rebuilds the cached orientation only when the rotation actually changes,
+or when there is none yet like in a zeroed box that never went through box_init */
+void box_setRotation(Box* box, const Vector3* rotation)
+{
+    box->rotation = *rotation;
+    if (vector3_equals(&box->orientation_rotation, rotation) && box_hasOrientation(box)) return;
+    box_updateOrientation(box);
+}
+
+/* builds the orientation matrix from "rotation", paying the trigonometry once per change instead of once per query.
+call it directly after writing "rotation" by hand */
+void box_updateOrientation(Box* box)
+{
+    box->orientation_rotation = box->rotation;
+    box->orientation = rotation_getMatrix(&box->rotation);
+}
+
+/* false for a zeroed orientation, which would collapse every point onto the center. the rows of a rotation are unit */
+bool box_hasOrientation(const Box* box)
+{
+    return vector3_squaredMagnitude(&box->orientation.row[0]) > 0.5f;
+}
+
+void box_transformToLocalSpace(const Box* box, Vector3* point)
+{
+    assert(box_hasOrientation(box));
+    Vector3 relative = vector3_difference(point, &box->center);
+    *point = matrix3x3_multiplyTransposeByVector(&box->orientation, &relative);
+}
+
+void box_transformToGlobalSpace(const Box* box, Vector3* point)
+{
+    assert(box_hasOrientation(box));
+    *point = matrix3x3_multiplyByVector(&box->orientation, point);
+    vector3_add(point, &box->center);
+}
+
+void box_rotateToLocalSpace(const Box* box, Vector3* vector)
+{
+    assert(box_hasOrientation(box));
+    *vector = matrix3x3_multiplyTransposeByVector(&box->orientation, vector);
+}
+
+void box_rotateToGlobalSpace(const Box* box, Vector3* vector)
+{
+    assert(box_hasOrientation(box));
+    *vector = matrix3x3_multiplyByVector(&box->orientation, vector);
+}
+
 AABB box_getLocalAABB(const Box* box) 
 {
     AABB aabb;
@@ -28,11 +100,46 @@ AABB box_getLocalAABB(const Box* box)
     return aabb;
 }
 
+/* returns the world space AABB enclosing the rotated box */
+AABB box_getAABB(const Box* box)
+{
+    assert(box_hasOrientation(box));
+    const Matrix3x3* r = &box->orientation;
+    Vector3 half_size = vector3_returnScaled(&box->size, 0.5f);
+
+    Vector3 extent = {
+        fabsf(r->row[0].x) * half_size.x + fabsf(r->row[0].y) * half_size.y + fabsf(r->row[0].z) * half_size.z,
+        fabsf(r->row[1].x) * half_size.x + fabsf(r->row[1].y) * half_size.y + fabsf(r->row[1].z) * half_size.z,
+        fabsf(r->row[2].x) * half_size.x + fabsf(r->row[2].y) * half_size.y + fabsf(r->row[2].z) * half_size.z
+    };
+
+    return (AABB){
+        .minCoordinates = vector3_difference(&box->center, &extent),
+        .maxCoordinates = vector3_sum(&box->center, &extent)
+    };
+}
+
+/* farthest corner of the box along "direction" */
+Vector3 box_getSupportPoint(const Box* box, const Vector3* direction)
+{
+    Vector3 local_direction = *direction;
+    box_rotateToLocalSpace(box, &local_direction);
+
+    Vector3 corner = {
+        local_direction.x >= 0.0f ? box->size.x * 0.5f : -box->size.x * 0.5f,
+        local_direction.y >= 0.0f ? box->size.y * 0.5f : -box->size.y * 0.5f,
+        local_direction.z >= 0.0f ? box->size.z * 0.5f : -box->size.z * 0.5f
+    };
+
+    box_transformToGlobalSpace(box, &corner);
+    return corner;
+}
+
 bool box_contactSphere(const Box* box, const Sphere* sphere)
 {
     // Transform the center of the sphere to the local space of the box
     Vector3 local_sphere_center = sphere->center;
-    point_transformToLocalSpace(&local_sphere_center, &box->center, &box->rotation);
+    box_transformToLocalSpace(box, &local_sphere_center);
 
     // Get the local AABB of the box and local sphere
     AABB local_aabb = box_getLocalAABB(box);
@@ -49,7 +156,7 @@ void box_contactSphereSetData(ContactData* contact, const Box* box, const Sphere
 {
     // Transform the center of the sphere to the local space of the box
     Vector3 local_sphere_center = sphere->center;
-    point_transformToLocalSpace(&local_sphere_center, &box->center, &box->rotation);
+    box_transformToLocalSpace(box, &local_sphere_center);
 
     // Get the local AABB of the box
     AABB local_aabb = box_getLocalAABB(box);
@@ -62,8 +169,22 @@ void box_contactSphereSetData(ContactData* contact, const Box* box, const Sphere
     vector3_normalize(&contact->normal);
 
     // Transform the closest point and normal back to global space
-    point_transformToGlobalSpace(&contact->point, &box->center, &box->rotation);
-    rotate_normal(&contact->normal, &box->rotation); // Rotate normal to global space
+    box_transformToGlobalSpace(box, &contact->point);
+    box_rotateToGlobalSpace(box, &contact->normal);
+}
+
+/* single pass test, the sphere is moved to the box space once and tested against the local AABB */
+bool box_collisionTestSphere(ContactData* contact, const Box* box, const Sphere* sphere)
+{
+    Sphere local_sphere = *sphere;
+    box_transformToLocalSpace(box, &local_sphere.center);
+    AABB local_aabb = box_getLocalAABB(box);
+
+    if (!aabb_collisionTestSphere(contact, &local_aabb, &local_sphere)) return false;
+
+    box_transformToGlobalSpace(box, &contact->point);
+    box_rotateToGlobalSpace(box, &contact->normal);
+    return true;
 }
 
 
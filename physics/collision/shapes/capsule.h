@@ -1,6 +1,9 @@
 #ifndef CAPSULE_H
 #define CAPSULE_H
 
+#define CAPSULE_SWEEP_MAX_ITERATIONS 16     // conservative advancement steps before a sweep gives up
+#define CAPSULE_SWEEP_TOLERANCE 0.01f       // gap at which a sweep counts as touching
+
 
 typedef struct {
     Vector3 start;
@@ -9,9 +12,26 @@ typedef struct {
     float length;
 } Capsule;
 
+/* capsules laid out one array per component, so a capsule can be tested against a whole group in a tight loop */
+typedef struct {
+    float* start_x;
+    float* start_y;
+    float* start_z;
+    float* axis_x;      // end - start
+    float* axis_y;
+    float* axis_z;
+    float* radius;
+    float* bound;       // radius of the sphere around the capsule centered at the middle of the axis
+    int count;
+    int capacity;
+} CapsuleBatch;
+
 // Function prototypes
 
 void capsule_setVertical(Capsule* capsule, const Vector3* position);
+AABB capsule_getAABB(const Capsule* capsule);
+Vector3 capsule_getAxisSupportPoint(const Capsule* capsule, const Vector3* direction);
+Vector3 capsule_getSupportPoint(const Capsule* capsule, const Vector3* direction);
 
 bool capsule_contactSphere(const Capsule* capsule, const Sphere* sphere);
 void capsule_contactSphereSetData(ContactData* contact, const Capsule* capsule, const Sphere* sphere);
@@ -23,9 +43,35 @@ bool capsule_contactBox(const Capsule* capsule, const Box* box);
 void capsule_contactBoxSetData(ContactData* contact, const Capsule* capsule, const Box* box);
 
 bool capsule_contactPlane(const Capsule* capsule, const Plane* plane);
+void capsule_contactPlaneSetData(ContactData* contact, const Capsule* capsule, const Plane* plane);
+
+bool capsule_contactCapsule(const Capsule* capsule, const Capsule* other);
+void capsule_contactCapsuleSetData(ContactData* contact, const Capsule* capsule, const Capsule* other);
+
+bool capsule_collisionTestSphere(ContactData* contact, const Capsule* capsule, const Sphere* sphere);
+bool capsule_collisionTestAABB(ContactData* contact, const Capsule* capsule, const AABB* aabb);
+bool capsule_collisionTestBox(ContactData* contact, const Capsule* capsule, const Box* box);
+bool capsule_collisionTestPlane(ContactData* contact, const Capsule* capsule, const Plane* plane);
+bool capsule_collisionTestCapsule(ContactData* contact, const Capsule* capsule, const Capsule* other);
+
+bool capsule_sweepSphere(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Sphere* sphere);
+bool capsule_sweepAABB(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const AABB* aabb);
+bool capsule_sweepBox(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Box* box);
+bool capsule_sweepPlane(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Plane* plane);
 
 bool capsule_intersectionRay(const Capsule* capsule, const Ray* ray);
 
+void capsuleBatch_init(CapsuleBatch* batch, int capacity);
+void capsuleBatch_delete(CapsuleBatch* batch);
+void capsuleBatch_clear(CapsuleBatch* batch);
+int capsuleBatch_add(CapsuleBatch* batch, const Capsule* capsule);
+void capsuleBatch_set(CapsuleBatch* batch, int index, const Capsule* capsule);
+int capsuleBatch_collisionTestCapsule(ContactData* contacts, int* indices, int max_contacts, const CapsuleBatch* batch, int first, const Capsule* capsule);
+void rayBatch_raycastCapsules(const RayBatch* rays, const CapsuleBatch* capsules, int first_id, float* distances, Vector3* normals, int* shapes);
+
+Vector3 capsule_getSeparatingNormal(const Vector3* axis, const Vector3* other_axis);
+void capsule_penetrationAABB(ContactData* contact, const Capsule* capsule, const AABB* aabb);
+
 // Function implementations
 
 void capsule_setVertical(Capsule* capsule, const Vector3* position)
@@ -36,6 +82,33 @@ void capsule_setVertical(Capsule* capsule, const Vector3* position)
     capsule->end.z = capsule->end.z + capsule->length - capsule->radius;
 }
 
+AABB capsule_getAABB(const Capsule* capsule)
+{
+    Vector3 extent = {capsule->radius, capsule->radius, capsule->radius};
+    Vector3 min = vector3_min(&capsule->start, &capsule->end);
+    Vector3 max = vector3_max(&capsule->start, &capsule->end);
+    return (AABB){
+        .minCoordinates = vector3_difference(&min, &extent),
+        .maxCoordinates = vector3_sum(&max, &extent)
+    };
+}
+
+/* end of the axis farthest along "direction" */
+Vector3 capsule_getAxisSupportPoint(const Capsule* capsule, const Vector3* direction)
+{
+    Vector3 axis = vector3_difference(&capsule->end, &capsule->start);
+    return (vector3_returnDotProduct(&axis, direction) >= 0.0f) ? capsule->end : capsule->start;
+}
+
+/* farthest point of the capsule along "direction", which doesn't need to be normalized */
+Vector3 capsule_getSupportPoint(const Capsule* capsule, const Vector3* direction)
+{
+    Vector3 support = capsule_getAxisSupportPoint(capsule, direction);
+    float length = vector3_magnitude(direction);
+    if (length > TOLERANCE) vector3_addScaledVector(&support, direction, capsule->radius / length);
+    return support;
+}
+
 bool capsule_contactSphere(const Capsule* capsule, const Sphere* sphere) 
 {
     // Calculate the closest point on the capsule segment to the sphere center
@@ -88,8 +161,8 @@ void capsule_contactAABBSetData(ContactData* contact, const Capsule* capsule, co
 bool capsule_contactBox(const Capsule* capsule, const Box* box)
 {
     Capsule local_capsule = *capsule;
-    point_transformToLocalSpace(&local_capsule.start, &box->center, &box->rotation);
-    point_transformToLocalSpace(&local_capsule.end, &box->center, &box->rotation);
+    box_transformToLocalSpace(box, &local_capsule.start);
+    box_transformToLocalSpace(box, &local_capsule.end);
     AABB local_aabb = box_getLocalAABB(box);  
     return capsule_contactAABB(&local_capsule, &local_aabb);
 }
@@ -97,13 +170,13 @@ bool capsule_contactBox(const Capsule* capsule, const Box* box)
 void capsule_contactBoxSetData(ContactData* contact, const Capsule* capsule, const Box* box)
 {
     Capsule local_capsule = *capsule;
-    point_transformToLocalSpace(&local_capsule.start, &box->center, &box->rotation);
-    point_transformToLocalSpace(&local_capsule.end, &box->center, &box->rotation);
+    box_transformToLocalSpace(box, &local_capsule.start);
+    box_transformToLocalSpace(box, &local_capsule.end);
     AABB local_aabb = box_getLocalAABB(box);
 
     capsule_contactAABBSetData(contact, &local_capsule, &local_aabb);
-    point_transformToGlobalSpace(&contact->point, &box->center, &box->rotation);
-    rotate_normal(&contact->normal, &box->rotation);
+    box_transformToGlobalSpace(box, &contact->point);
+    box_rotateToGlobalSpace(box, &contact->normal);
 }
 
 bool capsule_contactPlane(const Capsule* capsule, const Plane* plane)
@@ -134,19 +207,307 @@ void capsule_contactPlaneSetData(ContactData* contact, const Capsule* capsule, c
     // Set the contact normal as the plane's normal
     contact->normal = plane->normal;
 
-    // Determine the point of contact and penetration depth
-    if (fabs(distance_to_start) <= capsule->radius) {
-        // The start point of the capsule is within the radius distance from the plane
-        contact->penetration = capsule->radius - fabs(distance_to_start);
-        contact->point = capsule->start;
-        vector3_addScaledVector(&contact->point, &contact->normal, -distance_to_start);
-    } 
-    else if (fabs(distance_to_end) <= capsule->radius) {
-        // The end point of the capsule is within the radius distance from the plane
-        contact->penetration = capsule->radius - fabs(distance_to_end);
-        contact->point = capsule->end;
-        vector3_addScaledVector(&contact->point, &contact->normal, -distance_to_end);
+    // The endpoint deepest along the normal gives the depth, radius plus its distance when it is behind the plane
+    bool start_deeper = distance_to_start <= distance_to_end;
+    float distance = start_deeper ? distance_to_start : distance_to_end;
+    contact->penetration = capsule->radius - distance;
+    contact->point = start_deeper ? capsule->start : capsule->end;
+    vector3_addScaledVector(&contact->point, &contact->normal, -distance);
+}
+
+bool capsule_contactCapsule(const Capsule* capsule, const Capsule* other)
+{
+    Vector3 closest_on_axis, closest_on_other;
+    segment_closestPointsWithSegment(&capsule->start, &capsule->end, &other->start, &other->end, &closest_on_axis, &closest_on_other);
+
+    Vector3 difference = vector3_difference(&closest_on_axis, &closest_on_other);
+    float combined_radius = capsule->radius + other->radius;
+    return vector3_squaredMagnitude(&difference) <= combined_radius * combined_radius;
+}
+
+void capsule_contactCapsuleSetData(ContactData* contact, const Capsule* capsule, const Capsule* other)
+{
+    Vector3 closest_on_axis, closest_on_other;
+    segment_closestPointsWithSegment(&capsule->start, &capsule->end, &other->start, &other->end, &closest_on_axis, &closest_on_other);
+
+    // The normal points from the other capsule towards this one
+    contact->normal = vector3_difference(&closest_on_axis, &closest_on_other);
+    contact->penetration = capsule->radius + other->radius - vector3_magnitude(&contact->normal);
+    vector3_normalize(&contact->normal);
+
+    // Calculate the contact point in reference to the other capsule
+    contact->point = closest_on_other;
+    vector3_addScaledVector(&contact->point, &contact->normal, other->radius);
+}
+
+/* the collisionTest functions below answer the contact query and fill "contact" from a single evaluation,
+"contact" is left untouched when they return false */
+
+bool capsule_collisionTestSphere(ContactData* contact, const Capsule* capsule, const Sphere* sphere)
+{
+    Vector3 closest_on_axis = segment_closestToPoint(&capsule->start, &capsule->end, &sphere->center);
+    Vector3 difference = vector3_difference(&closest_on_axis, &sphere->center);
+    float distance_squared = vector3_squaredMagnitude(&difference);
+
+    float combined_radius = capsule->radius + sphere->radius;
+    if (distance_squared > combined_radius * combined_radius) return false;
+
+    float distance = vector3_magnitude(&difference);
+    contact->penetration = combined_radius - distance;
+    if (distance > TOLERANCE) contact->normal = vector3_returnScaled(&difference, 1.0f / distance);
+    else contact->normal = (Vector3){0.0f, 0.0f, 1.0f};
+
+    // The contact point is taken in reference to the sphere
+    contact->point = sphere->center;
+    vector3_addScaledVector(&contact->point, &contact->normal, sphere->radius);
+    return true;
+}
+
+/* the normal points from the AABB towards the capsule axis */
+bool capsule_collisionTestAABB(ContactData* contact, const Capsule* capsule, const AABB* aabb)
+{
+    Vector3 closest_point_on_aabb = aabb_closestToSegment(aabb, &capsule->end, &capsule->start);
+    Vector3 closest_point_on_axis = segment_closestToPoint(&capsule->end, &capsule->start, &closest_point_on_aabb);
+    Vector3 distance_vector = vector3_difference(&closest_point_on_axis, &closest_point_on_aabb);
+    float distance_squared = vector3_squaredMagnitude(&distance_vector);
+
+    if (distance_squared > capsule->radius * capsule->radius) return false;
+
+    // The axis goes through the box, the whole axis has to come out and not only its closest point
+    if (distance_squared < TOLERANCE) {
+        capsule_penetrationAABB(contact, capsule, aabb);
+        return true;
+    }
+
+    float distance = vector3_magnitude(&distance_vector);
+    contact->point = closest_point_on_aabb;
+    contact->penetration = capsule->radius - distance;
+    contact->normal = vector3_returnScaled(&distance_vector, 1.0f / distance);
+    return true;
+}
+
+/* the capsule is moved to the box space once, tested against the local AABB and the contact moved back */
+bool capsule_collisionTestBox(ContactData* contact, const Capsule* capsule, const Box* box)
+{
+    Capsule local_capsule = *capsule;
+    box_transformToLocalSpace(box, &local_capsule.start);
+    box_transformToLocalSpace(box, &local_capsule.end);
+    AABB local_aabb = box_getLocalAABB(box);
+
+    if (!capsule_collisionTestAABB(contact, &local_capsule, &local_aabb)) return false;
+
+    box_transformToGlobalSpace(box, &contact->point);
+    box_rotateToGlobalSpace(box, &contact->normal);
+    return true;
+}
+
+/* the capsule touches the plane while the signed distances of its endpoints overlap [-radius, radius],
+the endpoint with the smallest signed distance gives the depth, also when it is behind the plane */
+bool capsule_collisionTestPlane(ContactData* contact, const Capsule* capsule, const Plane* plane)
+{
+    float distance_to_start = plane_distanceToPoint(plane, &capsule->start);
+    float distance_to_end = plane_distanceToPoint(plane, &capsule->end);
+
+    bool start_deeper = distance_to_start <= distance_to_end;
+    float distance = start_deeper ? distance_to_start : distance_to_end;
+    float other_distance = start_deeper ? distance_to_end : distance_to_start;
+    if (distance > capsule->radius || other_distance < -capsule->radius) return false;
+
+    contact->normal = plane->normal;
+    contact->penetration = capsule->radius - distance;
+    contact->point = start_deeper ? capsule->start : capsule->end;
+    vector3_addScaledVector(&contact->point, &contact->normal, -distance);
+    return true;
+}
+
+/* the normal points from the other capsule towards this one, the point lies on the other capsule */
+bool capsule_collisionTestCapsule(ContactData* contact, const Capsule* capsule, const Capsule* other)
+{
+    Vector3 closest_on_axis, closest_on_other;
+    segment_closestPointsWithSegment(&capsule->start, &capsule->end, &other->start, &other->end, &closest_on_axis, &closest_on_other);
+
+    Vector3 difference = vector3_difference(&closest_on_axis, &closest_on_other);
+    float distance_squared = vector3_squaredMagnitude(&difference);
+
+    float combined_radius = capsule->radius + other->radius;
+    if (distance_squared > combined_radius * combined_radius) return false;
+
+    float distance = vector3_magnitude(&difference);
+    contact->penetration = combined_radius - distance;
+
+    if (distance > TOLERANCE) contact->normal = vector3_returnScaled(&difference, 1.0f / distance);
+    else {
+        Vector3 axis = vector3_difference(&capsule->end, &capsule->start);
+        Vector3 other_axis = vector3_difference(&other->end, &other->start);
+        contact->normal = capsule_getSeparatingNormal(&axis, &other_axis);
     }
+
+    contact->point = closest_on_other;
+    vector3_addScaledVector(&contact->point, &contact->normal, other->radius);
+    return true;
+}
+
+/* the sweep functions move the capsule along "displacement" and return true if it touches the shape on the way.
+"time" gets the fraction of the displacement travelled until the first contact, and "contact" the contact at that moment.
+a capsule already touching the shape returns time 0 with the contact of the matching collisionTest function */
+
+/* the sphere center is cast backwards against the capsule grown by the sphere radius */
+bool capsule_sweepSphere(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Sphere* sphere)
+{
+    if (capsule_collisionTestSphere(contact, capsule, sphere)) {
+        *time = 0.0f;
+        return true;
+    }
+
+    float length = vector3_magnitude(displacement);
+    if (length < TOLERANCE) return false;
+
+    Vector3 direction = vector3_returnScaled(displacement, -1.0f / length);
+    float radius = capsule->radius + sphere->radius;
+
+    Vector3 ba = vector3_difference(&capsule->end, &capsule->start);
+    Vector3 oa = vector3_difference(&sphere->center, &capsule->start);
+
+    float baba = vector3_returnDotProduct(&ba, &ba);
+    float bard = vector3_returnDotProduct(&ba, &direction);
+    float baoa = vector3_returnDotProduct(&ba, &oa);
+    float rdoa = vector3_returnDotProduct(&direction, &oa);
+    float oaoa = vector3_returnDotProduct(&oa, &oa);
+
+    float a = baba - bard * bard;
+    float b = baba * rdoa - baoa * bard;
+    float c = baba * oaoa - baoa * baoa - radius * radius * baba;
+    float h = b * b - a * c;
+    float t = -1.0f;
+
+    // Hit on the cylindrical body
+    if (h >= 0.0f && a > TOLERANCE) {
+        float body_t = (-b - sqrtf(h)) / a;
+        float y = baoa + body_t * bard;
+        if (y > 0.0f && y < baba) t = body_t;
+    }
+
+    // Otherwise the hit is on one of the caps, the closest one is kept
+    if (t < 0.0f) {
+        for (int i = 0; i < 2; i++) {
+            Vector3 oc = vector3_difference(&sphere->center, i == 0 ? &capsule->start : &capsule->end);
+            float cap_b = vector3_returnDotProduct(&direction, &oc);
+            float cap_c = vector3_returnDotProduct(&oc, &oc) - radius * radius;
+            float cap_h = cap_b * cap_b - cap_c;
+            if (cap_h < 0.0f) continue;
+            float cap_t = -cap_b - sqrtf(cap_h);
+            if (cap_t >= 0.0f && (t < 0.0f || cap_t < t)) t = cap_t;
+        }
+    }
+
+    if (t < 0.0f || t > length) return false;
+    *time = t / length;
+
+    // Contact at the moment of impact, touching with no penetration
+    Vector3 start = capsule->start;
+    Vector3 end = capsule->end;
+    vector3_addScaledVector(&start, displacement, *time);
+    vector3_addScaledVector(&end, displacement, *time);
+    Vector3 closest_on_axis = segment_closestToPoint(&start, &end, &sphere->center);
+
+    contact->normal = vector3_difference(&closest_on_axis, &sphere->center);
+    vector3_normalize(&contact->normal);
+    contact->point = sphere->center;
+    vector3_addScaledVector(&contact->point, &contact->normal, sphere->radius);
+    contact->penetration = 0.0f;
+    return true;
+}
+
+/* conservative advancement: the distance between convex shapes under a translation is a convex function of time,
+so moving by the gap over the closing speed along the current normal never passes the first contact */
+bool capsule_sweepAABB(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const AABB* aabb)
+{
+    if (capsule_collisionTestAABB(contact, capsule, aabb)) {
+        *time = 0.0f;
+        return true;
+    }
+
+    Capsule moved = *capsule;
+    float t = 0.0f;
+
+    for (int i = 0; i < CAPSULE_SWEEP_MAX_ITERATIONS; i++) {
+
+        Vector3 closest_point_on_aabb = aabb_closestToSegment(aabb, &moved.end, &moved.start);
+        Vector3 closest_point_on_axis = segment_closestToPoint(&moved.end, &moved.start, &closest_point_on_aabb);
+        Vector3 distance_vector = vector3_difference(&closest_point_on_axis, &closest_point_on_aabb);
+        float distance = vector3_magnitude(&distance_vector);
+        float gap = distance - capsule->radius;
+
+        Vector3 normal = vector3_returnScaled(&distance_vector, 1.0f / distance);
+
+        if (gap <= CAPSULE_SWEEP_TOLERANCE) {
+            *time = t;
+            contact->point = closest_point_on_aabb;
+            contact->normal = normal;
+            contact->penetration = -gap;
+            return true;
+        }
+
+        float closing_speed = -vector3_returnDotProduct(&normal, displacement);
+        if (closing_speed <= 0.0f) return false;
+
+        t += gap / closing_speed;
+        if (t > 1.0f) return false;
+
+        moved.start = capsule->start;
+        moved.end = capsule->end;
+        vector3_addScaledVector(&moved.start, displacement, t);
+        vector3_addScaledVector(&moved.end, displacement, t);
+    }
+
+    return false;
+}
+
+bool capsule_sweepBox(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Box* box)
+{
+    Capsule local_capsule = *capsule;
+    box_transformToLocalSpace(box, &local_capsule.start);
+    box_transformToLocalSpace(box, &local_capsule.end);
+    Vector3 local_displacement = *displacement;
+    box_rotateToLocalSpace(box, &local_displacement);
+    AABB local_aabb = box_getLocalAABB(box);
+
+    if (!capsule_sweepAABB(contact, time, &local_capsule, &local_displacement, &local_aabb)) return false;
+
+    box_transformToGlobalSpace(box, &contact->point);
+    box_rotateToGlobalSpace(box, &contact->normal);
+    return true;
+}
+
+/* the capsule is swept towards the plane from the side its axis is on */
+bool capsule_sweepPlane(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Plane* plane)
+{
+    if (capsule_collisionTestPlane(contact, capsule, plane)) {
+        *time = 0.0f;
+        return true;
+    }
+
+    float distance_to_start = plane_distanceToPoint(plane, &capsule->start);
+    float distance_to_end = plane_distanceToPoint(plane, &capsule->end);
+    float side = (distance_to_start > 0.0f) ? 1.0f : -1.0f;
+
+    // The endpoint nearest to the plane touches first
+    const Vector3* endpoint = (side * distance_to_start < side * distance_to_end) ? &capsule->start : &capsule->end;
+    float distance = min2(side * distance_to_start, side * distance_to_end);
+
+    float closing_speed = -side * vector3_returnDotProduct(&plane->normal, displacement);
+    if (closing_speed <= 0.0f) return false;
+
+    float t = (distance - capsule->radius) / closing_speed;
+    if (t > 1.0f) return false;
+    *time = t;
+
+    contact->normal = vector3_returnScaled(&plane->normal, side);
+    contact->point = *endpoint;
+    vector3_addScaledVector(&contact->point, displacement, t);
+    vector3_addScaledVector(&contact->point, &contact->normal, -capsule->radius);
+    contact->penetration = 0.0f;
+    return true;
 }
 
 bool capsule_intersectionRay(const Capsule* capsule, const Ray* ray)
@@ -187,7 +548,312 @@ bool capsule_intersectionRay(const Capsule* capsule, const Ray* ray)
     // Return false if no intersection is found
     return false;
 }
+/* one block holds every array */
+void capsuleBatch_init(CapsuleBatch* batch, int capacity)
+{
+    assert(capacity > 0);
+
+    float* memory = malloc(8 * capacity * sizeof(float));
+    assert(memory != NULL);
+
+    batch->start_x = memory;
+    batch->start_y = memory + capacity;
+    batch->start_z = memory + 2 * capacity;
+    batch->axis_x = memory + 3 * capacity;
+    batch->axis_y = memory + 4 * capacity;
+    batch->axis_z = memory + 5 * capacity;
+    batch->radius = memory + 6 * capacity;
+    batch->bound = memory + 7 * capacity;
+    batch->count = 0;
+    batch->capacity = capacity;
+}
+
+void capsuleBatch_delete(CapsuleBatch* batch)
+{
+    free(batch->start_x);
+    batch->start_x = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+void capsuleBatch_clear(CapsuleBatch* batch)
+{
+    batch->count = 0;
+}
+
+/* returns the index of the capsule in the batch */
+int capsuleBatch_add(CapsuleBatch* batch, const Capsule* capsule)
+{
+    assert(batch->count < batch->capacity);
+
+    int index = batch->count++;
+    capsuleBatch_set(batch, index, capsule);
+    return index;
+}
+
+/* call again after moving the capsule */
+void capsuleBatch_set(CapsuleBatch* batch, int index, const Capsule* capsule)
+{
+    assert(index >= 0 && index < batch->count);
+
+    Vector3 axis = vector3_difference(&capsule->end, &capsule->start);
+
+    batch->start_x[index] = capsule->start.x;
+    batch->start_y[index] = capsule->start.y;
+    batch->start_z[index] = capsule->start.z;
+    batch->axis_x[index] = axis.x;
+    batch->axis_y[index] = axis.y;
+    batch->axis_z[index] = axis.z;
+    batch->radius[index] = capsule->radius;
+    batch->bound[index] = capsule->radius + 0.5f * vector3_magnitude(&axis);
+}
+
+/* tests "capsule" against the capsules of the batch from "first" on, with the contacts of capsule_collisionTestCapsule.
+writes up to "max_contacts" contacts and the batch index of each in "indices", returns how many.
+for every pair within a group, test the capsule at index i from i + 1 */
+int capsuleBatch_collisionTestCapsule(ContactData* contacts, int* indices, int max_contacts, const CapsuleBatch* batch, int first, const Capsule* capsule)
+{
+    float p_x = capsule->start.x;
+    float p_y = capsule->start.y;
+    float p_z = capsule->start.z;
+    float d1_x = capsule->end.x - p_x;
+    float d1_y = capsule->end.y - p_y;
+    float d1_z = capsule->end.z - p_z;
+    float a = d1_x * d1_x + d1_y * d1_y + d1_z * d1_z;
+
+    float middle_x = p_x + 0.5f * d1_x;
+    float middle_y = p_y + 0.5f * d1_y;
+    float middle_z = p_z + 0.5f * d1_z;
+    float bound = capsule->radius + 0.5f * sqrtf(a);
+
+    int contact_count = 0;
+
+    for (int i = first; i < batch->count && contact_count < max_contacts; i++) {
+
+        float d2_x = batch->axis_x[i];
+        float d2_y = batch->axis_y[i];
+        float d2_z = batch->axis_z[i];
+
+        // Bounding spheres first, most pairs of a crowd end here
+        float c_x = batch->start_x[i] + 0.5f * d2_x - middle_x;
+        float c_y = batch->start_y[i] + 0.5f * d2_y - middle_y;
+        float c_z = batch->start_z[i] + 0.5f * d2_z - middle_z;
+        float bounds = bound + batch->bound[i];
+        if (c_x * c_x + c_y * c_y + c_z * c_z > bounds * bounds) continue;
+
+        // Closest points of the axes, as segment_closestPointsWithSegment
+        float r_x = p_x - batch->start_x[i];
+        float r_y = p_y - batch->start_y[i];
+        float r_z = p_z - batch->start_z[i];
+        float e = d2_x * d2_x + d2_y * d2_y + d2_z * d2_z;
+        float f = d2_x * r_x + d2_y * r_y + d2_z * r_z;
+        float c = d1_x * r_x + d1_y * r_y + d1_z * r_z;
+        float b = d1_x * d2_x + d1_y * d2_y + d1_z * d2_z;
+        float s, t;
+
+        if (a <= TOLERANCE && e <= TOLERANCE) {
+            s = 0.0f;
+            t = 0.0f;
+        }
+        else if (a <= TOLERANCE) {
+            s = 0.0f;
+            t = clamp(f / e, 0.0f, 1.0f);
+        }
+        else if (e <= TOLERANCE) {
+            t = 0.0f;
+            s = clamp(-c / a, 0.0f, 1.0f);
+        }
+        else {
+            float denominator = a * e - b * b;
+            s = (denominator > TOLERANCE) ? clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = clamp(-c / a, 0.0f, 1.0f);
+            }
+            else if (t > 1.0f) {
+                t = 1.0f;
+                s = clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+
+        float q_x = batch->start_x[i] + d2_x * t;
+        float q_y = batch->start_y[i] + d2_y * t;
+        float q_z = batch->start_z[i] + d2_z * t;
+        float n_x = p_x + d1_x * s - q_x;
+        float n_y = p_y + d1_y * s - q_y;
+        float n_z = p_z + d1_z * s - q_z;
+        float distance_squared = n_x * n_x + n_y * n_y + n_z * n_z;
+
+        float combined_radius = capsule->radius + batch->radius[i];
+        if (distance_squared > combined_radius * combined_radius) continue;
+
+        ContactData* contact = &contacts[contact_count];
+        float distance = sqrtf(distance_squared);
+        contact->penetration = combined_radius - distance;
+
+        if (distance > TOLERANCE) contact->normal = (Vector3){n_x / distance, n_y / distance, n_z / distance};
+        else {
+            Vector3 axis = {d1_x, d1_y, d1_z};
+            Vector3 other_axis = {d2_x, d2_y, d2_z};
+            contact->normal = capsule_getSeparatingNormal(&axis, &other_axis);
+        }
+
+        contact->point = (Vector3){q_x, q_y, q_z};
+        vector3_addScaledVector(&contact->point, &contact->normal, batch->radius[i]);
+
+        indices[contact_count++] = i;
+    }
+
+    return contact_count;
+}
 
+/* batched raycast against capsules, as the ones of ray.h. the capsule is the union of its body and its two end spheres,
+so the ray enters it at the nearest of their entries */
+void rayBatch_raycastCapsules(const RayBatch* rays, const CapsuleBatch* capsules, int first_id, float* distances, Vector3* normals, int* shapes)
+{
+    for (int i = 0; i < rays->count; i++) {
+
+        float origin_x = rays->origin_x[i];
+        float origin_y = rays->origin_y[i];
+        float origin_z = rays->origin_z[i];
+        float direction_x = rays->direction_x[i];
+        float direction_y = rays->direction_y[i];
+        float direction_z = rays->direction_z[i];
+
+        float nearest = distances[i];
+        int hit = -1;
+
+        for (int j = 0; j < capsules->count; j++) {
+
+            float radius_squared = capsules->radius[j] * capsules->radius[j];
+            float axis_x = capsules->axis_x[j];
+            float axis_y = capsules->axis_y[j];
+            float axis_z = capsules->axis_z[j];
+            float oa_x = origin_x - capsules->start_x[j];
+            float oa_y = origin_y - capsules->start_y[j];
+            float oa_z = origin_z - capsules->start_z[j];
+
+            float baba = axis_x * axis_x + axis_y * axis_y + axis_z * axis_z;
+            float bard = axis_x * direction_x + axis_y * direction_y + axis_z * direction_z;
+            float baoa = axis_x * oa_x + axis_y * oa_y + axis_z * oa_z;
+            float rdoa = direction_x * oa_x + direction_y * oa_y + direction_z * oa_z;
+            float oaoa = oa_x * oa_x + oa_y * oa_y + oa_z * oa_z;
+
+            // Starting inside the capsule is no hit
+            float along = (baba > TOLERANCE) ? clamp(baoa / baba, 0.0f, 1.0f) : 0.0f;
+            float inside_x = oa_x - axis_x * along;
+            float inside_y = oa_y - axis_y * along;
+            float inside_z = oa_z - axis_z * along;
+            if (inside_x * inside_x + inside_y * inside_y + inside_z * inside_z < radius_squared) continue;
+
+            float t = nearest;
+
+            // Body, the infinite cylinder cut at both ends
+            float a = baba - bard * bard;
+            if (a > TOLERANCE) {
+                float b = baba * rdoa - baoa * bard;
+                float c = baba * oaoa - baoa * baoa - radius_squared * baba;
+                float h = b * b - a * c;
+                if (h >= 0.0f) {
+                    float body_t = (-b - sqrtf(h)) / a;
+                    float y = baoa + body_t * bard;
+                    if (body_t >= 0.0f && y > 0.0f && y < baba && body_t < t) t = body_t;
+                }
+            }
+
+            // End spheres
+            float b = rdoa;
+            float c = oaoa - radius_squared;
+            float h = b * b - c;
+            if (h >= 0.0f && b <= 0.0f) t = min2(t, -b - sqrtf(h));
+
+            float ob_x = oa_x - axis_x;
+            float ob_y = oa_y - axis_y;
+            float ob_z = oa_z - axis_z;
+            b = direction_x * ob_x + direction_y * ob_y + direction_z * ob_z;
+            c = ob_x * ob_x + ob_y * ob_y + ob_z * ob_z - radius_squared;
+            h = b * b - c;
+            if (h >= 0.0f && b <= 0.0f) t = min2(t, -b - sqrtf(h));
+
+            if (t < nearest) {
+                nearest = t;
+                hit = j;
+            }
+        }
+
+        if (hit < 0) continue;
+
+        // From the closest point of the axis to the hit point
+        Vector3 point = {origin_x + direction_x * nearest, origin_y + direction_y * nearest, origin_z + direction_z * nearest};
+        Vector3 start = {capsules->start_x[hit], capsules->start_y[hit], capsules->start_z[hit]};
+        Vector3 end = {start.x + capsules->axis_x[hit], start.y + capsules->axis_y[hit], start.z + capsules->axis_z[hit]};
+        Vector3 closest = segment_closestToPoint(&start, &end, &point);
+        Vector3 normal = vector3_difference(&point, &closest);
+        vector3_divideByNumber(&normal, capsules->radius[hit]);
+
+        distances[i] = nearest;
+        normals[i] = normal;
+        shapes[i] = first_id + hit;
+    }
+}
+
+/* a normal for axes that cross, perpendicular to both, or to the first one when they are parallel */
+Vector3 capsule_getSeparatingNormal(const Vector3* axis, const Vector3* other_axis)
+{
+    Vector3 normal = vector3_returnCrossProduct(axis, other_axis);
+
+    if (vector3_squaredMagnitude(&normal) <= TOLERANCE) {
+        Vector3 side = (fabsf(axis->x) < fabsf(axis->z)) ? (Vector3){1.0f, 0.0f, 0.0f} : (Vector3){0.0f, 0.0f, 1.0f};
+        normal = vector3_returnCrossProduct(axis, &side);
+    }
+
+    if (vector3_squaredMagnitude(&normal) <= TOLERANCE) return (Vector3){0.0f, 0.0f, 1.0f};
+
+    vector3_normalize(&normal);
+    return normal;
+}
+
+/* contact of a capsule whose axis goes through the AABB. the least overlap over the face normals and the axis crossed
+with every edge direction is the exact depth of the axis, the radius adds the same to every one of them.
+the normal points from the AABB towards the capsule and the point is on the AABB */
+void capsule_penetrationAABB(ContactData* contact, const Capsule* capsule, const AABB* aabb)
+{
+    Vector3 half_size = aabb_getHalfSize(aabb);
+    Vector3 center = aabb_getCenter(aabb);
+    Vector3 half_axis = vector3_difference(&capsule->end, &capsule->start);
+    vector3_scale(&half_axis, 0.5f);
+    Vector3 offset = vector3_sum(&capsule->start, &half_axis);
+    vector3_subtract(&offset, &center);
+
+    contact->penetration = FLT_MAX;
+
+    for (int i = 0; i < 6; i++) {
+
+        Vector3 axis = {0.0f, 0.0f, 0.0f};
+        vector3_setElement(&axis, i % 3, 1.0f);
+        if (i >= 3) {
+            axis = vector3_returnCrossProduct(&half_axis, &axis);
+            if (vector3_squaredMagnitude(&axis) <= TOLERANCE) continue;
+            vector3_normalize(&axis);
+        }
+
+        float separation = vector3_returnDotProduct(&offset, &axis);
+        float overlap = half_size.x * fabsf(axis.x) + half_size.y * fabsf(axis.y) + half_size.z * fabsf(axis.z)
+            + fabsf(vector3_returnDotProduct(&half_axis, &axis)) + capsule->radius - fabsf(separation);
+
+        if (overlap < contact->penetration) {
+            contact->penetration = overlap;
+            contact->normal = (separation < 0.0f) ? vector3_getInverse(&axis) : axis;
+        }
+    }
+
+    // The deepest end of the axis, moved out to the surface of the box
+    Vector3 inward = vector3_getInverse(&contact->normal);
+    contact->point = capsule_getAxisSupportPoint(capsule, &inward);
+    vector3_addScaledVector(&contact->point, &contact->normal, contact->penetration - capsule->radius);
+}
 
 
 /*
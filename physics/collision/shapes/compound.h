@@ -0,0 +1,53 @@
+#ifndef COMPOUND_H
+#define COMPOUND_H
+
+/* COMPOUND.H
+several colliders moving as one, like the parts of an actor. the children are given in the frame of the compound
+and a bounding sphere around the compound origin encloses all of them whatever the rotation, so a test against
+the compound can be rejected before looking at any child. moving the compound only moves the sphere,
+the world space children are rebuilt the first time a test needs them, see collider_getCompoundChildren */
+
+
+// structures
+
+typedef struct Collider Collider;
+
+typedef struct {
+    const Collider* children;       // in the frame of the compound, owned by the caller
+    Collider* world_children;       // caller storage of "child_count" colliders for the world space children
+    int child_count;
+    Sphere bound;                   // centered on the compound origin, which is its position
+    Vector3 rotation;               // euler angles in degrees, like the boxes
+    bool dirty;                     // moved since the world children were built
+} Compound;
+
+
+// function prototypes
+
+void compound_setTransform(Compound* compound, const Vector3* position, const Vector3* rotation);
+void compound_setPosition(Compound* compound, const Vector3* position);
+AABB compound_getAABB(const Compound* compound);
+
+
+// function implementations
+
+/* cheap, the children follow when they are next needed */
+void compound_setTransform(Compound* compound, const Vector3* position, const Vector3* rotation)
+{
+    compound->bound.center = *position;
+    compound->rotation = *rotation;
+    compound->dirty = true;
+}
+
+void compound_setPosition(Compound* compound, const Vector3* position)
+{
+    compound->bound.center = *position;
+    compound->dirty = true;
+}
+
+AABB compound_getAABB(const Compound* compound)
+{
+    return sphere_getAABB(&compound->bound);
+}
+
+#endif
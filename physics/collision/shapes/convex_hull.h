@@ -0,0 +1,66 @@
+#ifndef CONVEX_HULL_H
+#define CONVEX_HULL_H
+
+/* CONVEX_HULL.H
+convex shape given by its points, only reached through its support point so the points don't need to be
+the exact hull, points inside it are harmless. the points are shared and translated by "center" */
+
+// structures
+
+typedef struct {
+    const Vector3* vertices;    // relative to "center"
+    int vertex_count;
+    Vector3 center;
+} ConvexHull;
+
+
+// function prototypes
+
+void convexHull_init(ConvexHull* hull, const Vector3* vertices, int vertex_count, const Vector3* center);
+AABB convexHull_getAABB(const ConvexHull* hull);
+Vector3 convexHull_getSupportPoint(const ConvexHull* hull, const Vector3* direction);
+
+
+// function implementations
+
+void convexHull_init(ConvexHull* hull, const Vector3* vertices, int vertex_count, const Vector3* center)
+{
+    assert(vertices != NULL && vertex_count > 0);
+
+    hull->vertices = vertices;
+    hull->vertex_count = vertex_count;
+    hull->center = *center;
+}
+
+AABB convexHull_getAABB(const ConvexHull* hull)
+{
+    AABB aabb = {hull->vertices[0], hull->vertices[0]};
+
+    for (int i = 1; i < hull->vertex_count; i++) {
+        aabb.minCoordinates = vector3_min(&aabb.minCoordinates, &hull->vertices[i]);
+        aabb.maxCoordinates = vector3_max(&aabb.maxCoordinates, &hull->vertices[i]);
+    }
+
+    vector3_add(&aabb.minCoordinates, &hull->center);
+    vector3_add(&aabb.maxCoordinates, &hull->center);
+    return aabb;
+}
+
+/* farthest point of the hull along "direction" */
+Vector3 convexHull_getSupportPoint(const ConvexHull* hull, const Vector3* direction)
+{
+    int best = 0;
+    float best_distance = vector3_returnDotProduct(&hull->vertices[0], direction);
+
+    for (int i = 1; i < hull->vertex_count; i++) {
+        float distance = vector3_returnDotProduct(&hull->vertices[i], direction);
+        if (distance > best_distance) {
+            best_distance = distance;
+            best = i;
+        }
+    }
+
+    return vector3_sum(&hull->vertices[best], &hull->center);
+}
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef HEIGHTFIELD_H
+#define HEIGHTFIELD_H
+
+/* HEIGHTFIELD.H
+terrain collider made of quantized heights sampled on a regular grid.
+the cell under a point is found with one division, so height and normal lookups
+cost a single bilinear sample no matter how big the terrain is */
+
+// structures
+
+typedef struct {
+
+    const int16_t* heights;     // columns * rows samples in row major order, not owned
+    int columns;                // samples along x
+    int rows;                   // samples along y
+
+    float cell_size;            // distance between samples in world units
+    float inverse_cell_size;
+    float height_scale;         // world units per quantized height unit
+    Vector3 origin;             // world position of the first sample at height 0
+
+    float min_height;
+    float max_height;
+
+} Heightfield;
+
+
+// function prototypes
+
+void heightfield_init(Heightfield* heightfield, const int16_t* heights, int columns, int rows, float cell_size, float height_scale, const Vector3* origin);
+
+bool heightfield_containsPoint(const Heightfield* heightfield, const Vector3* point);
+float heightfield_getHeight(const Heightfield* heightfield, float x, float y);
+Vector3 heightfield_getNormal(const Heightfield* heightfield, float x, float y);
+void heightfield_sample(const Heightfield* heightfield, float x, float y, float* height, Vector3* normal);
+AABB heightfield_getAABB(const Heightfield* heightfield);
+Vector3 heightfield_getSamplePoint(const Heightfield* heightfield, int column, int row);
+void heightfield_getCellTriangles(const Heightfield* heightfield, int column, int row, Triangle* triangles);
+void heightfield_getCellRange(const Heightfield* heightfield, const AABB* aabb, int* first_column, int* last_column, int* first_row, int* last_row);
+
+bool capsule_contactHeightfield(const Capsule* capsule, const Heightfield* heightfield);
+/* only valid after capsule_contactHeightfield returned true */
+void capsule_contactHeightfieldSetData(ContactData* contact, const Capsule* capsule, const Heightfield* heightfield);
+bool capsule_collisionTestHeightfield(ContactData* contact, const Capsule* capsule, const Heightfield* heightfield);
+bool capsule_sweepHeightfield(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Heightfield* heightfield);
+
+
+// function implementations
+
+void heightfield_init(Heightfield* heightfield, const int16_t* heights, int columns, int rows, float cell_size, float height_scale, const Vector3* origin)
+{
+    assert(columns > 1 && rows > 1);
+    assert(cell_size > 0.0f);
+
+    heightfield->heights = heights;
+    heightfield->columns = columns;
+    heightfield->rows = rows;
+    heightfield->cell_size = cell_size;
+    heightfield->inverse_cell_size = 1.0f / cell_size;
+    heightfield->height_scale = height_scale;
+    heightfield->origin = *origin;
+
+    int16_t min = heights[0];
+    int16_t max = heights[0];
+    for (int i = 1; i < columns * rows; i++) {
+        if (heights[i] < min) min = heights[i];
+        if (heights[i] > max) max = heights[i];
+    }
+    heightfield->min_height = origin->z + min * height_scale;
+    heightfield->max_height = origin->z + max * height_scale;
+}
+
+/* return true if the point lays over the grid, its height is ignored */
+bool heightfield_containsPoint(const Heightfield* heightfield, const Vector3* point)
+{
+    float x = point->x - heightfield->origin.x;
+    float y = point->y - heightfield->origin.y;
+    return (x >= 0.0f && x <= (heightfield->columns - 1) * heightfield->cell_size &&
+            y >= 0.0f && y <= (heightfield->rows - 1) * heightfield->cell_size);
+}
+
+/* samples the terrain under (x, y). points outside the grid get the height and normal of the border */
+void heightfield_sample(const Heightfield* heightfield, float x, float y, float* height, Vector3* normal)
+{
+    float grid_x = clamp((x - heightfield->origin.x) * heightfield->inverse_cell_size, 0.0f, heightfield->columns - 1);
+    float grid_y = clamp((y - heightfield->origin.y) * heightfield->inverse_cell_size, 0.0f, heightfield->rows - 1);
+
+    int column = (int)grid_x;
+    int row = (int)grid_y;
+    if (column > heightfield->columns - 2) column = heightfield->columns - 2;
+    if (row > heightfield->rows - 2) row = heightfield->rows - 2;
+
+    float fraction_x = grid_x - column;
+    float fraction_y = grid_y - row;
+
+    const int16_t* sample = &heightfield->heights[row * heightfield->columns + column];
+    float h00 = sample[0];
+    float h10 = sample[1];
+    float h01 = sample[heightfield->columns];
+    float h11 = sample[heightfield->columns + 1];
+
+    float bottom = h00 + (h10 - h00) * fraction_x;
+    float top = h01 + (h11 - h01) * fraction_x;
+
+    if (height) *height = heightfield->origin.z + heightfield->height_scale * (bottom + (top - bottom) * fraction_y);
+
+    if (normal) {
+        float slope_scale = heightfield->height_scale * heightfield->inverse_cell_size;
+        float slope_x = ((h10 - h00) * (1.0f - fraction_y) + (h11 - h01) * fraction_y) * slope_scale;
+        float slope_y = (top - bottom) * slope_scale;
+        *normal = (Vector3){-slope_x, -slope_y, 1.0f};
+        vector3_normalize(normal);
+    }
+}
+
+float heightfield_getHeight(const Heightfield* heightfield, float x, float y)
+{
+    float height;
+    heightfield_sample(heightfield, x, y, &height, NULL);
+    return height;
+}
+
+Vector3 heightfield_getNormal(const Heightfield* heightfield, float x, float y)
+{
+    Vector3 normal;
+    heightfield_sample(heightfield, x, y, NULL, &normal);
+    return normal;
+}
+
+AABB heightfield_getAABB(const Heightfield* heightfield)
+{
+    return (AABB){
+        .minCoordinates = {heightfield->origin.x, heightfield->origin.y, heightfield->min_height},
+        .maxCoordinates = {
+            heightfield->origin.x + (heightfield->columns - 1) * heightfield->cell_size,
+            heightfield->origin.y + (heightfield->rows - 1) * heightfield->cell_size,
+            heightfield->max_height
+        }
+    };
+}
+
+/* world position of a sample of the grid */
+Vector3 heightfield_getSamplePoint(const Heightfield* heightfield, int column, int row)
+{
+    return (Vector3){
+        heightfield->origin.x + column * heightfield->cell_size,
+        heightfield->origin.y + row * heightfield->cell_size,
+        heightfield->origin.z + heightfield->heights[row * heightfield->columns + column] * heightfield->height_scale
+    };
+}
+
+/* the cell from sample (column, row) to (column + 1, row + 1) split along its diagonal in two upward facing triangles,
+they match the bilinear surface at the samples and along the sides */
+void heightfield_getCellTriangles(const Heightfield* heightfield, int column, int row, Triangle* triangles)
+{
+    Vector3 corner_00 = heightfield_getSamplePoint(heightfield, column, row);
+    Vector3 corner_10 = heightfield_getSamplePoint(heightfield, column + 1, row);
+    Vector3 corner_01 = heightfield_getSamplePoint(heightfield, column, row + 1);
+    Vector3 corner_11 = heightfield_getSamplePoint(heightfield, column + 1, row + 1);
+
+    triangles[0] = (Triangle){corner_00, corner_10, corner_11};
+    triangles[1] = (Triangle){corner_00, corner_11, corner_01};
+}
+
+/* the cells under "aabb", clamped to the grid */
+void heightfield_getCellRange(const Heightfield* heightfield, const AABB* aabb, int* first_column, int* last_column, int* first_row, int* last_row)
+{
+    *first_column = (int)floorf((aabb->minCoordinates.x - heightfield->origin.x) * heightfield->inverse_cell_size);
+    *last_column = (int)floorf((aabb->maxCoordinates.x - heightfield->origin.x) * heightfield->inverse_cell_size);
+    *first_row = (int)floorf((aabb->minCoordinates.y - heightfield->origin.y) * heightfield->inverse_cell_size);
+    *last_row = (int)floorf((aabb->maxCoordinates.y - heightfield->origin.y) * heightfield->inverse_cell_size);
+
+    if (*first_column < 0) *first_column = 0;
+    if (*first_row < 0) *first_row = 0;
+    if (*last_column > heightfield->columns - 2) *last_column = heightfield->columns - 2;
+    if (*last_row > heightfield->rows - 2) *last_row = heightfield->rows - 2;
+}
+
+/* the terrain is tested against the sphere at the lower end of the capsule,
+taking the terrain under that sphere as a plane with the sampled height and normal.
+there is no terrain beyond the grid, a capsule whose lower end is outside of it touches nothing */
+bool capsule_contactHeightfield(const Capsule* capsule, const Heightfield* heightfield)
+{
+    const Vector3* lower = (capsule->start.z < capsule->end.z) ? &capsule->start : &capsule->end;
+    if (!heightfield_containsPoint(heightfield, lower)) return false;
+
+    float height;
+    Vector3 normal;
+    heightfield_sample(heightfield, lower->x, lower->y, &height, &normal);
+
+    // Distance from the sphere center to the tangent plane through the terrain point under it
+    float distance = normal.z * (lower->z - height);
+    return distance <= capsule->radius;
+}
+
+/* only valid after capsule_contactHeightfield returned true */
+void capsule_contactHeightfieldSetData(ContactData* contact, const Capsule* capsule, const Heightfield* heightfield)
+{
+    const Vector3* lower = (capsule->start.z < capsule->end.z) ? &capsule->start : &capsule->end;
+
+    float height;
+    heightfield_sample(heightfield, lower->x, lower->y, &height, &contact->normal);
+
+    float distance = contact->normal.z * (lower->z - height);
+    contact->penetration = capsule->radius - distance;
+    contact->point = *lower;
+    vector3_addScaledVector(&contact->point, &contact->normal, -distance);
+}
+
+/* single sample version of the two above, "contact" is left untouched when it returns false */
+bool capsule_collisionTestHeightfield(ContactData* contact, const Capsule* capsule, const Heightfield* heightfield)
+{
+    const Vector3* lower = (capsule->start.z < capsule->end.z) ? &capsule->start : &capsule->end;
+    if (!heightfield_containsPoint(heightfield, lower)) return false;
+
+    float height;
+    Vector3 normal;
+    heightfield_sample(heightfield, lower->x, lower->y, &height, &normal);
+
+    float distance = normal.z * (lower->z - height);
+    if (distance > capsule->radius) return false;
+
+    contact->normal = normal;
+    contact->penetration = capsule->radius - distance;
+    contact->point = *lower;
+    vector3_addScaledVector(&contact->point, &contact->normal, -distance);
+    return true;
+}
+
+/* the first contact of the capsule moved along "displacement" with the terrain, like the sweeps of capsule.h.
+a moving capsule can meet the terrain anywhere along its side, so the cells under the move are swept as their triangles
+instead of sampling under the lower end. they are visited in the order the capsule crosses them, and the AABB of the capsule
+is swept first, so only the triangles it reaches before the contact found so far get the exact sweep */
+bool capsule_sweepHeightfield(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Heightfield* heightfield)
+{
+    AABB capsule_aabb = capsule_getAABB(capsule);
+    AABB terrain_aabb = heightfield_getAABB(heightfield);
+    float terrain_time;
+    if (!aabb_sweepAABB(&terrain_time, &capsule_aabb, displacement, &terrain_aabb)) return false;
+
+    bool hit = false;
+    float nearest = 1.0f;
+    int first_column, last_column, first_row, last_row;
+
+    for (int step = 0; ; step++) {
+
+        // The cells under the move as far as the contact found so far
+        AABB end_aabb = capsule_aabb;
+        vector3_addScaledVector(&end_aabb.minCoordinates, displacement, nearest);
+        vector3_addScaledVector(&end_aabb.maxCoordinates, displacement, nearest);
+        AABB reach = aabb_returnMerged(&capsule_aabb, &end_aabb);
+        heightfield_getCellRange(heightfield, &reach, &first_column, &last_column, &first_row, &last_row);
+
+        // Rows in the order of the move, once past the reach every later row is too
+        int row = (displacement->y < 0.0f) ? last_row - step : first_row + step;
+        if (row < first_row || row > last_row) break;
+
+        for (int column_step = 0; column_step <= last_column - first_column; column_step++) {
+
+            int column = (displacement->x < 0.0f) ? last_column - column_step : first_column + column_step;
+            Triangle triangles[2];
+            heightfield_getCellTriangles(heightfield, column, row, triangles);
+
+            for (int i = 0; i < 2; i++) {
+
+                AABB triangle_aabb = triangle_getAABB(&triangles[i]);
+                float triangle_time;
+                if (!aabb_sweepAABB(&triangle_time, &capsule_aabb, displacement, &triangle_aabb) || triangle_time > nearest) continue;
+
+                // Swept only as far as the contact found so far, later contacts fall beyond the end
+                ContactData triangle_contact;
+                Vector3 remaining = vector3_returnScaled(displacement, nearest);
+                if (!capsule_sweepTriangle(&triangle_contact, &triangle_time, capsule, &remaining, &triangles[i])) continue;
+                if (hit && triangle_time >= 1.0f) continue;
+
+                *contact = triangle_contact;
+                nearest *= triangle_time;
+                hit = true;
+            }
+        }
+    }
+
+    if (hit) *time = nearest;
+    return hit;
+}
+
+#endif
@@ -0,0 +1,375 @@
+#ifndef MESH_H
+#define MESH_H
+
+/* MESH.H
+static triangle mesh collider. the triangles are kept in a bounding volume hierarchy
+built once at load time, so a query only visits the branches its AABB overlaps */
+
+#define TRIANGLE_MESH_LEAF_SIZE 4
+#define TRIANGLE_MESH_STACK_SIZE 64
+
+
+// structures
+
+typedef struct {
+    AABB aabb;
+    int first;      // first triangle for leaves, index of the second child for internal nodes
+    int count;      // number of triangles for leaves, 0 for internal nodes
+} TriangleMeshNode;
+
+typedef struct {
+
+    const Vector3* vertices;    // not owned by the mesh
+    int* indices;               // 3 per triangle, reordered by the hierarchy build
+    int triangle_count;
+
+    TriangleMeshNode* nodes;    // depth first order, the first child of an internal node is the next node
+    int node_count;
+
+} TriangleMesh;
+
+
+// function prototypes
+
+void triangleMesh_init(TriangleMesh* mesh, const Vector3* vertices, const int* indices, int triangle_count);
+void triangleMesh_delete(TriangleMesh* mesh);
+
+Triangle triangleMesh_getTriangle(const TriangleMesh* mesh, int triangle_index);
+AABB triangleMesh_getAABB(const TriangleMesh* mesh);
+int triangleMesh_queryAABB(const TriangleMesh* mesh, const AABB* aabb, int* triangles, int max_triangles);
+
+bool capsule_contactMesh(const Capsule* capsule, const TriangleMesh* mesh);
+void capsule_contactMeshSetData(ContactData* contact, const Capsule* capsule, const TriangleMesh* mesh);
+bool capsule_collisionTestMesh(ContactData* contact, const Capsule* capsule, const TriangleMesh* mesh);
+bool capsule_sweepMesh(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const TriangleMesh* mesh);
+
+int triangleMesh_buildNode(TriangleMesh* mesh, Vector3* centroids, int first, int count);
+void triangleMesh_swapTriangles(TriangleMesh* mesh, Vector3* centroids, int i, int j);
+void triangleMesh_selectMedian(TriangleMesh* mesh, Vector3* centroids, int first, int count, int axis);
+
+
+// function implementations
+
+/* builds the hierarchy over "triangle_count" triangles, "indices" is copied while "vertices" must stay alive */
+void triangleMesh_init(TriangleMesh* mesh, const Vector3* vertices, const int* indices, int triangle_count)
+{
+    assert(triangle_count > 0);
+
+    mesh->vertices = vertices;
+    mesh->triangle_count = triangle_count;
+    mesh->indices = malloc(3 * triangle_count * sizeof(int));
+    assert(mesh->indices != NULL);
+    memcpy(mesh->indices, indices, 3 * triangle_count * sizeof(int));
+
+    // A binary tree with leaves of at least one triangle never has more than 2n - 1 nodes
+    mesh->nodes = malloc((2 * triangle_count - 1) * sizeof(TriangleMeshNode));
+    assert(mesh->nodes != NULL);
+    mesh->node_count = 0;
+
+    Vector3* centroids = malloc(triangle_count * sizeof(Vector3));
+    assert(centroids != NULL);
+
+    for (int i = 0; i < triangle_count; i++) {
+        Triangle triangle = triangleMesh_getTriangle(mesh, i);
+        Vector3 sum = vector3_sum(&triangle.a, &triangle.b);
+        vector3_add(&sum, &triangle.c);
+        centroids[i] = vector3_returnScaled(&sum, 1.0f / 3.0f);
+    }
+
+    triangleMesh_buildNode(mesh, centroids, 0, triangle_count);
+
+    free(centroids);
+}
+
+void triangleMesh_delete(TriangleMesh* mesh)
+{
+    free(mesh->indices);
+    free(mesh->nodes);
+    mesh->indices = NULL;
+    mesh->nodes = NULL;
+    mesh->triangle_count = 0;
+    mesh->node_count = 0;
+}
+
+Triangle triangleMesh_getTriangle(const TriangleMesh* mesh, int triangle_index)
+{
+    const int* index = &mesh->indices[3 * triangle_index];
+    return (Triangle){mesh->vertices[index[0]], mesh->vertices[index[1]], mesh->vertices[index[2]]};
+}
+
+AABB triangleMesh_getAABB(const TriangleMesh* mesh)
+{
+    return mesh->nodes[0].aabb;
+}
+
+/* writes in "triangles" the indices of the triangles whose AABB overlaps "aabb",
+returns how many were written (never more than "max_triangles") */
+int triangleMesh_queryAABB(const TriangleMesh* mesh, const AABB* aabb, int* triangles, int max_triangles)
+{
+    int count = 0;
+    int stack[TRIANGLE_MESH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+
+        const TriangleMeshNode* node = &mesh->nodes[stack[--stack_size]];
+        if (!aabb_contactAABB(&node->aabb, aabb)) continue;
+
+        if (node->count == 0) {
+            assert(stack_size + 2 <= TRIANGLE_MESH_STACK_SIZE);
+            stack[stack_size++] = node->first;
+            stack[stack_size++] = (node - mesh->nodes) + 1;
+            continue;
+        }
+
+        for (int i = node->first; i < node->first + node->count; i++) {
+            Triangle triangle = triangleMesh_getTriangle(mesh, i);
+            AABB triangle_aabb = triangle_getAABB(&triangle);
+            if (!aabb_contactAABB(&triangle_aabb, aabb)) continue;
+            if (count == max_triangles) return count;
+            triangles[count++] = i;
+        }
+    }
+
+    return count;
+}
+
+bool capsule_contactMesh(const Capsule* capsule, const TriangleMesh* mesh)
+{
+    AABB capsule_aabb = capsule_getAABB(capsule);
+    int stack[TRIANGLE_MESH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+
+        const TriangleMeshNode* node = &mesh->nodes[stack[--stack_size]];
+        if (!aabb_contactAABB(&node->aabb, &capsule_aabb)) continue;
+
+        if (node->count == 0) {
+            assert(stack_size + 2 <= TRIANGLE_MESH_STACK_SIZE);
+            stack[stack_size++] = node->first;
+            stack[stack_size++] = (node - mesh->nodes) + 1;
+            continue;
+        }
+
+        for (int i = node->first; i < node->first + node->count; i++) {
+            Triangle triangle = triangleMesh_getTriangle(mesh, i);
+            if (capsule_contactTriangle(capsule, &triangle)) return true;
+        }
+    }
+
+    return false;
+}
+
+/* fills "contact" with the deepest contact among the triangles touching the capsule */
+void capsule_contactMeshSetData(ContactData* contact, const Capsule* capsule, const TriangleMesh* mesh)
+{
+    AABB capsule_aabb = capsule_getAABB(capsule);
+    int stack[TRIANGLE_MESH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    contact->penetration = -FLT_MAX;
+
+    while (stack_size > 0) {
+
+        const TriangleMeshNode* node = &mesh->nodes[stack[--stack_size]];
+        if (!aabb_contactAABB(&node->aabb, &capsule_aabb)) continue;
+
+        if (node->count == 0) {
+            assert(stack_size + 2 <= TRIANGLE_MESH_STACK_SIZE);
+            stack[stack_size++] = node->first;
+            stack[stack_size++] = (node - mesh->nodes) + 1;
+            continue;
+        }
+
+        for (int i = node->first; i < node->first + node->count; i++) {
+
+            Triangle triangle = triangleMesh_getTriangle(mesh, i);
+            if (!capsule_contactTriangle(capsule, &triangle)) continue;
+
+            ContactData triangle_contact;
+            capsule_contactTriangleSetData(&triangle_contact, capsule, &triangle);
+            if (triangle_contact.penetration > contact->penetration) *contact = triangle_contact;
+        }
+    }
+}
+
+/* single traversal version of the two above, keeps the deepest contact and returns false if there is none */
+bool capsule_collisionTestMesh(ContactData* contact, const Capsule* capsule, const TriangleMesh* mesh)
+{
+    AABB capsule_aabb = capsule_getAABB(capsule);
+    int stack[TRIANGLE_MESH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    bool hit = false;
+
+    while (stack_size > 0) {
+
+        const TriangleMeshNode* node = &mesh->nodes[stack[--stack_size]];
+        if (!aabb_contactAABB(&node->aabb, &capsule_aabb)) continue;
+
+        if (node->count == 0) {
+            assert(stack_size + 2 <= TRIANGLE_MESH_STACK_SIZE);
+            stack[stack_size++] = node->first;
+            stack[stack_size++] = (node - mesh->nodes) + 1;
+            continue;
+        }
+
+        for (int i = node->first; i < node->first + node->count; i++) {
+
+            Triangle triangle = triangleMesh_getTriangle(mesh, i);
+            ContactData triangle_contact;
+            if (!capsule_collisionTestTriangle(&triangle_contact, capsule, &triangle)) continue;
+
+            if (!hit || triangle_contact.penetration > contact->penetration) *contact = triangle_contact;
+            hit = true;
+        }
+    }
+
+    return hit;
+}
+
+/* the first contact of the capsule moved along "displacement" with any triangle, like the sweeps of capsule.h.
+the AABB of the capsule is swept through the hierarchy first, so only the nodes and triangles it reaches before
+the contact found so far get the exact sweep */
+bool capsule_sweepMesh(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const TriangleMesh* mesh)
+{
+    AABB capsule_aabb = capsule_getAABB(capsule);
+    int stack[TRIANGLE_MESH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    bool hit = false;
+    float nearest = 1.0f;
+
+    while (stack_size > 0) {
+
+        const TriangleMeshNode* node = &mesh->nodes[stack[--stack_size]];
+        float node_time;
+        if (!aabb_sweepAABB(&node_time, &capsule_aabb, displacement, &node->aabb) || node_time > nearest) continue;
+
+        // The child the capsule reaches first goes on top, its contact prunes more of the other one
+        if (node->count == 0) {
+            assert(stack_size + 2 <= TRIANGLE_MESH_STACK_SIZE);
+            int near_child = (node - mesh->nodes) + 1;
+            int far_child = node->first;
+            float near_time, far_time;
+            if (!aabb_sweepAABB(&near_time, &capsule_aabb, displacement, &mesh->nodes[near_child].aabb)) near_time = 2.0f;
+            if (!aabb_sweepAABB(&far_time, &capsule_aabb, displacement, &mesh->nodes[far_child].aabb)) far_time = 2.0f;
+            if (far_time < near_time) {
+                far_child = near_child;
+                near_child = node->first;
+            }
+            stack[stack_size++] = far_child;
+            stack[stack_size++] = near_child;
+            continue;
+        }
+
+        for (int i = node->first; i < node->first + node->count; i++) {
+
+            Triangle triangle = triangleMesh_getTriangle(mesh, i);
+            AABB triangle_aabb = triangle_getAABB(&triangle);
+            float triangle_time;
+            if (!aabb_sweepAABB(&triangle_time, &capsule_aabb, displacement, &triangle_aabb) || triangle_time > nearest) continue;
+
+            // Swept only as far as the contact found so far, later contacts fall beyond the end
+            ContactData triangle_contact;
+            Vector3 remaining = vector3_returnScaled(displacement, nearest);
+            if (!capsule_sweepTriangle(&triangle_contact, &triangle_time, capsule, &remaining, &triangle)) continue;
+            if (hit && triangle_time >= 1.0f) continue;
+
+            *contact = triangle_contact;
+            nearest *= triangle_time;
+            hit = true;
+        }
+    }
+
+    if (hit) *time = nearest;
+    return hit;
+}
+
+/* builds the node for the triangles [first, first + count), splitting at the median centroid
+of the longest axis. returns the index of the node */
+int triangleMesh_buildNode(TriangleMesh* mesh, Vector3* centroids, int first, int count)
+{
+    int node_index = mesh->node_count++;
+    TriangleMeshNode* node = &mesh->nodes[node_index];
+
+    Triangle triangle = triangleMesh_getTriangle(mesh, first);
+    node->aabb = triangle_getAABB(&triangle);
+    AABB centroid_bounds = {centroids[first], centroids[first]};
+
+    for (int i = first + 1; i < first + count; i++) {
+        triangle = triangleMesh_getTriangle(mesh, i);
+        AABB triangle_aabb = triangle_getAABB(&triangle);
+        aabb_merge(&node->aabb, &triangle_aabb);
+        centroid_bounds.minCoordinates = vector3_min(&centroid_bounds.minCoordinates, &centroids[i]);
+        centroid_bounds.maxCoordinates = vector3_max(&centroid_bounds.maxCoordinates, &centroids[i]);
+    }
+
+    if (count <= TRIANGLE_MESH_LEAF_SIZE) {
+        node->first = first;
+        node->count = count;
+        return node_index;
+    }
+
+    Vector3 extent = vector3_difference(&centroid_bounds.maxCoordinates, &centroid_bounds.minCoordinates);
+    int axis = vector3_returnMaxAxis(&extent);
+    int half = count / 2;
+    triangleMesh_selectMedian(mesh, centroids, first, count, axis);
+
+    node->count = 0;
+    triangleMesh_buildNode(mesh, centroids, first, half);
+    int second_child = triangleMesh_buildNode(mesh, centroids, first + half, count - half);
+    mesh->nodes[node_index].first = second_child;
+
+    return node_index;
+}
+
+void triangleMesh_swapTriangles(TriangleMesh* mesh, Vector3* centroids, int i, int j)
+{
+    for (int k = 0; k < 3; k++) {
+        int index = mesh->indices[3 * i + k];
+        mesh->indices[3 * i + k] = mesh->indices[3 * j + k];
+        mesh->indices[3 * j + k] = index;
+    }
+    Vector3 centroid = centroids[i];
+    centroids[i] = centroids[j];
+    centroids[j] = centroid;
+}
+
+/* partially sorts the triangles so the one at "first + count / 2" has the median centroid along "axis",
+with lower centroids before it and higher after it */
+void triangleMesh_selectMedian(TriangleMesh* mesh, Vector3* centroids, int first, int count, int axis)
+{
+    int low = first;
+    int high = first + count - 1;
+    int median = first + count / 2;
+
+    while (low < high) {
+
+        float pivot = vector3_returnElement(&centroids[(low + high) / 2], axis);
+        int i = low;
+        int j = high;
+
+        while (i <= j) {
+            while (vector3_returnElement(&centroids[i], axis) < pivot) i++;
+            while (vector3_returnElement(&centroids[j], axis) > pivot) j--;
+            if (i <= j) {
+                triangleMesh_swapTriangles(mesh, centroids, i, j);
+                i++;
+                j--;
+            }
+        }
+
+        if (median <= j) high = j;
+        else if (median >= i) low = i;
+        else return;
+    }
+}
+
+#endif
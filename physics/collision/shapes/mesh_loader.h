@@ -0,0 +1,325 @@
+#ifndef MESH_LOADER_H
+#define MESH_LOADER_H
+
+/* MESH_LOADER.H
+reads the triangles of a binary gltf (.glb) file into arrays a TriangleMesh can be built from,
+like the level geometry of assets/ground.glb. only what a collider needs is read: the positions and
+indices of every triangle primitive of every mesh, in the coordinates of the file with the node
+transforms ignored, as the scenery is drawn with the model at the origin.
+the path goes straight to fopen, so "rom:/" paths work on the console when the .glb is in the filesystem */
+
+#define GLB_MAGIC 0x46546C67u           // "glTF"
+#define GLB_CHUNK_JSON 0x4E4F534Au
+#define GLB_CHUNK_BIN 0x004E4942u
+
+#define GLTF_FLOAT 5126
+#define GLTF_UNSIGNED_BYTE 5121
+#define GLTF_UNSIGNED_SHORT 5123
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_TRIANGLES 4
+
+
+// structures
+
+typedef struct {
+    Vector3* vertices;
+    int* indices;           // 3 per triangle
+    int vertex_count;
+    int triangle_count;
+} TriangleMeshData;
+
+typedef struct {
+    const uint8_t* data;    // first element
+    int count;
+    int stride;             // bytes between elements
+    int component_type;
+} GltfAccessor;
+
+
+// function prototypes
+
+bool triangleMeshData_loadGlb(TriangleMeshData* data, const char* path);
+bool triangleMeshData_parseGlb(TriangleMeshData* data, const uint8_t* file, size_t size);
+void triangleMeshData_delete(TriangleMeshData* data);
+
+bool triangleMeshData_getAccessor(GltfAccessor* accessor, const char* json, int accessor_index, const uint8_t* binary, size_t binary_size);
+bool triangleMeshData_appendPrimitive(TriangleMeshData* data, const char* json, const char* primitive, const uint8_t* binary, size_t binary_size);
+
+const char* json_skipWhitespace(const char* json);
+const char* json_skipValue(const char* json);
+const char* json_getMember(const char* object, const char* key);
+const char* json_getElement(const char* array, int index);
+int json_getInt(const char* value, int default_value);
+
+
+// function implementations
+
+/* returns false and leaves "data" empty if the file can't be read or holds no triangles */
+bool triangleMeshData_loadGlb(TriangleMeshData* data, const char* path)
+{
+    *data = (TriangleMeshData){0};
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* buffer = (size > 0) ? malloc(size) : NULL;
+    bool read = (buffer != NULL && fread(buffer, 1, size, file) == (size_t)size);
+    fclose(file);
+
+    bool loaded = read && triangleMeshData_parseGlb(data, buffer, size);
+    free(buffer);
+    return loaded;
+}
+
+/* same as above for a file already in memory */
+bool triangleMeshData_parseGlb(TriangleMeshData* data, const uint8_t* file, size_t size)
+{
+    *data = (TriangleMeshData){0};
+
+    // 12 bytes of header, then chunks of length, type and data, all little endian
+    uint32_t words[5];
+    if (size < sizeof(words)) return false;
+    memcpy(words, file, sizeof(words));
+    if (words[0] != GLB_MAGIC || words[1] != 2 || words[4] != GLB_CHUNK_JSON) return false;
+
+    size_t json_size = words[3];
+    if (20 + json_size > size) return false;
+
+    const uint8_t* binary = NULL;
+    size_t binary_size = 0;
+    size_t binary_header = 20 + ((json_size + 3) & ~(size_t)3);
+    if (binary_header + 8 <= size) {
+        uint32_t chunk[2];
+        memcpy(chunk, file + binary_header, sizeof(chunk));
+        if (chunk[1] == GLB_CHUNK_BIN && binary_header + 8 + chunk[0] <= size) {
+            binary = file + binary_header + 8;
+            binary_size = chunk[0];
+        }
+    }
+
+    // The json chunk isn't terminated
+    char* json = malloc(json_size + 1);
+    assert(json != NULL);
+    memcpy(json, file + 20, json_size);
+    json[json_size] = '\0';
+
+    bool valid = true;
+    const char* meshes = json_getMember(json, "meshes");
+
+    for (int i = 0; valid && meshes != NULL; i++) {
+
+        const char* mesh = json_getElement(meshes, i);
+        if (mesh == NULL) break;
+        const char* primitives = json_getMember(mesh, "primitives");
+
+        for (int j = 0; valid && primitives != NULL; j++) {
+            const char* primitive = json_getElement(primitives, j);
+            if (primitive == NULL) break;
+            valid = triangleMeshData_appendPrimitive(data, json, primitive, binary, binary_size);
+        }
+    }
+
+    free(json);
+
+    if (!valid || data->triangle_count == 0) {
+        triangleMeshData_delete(data);
+        return false;
+    }
+    return true;
+}
+
+void triangleMeshData_delete(TriangleMeshData* data)
+{
+    free(data->vertices);
+    free(data->indices);
+    *data = (TriangleMeshData){0};
+}
+
+/* finds where the elements of an accessor are in the binary chunk, returns false if they don't fit in it */
+bool triangleMeshData_getAccessor(GltfAccessor* accessor, const char* json, int accessor_index, const uint8_t* binary, size_t binary_size)
+{
+    const char* object = json_getElement(json_getMember(json, "accessors"), accessor_index);
+    if (object == NULL) return false;
+
+    int view_index = json_getInt(json_getMember(object, "bufferView"), -1);
+    const char* view = json_getElement(json_getMember(json, "bufferViews"), view_index);
+    if (view == NULL || binary == NULL) return false;
+
+    accessor->count = json_getInt(json_getMember(object, "count"), 0);
+    accessor->component_type = json_getInt(json_getMember(object, "componentType"), 0);
+
+    int element_size;
+    switch (accessor->component_type) {
+        case GLTF_FLOAT: element_size = 3 * sizeof(float); break;
+        case GLTF_UNSIGNED_BYTE: element_size = 1; break;
+        case GLTF_UNSIGNED_SHORT: element_size = 2; break;
+        case GLTF_UNSIGNED_INT: element_size = 4; break;
+        default: return false;
+    }
+    accessor->stride = json_getInt(json_getMember(view, "byteStride"), element_size);
+
+    size_t offset = (size_t)json_getInt(json_getMember(view, "byteOffset"), 0) + json_getInt(json_getMember(object, "byteOffset"), 0);
+    size_t length = (accessor->count > 0) ? (size_t)(accessor->count - 1) * accessor->stride + element_size : 0;
+    if (accessor->count < 0 || offset + length > binary_size) return false;
+
+    accessor->data = binary + offset;
+    return true;
+}
+
+/* adds the triangles of one primitive, the ones that aren't triangle lists are skipped */
+bool triangleMeshData_appendPrimitive(TriangleMeshData* data, const char* json, const char* primitive, const uint8_t* binary, size_t binary_size)
+{
+    if (json_getInt(json_getMember(primitive, "mode"), GLTF_TRIANGLES) != GLTF_TRIANGLES) return true;
+
+    GltfAccessor positions;
+    int position_index = json_getInt(json_getMember(json_getMember(primitive, "attributes"), "POSITION"), -1);
+    if (!triangleMeshData_getAccessor(&positions, json, position_index, binary, binary_size)) return false;
+    if (positions.component_type != GLTF_FLOAT) return false;
+
+    // Without indices every three vertices are a triangle
+    GltfAccessor indices = {.data = NULL, .count = positions.count};
+    int indices_index = json_getInt(json_getMember(primitive, "indices"), -1);
+    if (indices_index >= 0 && !triangleMeshData_getAccessor(&indices, json, indices_index, binary, binary_size)) return false;
+    if (indices.data != NULL && indices.component_type == GLTF_FLOAT) return false;
+
+    int first_vertex = data->vertex_count;
+    int first_index = 3 * data->triangle_count;
+    int triangle_count = indices.count / 3;
+
+    data->vertices = realloc(data->vertices, (first_vertex + positions.count) * sizeof(Vector3));
+    data->indices = realloc(data->indices, (first_index + 3 * triangle_count) * sizeof(int));
+    assert(data->vertices != NULL && data->indices != NULL);
+
+    for (int i = 0; i < positions.count; i++) {
+        float position[3];
+        memcpy(position, positions.data + i * positions.stride, sizeof(position));
+        data->vertices[first_vertex + i] = (Vector3){position[0], position[1], position[2]};
+    }
+
+    for (int i = 0; i < 3 * triangle_count; i++) {
+
+        uint32_t index = i;
+        if (indices.data != NULL) {
+            const uint8_t* element = indices.data + i * indices.stride;
+            if (indices.component_type == GLTF_UNSIGNED_BYTE) index = element[0];
+            else if (indices.component_type == GLTF_UNSIGNED_SHORT) index = element[0] | (element[1] << 8);
+            else index = element[0] | (element[1] << 8) | (element[2] << 16) | ((uint32_t)element[3] << 24);
+        }
+        if (index >= (uint32_t)positions.count) return false;
+
+        data->indices[first_index + i] = first_vertex + (int)index;
+    }
+
+    data->vertex_count += positions.count;
+    data->triangle_count += triangle_count;
+    return true;
+}
+
+const char* json_skipWhitespace(const char* json)
+{
+    while (*json == ' ' || *json == '\t' || *json == '\n' || *json == '\r') json++;
+    return json;
+}
+
+/* returns the end of the value starting at "json", or NULL if it is malformed */
+const char* json_skipValue(const char* json)
+{
+    json = json_skipWhitespace(json);
+
+    if (*json == '"') {
+        for (json++; *json != '"'; json++) {
+            if (*json == '\0') return NULL;
+            if (*json == '\\' && *++json == '\0') return NULL;
+        }
+        return json + 1;
+    }
+
+    if (*json == '{' || *json == '[') {
+
+        char close = (*json == '{') ? '}' : ']';
+        json = json_skipWhitespace(json + 1);
+
+        while (*json != close) {
+            // Object members are a key string, a colon and a value
+            if (close == '}') {
+                json = json_skipValue(json);
+                if (json == NULL) return NULL;
+                json = json_skipWhitespace(json);
+                if (*json++ != ':') return NULL;
+            }
+            json = json_skipValue(json);
+            if (json == NULL) return NULL;
+            json = json_skipWhitespace(json);
+            if (*json == ',') json = json_skipWhitespace(json + 1);
+            else if (*json != close) return NULL;
+        }
+        return json + 1;
+    }
+
+    // Numbers, true, false and null
+    const char* start = json;
+    while (*json != '\0' && *json != ',' && *json != '}' && *json != ']' && *json != ' ' && *json != '\n' && *json != '\r' && *json != '\t') json++;
+    return (json > start) ? json : NULL;
+}
+
+/* returns the value of "key" in the object starting at "object", or NULL if it isn't there */
+const char* json_getMember(const char* object, const char* key)
+{
+    if (object == NULL) return NULL;
+    object = json_skipWhitespace(object);
+    if (*object != '{') return NULL;
+
+    size_t key_length = strlen(key);
+    const char* member = json_skipWhitespace(object + 1);
+
+    while (*member == '"') {
+
+        const char* key_end = json_skipValue(member);
+        if (key_end == NULL) return NULL;
+        const char* value = json_skipWhitespace(key_end);
+        if (*value++ != ':') return NULL;
+
+        if ((size_t)(key_end - member) == key_length + 2 && strncmp(member + 1, key, key_length) == 0) return json_skipWhitespace(value);
+
+        const char* value_end = json_skipValue(value);
+        if (value_end == NULL) return NULL;
+        member = json_skipWhitespace(value_end);
+        if (*member != ',') return NULL;
+        member = json_skipWhitespace(member + 1);
+    }
+
+    return NULL;
+}
+
+/* returns the element "index" of the array starting at "array", or NULL if it is out of bounds */
+const char* json_getElement(const char* array, int index)
+{
+    if (array == NULL || index < 0) return NULL;
+    array = json_skipWhitespace(array);
+    if (*array != '[') return NULL;
+
+    const char* element = json_skipWhitespace(array + 1);
+    if (*element == ']') return NULL;
+
+    for (int i = 0; i < index; i++) {
+        element = json_skipValue(element);
+        if (element == NULL) return NULL;
+        element = json_skipWhitespace(element);
+        if (*element != ',') return NULL;
+        element = json_skipWhitespace(element + 1);
+    }
+
+    return element;
+}
+
+int json_getInt(const char* value, int default_value)
+{
+    if (value == NULL || (*value != '-' && (*value < '0' || *value > '9'))) return default_value;
+    return (int)strtol(value, NULL, 10);
+}
+
+#endif
@@ -16,6 +16,8 @@ void plane_setFromRotationAndPoint(Plane* plane, const Vector3* rotation, const
 void plane_setFromNormalAndPoint(Plane* plane, const Vector3* normal, const Vector3* point);
 float plane_distanceToPoint(const Plane* plane, const Vector3* point);
 
+bool plane_collisionTestSphere(ContactData* contact, const Plane* plane, const Sphere* sphere);
+
 // function implementations
 
 Vector3 plane_getNormalFromRotation(const Vector3* rotation)
@@ -70,4 +72,17 @@ void plane_contactSphereGetData(ContactData* contact, const Plane* plane, const
     contact->point = vector3_difference(&sphere->center, &scaled_normal);
 }
 
+/* single pass test, returns false without touching "contact" when the sphere is away from the plane */
+bool plane_collisionTestSphere(ContactData* contact, const Plane* plane, const Sphere* sphere)
+{
+    float distance = vector3_returnDotProduct(&plane->normal, &sphere->center) - plane->displacement;
+    if (fabs(distance) > sphere->radius) return false;
+
+    contact->normal = plane->normal;
+    contact->penetration = sphere->radius - fabs(distance);
+    contact->point = sphere->center;
+    vector3_addScaledVector(&contact->point, &plane->normal, -distance);
+    return true;
+}
+
 #endif
@@ -1,6 +1,8 @@
 #ifndef RAY_H
 #define RAY_H
 
+#define RAY_PARALLEL_INVERSE 1e30f      // inverse direction along an axis the ray is parallel to, finite so the slabs never get 0 * infinity
+
 // structures
 
 typedef struct {
@@ -8,6 +10,22 @@ typedef struct {
     Vector3 direction;
 } Ray;
 
+/* rays laid out one array per component with their inverse directions precomputed, for the batched raycasts.
+the directions are normalized, so the hit distances are in world units */
+typedef struct {
+    float* origin_x;
+    float* origin_y;
+    float* origin_z;
+    float* direction_x;
+    float* direction_y;
+    float* direction_z;
+    float* inverse_x;
+    float* inverse_y;
+    float* inverse_z;
+    int count;
+    int capacity;
+} RayBatch;
+
 // function prototypes
 
 Vector3 ray_getDirectionFromRotation(const Vector3* rotation);
@@ -22,6 +40,16 @@ void raycast_aabb(ContactData* contact, const Ray* ray, const AABB* aabb);
 bool ray_intersectionBox(const Ray* ray, const Box* box);
 void raycast_box(ContactData* contact, const Ray* ray, const Box* box);
 
+void rayBatch_init(RayBatch* batch, int capacity);
+void rayBatch_delete(RayBatch* batch);
+void rayBatch_clear(RayBatch* batch);
+int rayBatch_add(RayBatch* batch, const Ray* ray);
+void rayBatch_set(RayBatch* batch, int index, const Ray* ray);
+
+void rayBatch_resetHits(const RayBatch* rays, float* distances, int* shapes, float max_distance);
+void rayBatch_raycastAABBs(const RayBatch* rays, const AABBBatch* aabbs, int first_id, float* distances, Vector3* normals, int* shapes);
+void rayBatch_raycastSpheres(const RayBatch* rays, const SphereBatch* spheres, int first_id, float* distances, Vector3* normals, int* shapes);
+
 // function implementations
 
 Vector3 ray_getDirectionFromRotation(const Vector3* rotation)
@@ -126,7 +154,8 @@ void raycast_aabb(ContactData* contact, const Ray* ray, const AABB* aabb)
     float t1 = 0;
     float t2 = 0;
     float rayDirectionInverse = 0;
-    
+    int enter_axis = -1;
+
     // For x-axis
     if (fabs(ray->direction.x) < epsilon) {
         if (ray->origin.x < aabb->minCoordinates.x || ray->origin.x > aabb->maxCoordinates.x) return;
@@ -139,7 +168,10 @@ void raycast_aabb(ContactData* contact, const Ray* ray, const AABB* aabb)
             t2 = t1;
             t1 = temp;
         }
-        tMin = max2(tMin, t1);
+        if (t1 > tMin) {
+            tMin = t1;
+            enter_axis = 0;
+        }
         tMax = min2(tMax, t2);
         if (tMin > tMax) return;
     }
@@ -156,7 +188,10 @@ void raycast_aabb(ContactData* contact, const Ray* ray, const AABB* aabb)
             t2 = t1;
             t1 = temp;
         }
-        tMin = max2(tMin, t1);
+        if (t1 > tMin) {
+            tMin = t1;
+            enter_axis = 1;
+        }
         tMax = min2(tMax, t2);
         if (tMin > tMax) return;
     }
@@ -173,7 +208,10 @@ void raycast_aabb(ContactData* contact, const Ray* ray, const AABB* aabb)
             t2 = t1;
             t1 = temp;
         }
-        tMin = max2(tMin, t1);
+        if (t1 > tMin) {
+            tMin = t1;
+            enter_axis = 2;
+        }
         tMax = min2(tMax, t2);
         if (tMin > tMax) return;
     }
@@ -182,32 +220,24 @@ void raycast_aabb(ContactData* contact, const Ray* ray, const AABB* aabb)
     vector3_scale(&temp, tMin);
     vector3_add(&temp, &ray->origin);
     contact->point = temp;
-    
-    // Assuming the normal should be calculated based on which side the intersection occurred
-    if (tMin == t1) {
-        contact->normal = (Vector3){1, 0, 0};
-    } else if (tMin == t2) {
-        contact->normal = (Vector3){-1, 0, 0};
-    } else if (tMin == t1) {
-        contact->normal = (Vector3){0, 1, 0};
-    } else if (tMin == t2) {
-        contact->normal = (Vector3){0, -1, 0};
-    } else if (tMin == t1) {
-        contact->normal = (Vector3){0, 0, 1};
-    } else if (tMin == t2) {
-        contact->normal = (Vector3){0, 0, -1};
+
+    // The normal is the face of the last slab entered, against the direction. A ray starting inside gets its own direction reversed
+    if (enter_axis < 0) {
+        contact->normal = vector3_getInverse(&ray->direction);
+        vector3_normalize(&contact->normal);
+        return;
     }
+
+    contact->normal = (Vector3){0.0f, 0.0f, 0.0f};
+    vector3_setElement(&contact->normal, enter_axis, (vector3_returnElement(&ray->direction, enter_axis) > 0.0f) ? -1.0f : 1.0f);
 }
 
 bool ray_intersectionBox(const Ray* ray, const Box* box) 
 {
-    // Transform the ray to the local space of the box
+    // Transform the ray to the local space of the box with the cached orientation
     Ray local_ray = *ray;
-    point_transformToLocalSpace(&local_ray.origin, &box->center, &box->rotation);
-    rotate_normal(&local_ray.direction, &box->rotation);
-
-    // Invert the direction of the local ray for the intersection test
-    vector3_invert(&local_ray.direction);
+    box_transformToLocalSpace(box, &local_ray.origin);
+    box_rotateToLocalSpace(box, &local_ray.direction);
 
     // Get the local AABB of the box
     AABB local_AABB = box_getLocalAABB(box);
@@ -218,13 +248,10 @@ bool ray_intersectionBox(const Ray* ray, const Box* box)
 
 void raycast_box(ContactData* contact, const Ray* ray, const Box* box)
 {
-    // Transform the ray to the local space of the box
+    // Transform the ray to the local space of the box with the cached orientation
     Ray local_ray = *ray;
-    point_transformToLocalSpace(&local_ray.origin, &box->center, &box->rotation);
-    rotate_normal(&local_ray.direction, &box->rotation);
-
-    // Invert the direction of the local ray for the intersection test
-    vector3_invert(&local_ray.direction);
+    box_transformToLocalSpace(box, &local_ray.origin);
+    box_rotateToLocalSpace(box, &local_ray.direction);
     
     // Get the local AABB of the box
     AABB local_aabb = box_getLocalAABB(box);
@@ -233,8 +260,8 @@ void raycast_box(ContactData* contact, const Ray* ray, const Box* box)
     raycast_aabb(contact, &local_ray, &local_aabb);
 
     // Transform the hit point and normal back to global space
-    point_transformToGlobalSpace(&contact->point, &box->center, &box->rotation);
-    rotate_normal(&contact->normal, &box->rotation);
+    box_transformToGlobalSpace(box, &contact->point);
+    box_rotateToGlobalSpace(box, &contact->normal);
 }
 
 bool ray_intersectionPlane(const Ray* ray, const Plane* plane)
@@ -260,4 +287,176 @@ void raycast_plane(ContactData* contact, const Ray* ray, const Plane* plane)
 }
 
 
-#endif
+/* one block holds every array */
+void rayBatch_init(RayBatch* batch, int capacity)
+{
+    assert(capacity > 0);
+
+    float* memory = malloc(9 * capacity * sizeof(float));
+    assert(memory != NULL);
+
+    batch->origin_x = memory;
+    batch->origin_y = memory + capacity;
+    batch->origin_z = memory + 2 * capacity;
+    batch->direction_x = memory + 3 * capacity;
+    batch->direction_y = memory + 4 * capacity;
+    batch->direction_z = memory + 5 * capacity;
+    batch->inverse_x = memory + 6 * capacity;
+    batch->inverse_y = memory + 7 * capacity;
+    batch->inverse_z = memory + 8 * capacity;
+    batch->count = 0;
+    batch->capacity = capacity;
+}
+
+void rayBatch_delete(RayBatch* batch)
+{
+    free(batch->origin_x);
+    batch->origin_x = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+void rayBatch_clear(RayBatch* batch)
+{
+    batch->count = 0;
+}
+
+/* returns the index of the ray in the batch */
+int rayBatch_add(RayBatch* batch, const Ray* ray)
+{
+    assert(batch->count < batch->capacity);
+
+    int index = batch->count++;
+    rayBatch_set(batch, index, ray);
+    return index;
+}
+
+void rayBatch_set(RayBatch* batch, int index, const Ray* ray)
+{
+    assert(index >= 0 && index < batch->count);
+
+    Vector3 direction = vector3_returnNormalized(&ray->direction);
+
+    batch->origin_x[index] = ray->origin.x;
+    batch->origin_y[index] = ray->origin.y;
+    batch->origin_z[index] = ray->origin.z;
+    batch->direction_x[index] = direction.x;
+    batch->direction_y[index] = direction.y;
+    batch->direction_z[index] = direction.z;
+    batch->inverse_x[index] = (fabsf(direction.x) > TOLERANCE) ? 1.0f / direction.x : copysignf(RAY_PARALLEL_INVERSE, direction.x);
+    batch->inverse_y[index] = (fabsf(direction.y) > TOLERANCE) ? 1.0f / direction.y : copysignf(RAY_PARALLEL_INVERSE, direction.y);
+    batch->inverse_z[index] = (fabsf(direction.z) > TOLERANCE) ? 1.0f / direction.z : copysignf(RAY_PARALLEL_INVERSE, direction.z);
+}
+
+/* the batched raycasts below keep the nearest hit of each ray across calls, so several shape batches can be cast in turn.
+"distances" holds the reach of each ray on the way in and the distance to the nearest hit on the way out,
+"shapes" gets first_id plus the index of the hit shape in its batch and "normals" its normal, both untouched for rays without a hit.
+rays starting inside a shape don't hit it */
+
+/* sets every ray of the batch to reach "max_distance" without a hit (shape -1) */
+void rayBatch_resetHits(const RayBatch* rays, float* distances, int* shapes, float max_distance)
+{
+    for (int i = 0; i < rays->count; i++) {
+        distances[i] = max_distance;
+        shapes[i] = -1;
+    }
+}
+
+void rayBatch_raycastAABBs(const RayBatch* rays, const AABBBatch* aabbs, int first_id, float* distances, Vector3* normals, int* shapes)
+{
+    for (int i = 0; i < rays->count; i++) {
+
+        float origin_x = rays->origin_x[i];
+        float origin_y = rays->origin_y[i];
+        float origin_z = rays->origin_z[i];
+        float inverse_x = rays->inverse_x[i];
+        float inverse_y = rays->inverse_y[i];
+        float inverse_z = rays->inverse_z[i];
+
+        float nearest = distances[i];
+        int hit = -1;
+
+        for (int j = 0; j < aabbs->count; j++) {
+
+            float t1_x = (aabbs->min_x[j] - origin_x) * inverse_x;
+            float t2_x = (aabbs->max_x[j] - origin_x) * inverse_x;
+            float t1_y = (aabbs->min_y[j] - origin_y) * inverse_y;
+            float t2_y = (aabbs->max_y[j] - origin_y) * inverse_y;
+            float t1_z = (aabbs->min_z[j] - origin_z) * inverse_z;
+            float t2_z = (aabbs->max_z[j] - origin_z) * inverse_z;
+
+            float enter = max2(max2(min2(t1_x, t2_x), min2(t1_y, t2_y)), min2(t1_z, t2_z));
+            float exit = min2(min2(max2(t1_x, t2_x), max2(t1_y, t2_y)), max2(t1_z, t2_z));
+
+            if (enter <= exit && enter >= 0.0f && enter < nearest) {
+                nearest = enter;
+                hit = j;
+            }
+        }
+
+        if (hit < 0) continue;
+
+        // Only the nearest box needs its normal, the face of the last slab entered
+        float enter_x = min2((aabbs->min_x[hit] - origin_x) * inverse_x, (aabbs->max_x[hit] - origin_x) * inverse_x);
+        float enter_y = min2((aabbs->min_y[hit] - origin_y) * inverse_y, (aabbs->max_y[hit] - origin_y) * inverse_y);
+
+        Vector3 normal = {0.0f, 0.0f, 0.0f};
+        if (enter_x == nearest) normal.x = (inverse_x > 0.0f) ? -1.0f : 1.0f;
+        else if (enter_y == nearest) normal.y = (inverse_y > 0.0f) ? -1.0f : 1.0f;
+        else normal.z = (inverse_z > 0.0f) ? -1.0f : 1.0f;
+
+        distances[i] = nearest;
+        normals[i] = normal;
+        shapes[i] = first_id + hit;
+    }
+}
+
+void rayBatch_raycastSpheres(const RayBatch* rays, const SphereBatch* spheres, int first_id, float* distances, Vector3* normals, int* shapes)
+{
+    for (int i = 0; i < rays->count; i++) {
+
+        float origin_x = rays->origin_x[i];
+        float origin_y = rays->origin_y[i];
+        float origin_z = rays->origin_z[i];
+        float direction_x = rays->direction_x[i];
+        float direction_y = rays->direction_y[i];
+        float direction_z = rays->direction_z[i];
+
+        float nearest = distances[i];
+        int hit = -1;
+
+        for (int j = 0; j < spheres->count; j++) {
+
+            // Unit direction, so the quadratic is t^2 + 2bt + c
+            float oc_x = origin_x - spheres->center_x[j];
+            float oc_y = origin_y - spheres->center_y[j];
+            float oc_z = origin_z - spheres->center_z[j];
+            float b = oc_x * direction_x + oc_y * direction_y + oc_z * direction_z;
+            float c = oc_x * oc_x + oc_y * oc_y + oc_z * oc_z - spheres->radius[j] * spheres->radius[j];
+            float discriminant = b * b - c;
+
+            if (c < 0.0f || b > 0.0f || discriminant < 0.0f) continue;
+
+            float t = -b - sqrtf(discriminant);
+            if (t < nearest) {
+                nearest = t;
+                hit = j;
+            }
+        }
+
+        if (hit < 0) continue;
+
+        Vector3 normal = {
+            origin_x + direction_x * nearest - spheres->center_x[hit],
+            origin_y + direction_y * nearest - spheres->center_y[hit],
+            origin_z + direction_z * nearest - spheres->center_z[hit]
+        };
+        vector3_divideByNumber(&normal, spheres->radius[hit]);
+
+        distances[i] = nearest;
+        normals[i] = normal;
+        shapes[i] = first_id + hit;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -8,10 +8,28 @@ typedef struct {
     float radius;
 } Sphere;
 
+/* spheres laid out one array per component, for the batched queries */
+typedef struct {
+    float* center_x;
+    float* center_y;
+    float* center_z;
+    float* radius;
+    int count;
+    int capacity;
+} SphereBatch;
+
 
 
+Vector3 sphere_getSupportPoint(const Sphere* sphere, const Vector3* direction);
+
 bool sphere_contactSphere(const Sphere* s, const Sphere* t);
-void sphere_collisionTestSphere(ContactData* contact, const Sphere* s, const Sphere* t);
+bool sphere_collisionTestSphere(ContactData* contact, const Sphere* s, const Sphere* t);
+
+void sphereBatch_init(SphereBatch* batch, int capacity);
+void sphereBatch_delete(SphereBatch* batch);
+void sphereBatch_clear(SphereBatch* batch);
+int sphereBatch_add(SphereBatch* batch, const Sphere* sphere);
+void sphereBatch_set(SphereBatch* batch, int index, const Sphere* sphere);
 
 
 bool sphere_contactSphere(const Sphere* s, const Sphere* t) 
@@ -24,11 +42,31 @@ bool sphere_contactSphere(const Sphere* s, const Sphere* t)
     return vector3_squaredMagnitude(&diff) <= radiusSum * radiusSum;
 }
 
-void sphere_collisionTestSphere(ContactData *contact, const Sphere *s, const Sphere *t) 
+/* farthest point of the sphere along "direction", which doesn't need to be normalized */
+Vector3 sphere_getSupportPoint(const Sphere* sphere, const Vector3* direction)
+{
+    float length = vector3_magnitude(direction);
+    if (length < TOLERANCE) return sphere->center;
+
+    Vector3 support = sphere->center;
+    vector3_addScaledVector(&support, direction, sphere->radius / length);
+    return support;
+}
+
+/* single pass test, returns false without touching "contact" when the spheres are apart */
+bool sphere_collisionTestSphere(ContactData *contact, const Sphere *s, const Sphere *t) 
 {
+    float radiusSum = s->radius + t->radius;
+
     // Calculate the normal pointing towards the first sphere
-    contact->normal = vector3_difference(&t->center, &s->center);
-    vector3_normalize(&contact->normal);
+    Vector3 difference = vector3_difference(&t->center, &s->center);
+    float distanceSquared = vector3_squaredMagnitude(&difference);
+    if (distanceSquared > radiusSum * radiusSum) return false;
+
+    float distance = vector3_magnitude(&difference);
+    contact->penetration = radiusSum - distance;
+    if (distance > TOLERANCE) contact->normal = vector3_returnScaled(&difference, 1.0f / distance);
+    else contact->normal = (Vector3){0.0f, 0.0f, 1.0f};
 
     // Calculate the contact point in reference to the second sphere
     contact->point = (Vector3){
@@ -36,6 +74,57 @@ void sphere_collisionTestSphere(ContactData *contact, const Sphere *s, const Sph
         t->center.y - contact->normal.y * t->radius,
         t->center.z - contact->normal.z * t->radius
     };
+
+    return true;
+}
+
+/* one block holds every array */
+void sphereBatch_init(SphereBatch* batch, int capacity)
+{
+    assert(capacity > 0);
+
+    float* memory = malloc(4 * capacity * sizeof(float));
+    assert(memory != NULL);
+
+    batch->center_x = memory;
+    batch->center_y = memory + capacity;
+    batch->center_z = memory + 2 * capacity;
+    batch->radius = memory + 3 * capacity;
+    batch->count = 0;
+    batch->capacity = capacity;
+}
+
+void sphereBatch_delete(SphereBatch* batch)
+{
+    free(batch->center_x);
+    batch->center_x = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+void sphereBatch_clear(SphereBatch* batch)
+{
+    batch->count = 0;
+}
+
+/* returns the index of the sphere in the batch */
+int sphereBatch_add(SphereBatch* batch, const Sphere* sphere)
+{
+    assert(batch->count < batch->capacity);
+
+    int index = batch->count++;
+    sphereBatch_set(batch, index, sphere);
+    return index;
+}
+
+void sphereBatch_set(SphereBatch* batch, int index, const Sphere* sphere)
+{
+    assert(index >= 0 && index < batch->count);
+
+    batch->center_x[index] = sphere->center.x;
+    batch->center_y[index] = sphere->center.y;
+    batch->center_z[index] = sphere->center.z;
+    batch->radius[index] = sphere->radius;
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,263 @@
+#ifndef TRIANGLE_H
+#define TRIANGLE_H
+
+// structures
+
+typedef struct {
+    Vector3 a;
+    Vector3 b;
+    Vector3 c;
+} Triangle;
+
+
+// function prototypes
+
+Vector3 triangle_getNormal(const Triangle* triangle);
+AABB triangle_getAABB(const Triangle* triangle);
+Vector3 triangle_closestToPoint(const Triangle* triangle, const Vector3* point);
+
+Vector3 capsule_closestToTriangle(const Capsule* capsule, const Triangle* triangle);
+bool capsule_contactTriangle(const Capsule* capsule, const Triangle* triangle);
+void capsule_contactTriangleSetData(ContactData* contact, const Capsule* capsule, const Triangle* triangle);
+bool capsule_collisionTestTriangle(ContactData* contact, const Capsule* capsule, const Triangle* triangle);
+void capsule_penetrationTriangle(ContactData* contact, const Capsule* capsule, const Triangle* triangle, const Vector3* point);
+bool capsule_sweepTriangle(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Triangle* triangle);
+
+
+// function implementations
+
+/* returns the unit normal of the triangle, following the counter clockwise winding a, b, c */
+Vector3 triangle_getNormal(const Triangle* triangle)
+{
+    Vector3 ab = vector3_difference(&triangle->b, &triangle->a);
+    Vector3 ac = vector3_difference(&triangle->c, &triangle->a);
+    Vector3 normal = vector3_returnCrossProduct(&ab, &ac);
+    vector3_normalize(&normal);
+    return normal;
+}
+
+AABB triangle_getAABB(const Triangle* triangle)
+{
+    AABB aabb;
+    aabb.minCoordinates = vector3_min(&triangle->a, &triangle->b);
+    aabb.minCoordinates = vector3_min(&aabb.minCoordinates, &triangle->c);
+    aabb.maxCoordinates = vector3_max(&triangle->a, &triangle->b);
+    aabb.maxCoordinates = vector3_max(&aabb.maxCoordinates, &triangle->c);
+    return aabb;
+}
+
+/* returns the point of the triangle closest to "point".
+the point is projected on the plane of the triangle, if the projection falls outside
+the closest point lays on one of the edges */
+Vector3 triangle_closestToPoint(const Triangle* triangle, const Vector3* point)
+{
+    Vector3 normal = triangle_getNormal(triangle);
+    Vector3 to_point = vector3_difference(point, &triangle->a);
+    Vector3 projection = *point;
+    vector3_addScaledVector(&projection, &normal, -vector3_returnDotProduct(&to_point, &normal));
+
+    float u, v, w;
+    triangle_getBarycentricCoordinates(&triangle->a, &triangle->b, &triangle->c, &projection, &u, &v, &w);
+    if (u >= 0.0f && v >= 0.0f && w >= 0.0f) return projection;
+
+    // Outside the triangle, keep the closest point among the three edges
+    Vector3 closest_ab = segment_closestToPoint(&triangle->a, &triangle->b, point);
+    Vector3 closest_bc = segment_closestToPoint(&triangle->b, &triangle->c, point);
+    Vector3 closest_ca = segment_closestToPoint(&triangle->c, &triangle->a, point);
+
+    Vector3 difference = vector3_difference(&closest_ab, point);
+    float distance_ab = vector3_squaredMagnitude(&difference);
+    difference = vector3_difference(&closest_bc, point);
+    float distance_bc = vector3_squaredMagnitude(&difference);
+    difference = vector3_difference(&closest_ca, point);
+    float distance_ca = vector3_squaredMagnitude(&difference);
+
+    if (distance_ab <= distance_bc && distance_ab <= distance_ca) return closest_ab;
+    if (distance_bc <= distance_ca) return closest_bc;
+    return closest_ca;
+}
+
+/* finds the center of the sphere along the capsule axis that is closest to the triangle.
+an axis that crosses the triangle touches it where it crosses. otherwise the closest points are an end
+of the axis and its closest point of the triangle, or the axis and one of the edges, whichever are nearer */
+Vector3 capsule_closestToTriangle(const Capsule* capsule, const Triangle* triangle)
+{
+    // A sphere has only its center, like the camera casts
+    if (vector3_equals(&capsule->start, &capsule->end)) return capsule->start;
+
+    Vector3 normal = triangle_getNormal(triangle);
+    Vector3 to_start = vector3_difference(&capsule->start, &triangle->a);
+    Vector3 to_end = vector3_difference(&capsule->end, &triangle->a);
+    float start_distance = vector3_returnDotProduct(&normal, &to_start);
+    float end_distance = vector3_returnDotProduct(&normal, &to_end);
+
+    if ((start_distance <= 0.0f) != (end_distance <= 0.0f)) {
+        Vector3 crossing = capsule->start;
+        Vector3 axis = vector3_difference(&capsule->end, &capsule->start);
+        vector3_addScaledVector(&crossing, &axis, start_distance / (start_distance - end_distance));
+
+        float u, v, w;
+        triangle_getBarycentricCoordinates(&triangle->a, &triangle->b, &triangle->c, &crossing, &u, &v, &w);
+        if (u >= 0.0f && v >= 0.0f && w >= 0.0f) return crossing;
+    }
+
+    Vector3 center = capsule->start;
+    Vector3 closest = triangle_closestToPoint(triangle, &capsule->start);
+    Vector3 difference = vector3_difference(&center, &closest);
+    float best = vector3_squaredMagnitude(&difference);
+
+    closest = triangle_closestToPoint(triangle, &capsule->end);
+    difference = vector3_difference(&capsule->end, &closest);
+    float distance = vector3_squaredMagnitude(&difference);
+    if (distance < best) {
+        best = distance;
+        center = capsule->end;
+    }
+
+    const Vector3* edges[3][2] = {{&triangle->a, &triangle->b}, {&triangle->b, &triangle->c}, {&triangle->c, &triangle->a}};
+    for (int i = 0; i < 3; i++) {
+        Vector3 on_axis, on_edge;
+        segment_closestPointsWithSegment(&capsule->start, &capsule->end, edges[i][0], edges[i][1], &on_axis, &on_edge);
+        difference = vector3_difference(&on_axis, &on_edge);
+        distance = vector3_squaredMagnitude(&difference);
+        if (distance < best) {
+            best = distance;
+            center = on_axis;
+        }
+    }
+
+    return center;
+}
+
+bool capsule_contactTriangle(const Capsule* capsule, const Triangle* triangle)
+{
+    Vector3 center = capsule_closestToTriangle(capsule, triangle);
+    Vector3 closest_point = triangle_closestToPoint(triangle, &center);
+    Vector3 distance_vector = vector3_difference(&center, &closest_point);
+
+    return vector3_squaredMagnitude(&distance_vector) <= capsule->radius * capsule->radius;
+}
+
+void capsule_contactTriangleSetData(ContactData* contact, const Capsule* capsule, const Triangle* triangle)
+{
+    Vector3 center = capsule_closestToTriangle(capsule, triangle);
+    contact->point = triangle_closestToPoint(triangle, &center);
+
+    Vector3 distance_vector = vector3_difference(&center, &contact->point);
+    float distance_squared = vector3_squaredMagnitude(&distance_vector);
+
+    // The axis goes through the triangle, push along the face normal
+    if (distance_squared < TOLERANCE) {
+        capsule_penetrationTriangle(contact, capsule, triangle, &contact->point);
+        return;
+    }
+
+    float distance = vector3_magnitude(&distance_vector);
+    contact->penetration = capsule->radius - distance;
+    contact->normal = vector3_returnScaled(&distance_vector, 1.0f / distance);
+}
+
+/* single pass test, "contact" is left untouched when it returns false */
+bool capsule_collisionTestTriangle(ContactData* contact, const Capsule* capsule, const Triangle* triangle)
+{
+    Vector3 center = capsule_closestToTriangle(capsule, triangle);
+    Vector3 closest_point = triangle_closestToPoint(triangle, &center);
+    Vector3 distance_vector = vector3_difference(&center, &closest_point);
+    float distance_squared = vector3_squaredMagnitude(&distance_vector);
+
+    if (distance_squared > capsule->radius * capsule->radius) return false;
+
+    if (distance_squared < TOLERANCE) {
+        capsule_penetrationTriangle(contact, capsule, triangle, &closest_point);
+        return true;
+    }
+
+    contact->point = closest_point;
+
+    float distance = vector3_magnitude(&distance_vector);
+    contact->penetration = capsule->radius - distance;
+    contact->normal = vector3_returnScaled(&distance_vector, 1.0f / distance);
+    return true;
+}
+
+/* contact of a capsule whose axis goes through the triangle at "point". the end of the axis behind the face
+decides the depth, it has to come out to the radius in front of it along the face normal */
+void capsule_penetrationTriangle(ContactData* contact, const Capsule* capsule, const Triangle* triangle, const Vector3* point)
+{
+    contact->normal = triangle_getNormal(triangle);
+    Vector3 to_start = vector3_difference(&capsule->start, &triangle->a);
+    Vector3 to_end = vector3_difference(&capsule->end, &triangle->a);
+    float deepest = fminf(vector3_returnDotProduct(&contact->normal, &to_start), vector3_returnDotProduct(&contact->normal, &to_end));
+
+    contact->point = *point;
+    contact->penetration = capsule->radius - fminf(deepest, 0.0f);
+}
+
+/* conservative advancement like capsule_sweepAABB, the triangle is convex as well.
+nothing touches the triangle before the capsule reaches its plane, so a capsule clear of the plane starts advancing there */
+bool capsule_sweepTriangle(ContactData* contact, float* time, const Capsule* capsule, const Vector3* displacement, const Triangle* triangle)
+{
+    Vector3 face_normal = triangle_getNormal(triangle);
+    Vector3 to_start = vector3_difference(&capsule->start, &triangle->a);
+    Vector3 to_end = vector3_difference(&capsule->end, &triangle->a);
+    float start_distance = vector3_returnDotProduct(&face_normal, &to_start);
+    float end_distance = vector3_returnDotProduct(&face_normal, &to_end);
+    float nearest_distance = min2(start_distance, end_distance);
+    float farthest_distance = max2(start_distance, end_distance);
+    float approach_speed = -vector3_returnDotProduct(&face_normal, displacement);
+
+    float t = 0.0f;
+
+    if (nearest_distance > capsule->radius) {
+        if (approach_speed <= 0.0f) return false;
+        t = (nearest_distance - capsule->radius) / approach_speed;
+    }
+    else if (farthest_distance < -capsule->radius) {
+        if (approach_speed >= 0.0f) return false;
+        t = (farthest_distance + capsule->radius) / approach_speed;
+    }
+    else if (capsule_collisionTestTriangle(contact, capsule, triangle)) {
+        *time = 0.0f;
+        return true;
+    }
+
+    if (t > 1.0f) return false;
+
+    Capsule moved = *capsule;
+    vector3_addScaledVector(&moved.start, displacement, t);
+    vector3_addScaledVector(&moved.end, displacement, t);
+
+    for (int i = 0; i < CAPSULE_SWEEP_MAX_ITERATIONS; i++) {
+
+        Vector3 center = capsule_closestToTriangle(&moved, triangle);
+        Vector3 closest_point = triangle_closestToPoint(triangle, &center);
+        Vector3 distance_vector = vector3_difference(&center, &closest_point);
+        float distance = vector3_magnitude(&distance_vector);
+        float gap = distance - capsule->radius;
+
+        Vector3 normal = vector3_returnScaled(&distance_vector, 1.0f / distance);
+
+        if (gap <= CAPSULE_SWEEP_TOLERANCE) {
+            *time = t;
+            contact->point = closest_point;
+            contact->normal = normal;
+            contact->penetration = -gap;
+            return true;
+        }
+
+        float closing_speed = -vector3_returnDotProduct(&normal, displacement);
+        if (closing_speed <= 0.0f) return false;
+
+        t += gap / closing_speed;
+        if (t > 1.0f) return false;
+
+        moved.start = capsule->start;
+        moved.end = capsule->end;
+        vector3_addScaledVector(&moved.start, displacement, t);
+        vector3_addScaledVector(&moved.end, displacement, t);
+    }
+
+    return false;
+}
+
+#endif
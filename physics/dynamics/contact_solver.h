@@ -0,0 +1,308 @@
+#ifndef CONTACT_SOLVER_H
+#define CONTACT_SOLVER_H
+
+/* CONTACT_SOLVER.H
+sequential impulse solver for the contacts between rigid bodies. the bodies have no inertia tensor,
+so only the linear velocities are solved. the constraints live in an array allocated once by contactSolver_init.
+a frame goes:
+    rigidBody_integrateVelocity on every body
+    contactSolver_clear, then contactSolver_addManifold / contactSolver_addContact for every touching pair
+    contactSolver_solve
+    rigidBody_integratePosition on every body */
+
+
+// structures
+
+typedef struct {
+
+    RigidBody* body_a;          // the normal points from b towards a, b can be NULL for static geometry
+    RigidBody* body_b;
+    ContactPoint* cached;       // manifold point the impulses are warm started from and stored to, can be NULL
+
+    Vector3 normal;
+    Vector3 tangents[2];
+    float penetration;
+
+    float inverse_mass_a;
+    float inverse_mass_b;
+    float effective_mass;       // the same along every direction without angular terms
+    float friction;
+    float bias;                 // separating velocity asked by the baumgarte correction
+
+    float normal_impulse;
+    float tangent_impulse[2];
+    float split_impulse;
+
+} ContactConstraint;
+
+typedef struct {
+
+    ContactConstraint* constraints;
+    int capacity;
+    int count;
+
+    int velocity_iterations;
+    int position_iterations;    // only used with SPLIT_IMPULSES
+    ContactsPositionCorrectionTechnique position_correction;
+
+} ContactSolver;
+
+
+// function prototypes
+
+void contactSolver_init(ContactSolver* solver, int capacity);
+void contactSolver_initFromArena(ContactSolver* solver, MemoryArena* arena, int capacity);
+void contactSolver_setMemory(ContactSolver* solver, void* memory, int capacity);
+void contactSolver_delete(ContactSolver* solver);
+void contactSolver_clear(ContactSolver* solver);
+
+void contactSolver_addContact(ContactSolver* solver, RigidBody* a, RigidBody* b, const ContactData* contact, ContactPoint* cached);
+void contactSolver_addManifold(ContactSolver* solver, RigidBody* a, RigidBody* b, ContactManifold* manifold);
+
+void contactSolver_solve(ContactSolver* solver, float time_step);
+
+void contactSolver_prepare(ContactSolver* solver, float time_step);
+void contactSolver_solveVelocities(ContactSolver* solver);
+void contactSolver_solvePositions(ContactSolver* solver, float time_step);
+void contactSolver_storeImpulses(ContactSolver* solver);
+
+void contactConstraint_setTangents(ContactConstraint* constraint);
+Vector3 contactConstraint_getRelativeVelocity(const ContactConstraint* constraint);
+void contactConstraint_applyImpulse(ContactConstraint* constraint, const Vector3* impulse);
+
+
+// function implementations
+
+void contactSolver_init(ContactSolver* solver, int capacity)
+{
+    void* memory = malloc(capacity * sizeof(ContactConstraint));
+    assert(memory != NULL);
+    contactSolver_setMemory(solver, memory, capacity);
+}
+
+/* the constraints live as long as the arena, don't call contactSolver_delete on it */
+void contactSolver_initFromArena(ContactSolver* solver, MemoryArena* arena, int capacity)
+{
+    contactSolver_setMemory(solver, memoryArena_allocate(arena, capacity * sizeof(ContactConstraint)), capacity);
+}
+
+/* sets up the solver over "memory", room for "capacity" constraints */
+void contactSolver_setMemory(ContactSolver* solver, void* memory, int capacity)
+{
+    assert(capacity > 0);
+
+    solver->constraints = memory;
+    solver->capacity = capacity;
+    solver->count = 0;
+
+    solver->velocity_iterations = DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS;
+    solver->position_iterations = DEFAULT_POSITION_SOLVER_NB_ITERATIONS;
+    solver->position_correction = SPLIT_IMPULSES;
+}
+
+void contactSolver_delete(ContactSolver* solver)
+{
+    free(solver->constraints);
+    solver->constraints = NULL;
+    solver->capacity = 0;
+    solver->count = 0;
+}
+
+void contactSolver_clear(ContactSolver* solver)
+{
+    solver->count = 0;
+}
+
+/* adds a contact whose normal points from "b" towards "a". with "cached" the contact is warm started
+from the impulses of the last frame, and gives back the ones found by this frame */
+void contactSolver_addContact(ContactSolver* solver, RigidBody* a, RigidBody* b, const ContactData* contact, ContactPoint* cached)
+{
+    assert(solver->count < solver->capacity);
+    assert(a != NULL);
+
+    ContactConstraint* constraint = &solver->constraints[solver->count++];
+
+    constraint->body_a = a;
+    constraint->body_b = b;
+    constraint->cached = cached;
+    constraint->normal = contact->normal;
+    constraint->penetration = contact->penetration;
+
+    if (cached != NULL) {
+        constraint->normal_impulse = cached->normal_impulse;
+        constraint->tangent_impulse[0] = cached->tangent_impulse[0];
+        constraint->tangent_impulse[1] = cached->tangent_impulse[1];
+    }
+    else {
+        constraint->normal_impulse = 0.0f;
+        constraint->tangent_impulse[0] = 0.0f;
+        constraint->tangent_impulse[1] = 0.0f;
+    }
+}
+
+/* adds the points of "manifold" matched this frame, see contactSolver_addContact.
+"a" must be the body of manifold->collider_a, it can be NULL when "b" isn't */
+void contactSolver_addManifold(ContactSolver* solver, RigidBody* a, RigidBody* b, ContactManifold* manifold)
+{
+    for (int i = 0; i < manifold->point_count; i++) {
+
+        ContactPoint* point = &manifold->points[i];
+        if (point->frames_unmatched > 0) continue;
+
+        if (a != NULL) {
+            contactSolver_addContact(solver, a, b, &point->data, point);
+            continue;
+        }
+
+        // The solver needs a body on the a side, the flipped contact keeps flipped impulses
+        ContactData flipped = point->data;
+        vector3_invert(&flipped.normal);
+        contactSolver_addContact(solver, b, NULL, &flipped, point);
+    }
+}
+
+void contactSolver_solve(ContactSolver* solver, float time_step)
+{
+    assert(time_step > 0.0f);
+
+    contactSolver_prepare(solver, time_step);
+    contactSolver_solveVelocities(solver);
+    if (solver->position_correction == SPLIT_IMPULSES) contactSolver_solvePositions(solver, time_step);
+    contactSolver_storeImpulses(solver);
+}
+
+/* computes the per contact terms that don't change between iterations and applies the warm start impulses */
+void contactSolver_prepare(ContactSolver* solver, float time_step)
+{
+    for (int i = 0; i < solver->count; i++) {
+
+        ContactConstraint* constraint = &solver->constraints[i];
+        RigidBody* a = constraint->body_a;
+        RigidBody* b = constraint->body_b;
+
+        constraint->inverse_mass_a = a->inverse_mass;
+        constraint->inverse_mass_b = (b != NULL) ? b->inverse_mass : 0.0f;
+        float inverse_mass_sum = constraint->inverse_mass_a + constraint->inverse_mass_b;
+        constraint->effective_mass = (inverse_mass_sum > 0.0f) ? 1.0f / inverse_mass_sum : 0.0f;
+        constraint->friction = (b != NULL) ? sqrtf(a->friction * b->friction) : a->friction;
+
+        contactConstraint_setTangents(constraint);
+
+        // Baumgarte feeds the position error into the velocity, split impulses keep it apart
+        float error = max2(constraint->penetration - CONTACT_SOLVER_PENETRATION_SLOP, 0.0f);
+        constraint->bias = (solver->position_correction == BAUMGARTE_CONTACTS) ? CONTACT_SOLVER_BAUMGARTE_FACTOR * error / time_step : 0.0f;
+        constraint->split_impulse = 0.0f;
+
+        Vector3 impulse = vector3_returnScaled(&constraint->normal, constraint->normal_impulse);
+        vector3_addScaledVector(&impulse, &constraint->tangents[0], constraint->tangent_impulse[0]);
+        vector3_addScaledVector(&impulse, &constraint->tangents[1], constraint->tangent_impulse[1]);
+        contactConstraint_applyImpulse(constraint, &impulse);
+    }
+}
+
+void contactSolver_solveVelocities(ContactSolver* solver)
+{
+    for (int iteration = 0; iteration < solver->velocity_iterations; iteration++) {
+        for (int i = 0; i < solver->count; i++) {
+
+            ContactConstraint* constraint = &solver->constraints[i];
+
+            // Friction first, bounded by the normal impulse of the last iteration
+            float max_friction = constraint->friction * constraint->normal_impulse;
+
+            for (int k = 0; k < 2; k++) {
+
+                Vector3 relative_velocity = contactConstraint_getRelativeVelocity(constraint);
+                float tangent_speed = vector3_returnDotProduct(&relative_velocity, &constraint->tangents[k]);
+
+                float previous = constraint->tangent_impulse[k];
+                constraint->tangent_impulse[k] = clamp(previous - constraint->effective_mass * tangent_speed, -max_friction, max_friction);
+
+                Vector3 impulse = vector3_returnScaled(&constraint->tangents[k], constraint->tangent_impulse[k] - previous);
+                contactConstraint_applyImpulse(constraint, &impulse);
+            }
+
+            // The accumulated normal impulse can only push the bodies apart
+            Vector3 relative_velocity = contactConstraint_getRelativeVelocity(constraint);
+            float normal_speed = vector3_returnDotProduct(&relative_velocity, &constraint->normal);
+
+            float previous = constraint->normal_impulse;
+            constraint->normal_impulse = max2(previous + constraint->effective_mass * (constraint->bias - normal_speed), 0.0f);
+
+            Vector3 impulse = vector3_returnScaled(&constraint->normal, constraint->normal_impulse - previous);
+            contactConstraint_applyImpulse(constraint, &impulse);
+        }
+    }
+}
+
+/* split impulses: solves the penetration on the split velocities, which move the bodies
+on the next position step and are then discarded, so the correction adds no momentum */
+void contactSolver_solvePositions(ContactSolver* solver, float time_step)
+{
+    for (int iteration = 0; iteration < solver->position_iterations; iteration++) {
+        for (int i = 0; i < solver->count; i++) {
+
+            ContactConstraint* constraint = &solver->constraints[i];
+            RigidBody* a = constraint->body_a;
+            RigidBody* b = constraint->body_b;
+
+            float error = max2(constraint->penetration - CONTACT_SOLVER_PENETRATION_SLOP, 0.0f);
+            float target_speed = CONTACT_SOLVER_BAUMGARTE_FACTOR * error / time_step;
+
+            Vector3 split_velocity = a->split_velocity;
+            if (b != NULL) vector3_subtract(&split_velocity, &b->split_velocity);
+            float split_speed = vector3_returnDotProduct(&split_velocity, &constraint->normal);
+
+            float previous = constraint->split_impulse;
+            constraint->split_impulse = max2(previous + constraint->effective_mass * (target_speed - split_speed), 0.0f);
+            float delta = constraint->split_impulse - previous;
+
+            vector3_addScaledVector(&a->split_velocity, &constraint->normal, delta * constraint->inverse_mass_a);
+            if (b != NULL) vector3_addScaledVector(&b->split_velocity, &constraint->normal, -delta * constraint->inverse_mass_b);
+        }
+    }
+}
+
+/* gives the accumulated impulses back to the manifold points for the next frame warm start */
+void contactSolver_storeImpulses(ContactSolver* solver)
+{
+    for (int i = 0; i < solver->count; i++) {
+
+        ContactConstraint* constraint = &solver->constraints[i];
+        if (constraint->cached == NULL) continue;
+
+        constraint->cached->normal_impulse = constraint->normal_impulse;
+        constraint->cached->tangent_impulse[0] = constraint->tangent_impulse[0];
+        constraint->cached->tangent_impulse[1] = constraint->tangent_impulse[1];
+    }
+}
+
+/* builds the friction directions from the normal alone, so they stay the same between frames and
+the cached tangent impulses remain valid */
+void contactConstraint_setTangents(ContactConstraint* constraint)
+{
+    const Vector3* normal = &constraint->normal;
+
+    if (fabsf(normal->x) >= 0.57735f) constraint->tangents[0] = (Vector3){normal->y, -normal->x, 0.0f};
+    else constraint->tangents[0] = (Vector3){0.0f, normal->z, -normal->y};
+
+    vector3_normalize(&constraint->tangents[0]);
+    constraint->tangents[1] = vector3_returnCrossProduct(normal, &constraint->tangents[0]);
+}
+
+/* velocity of a relative to b */
+Vector3 contactConstraint_getRelativeVelocity(const ContactConstraint* constraint)
+{
+    Vector3 velocity = constraint->body_a->velocity;
+    if (constraint->body_b != NULL) vector3_subtract(&velocity, &constraint->body_b->velocity);
+    return velocity;
+}
+
+/* applies "impulse" to a and its opposite to b */
+void contactConstraint_applyImpulse(ContactConstraint* constraint, const Vector3* impulse)
+{
+    vector3_addScaledVector(&constraint->body_a->velocity, impulse, constraint->inverse_mass_a);
+    if (constraint->body_b != NULL) vector3_addScaledVector(&constraint->body_b->velocity, impulse, -constraint->inverse_mass_b);
+}
+
+#endif
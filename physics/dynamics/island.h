@@ -0,0 +1,141 @@
+#ifndef ISLAND_H
+#define ISLAND_H
+
+/* ISLAND.H
+groups the bodies touching each other into islands with a union find over the contacts of the solver,
+so a pile of bodies goes to sleep and wakes up as a whole. static geometry doesn't join islands.
+islands_updateSleeping goes between contactSolver_solve and rigidBody_integratePosition.
+sleeping bodies skip the integration, and pairs where neither body is active (rigidBody_isActive)
+can skip the broadphase update and the narrowphase, so a scene at rest costs next to nothing */
+
+
+// structures
+
+typedef struct {
+    int* parents;           // union find forest over the body indices
+    float* sleep_times;     // shortest sleep time of the bodies of each island, indexed by its root
+    int capacity;
+} Islands;
+
+
+// function prototypes
+
+void islands_init(Islands* islands, int capacity);
+void islands_initFromArena(Islands* islands, MemoryArena* arena, int capacity);
+void islands_delete(Islands* islands);
+
+int islands_find(Islands* islands, int index);
+void islands_merge(Islands* islands, int a, int b);
+
+void islands_build(Islands* islands, RigidBody* bodies, int body_count, const ContactSolver* solver);
+void islands_updateSleeping(Islands* islands, RigidBody* bodies, int body_count, const ContactSolver* solver, float time_step);
+
+
+// function implementations
+
+void islands_init(Islands* islands, int capacity)
+{
+    assert(capacity > 0);
+
+    islands->parents = malloc(capacity * sizeof(int));
+    islands->sleep_times = malloc(capacity * sizeof(float));
+    assert(islands->parents != NULL && islands->sleep_times != NULL);
+    islands->capacity = capacity;
+}
+
+/* the arrays live as long as the arena, don't call islands_delete on them */
+void islands_initFromArena(Islands* islands, MemoryArena* arena, int capacity)
+{
+    assert(capacity > 0);
+
+    islands->parents = memoryArena_allocate(arena, capacity * sizeof(int));
+    islands->sleep_times = memoryArena_allocate(arena, capacity * sizeof(float));
+    islands->capacity = capacity;
+}
+
+void islands_delete(Islands* islands)
+{
+    free(islands->parents);
+    free(islands->sleep_times);
+    islands->parents = NULL;
+    islands->sleep_times = NULL;
+    islands->capacity = 0;
+}
+
+/* returns the root of the island of body "index", halving the path on the way */
+int islands_find(Islands* islands, int index)
+{
+    while (islands->parents[index] != index) {
+        islands->parents[index] = islands->parents[islands->parents[index]];
+        index = islands->parents[index];
+    }
+    return index;
+}
+
+void islands_merge(Islands* islands, int a, int b)
+{
+    int root_a = islands_find(islands, a);
+    int root_b = islands_find(islands, b);
+    if (root_a == root_b) return;
+
+    // Keep the smallest index as root so the forest stays shallow for piles built in order
+    if (root_a < root_b) islands->parents[root_b] = root_a;
+    else islands->parents[root_a] = root_b;
+}
+
+/* joins the bodies of every contact between two dynamic bodies, "bodies" must hold all the bodies of the solver */
+void islands_build(Islands* islands, RigidBody* bodies, int body_count, const ContactSolver* solver)
+{
+    assert(body_count <= islands->capacity);
+
+    for (int i = 0; i < body_count; i++) islands->parents[i] = i;
+
+    for (int i = 0; i < solver->count; i++) {
+
+        const ContactConstraint* constraint = &solver->constraints[i];
+        if (constraint->body_b == NULL || constraint->body_a->inverse_mass == 0.0f || constraint->body_b->inverse_mass == 0.0f) continue;
+
+        int a = constraint->body_a - bodies;
+        int b = constraint->body_b - bodies;
+        assert(a >= 0 && a < body_count && b >= 0 && b < body_count);
+
+        islands_merge(islands, a, b);
+    }
+}
+
+/* puts to sleep the islands whose bodies all stayed slow for DEFAULT_TIME_BEFORE_SLEEP,
+and wakes up every body of the islands that aren't, so a sleeping body touched by an awake one wakes up */
+void islands_updateSleeping(Islands* islands, RigidBody* bodies, int body_count, const ContactSolver* solver, float time_step)
+{
+    islands_build(islands, bodies, body_count, solver);
+
+    for (int i = 0; i < body_count; i++) islands->sleep_times[i] = FLT_MAX;
+
+    for (int i = 0; i < body_count; i++) {
+
+        RigidBody* body = &bodies[i];
+        if (body->inverse_mass == 0.0f || body->sleeping) continue;
+
+        rigidBody_updateSleepTime(body, time_step);
+
+        int root = islands_find(islands, i);
+        islands->sleep_times[root] = min2(islands->sleep_times[root], body->sleep_time);
+    }
+
+    for (int i = 0; i < body_count; i++) {
+
+        RigidBody* body = &bodies[i];
+        if (body->inverse_mass == 0.0f) continue;
+
+        bool island_sleeps = islands->sleep_times[islands_find(islands, i)] >= DEFAULT_TIME_BEFORE_SLEEP;
+
+        if (island_sleeps && !body->sleeping) {
+            body->sleeping = true;
+            body->velocity = (Vector3){0.0f, 0.0f, 0.0f};
+            body->split_velocity = (Vector3){0.0f, 0.0f, 0.0f};
+        }
+        else if (!island_sleeps && body->sleeping) rigidBody_wakeUp(body);
+    }
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef PHYSICS_WORLD_H
+#define PHYSICS_WORLD_H
+
+/* PHYSICS_WORLD.H
+owns the rigid bodies, their colliders and everything needed to step them. the bodies, colliders, contact manifolds,
+solver constraints, islands and broadphase query results are all carved from a single arena sized once by physicsWorld_init,
+so creating and destroying objects never allocates. the broadphase tree grows on its own */
+
+#define PHYSICS_WORLD_PAIRS_PER_CONTACT 4   // candidate pairs per step for each contact, the fat bounds meet well before the shapes
+
+
+// structures
+
+typedef struct {
+    Collider collider;      // first member, so the colliders handed to the manifolds lead back here
+    PoolHandle body;        // POOL_NULL_HANDLE for static colliders
+} WorldCollider;
+
+typedef struct {
+
+    MemoryArena arena;
+    Pool bodies;            // RigidBody, also a plain array thanks to its alignment
+    Pool colliders;         // WorldCollider
+
+    DynamicTree broadphase;
+    CollisionPairBuffer pairs;
+    ContactManifoldCache manifolds;
+    ContactSolver solver;
+    Islands islands;
+    CollisionFilterTable filters;   // its counters cover the last step
+    int* candidates;                // broadphase query results, room for every collider so no query is cut short
+
+    Vector3 gravity;        // zero until set by the caller
+
+} PhysicsWorld;
+
+
+// function prototypes
+
+void physicsWorld_init(PhysicsWorld* world, int max_bodies, int max_colliders, int max_contacts);
+void physicsWorld_delete(PhysicsWorld* world);
+
+PoolHandle physicsWorld_createBody(PhysicsWorld* world, float mass, const Vector3* position);
+void physicsWorld_destroyBody(PhysicsWorld* world, PoolHandle handle);
+RigidBody* physicsWorld_getBody(const PhysicsWorld* world, PoolHandle handle);
+
+PoolHandle physicsWorld_createCollider(PhysicsWorld* world, const Collider* shape, PoolHandle body);
+void physicsWorld_destroyCollider(PhysicsWorld* world, PoolHandle handle);
+Collider* physicsWorld_getCollider(const PhysicsWorld* world, PoolHandle handle);
+
+void physicsWorld_step(PhysicsWorld* world, float time_step);
+
+void physicsWorld_updateBroadphase(PhysicsWorld* world);
+void physicsWorld_collide(PhysicsWorld* world);
+RigidBody* physicsWorld_getColliderBody(const PhysicsWorld* world, const Collider* collider);
+
+
+// function implementations
+
+/* "max_contacts" bounds the touching collider pairs, each can hold up to CONTACT_MANIFOLD_MAX_POINTS points */
+void physicsWorld_init(PhysicsWorld* world, int max_bodies, int max_colliders, int max_contacts)
+{
+    int max_constraints = max_contacts * CONTACT_MANIFOLD_MAX_POINTS;
+    int manifold_capacity = max_contacts * 2;
+    int pair_capacity = max_contacts * PHYSICS_WORLD_PAIRS_PER_CONTACT;
+
+    size_t size = pool_getMemorySize(sizeof(RigidBody), max_bodies)
+        + pool_getMemorySize(sizeof(WorldCollider), max_colliders)
+        + collisionPairBuffer_getMemorySize(pair_capacity)
+        + memoryArena_getAlignedSize(contactManifoldCache_getMemorySize(manifold_capacity))
+        + memoryArena_getAlignedSize(max_constraints * sizeof(ContactConstraint))
+        + memoryArena_getAlignedSize(max_bodies * sizeof(int))
+        + memoryArena_getAlignedSize(max_bodies * sizeof(float))
+        + memoryArena_getAlignedSize(max_colliders * sizeof(int));
+
+    memoryArena_init(&world->arena, size);
+
+    pool_init(&world->bodies, &world->arena, sizeof(RigidBody), max_bodies);
+    pool_init(&world->colliders, &world->arena, sizeof(WorldCollider), max_colliders);
+    collisionPairBuffer_initFromArena(&world->pairs, &world->arena, pair_capacity);
+    contactManifoldCache_initFromArena(&world->manifolds, &world->arena, manifold_capacity);
+    contactSolver_initFromArena(&world->solver, &world->arena, max_constraints);
+    islands_initFromArena(&world->islands, &world->arena, max_bodies);
+    world->candidates = memoryArena_allocate(&world->arena, max_colliders * sizeof(int));
+
+    // The bodies pool is walked as a RigidBody array by the islands
+    assert(world->bodies.stride == sizeof(RigidBody));
+
+    dynamicTree_init(&world->broadphase);
+    collisionFilterTable_init(&world->filters);
+    world->gravity = (Vector3){0.0f, 0.0f, 0.0f};
+}
+
+void physicsWorld_delete(PhysicsWorld* world)
+{
+    dynamicTree_delete(&world->broadphase);
+    memoryArena_delete(&world->arena);
+}
+
+/* a mass of 0 makes a static body */
+PoolHandle physicsWorld_createBody(PhysicsWorld* world, float mass, const Vector3* position)
+{
+    PoolHandle handle = pool_allocate(&world->bodies);
+    RigidBody* body = pool_get(&world->bodies, handle);
+
+    body->position = *position;
+    body->previous_position = *position;
+    rigidBody_setMass(body, mass);
+
+    return handle;
+}
+
+/* also destroys the colliders attached to the body */
+void physicsWorld_destroyBody(PhysicsWorld* world, PoolHandle handle)
+{
+    for (int i = 0; i < world->colliders.high_water; i++) {
+        if (!pool_isUsed(&world->colliders, i)) continue;
+        WorldCollider* collider = pool_getAt(&world->colliders, i);
+        if (collider->body == handle) physicsWorld_destroyCollider(world, pool_getHandle(&world->colliders, i));
+    }
+
+    pool_free(&world->bodies, handle);
+}
+
+/* returns NULL for destroyed bodies */
+RigidBody* physicsWorld_getBody(const PhysicsWorld* world, PoolHandle handle)
+{
+    return pool_get(&world->bodies, handle);
+}
+
+/* copies "shape" into the world and inserts it in the broadphase, "body" moves it or POOL_NULL_HANDLE leaves it static */
+PoolHandle physicsWorld_createCollider(PhysicsWorld* world, const Collider* shape, PoolHandle body)
+{
+    PoolHandle handle = pool_allocate(&world->colliders);
+    WorldCollider* collider = pool_get(&world->colliders, handle);
+
+    collider->collider = *shape;
+    collider->collider.proxy_id = DYNAMIC_TREE_NULL_NODE;
+    collider->body = body;
+
+    RigidBody* rigid_body = physicsWorld_getBody(world, body);
+    if (rigid_body != NULL) collider_setPosition(&collider->collider, &rigid_body->position);
+
+    collider_addToBroadphase(&collider->collider, &world->broadphase);
+    return handle;
+}
+
+void physicsWorld_destroyCollider(PhysicsWorld* world, PoolHandle handle)
+{
+    WorldCollider* collider = pool_get(&world->colliders, handle);
+    assert(collider != NULL);
+
+    // The bodies resting on it have to fall, sleeping ones have no manifold left so the broadphase finds them
+    const AABB* bounds = dynamicTree_getFatAABB(&world->broadphase, collider->collider.proxy_id);
+    int candidate_count = dynamicTree_queryAABB(&world->broadphase, bounds, world->candidates, world->colliders.capacity);
+
+    for (int i = 0; i < candidate_count; i++) {
+        WorldCollider* other = dynamicTree_getData(&world->broadphase, world->candidates[i]);
+        RigidBody* body = physicsWorld_getBody(world, other->body);
+        if (body != NULL) rigidBody_wakeUp(body);
+    }
+
+    collider_removeFromBroadphase(&collider->collider, &world->broadphase);
+    pool_free(&world->colliders, handle);
+}
+
+/* returns NULL for destroyed colliders */
+Collider* physicsWorld_getCollider(const PhysicsWorld* world, PoolHandle handle)
+{
+    WorldCollider* collider = pool_get(&world->colliders, handle);
+    return (collider != NULL) ? &collider->collider : NULL;
+}
+
+/* advances the world by "time_step": integrates the velocities, finds and solves the contacts,
+updates the sleeping islands and integrates the positions */
+void physicsWorld_step(PhysicsWorld* world, float time_step)
+{
+    RigidBody* bodies = (RigidBody*)world->bodies.elements;
+    int body_count = world->bodies.high_water;
+
+    for (int i = 0; i < body_count; i++) {
+        if (!rigidBody_isActive(&bodies[i])) continue;
+        vector3_addScaledVector(&bodies[i].velocity, &world->gravity, time_step);
+        rigidBody_integrateVelocity(&bodies[i], time_step);
+    }
+
+    physicsWorld_updateBroadphase(world);
+    physicsWorld_collide(world);
+
+    contactSolver_solve(&world->solver, time_step);
+    islands_updateSleeping(&world->islands, bodies, body_count, &world->solver, time_step);
+
+    // Freed slots are zeroed, their inverse mass keeps them out
+    for (int i = 0; i < body_count; i++) {
+        if (bodies[i].inverse_mass > 0.0f) rigidBody_integratePosition(&bodies[i], time_step);
+    }
+}
+
+/* moves the colliders of the active bodies to their body */
+void physicsWorld_updateBroadphase(PhysicsWorld* world)
+{
+    for (int i = 0; i < world->colliders.high_water; i++) {
+
+        if (!pool_isUsed(&world->colliders, i)) continue;
+
+        WorldCollider* collider = pool_getAt(&world->colliders, i);
+        RigidBody* body = physicsWorld_getBody(world, collider->body);
+        if (!rigidBody_isActive(body)) continue;
+
+        collider_setPosition(&collider->collider, &body->position);
+        collider_updateBroadphase(&collider->collider, &world->broadphase);
+    }
+
+    // The pairs come from queries, the move buffer would only grow
+    dynamicTree_clearMoves(&world->broadphase);
+}
+
+/* gathers the pairs with at least one active body, runs the narrowphase on them bucketed by type pair
+and hands the resulting manifolds to the solver */
+void physicsWorld_collide(PhysicsWorld* world)
+{
+    contactSolver_clear(&world->solver);
+    collisionFilterTable_resetCounters(&world->filters);
+    collisionPairBuffer_clear(&world->pairs);
+
+    for (int i = 0; i < world->colliders.high_water; i++) {
+
+        if (!pool_isUsed(&world->colliders, i)) continue;
+
+        WorldCollider* collider = pool_getAt(&world->colliders, i);
+        if (!rigidBody_isActive(physicsWorld_getBody(world, collider->body))) continue;
+
+        // Fat against fat, so both colliders of a pair find each other
+        const AABB* query = dynamicTree_getFatAABB(&world->broadphase, collider->collider.proxy_id);
+        int candidate_count = dynamicTree_queryAABB(&world->broadphase, query, world->candidates, world->colliders.capacity);
+
+        for (int j = 0; j < candidate_count; j++) {
+
+            WorldCollider* other = dynamicTree_getData(&world->broadphase, world->candidates[j]);
+            if (other == collider || other->body == collider->body) continue;
+
+            // Pairs of two active bodies are tested from the collider with the lowest slot
+            int other_index = ((uint8_t*)other - world->colliders.elements) / world->colliders.stride;
+            if (rigidBody_isActive(physicsWorld_getBody(world, other->body)) && other_index < i) continue;
+            if (!collisionFilterTable_shouldCollide(&world->filters, &collider->collider.filter, &other->collider.filter)) continue;
+
+            // Convex pairs that touched last frame start gjk where it ended
+            CollisionPair* pair = collisionPairBuffer_add(&world->pairs, &collider->collider, &other->collider);
+            if (pair == NULL || !collisionPair_usesGjk(pair)) continue;
+
+            const ContactManifold* manifold = contactManifoldCache_get(&world->manifolds, pair->a, pair->b);
+            if (manifold != NULL) pair->gjk = contactManifold_getGjkCache(manifold, pair->a);
+        }
+    }
+
+    collisionPairBuffer_sortByType(&world->pairs);
+    int contact_count = collisionPairBuffer_collisionTest(&world->pairs);
+
+    for (int i = 0; i < contact_count; i++) {
+
+        const CollisionPair* pair = &world->pairs.sorted[i];
+        ContactManifold* manifold = contactManifoldCache_update(&world->manifolds, pair->a, pair->b, &world->pairs.contacts[i]);
+        if (collisionPair_usesGjk(pair)) contactManifold_setGjkCache(manifold, pair->a, &pair->gjk);
+        contactSolver_addManifold(&world->solver,
+            physicsWorld_getColliderBody(world, manifold->collider_a),
+            physicsWorld_getColliderBody(world, manifold->collider_b),
+            manifold);
+    }
+
+    contactManifoldCache_removeStale(&world->manifolds);
+}
+
+/* returns the body moving "collider", NULL for static colliders */
+RigidBody* physicsWorld_getColliderBody(const PhysicsWorld* world, const Collider* collider)
+{
+    const WorldCollider* world_collider = (const WorldCollider*)collider;
+    return physicsWorld_getBody(world, world_collider->body);
+}
+
+#endif
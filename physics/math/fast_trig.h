@@ -0,0 +1,162 @@
+#ifndef FAST_TRIG_H
+#define FAST_TRIG_H
+
+/* FAST_TRIG.H
+single precision sin, cos, atan2 and acos built from short polynomials, to keep libm out of the per frame paths.
+the accuracy is chosen at compile time with FAST_TRIG_ACCURACY, the max absolute errors below are the bounds
+the math bench checks every tier against the double precision libm functions:
+
+                        sin / cos      atan2          acos
+    FAST_TRIG_LIBM      libm sinf, cosf, atan2f, acosf
+    FAST_TRIG_PRECISE   1.0e-7         2.0e-6         4.1e-7
+    FAST_TRIG_FAST      6.8e-4         5.0e-3         6.8e-5
+
+the sin and cos errors hold over [-1000, 1000] radians, the range reduction loses precision beyond.
+every tier can be called by name with the *Tier functions, the others use FAST_TRIG_ACCURACY */
+
+#define FAST_TRIG_LIBM 0
+#define FAST_TRIG_PRECISE 1
+#define FAST_TRIG_FAST 2
+
+#ifndef FAST_TRIG_ACCURACY
+#define FAST_TRIG_ACCURACY FAST_TRIG_PRECISE
+#endif
+
+#define FAST_TRIG_PRECISE_SIN_ERROR 1.0e-7f
+#define FAST_TRIG_PRECISE_ATAN2_ERROR 2.0e-6f
+#define FAST_TRIG_PRECISE_ACOS_ERROR 4.1e-7f
+#define FAST_TRIG_FAST_SIN_ERROR 6.8e-4f
+#define FAST_TRIG_FAST_ATAN2_ERROR 5.0e-3f
+#define FAST_TRIG_FAST_ACOS_ERROR 6.8e-5f
+#define FAST_TRIG_SIN_RANGE 1000.0f                 // largest angle the sin and cos errors hold for
+
+#define FAST_TRIG_2_OVER_PI 0.636619772f
+#define FAST_TRIG_PI_OVER_2_HIGH 1.5703125f          // pi / 2 split in two parts so the range reduction
+#define FAST_TRIG_PI_OVER_2_LOW 4.83826794897e-4f    // stays exact for the first bits of the remainder
+
+
+// function prototypes
+
+void trig_sinCosTier(float angle, float* sine, float* cosine, int accuracy);
+float trig_atan2Tier(float y, float x, int accuracy);
+float trig_acosTier(float x, int accuracy);
+
+void trig_sinCos(float angle, float* sine, float* cosine);
+float trig_sin(float angle);
+float trig_cos(float angle);
+float trig_atan2(float y, float x);
+float trig_acos(float x);
+
+
+// function implementations
+
+/* sine and cosine of "angle" in radians from a single range reduction, at the "accuracy" tier.
+the tier is a constant in every call, so the branches of the other tiers compile away */
+inline void trig_sinCosTier(float angle, float* sine, float* cosine, int accuracy)
+{
+    if (accuracy == FAST_TRIG_LIBM) {
+        *sine = sinf(angle);
+        *cosine = cosf(angle);
+        return;
+    }
+
+    // Reduce the angle to [-pi/4, pi/4] and keep the quadrant
+    float quadrant_float = floorf(angle * FAST_TRIG_2_OVER_PI + 0.5f);
+    int quadrant = (int)quadrant_float;
+    float r = angle - quadrant_float * FAST_TRIG_PI_OVER_2_HIGH;
+    r -= quadrant_float * FAST_TRIG_PI_OVER_2_LOW;
+    float r2 = r * r;
+
+    float s, c;
+    if (accuracy == FAST_TRIG_PRECISE) {
+        s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+        c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+    }
+    else {
+        s = r * (1.0f + r2 * (-1.6605e-1f + r2 * 7.61e-3f));
+        c = 1.0f + r2 * (-4.967e-1f + r2 * 3.705e-2f);
+    }
+
+    switch (quadrant & 3) {
+        case 0: *sine = s; *cosine = c; break;
+        case 1: *sine = c; *cosine = -s; break;
+        case 2: *sine = -s; *cosine = -c; break;
+        default: *sine = -c; *cosine = s; break;
+    }
+}
+
+/* angle of (x, y) in radians in [-pi, pi] at the "accuracy" tier, returns 0 for the origin */
+inline float trig_atan2Tier(float y, float x, int accuracy)
+{
+    if (accuracy == FAST_TRIG_LIBM) return atan2f(y, x);
+
+    float abs_x = fabsf(x);
+    float abs_y = fabsf(y);
+    float max = max2(abs_x, abs_y);
+    if (max == 0.0f) return 0.0f;
+
+    // The polynomial covers atan in [0, 1], the octant is restored afterwards
+    float a = min2(abs_x, abs_y) / max;
+    float s = a * a;
+
+    float angle;
+    if (accuracy == FAST_TRIG_PRECISE) angle = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+    else angle = a * (0.97239411f + s * -0.19194795f);
+
+    if (abs_y > abs_x) angle = PI * 0.5f - angle;
+    if (x < 0.0f) angle = PI - angle;
+    if (y < 0.0f) angle = -angle;
+    return angle;
+}
+
+/* arc cosine in radians at the "accuracy" tier, "x" is clamped to [-1, 1] so rounding errors in normalized
+dot products don't give NaN */
+inline float trig_acosTier(float x, int accuracy)
+{
+    x = clamp(x, -1.0f, 1.0f);
+    if (accuracy == FAST_TRIG_LIBM) return acosf(x);
+
+    float a = fabsf(x);
+    float angle;
+    if (accuracy == FAST_TRIG_PRECISE) {
+        angle = sqrtf(1.0f - a) * (1.5707963050f + a * (-0.2145988016f + a * (0.0889789874f + a * (-0.0501743046f
+              + a * (0.0308918810f + a * (-0.0170881256f + a * (0.0066700901f + a * -0.0012624911f)))))));
+    }
+    else angle = sqrtf(1.0f - a) * (1.5707288f + a * (-0.2121144f + a * (0.0742610f + a * -0.0187293f)));
+
+    return (x < 0.0f) ? PI - angle : angle;
+}
+
+/* sine and cosine of "angle" in radians from a single range reduction */
+inline void trig_sinCos(float angle, float* sine, float* cosine)
+{
+    trig_sinCosTier(angle, sine, cosine, FAST_TRIG_ACCURACY);
+}
+
+inline float trig_sin(float angle)
+{
+    float sine, cosine;
+    trig_sinCos(angle, &sine, &cosine);
+    return sine;
+}
+
+inline float trig_cos(float angle)
+{
+    float sine, cosine;
+    trig_sinCos(angle, &sine, &cosine);
+    return cosine;
+}
+
+/* angle of (x, y) in radians in [-pi, pi], returns 0 for the origin */
+inline float trig_atan2(float y, float x)
+{
+    return trig_atan2Tier(y, x, FAST_TRIG_ACCURACY);
+}
+
+/* arc cosine in radians, "x" is clamped to [-1, 1] so rounding errors in normalized dot products don't give NaN */
+inline float trig_acos(float x)
+{
+    return trig_acosTier(x, FAST_TRIG_ACCURACY);
+}
+
+#endif
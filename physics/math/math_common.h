@@ -40,7 +40,7 @@ inline float qi_sqrt(float number)
 
     union {
         float f;
-        long l;
+        int32_t l;
     } converter;
 
     converter.f = y; // Almacena el float en la unión
@@ -21,6 +21,7 @@ void point_rotateZYX(Vector3 *point, const Vector3 *rotation);
 void point_rotateXYZ(Vector3 *point, const Vector3 *rotation);
 void point_transformToLocalSpace(Vector3* global_point, const Vector3* local_center, const Vector3* local_rotation);
 void point_transformToGlobalSpace(Vector3* local_point, const Vector3* local_center, const Vector3* local_rotation);
+Matrix3x3 rotation_getMatrix(const Vector3* rotation);
 
 Vector3 segment_closestToPoint(const Vector3 *seg_a, const Vector3 *seg_b, const Vector3 *point_c);
 void segment_closestPointsWithSegment(const Vector3 *seg1_a, const Vector3 *seg1_b, const Vector3 *seg2_a, const Vector3 *seg2_b, Vector3 *closest_seg1, Vector3 *closest_seg2);
@@ -317,16 +318,16 @@ inline float segment_distanceToPoint(const Vector3 *a, const Vector3 *b, const V
 Matrix3x3 rotationMatrix_getFromEuler(const Vector3 *rotation)
 {
     float rad_x = rad(rotation->x);
-    float cos_rad_x = cosf(rad_x);
-    float sin_rad_x = sinf(rad_x);
+    float cos_rad_x, sin_rad_x;
+    trig_sinCos(rad_x, &sin_rad_x, &cos_rad_x);
 
     float rad_y = rad(rotation->y);
-    float cos_rad_y = cosf(rad_y);
-    float sin_rad_y = sinf(rad_y);
+    float cos_rad_y, sin_rad_y;
+    trig_sinCos(rad_y, &sin_rad_y, &cos_rad_y);
 
     float rad_z = rad(rotation->z);
-    float cos_rad_z = cosf(rad_z);
-    float sin_rad_z = sinf(rad_z);
+    float cos_rad_z, sin_rad_z;
+    trig_sinCos(rad_z, &sin_rad_z, &cos_rad_z);
 
     Matrix3x3 R_x = {
         .row = {
@@ -363,16 +364,16 @@ Matrix3x3 rotationMatrix_getFromEuler(const Vector3 *rotation)
 void point_rotateZYX(Vector3 *point, const Vector3 *rotation)
 {
     float rad_x = rad(rotation->x);
-    float cos_rad_x = cosf(rad_x);
-    float sin_rad_x = sinf(rad_x);
+    float cos_rad_x, sin_rad_x;
+    trig_sinCos(rad_x, &sin_rad_x, &cos_rad_x);
 
     float rad_y = rad(rotation->y);
-    float cos_rad_y = cosf(rad_y);
-    float sin_rad_y = sinf(rad_y);
+    float cos_rad_y, sin_rad_y;
+    trig_sinCos(rad_y, &sin_rad_y, &cos_rad_y);
 
     float rad_z = rad(rotation->z);
-    float cos_rad_z = cosf(rad_z);
-    float sin_rad_z = sinf(rad_z);
+    float cos_rad_z, sin_rad_z;
+    trig_sinCos(rad_z, &sin_rad_z, &cos_rad_z);
 
     // Rotate around Z axis
     float xZ = point->x * cos_rad_z - point->y * sin_rad_z;
@@ -391,16 +392,16 @@ void point_rotateZYX(Vector3 *point, const Vector3 *rotation)
 void point_rotateXYZ(Vector3 *point, const Vector3 *rotation)
 {
     float rad_x = rad(rotation->x);
-    float cos_rad_x = cosf(rad_x);
-    float sin_rad_x = sinf(rad_x);
+    float cos_rad_x, sin_rad_x;
+    trig_sinCos(rad_x, &sin_rad_x, &cos_rad_x);
 
     float rad_y = rad(rotation->y);
-    float cos_rad_y = cosf(rad_y);
-    float sin_rad_y = sinf(rad_y);
+    float cos_rad_y, sin_rad_y;
+    trig_sinCos(rad_y, &sin_rad_y, &cos_rad_y);
 
     float rad_z = rad(rotation->z);
-    float cos_rad_z = cosf(rad_z);
-    float sin_rad_z = sinf(rad_z);
+    float cos_rad_z, sin_rad_z;
+    trig_sinCos(rad_z, &sin_rad_z, &cos_rad_z);
 
     // Rotate around X axis (inverse order)
     float yX = point->y * cos_rad_x + point->z * sin_rad_x;
@@ -439,6 +440,26 @@ void point_transformToGlobalSpace(Vector3* local_point, const Vector3* local_cen
     vector3_add(local_point, local_center);
 }
 
+/* local to global rotation matrix R = Rz * Ry * Rx of the euler angles in degrees "rotation",
+the same rotation point_transformToGlobalSpace applies. keep it around instead of rebuilding it per query */
+Matrix3x3 rotation_getMatrix(const Vector3* rotation)
+{
+    float cos_x, sin_x;
+    trig_sinCos(rad(rotation->x), &sin_x, &cos_x);
+
+    float cos_y, sin_y;
+    trig_sinCos(rad(rotation->y), &sin_y, &cos_y);
+
+    float cos_z, sin_z;
+    trig_sinCos(rad(rotation->z), &sin_z, &cos_z);
+
+    return (Matrix3x3){
+        .row = {
+            {cos_y * cos_z, cos_z * sin_y * sin_x - sin_z * cos_x, cos_z * sin_y * cos_x + sin_z * sin_x},
+            {cos_y * sin_z, sin_z * sin_y * sin_x + cos_z * cos_x, sin_z * sin_y * cos_x - cos_z * sin_x},
+            {-sin_y, cos_y * sin_x, cos_y * cos_x}}};
+}
+
 // another very convenient and very difficult to figure out algorithm
 void rotate_normal(Vector3 *vector, const Vector3 *rotation)
 {
@@ -34,6 +34,7 @@ void matrix3x3_scale(Matrix3x3* matrix, float scalar);
 
 Matrix3x3 matrix3x3_multiply(const Matrix3x3* matrix1, const Matrix3x3* matrix2);
 Vector3 matrix3x3_multiplyByVector(const Matrix3x3* matrix, const Vector3* vector);
+Vector3 matrix3x3_multiplyTransposeByVector(const Matrix3x3* matrix, const Vector3* vector);
 
 Matrix3x3 matrix3x3_returnNegative(const Matrix3x3* matrix);
 Matrix3x3 matrix3x3_returnTranspose(const Matrix3x3* matrix);
@@ -242,6 +243,15 @@ Vector3 matrix3x3_multiplyByVector(const Matrix3x3* matrix, const Vector3* vecto
     };
 }
 
+/* Multiplies the transpose of the matrix by a vector, without building the transpose. */
+Vector3 matrix3x3_multiplyTransposeByVector(const Matrix3x3* matrix, const Vector3* vector) {
+    return (Vector3){
+        .x = matrix->row[0].x * vector->x + matrix->row[1].x * vector->y + matrix->row[2].x * vector->z,
+        .y = matrix->row[0].y * vector->x + matrix->row[1].y * vector->y + matrix->row[2].y * vector->z,
+        .z = matrix->row[0].z * vector->x + matrix->row[1].z * vector->y + matrix->row[2].z * vector->z
+    };
+}
+
 /* Checks if two matrices are equal. */
 int matrix3x3_equals(const Matrix3x3* matrix1, const Matrix3x3* matrix2) {
     return (matrix1->row[0].x == matrix2->row[0].x && matrix1->row[0].y == matrix2->row[0].y && matrix1->row[0].z == matrix2->row[0].z &&
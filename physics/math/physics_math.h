@@ -3,10 +3,17 @@
 
 // Libraries
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
 #include <math.h>
 #include <float.h>
 
 #include "math_common.h"
+#include "fast_trig.h"
 
 #include "vector2.h"
 #include "vector3.h"
@@ -0,0 +1,62 @@
+#ifndef MEMORY_ARENA_H
+#define MEMORY_ARENA_H
+
+/* MEMORY_ARENA.H
+a single block allocated once at startup and handed out in GLOBAL_ALIGNMENT aligned pieces.
+pieces are never freed one by one, the whole arena goes with memoryArena_delete */
+
+
+// structures
+
+typedef struct {
+    uint8_t* memory;
+    size_t size;
+    size_t offset;          // start of the free part of the block
+} MemoryArena;
+
+
+// function prototypes
+
+size_t memoryArena_getAlignedSize(size_t size);
+
+void memoryArena_init(MemoryArena* arena, size_t size);
+void memoryArena_delete(MemoryArena* arena);
+void* memoryArena_allocate(MemoryArena* arena, size_t size);
+
+
+// function implementations
+
+/* rounds "size" up to GLOBAL_ALIGNMENT, add up the sizes of the pieces with it to size an arena */
+size_t memoryArena_getAlignedSize(size_t size)
+{
+    return (size + GLOBAL_ALIGNMENT - 1) & ~(size_t)(GLOBAL_ALIGNMENT - 1);
+}
+
+void memoryArena_init(MemoryArena* arena, size_t size)
+{
+    arena->size = memoryArena_getAlignedSize(size);
+    arena->offset = 0;
+    arena->memory = aligned_alloc(GLOBAL_ALIGNMENT, arena->size);
+    assert(arena->memory != NULL);
+}
+
+void memoryArena_delete(MemoryArena* arena)
+{
+    free(arena->memory);
+    arena->memory = NULL;
+    arena->size = 0;
+    arena->offset = 0;
+}
+
+/* returns "size" bytes aligned to GLOBAL_ALIGNMENT, the arena must have been sized for them */
+void* memoryArena_allocate(MemoryArena* arena, size_t size)
+{
+    size = memoryArena_getAlignedSize(size);
+    assert(arena->offset + size <= arena->size);
+
+    void* piece = arena->memory + arena->offset;
+    arena->offset += size;
+    return piece;
+}
+
+#endif
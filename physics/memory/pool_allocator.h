@@ -0,0 +1,130 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+/* POOL_ALLOCATOR.H
+fixed capacity pool of same size elements carved from a memory arena, with a free list of slots.
+elements never move, so pointers to them stay valid until they are freed. they are also reached through handles
+that carry the generation of their slot, so a handle to a freed element resolves to NULL instead of its successor */
+
+#define POOL_NULL_HANDLE 0xFFFFFFFFu
+#define POOL_MAX_CAPACITY 0xFFFF
+#define POOL_SLOT_USED -2           // value of "next_free" for the slots in use
+
+
+// structures
+
+typedef uint32_t PoolHandle;        // slot index in the low 16 bits, slot generation in the high 16 bits
+
+typedef struct {
+    uint8_t* elements;
+    uint16_t* generations;          // bumped on every free
+    int* next_free;                 // free list through the slots, POOL_SLOT_USED for the slots in use
+    int stride;                     // element size rounded up to GLOBAL_ALIGNMENT
+    int capacity;
+    int count;
+    int high_water;                 // slots from here on were never used, iterations stop here
+    int first_free;
+} Pool;
+
+
+// function prototypes
+
+size_t pool_getMemorySize(int element_size, int capacity);
+void pool_init(Pool* pool, MemoryArena* arena, int element_size, int capacity);
+
+PoolHandle pool_allocate(Pool* pool);
+void pool_free(Pool* pool, PoolHandle handle);
+
+void* pool_get(const Pool* pool, PoolHandle handle);
+void* pool_getAt(const Pool* pool, int index);
+bool pool_isUsed(const Pool* pool, int index);
+PoolHandle pool_getHandle(const Pool* pool, int index);
+
+
+// function implementations
+
+/* bytes "pool_init" takes from the arena */
+size_t pool_getMemorySize(int element_size, int capacity)
+{
+    return memoryArena_getAlignedSize(memoryArena_getAlignedSize(element_size) * capacity)
+        + memoryArena_getAlignedSize(capacity * sizeof(uint16_t))
+        + memoryArena_getAlignedSize(capacity * sizeof(int));
+}
+
+void pool_init(Pool* pool, MemoryArena* arena, int element_size, int capacity)
+{
+    assert(element_size > 0);
+    assert(capacity > 0 && capacity <= POOL_MAX_CAPACITY);
+
+    pool->stride = memoryArena_getAlignedSize(element_size);
+    pool->capacity = capacity;
+    pool->count = 0;
+    pool->high_water = 0;
+    pool->first_free = -1;
+
+    pool->elements = memoryArena_allocate(arena, pool->stride * capacity);
+    pool->generations = memoryArena_allocate(arena, capacity * sizeof(uint16_t));
+    pool->next_free = memoryArena_allocate(arena, capacity * sizeof(int));
+
+    memset(pool->generations, 0, capacity * sizeof(uint16_t));
+}
+
+/* returns the handle of a zeroed element, reusing freed slots before new ones */
+PoolHandle pool_allocate(Pool* pool)
+{
+    assert(pool->count < pool->capacity);
+
+    int index;
+    if (pool->first_free >= 0) {
+        index = pool->first_free;
+        pool->first_free = pool->next_free[index];
+    }
+    else index = pool->high_water++;
+
+    pool->next_free[index] = POOL_SLOT_USED;
+    pool->count++;
+
+    memset(pool_getAt(pool, index), 0, pool->stride);
+    return pool_getHandle(pool, index);
+}
+
+/* the element is zeroed so linear iterations over the slots can read freed ones safely */
+void pool_free(Pool* pool, PoolHandle handle)
+{
+    assert(pool_get(pool, handle) != NULL);
+
+    int index = handle & 0xFFFF;
+    memset(pool_getAt(pool, index), 0, pool->stride);
+    pool->generations[index]++;
+    pool->next_free[index] = pool->first_free;
+    pool->first_free = index;
+    pool->count--;
+}
+
+/* returns the element of "handle", or NULL when it was freed */
+void* pool_get(const Pool* pool, PoolHandle handle)
+{
+    if (handle == POOL_NULL_HANDLE) return NULL;
+
+    int index = handle & 0xFFFF;
+    if (index >= pool->high_water || pool->next_free[index] != POOL_SLOT_USED) return NULL;
+    if (pool->generations[index] != (handle >> 16)) return NULL;
+    return pool_getAt(pool, index);
+}
+
+void* pool_getAt(const Pool* pool, int index)
+{
+    return pool->elements + index * pool->stride;
+}
+
+bool pool_isUsed(const Pool* pool, int index)
+{
+    return pool->next_free[index] == POOL_SLOT_USED;
+}
+
+PoolHandle pool_getHandle(const Pool* pool, int index)
+{
+    return ((PoolHandle)pool->generations[index] << 16) | (PoolHandle)index;
+}
+
+#endif
@@ -1,18 +1,45 @@
 #ifndef PHYSICS_H
 #define PHYSICS_H
 
+#include "physics_config.h"
 
 #include "math/physics_math.h"
 
+#include "memory/memory_arena.h"
+#include "memory/pool_allocator.h"
+
 #include "body/rigid_body.h"
 
 
 #include "collision/contact_data.h"
+#include "collision/collision_filter.h"
 #include "collision/shapes/sphere.h"
 #include "collision/shapes/AABB.h"
 #include "collision/shapes/box.h"
 #include "collision/shapes/plane.h"
 #include "collision/shapes/ray.h"
 #include "collision/shapes/capsule.h"
+#include "collision/shapes/triangle.h"
+#include "collision/shapes/mesh.h"
+#include "collision/shapes/mesh_loader.h"
+#include "collision/shapes/heightfield.h"
+#include "collision/shapes/convex_hull.h"
+#include "collision/shapes/compound.h"
+
+#include "collision/broadphase/broadphase_pair.h"
+#include "collision/broadphase/dynamic_tree.h"
+#include "collision/broadphase/spatial_hash.h"
+#include "collision/broadphase/sweep_and_prune.h"
+
+#include "collision/collider.h"
+#include "collision/narrowphase/gjk.h"
+#include "collision/narrowphase/epa.h"
+#include "collision/narrowphase/narrowphase.h"
+#include "collision/contact_manifold.h"
+
+#include "dynamics/contact_solver.h"
+#include "dynamics/island.h"
+
+#include "engine/physics_world.h"
 
 #endif
\ No newline at end of file
@@ -59,7 +59,23 @@ without triggering a large modification of the tree each frame which can be cost
 #define NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD 255
 
 /* Distance threshold to consider that two contact points in a manifold are the same */
-#define SAME_CONTACT_POINT_DISTANCE_THRESHOLD 0.01f
+#define SAME_CONTACT_POINT_DISTANCE_THRESHOLD 0.5f
+
+/* Default number of iterations of the velocity and position passes of the contact solver */
+#define DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS 10
+#define DEFAULT_POSITION_SOLVER_NB_ITERATIONS 5
+
+/* Fraction of the penetration corrected per step by the contact solver position correction */
+#define CONTACT_SOLVER_BAUMGARTE_FACTOR 0.2f
+
+/* Penetration depth the contact solver leaves uncorrected, so resting contacts keep touching */
+#define CONTACT_SOLVER_PENETRATION_SLOP 0.1f
+
+/* Speed under which a body starts counting the time before it can sleep */
+#define DEFAULT_SLEEP_LINEAR_VELOCITY 2.0f
+
+/* Time (in seconds) a whole island must stay under the sleep velocity before it sleeps */
+#define DEFAULT_TIME_BEFORE_SLEEP 1.0f
 
 /* Global alignment (in bytes) that all allocators must enforce */
 #define GLOBAL_ALIGNMENT 16
@@ -1,6 +1,9 @@
 #ifndef TIME_H
 #define TIME_H
 
+#define TIME_FIXED_STEP_S (1.0f / 60.0f)     // duration of one physics tick
+#define TIME_MAX_STEPS_PER_FRAME 4           // ticks a single frame may run before the lost time is dropped
+
 
 // structures
 
@@ -13,6 +16,10 @@ typedef struct
     float frame_time_s;
     float frame_rate;
 
+    float fixed_time_s;             // constant step handed to the physics
+    float accumulator_s;            // frame time not yet consumed by physics ticks
+    float interpolation_factor;     // fraction of a tick between the last two physics states, for rendering
+
 } TimeData;
 
 
@@ -20,6 +27,7 @@ typedef struct
 
 void time_init(TimeData *time);
 void time_setData(TimeData *time);
+bool time_consumeFixedStep(TimeData *time);
 
 
 // functions implementations
@@ -32,6 +40,9 @@ void time_init(TimeData *time)
     time->last_frame_ms = 0.0f;
     time->frame_time_s = 0.0f;
     time->frame_rate = 0.0f;
+    time->fixed_time_s = TIME_FIXED_STEP_S;
+    time->accumulator_s = 0.0f;
+    time->interpolation_factor = 0.0f;
 }
 
 
@@ -47,6 +58,24 @@ void time_setData(TimeData *time)
     time->frame_rate = 1 / time->frame_time_s;
 
     time->last_frame_ms = time->current_frame_ms;
+
+    // Cap the debt so a long hitch doesn't make the next frames even slower catching up
+    time->accumulator_s += time->frame_time_s;
+    if (time->accumulator_s > TIME_MAX_STEPS_PER_FRAME * time->fixed_time_s) time->accumulator_s = TIME_MAX_STEPS_PER_FRAME * time->fixed_time_s;
+}
+
+/* returns true while there is a whole tick of frame time left to simulate and consumes it,
+once it returns false the interpolation factor holds how far the frame is into the next tick.
+use it as the condition of the physics loop */
+bool time_consumeFixedStep(TimeData *time)
+{
+    if (time->accumulator_s >= time->fixed_time_s) {
+        time->accumulator_s -= time->fixed_time_s;
+        return true;
+    }
+
+    time->interpolation_factor = time->accumulator_s / time->fixed_time_s;
+    return false;
 }
 
 #endif
\ No newline at end of file